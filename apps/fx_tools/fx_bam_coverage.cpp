@@ -260,7 +260,8 @@ int main(int argc, char const ** argv)
     seqan::BamHeader header;
     readHeader(header, bamFile);
 
-    seqan::BamAlignmentRecord record;
+    // Only the fixed-size fields are used, so we do not decode the records.
+    seqan::BamAlignmentRecordView record;
     while (!atEnd(bamFile))
     {
         readRecord(record, bamFile);
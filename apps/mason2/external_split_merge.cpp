@@ -132,6 +132,38 @@ void IdSplitter::close()
     fileNames.clear();
 }
 
+// ---------------------------------------------------------------------------
+// Function TempReadsFileOut::open()
+// ---------------------------------------------------------------------------
+
+bool TempReadsFileOut::open(std::fstream & file, bool compress)
+{
+    close();
+    bool success = false;
+#if SEQAN_HAS_ZLIB
+    if (compress)
+        success = seqan::open(stream, file, seqan::BgzfFile());
+    else
+        success = seqan::open(stream, file, seqan::Nothing());
+#else
+    (void)compress;
+    success = seqan::open(stream, file, seqan::Nothing());
+#endif
+    if (success)
+        iter = directionIterator(stream, seqan::Output());
+    return success;
+}
+
+// ---------------------------------------------------------------------------
+// Function TempReadsFileOut::close()
+// ---------------------------------------------------------------------------
+
+void TempReadsFileOut::close()
+{
+    if (stream)
+        seqan::close(stream);
+}
+
 // ---------------------------------------------------------------------------
 // Function SamJoiner::init()
 // ---------------------------------------------------------------------------
@@ -144,9 +176,15 @@ void SamJoiner::init(seqan::BamFileOut * outPtr)
     for (unsigned i = 0; i < splitter->files.size(); ++i)
     {
         if (i == 0u && outPtr)
-            bamFileIns.push_back(new seqan::BamFileIn(*outPtr, *splitter->files[i]));
+            bamFileIns.push_back(new seqan::BamFileIn(*outPtr));
         else
-            bamFileIns.push_back(new seqan::BamFileIn(*splitter->files[i]));
+            bamFileIns.push_back(new seqan::BamFileIn());
+        bamFileIns.back()->stream.bgzfThreads = 1;
+        if (!open(*bamFileIns.back(), *splitter->files[i]))
+        {
+            std::cerr << "ERROR: Could not read temporary file!\n";
+            exit(1);
+        }
 
         // We use a separate header structure and name stores and caches.  Since the headers of all files are equal, we
         // will write out the first one only.
@@ -157,7 +195,10 @@ void SamJoiner::init(seqan::BamFileOut * outPtr)
 
         active[i] = _loadNext(records[i], i);
         numActive += (active[i] != false);
+        if (active[i])
+            heap.push_back(i);
     }
+    std::make_heap(heap.begin(), heap.end(), HeapGreater(records));
 }
 
 // ---------------------------------------------------------------------------
@@ -178,23 +219,25 @@ bool SamJoiner::_loadNext(seqan::BamAlignmentRecord & record, unsigned idx)
 
 int SamJoiner::get(seqan::BamAlignmentRecord & record)
 {
-    unsigned idx = seqan::maxValue<unsigned>();
-    for (unsigned i = 0; i < length(records); ++i)
-    {
-        if (!active[i])
-            continue;
-        if (idx == seqan::maxValue<unsigned>() || ltBamAlignmentRecord(records[i], records[idx]))
-            idx = i;
-    }
-    if (idx == seqan::maxValue<unsigned>())
+    if (heap.empty())
         return 1;
 
+    // Move the file with the smallest record to the back.
+    std::pop_heap(heap.begin(), heap.end(), HeapGreater(records));
+    unsigned idx = heap.back();
+
     // We use double-buffering and the input parameters as buffers.
     using std::swap;
     active[idx] = _loadNext(record, idx);
     swap(record, records[idx]);
     numActive -= !active[idx];
 
+    // Sift the file back in with its next record or drop it if exhausted.
+    if (active[idx])
+        std::push_heap(heap.begin(), heap.end(), HeapGreater(records));
+    else
+        heap.pop_back();
+
     return 0;
 }
 
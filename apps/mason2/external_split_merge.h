@@ -40,12 +40,18 @@
 // final step, we merge the fragments/reads by their id and write them to
 // the final file.
 //
+// The temporary reads and alignments are stored in binary formats (see
+// MasonTempReads and SAM, or BAM when compressed).  With --temp-compression
+// they are BGZF-compressed, each temporary stream on a single thread of its
+// own, and the joiners read them back block-wise with read-ahead.
+//
 // This header provides the data structures and routines to manage this.
 // ==========================================================================
 
 #ifndef APPS_MASON2_EXTERNAL_SPLIT_MERGE_H_
 #define APPS_MASON2_EXTERNAL_SPLIT_MERGE_H_
 
+#include <algorithm>
 #include <vector>
 #include <iostream>
 
@@ -66,6 +72,16 @@ inline int strnum_cmp(const char *a, const char *b);
 // Tags, Classes, Enums
 // ============================================================================
 
+// --------------------------------------------------------------------------
+// Tag MasonTempReads
+// --------------------------------------------------------------------------
+
+// Binary record format for the temporary read files.  Each record consists of the id, the sequence, and the qualities,
+// each prefixed by its length as a 32 bit integer.
+
+struct MasonTempReads_;
+typedef seqan::Tag<MasonTempReads_> MasonTempReads;
+
 // --------------------------------------------------------------------------
 // Class ContigPicker
 // --------------------------------------------------------------------------
@@ -147,6 +163,42 @@ public:
     void close();
 };
 
+// ----------------------------------------------------------------------------
+// Class TempReadsFileOut
+// ----------------------------------------------------------------------------
+
+// Writes reads in the MasonTempReads format to one file of an IdSplitter.
+//
+// The file should only be open while it is written to since every compressed stream keeps its own buffers and
+// compression thread.
+
+class TempReadsFileOut
+{
+public:
+    typedef seqan::VirtualStream<char, seqan::Output> TStream;
+    typedef seqan::DirectionIterator<TStream, seqan::Output>::Type TOutputIterator;
+
+    // The stream writing to the file and an iterator on it.
+    TStream stream;
+    TOutputIterator iter;
+
+    TempReadsFileOut()
+    {
+        stream.bgzfThreads = 1;
+    }
+
+    bool isOpen() const
+    {
+        return stream;
+    }
+
+    // Open for writing to file, BGZF-compressed if compress is true and zlib is available.
+    bool open(std::fstream & file, bool compress);
+
+    // Close the stream, flushing the buffers.
+    void close();
+};
+
 // ----------------------------------------------------------------------------
 // Class FastxJoiner
 // ----------------------------------------------------------------------------
@@ -154,15 +206,32 @@ public:
 // Allows joining by id name from FASTA data stored in a IdSplitter.
 //
 // Construct with IdSplitter after reset() call.
-
-// TODO(holtgrew): Could use a heap/tournament tree.
+//
+// The active files are kept in a heap ordered by their current id such that the next record is found in logarithmic
+// time in the number of files.
 
 template <typename TTag>
 class FastxJoiner
 {
 public:
-    // The type of the input iterator to use.
-    typedef typename seqan::DirectionIterator<std::fstream, seqan::Input>::Type TInputIterator;
+    // The type of the input streams and iterators to use.  The compression of the files is detected automatically.
+    typedef seqan::VirtualStream<char, seqan::Input> TInputStream;
+    typedef typename seqan::DirectionIterator<TInputStream, seqan::Input>::Type TInputIterator;
+
+    // Heap order on file indices, the file with the smallest current id is on top, ties are broken by index.
+    struct HeapGreater
+    {
+        seqan::StringSet<seqan::CharString> const * ids;
+
+        HeapGreater(seqan::StringSet<seqan::CharString> const & ids) : ids(&ids)
+        {}
+
+        bool operator()(unsigned lhs, unsigned rhs) const
+        {
+            int res = strnum_cmp(toCString((*ids)[lhs]), toCString((*ids)[rhs]));
+            return (res > 0) || (res == 0 && lhs > rhs);
+        }
+    };
 
     // The IdSplitter to use.
     IdSplitter * splitter;
@@ -172,7 +241,10 @@ public:
     seqan::StringSet<seqan::CharString> ids, seqs, quals;
     // Maps files for activeness.
     std::vector<bool> active;
-    // Input iterators, one for each input file.
+    // Indices of the active files, arranged as a heap by HeapGreater.
+    std::vector<unsigned> heap;
+    // Input streams and iterators, one for each input file.
+    std::vector<TInputStream *> inputStreams;
     std::vector<TInputIterator> inputIterators;
 
     FastxJoiner() : splitter(), numActive(0)
@@ -183,6 +255,12 @@ public:
         _init();
     }
 
+    ~FastxJoiner()
+    {
+        for (unsigned i = 0; i < inputStreams.size(); ++i)
+            delete inputStreams[i];
+    }
+
     void _init();
 
     template <typename TSeq>
@@ -203,14 +281,30 @@ public:
 // Allows joining by id name from FASTA data stored in a IdSplitter.
 //
 // Construct with IdSplitter after reset() call.
-
-// TODO(holtgrew): Could use a heap/tournament tree.
+//
+// As in FastxJoiner, the active files are kept in a heap ordered by their current record.
 
 // Compare two BAM alignment records by query name, tie is broken by first/last flag, first < last.
 
 class SamJoiner
 {
 public:
+    // Heap order on file indices, the file with the smallest current record is on top, ties are broken by index.
+    struct HeapGreater
+    {
+        seqan::String<seqan::BamAlignmentRecord> const * records;
+
+        HeapGreater(seqan::String<seqan::BamAlignmentRecord> const & records) : records(&records)
+        {}
+
+        bool operator()(unsigned lhs, unsigned rhs) const
+        {
+            bool lhsLess = ltBamAlignmentRecord((*records)[lhs], (*records)[rhs]);
+            bool rhsLess = ltBamAlignmentRecord((*records)[rhs], (*records)[lhs]);
+            return (lhsLess != rhsLess) ? rhsLess : (lhs > rhs);
+        }
+    };
+
     // The IdSplitter to use.
     IdSplitter * splitter;
     // Number of active files.
@@ -219,6 +313,8 @@ public:
     seqan::String<seqan::BamAlignmentRecord> records;
     // Maps files for activeness.
     std::vector<bool> active;
+    // Indices of the active files, arranged as a heap by HeapGreater.
+    std::vector<unsigned> heap;
     // Input BAM files, one for each input file.
     std::vector<seqan::BamFileIn *> bamFileIns;
 
@@ -275,10 +371,20 @@ void FastxJoiner<TTag>::_init()
 
     for (unsigned i = 0; i < splitter->files.size(); ++i)
     {
-        inputIterators.push_back(directionIterator(*splitter->files[i], seqan::Input()));
+        inputStreams.push_back(new TInputStream);
+        inputStreams.back()->bgzfThreads = 1;
+        if (!open(*inputStreams.back(), *splitter->files[i]))
+        {
+            std::cerr << "ERROR: Could not read temporary file!\n";
+            exit(1);
+        }
+        inputIterators.push_back(directionIterator(*inputStreams.back(), seqan::Input()));
         active[i] = _loadNext(ids[i], seqs[i], quals[i], i);
         numActive += (active[i] != false);
+        if (active[i])
+            heap.push_back(i);
     }
+    std::make_heap(heap.begin(), heap.end(), HeapGreater(ids));
 }
 
 // ----------------------------------------------------------------------------
@@ -302,17 +408,13 @@ bool FastxJoiner<TTag>::_loadNext(TSeq & id, TSeq & seq, TSeq & qual, unsigned i
 template <typename TTag>
 int FastxJoiner<TTag>::get(seqan::CharString & id, seqan::CharString & seq, seqan::CharString & qual)
 {
-    unsigned idx = seqan::maxValue<unsigned>();
-    for (unsigned i = 0; i < length(ids); ++i)
-    {
-        if (!active[i])
-            continue;
-        if (idx == seqan::maxValue<unsigned>() || strnum_cmp(toCString(ids[i]), toCString(ids[idx])) < 0)
-            idx = i;
-    }
-    if (idx == seqan::maxValue<unsigned>())
+    if (heap.empty())
         return 1;
 
+    // Move the file with the smallest id to the back.
+    std::pop_heap(heap.begin(), heap.end(), HeapGreater(ids));
+    unsigned idx = heap.back();
+
     // We use double-buffering and the input parameters as buffers.
     active[idx] = _loadNext(id, seq, qual, idx);
     swap(id, ids[idx]);
@@ -320,9 +422,66 @@ int FastxJoiner<TTag>::get(seqan::CharString & id, seqan::CharString & seq, seqa
     swap(qual, quals[idx]);
     numActive -= !active[idx];
 
+    // Sift the file back in with its next id or drop it if exhausted.
+    if (active[idx])
+        std::push_heap(heap.begin(), heap.end(), HeapGreater(ids));
+    else
+        heap.pop_back();
+
     return 0;
 }
 
+// ----------------------------------------------------------------------------
+// Function readRecord()                                         [MasonTempReads]
+// ----------------------------------------------------------------------------
+
+template <typename TIdString, typename TSeqString, typename TQualString, typename TFwdIterator>
+inline void readRecord(TIdString & meta, TSeqString & seq, TQualString & qual, TFwdIterator & iter,
+                       MasonTempReads const & /*tag*/)
+{
+    __uint32 len = 0;
+
+    clear(meta);
+    readRawPod(len, iter);
+    write(meta, iter, len);
+
+    clear(seq);
+    readRawPod(len, iter);
+    write(seq, iter, len);
+
+    clear(qual);
+    readRawPod(len, iter);
+    write(qual, iter, len);
+}
+
+// ----------------------------------------------------------------------------
+// Function writeRecord()                                        [MasonTempReads]
+// ----------------------------------------------------------------------------
+
+template <typename TTarget, typename TIdString, typename TSeqString, typename TQualString>
+inline void writeRecord(TTarget & target, TIdString const & meta, TSeqString const & seq, TQualString const & qual,
+                        MasonTempReads const & /*tag*/)
+{
+    appendRawPod(target, (__uint32)length(meta));
+    write(target, meta);
+    appendRawPod(target, (__uint32)length(seq));
+    write(target, seq);
+    appendRawPod(target, (__uint32)length(qual));
+    write(target, qual);
+}
+
+// ----------------------------------------------------------------------------
+// Function writeRecords()                                     [TempReadsFileOut]
+// ----------------------------------------------------------------------------
+
+template <typename TIdStringSet, typename TSeqStringSet, typename TQualStringSet>
+inline void writeRecords(TempReadsFileOut & file, TIdStringSet const & meta, TSeqStringSet const & seq,
+                         TQualStringSet const & qual)
+{
+    for (unsigned i = 0; i < length(seq); ++i)
+        writeRecord(file.iter, meta[i], seq[i], qual[i], MasonTempReads());
+}
+
 // ----------------------------------------------------------------------------
 // Function ltBamAlignmentRecord()
 // ----------------------------------------------------------------------------
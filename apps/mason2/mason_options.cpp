@@ -1106,6 +1106,9 @@ void MasonSimulatorOptions::addOptions(seqan::ArgumentParser & parser) const
     setMinValue(parser, "chunk-size", "65536");
     setDefaultValue(parser, "chunk-size", "65536");
 
+    addOption(parser, seqan::ArgParseOption("", "temp-compression", "BGZF-compress the temporary files.  Saves scratch "
+                                            "disk space at the cost of CPU time."));
+
     addOption(parser, seqan::ArgParseOption("n", "num-fragments", "Number of reads/pairs to simulate.",
                                             seqan::ArgParseOption::INTEGER, "NUM"));
     setRequired(parser, "num-fragments");
@@ -1220,6 +1223,11 @@ void MasonSimulatorOptions::getOptionValues(seqan::ArgumentParser const & parser
     numThreads = 1;
 #endif  // #if SEQAN_HAS_OPENMP
     getOptionValue(chunkSize, parser, "chunk-size");
+#if SEQAN_HAS_ZLIB
+    compressTempFiles = isSet(parser, "temp-compression");
+#else  // #if SEQAN_HAS_ZLIB
+    compressTempFiles = false;
+#endif  // #if SEQAN_HAS_ZLIB
     getOptionValue(numFragments, parser, "num-fragments");
     getOptionValue(forceSingleEnd, parser, "force-single-end");
     getOptionValue(methFastaInFile, parser, "meth-fasta-in");
@@ -1271,6 +1279,7 @@ void MasonSimulatorOptions::print(std::ostream & out) const
         << "\n"
         << "NUM THREADS\t" << numThreads << "\n"
         << "CHUNK SIZE\t" << chunkSize << "\n"
+        << "COMPRESS TEMP FILES\t" << getYesNoStr(compressTempFiles) << "\n"
         << "\n"
         << "METHYLATION FASTA IN\t" << methFastaInFile << "\n"
         << "OUTPUT FILE LEFT\t" << outFileNameLeft << "\n"
@@ -655,6 +655,8 @@ struct MasonSimulatorOptions
     int numThreads;
     // Number of reads/pairs to simulate in one chunk
     int chunkSize;
+    // Whether to compress the temporary files.
+    bool compressTempFiles;
 
     // Number of reads/pairs to simulate.
     int numFragments;
@@ -687,8 +689,8 @@ struct MasonSimulatorOptions
     Roche454SequencingOptions rocheOptions;
 
     MasonSimulatorOptions() :
-            verbosity(1), seed(0), methSeed(0), seedSpacing(2048), numThreads(1), chunkSize(64*1024), numFragments(0),
-            forceSingleEnd(false)
+            verbosity(1), seed(0), methSeed(0), seedSpacing(2048), numThreads(1), chunkSize(64*1024),
+            compressTempFiles(false), numFragments(0), forceSingleEnd(false)
     {}
 
     // Add options to the argument parser.  Calls addOptions() on the nested *Options objects.
@@ -802,6 +802,30 @@ public:
     }
 };
 
+// --------------------------------------------------------------------------
+// Class SimulatedReadsBuffer
+// --------------------------------------------------------------------------
+
+// Reads and alignments of one thread's chunk, buffered for writing while the next chunk is simulated.
+
+class SimulatedReadsBuffer
+{
+public:
+    seqan::StringSet<seqan::CharString> ids;
+    seqan::StringSet<seqan::Dna5String> seqs;
+    seqan::StringSet<seqan::CharString> quals;
+    std::vector<seqan::BamAlignmentRecord> alignmentRecords;
+
+    // Exchange the buffers with the output buffers of the given thread.
+    void swapWith(ReadSimulatorThread & thread)
+    {
+        swap(ids, thread.ids);
+        swap(seqs, thread.seqs);
+        swap(quals, thread.quals);
+        alignmentRecords.swap(thread.alignmentRecords);
+    }
+};
+
 // --------------------------------------------------------------------------
 // Class MasonSimulatorApp
 // --------------------------------------------------------------------------
@@ -818,6 +842,12 @@ public:
 
     // Threads used for simulation.
     std::vector<ReadSimulatorThread> threads;
+    // Output of the previously simulated chunk, one buffer per thread, and the index of its temporary file (-1 if
+    // nothing is pending).
+    std::vector<SimulatedReadsBuffer> pendingReads;
+    int pendingFileIdx;
+    // Whether the pending chunk is the last one for its temporary file.
+    bool pendingLastChunk;
 
     // ----------------------------------------------------------------------
     // VCF Materialization
@@ -840,7 +870,7 @@ public:
     // alignment information relative to the materialized sequence.
     IdSplitter fragmentSplitter;
     // Helper for joining the FASTQ files.
-    std::SEQAN_AUTO_PTR_NAME<FastxJoiner<seqan::Fastq> > fastxJoiner;
+    std::SEQAN_AUTO_PTR_NAME<FastxJoiner<MasonTempReads> > fastxJoiner;
     // Helper for storing SAM records for each contig/haplotype pair.  In the end, we will join this again.
     IdSplitter alignmentSplitter;
     // Helper for joining the SAM files.
@@ -848,9 +878,10 @@ public:
 
     // The BamHeader to use.
     seqan::BamHeader bamHeader;
-    // BamFileOut and SeqFileOut objects for writing to alignmentSplitter and fragmentSplitter files.
+    // BamFileOut and TempReadsFileOut objects for writing to alignmentSplitter and fragmentSplitter files.  They are
+    // opened when the first chunk of their contig/haplotype is written and closed after its last chunk.
     std::vector<seqan::BamFileOut *> bamFileOuts;
-    std::vector<seqan::SeqFileOut *> seqFileOuts;
+    std::vector<TempReadsFileOut *> seqFileOuts;
 
     // ----------------------------------------------------------------------
     // File Output
@@ -862,7 +893,8 @@ public:
     std::SEQAN_AUTO_PTR_NAME<seqan::BamFileOut> outBamStream;
 
     MasonSimulatorApp(MasonSimulatorOptions const & options) :
-            options(options), rng(options.seed), methRng(options.methSeed),
+            options(options), rng(options.seed), methRng(options.methSeed), pendingFileIdx(-1),
+            pendingLastChunk(false),
             vcfMat(methRng,
                    toCString(options.matOptions.fastaFileName),
                    toCString(options.matOptions.vcfFileName),
@@ -982,22 +1014,23 @@ public:
                 std::vector<std::pair<int, int> > gapIntervals;
                 buildGapIntervals(gapIntervals, contigSeq);
 
-                // Perform the simulation.
-                SEQAN_OMP_PRAGMA(parallel num_threads(options.numThreads))
+                // Perform the simulation while an extra thread writes out the previously simulated chunk.
+                SEQAN_OMP_PRAGMA(parallel for schedule(static, 1) num_threads(options.numThreads + 1))
+                for (int tID = 0; tID <= options.numThreads; ++tID)
                 {
-                    threads[omp_get_thread_num()].run(contigSeq, gapIntervals, varInfos, vcfMat.posMap,
-                                                      sequenceName(vcfMat.faiIndex, rID),
-                                                      refSeq, rID, hID);
+                    if (tID < options.numThreads)
+                        threads[tID].run(contigSeq, gapIntervals, varInfos, vcfMat.posMap,
+                                         sequenceName(vcfMat.faiIndex, rID), refSeq, rID, hID);
+                    else
+                        _writePendingReads();
                 }
 
-                // Write out the temporary sequence.
+                // Hand the simulated reads over to the writer for the next round.
+                pendingFileIdx = rID * haplotypeCount + hID;
+                pendingLastChunk = doBreak;
                 for (int tID = 0; tID < options.numThreads; ++tID)
                 {
-                    unsigned idx = rID * haplotypeCount + hID;
-                    writeRecords(*seqFileOuts[idx], threads[tID].ids, threads[tID].seqs, threads[tID].quals);
-                    if (!empty(options.outFileNameSam))
-                        for (unsigned i = 0; i < length(threads[tID].alignmentRecords); ++i)
-                            writeRecord(*bamFileOuts[idx], threads[tID].alignmentRecords[i]);
+                    pendingReads[tID].swapWith(threads[tID]);
                     std::cerr << '.' << std::flush;
                 }
 
@@ -1007,16 +1040,68 @@ public:
 
             std::cerr << " (" << contigFragmentCount << " fragments) OK\n";
         }
+        _writePendingReads();
         std::cerr << "  Done simulating reads.\n";
     }
 
+    // Write the pending reads and alignments to their temporary files.
+    void _writePendingReads()
+    {
+        if (pendingFileIdx == -1)
+            return;  // Nothing simulated yet.
+
+        TempReadsFileOut & seqFileOut = *seqFileOuts[pendingFileIdx];
+        if (!seqFileOut.isOpen())
+            _openTempFiles(pendingFileIdx);
+
+        for (int tID = 0; tID < options.numThreads; ++tID)
+        {
+            SimulatedReadsBuffer & buffer = pendingReads[tID];
+            writeRecords(seqFileOut, buffer.ids, buffer.seqs, buffer.quals);
+            if (!empty(options.outFileNameSam))
+                for (unsigned i = 0; i < length(buffer.alignmentRecords); ++i)
+                    writeRecord(*bamFileOuts[pendingFileIdx], buffer.alignmentRecords[i]);
+        }
+
+        if (pendingLastChunk)
+        {
+            seqFileOut.close();
+            if (!empty(options.outFileNameSam))
+                close(*bamFileOuts[pendingFileIdx]);
+        }
+        pendingFileIdx = -1;
+    }
+
+    // Open the temporary read and alignment files with the given index for writing.
+    void _openTempFiles(int idx)
+    {
+        if (!seqFileOuts[idx]->open(*fragmentSplitter.files[idx], options.compressTempFiles))
+        {
+            std::cerr << "ERROR: Could not open temporary file!\n";
+            exit(1);
+        }
+        if (!empty(options.outFileNameSam))
+        {
+            // BGZF-compressed BAM if temporary files are compressed, plain SAM otherwise.
+            bool success = options.compressTempFiles ?
+                    open(*bamFileOuts[idx], *alignmentSplitter.files[idx], seqan::Bam()) :
+                    open(*bamFileOuts[idx], *alignmentSplitter.files[idx], seqan::Sam());
+            if (!success)
+            {
+                std::cerr << "ERROR: Could not open temporary file!\n";
+                exit(1);
+            }
+            writeHeader(*bamFileOuts[idx], bamHeader);
+        }
+    }
+
     void _simulateReadsJoin()
     {
         std::cerr << "\nJoining temporary files ...";
         clearOutFiles();  // clear output files such that they are flushed
         fragmentSplitter.reset();
-        fastxJoiner.reset(new FastxJoiner<seqan::Fastq>(fragmentSplitter));
-        FastxJoiner<seqan::Fastq> & joiner = *fastxJoiner.get();  // Shortcut
+        fastxJoiner.reset(new FastxJoiner<MasonTempReads>(fragmentSplitter));
+        FastxJoiner<MasonTempReads> & joiner = *fastxJoiner.get();  // Shortcut
         seqan::CharString id, seq, qual;
         if (options.seqOptions.simulateMatePairs)
             while (!joiner.atEnd())
@@ -1084,9 +1169,13 @@ public:
         // Open alignment splitters.
         alignmentSplitter.numContigs = fragmentIdSplitter.numContigs;
         alignmentSplitter.open();
-        // Construct output BAM files.
+        // Construct output BAM files, they are opened in _openTempFiles().
+        // Each compressed temporary file gets a single helper thread for compression.
         for (unsigned i = 0; i < alignmentSplitter.files.size(); ++i)
-            bamFileOuts.push_back(new seqan::BamFileOut(*alignmentSplitter.files[i], seqan::Sam()));
+        {
+            bamFileOuts.push_back(new seqan::BamFileOut());
+            bamFileOuts.back()->stream.bgzfThreads = 1;
+        }
         // Build and write out header, fill ref name store.
         seqan::BamHeaderRecord vnHeaderRecord;
         vnHeaderRecord.type = seqan::BAM_HEADER_FIRST;
@@ -1116,9 +1205,6 @@ public:
             appendValue(seqHeaderRecord.tags, seqan::Pair<seqan::CharString>("LN", ss.str().c_str()));
             appendValue(bamHeader, seqHeaderRecord);
         }
-        // Write out header to each output BAM file.
-        for (unsigned i = 0; i < alignmentSplitter.files.size(); ++i)
-            writeHeader(*bamFileOuts[i], bamHeader);
     }
 
     // Configure contigPicker.
@@ -1141,7 +1227,7 @@ public:
         fragmentSplitter.numContigs = fragmentIdSplitter.numContigs;
         fragmentSplitter.open();
         for (unsigned i = 0; i < fragmentSplitter.files.size(); ++i)
-            seqFileOuts.push_back(new seqan::SeqFileOut(*fragmentSplitter.files[i], seqan::Fastq()));
+            seqFileOuts.push_back(new TempReadsFileOut());
         // Splitter for alignments, only required when writing out SAM/BAM.
         if (!empty(options.outFileNameSam))
             _initAlignmentSplitter();
@@ -1196,6 +1282,7 @@ public:
         // Initialize simulation threads.
         std::cerr << "Initializing simulation threads ...";
         threads.resize(options.numThreads);
+        pendingReads.resize(options.numThreads);
         for (int i = 0; i < options.numThreads; ++i)
             threads[i].init(options.seed + i * options.seedSpacing,
                             options.methSeed + i * options.seedSpacing,
@@ -352,7 +352,7 @@ int main(int argc, char const ** argv)
     // TODO(holtgrew): This is only suited for the Illumina mate pair protocol at the moment (--> <--).
     int oldRId = 0;
     int oldPos = 0;
-    seqan::BamAlignmentRecord record;
+    seqan::BamAlignmentRecordView record;
     while (!atEnd(bamFileIn))
     {
         readRecord(record, bamFileIn);
@@ -45,7 +45,7 @@ int RoiBuilder::nextId = 0;
 // ---------------------------------------------------------------------------
 
 // Create a new ROI.
-void RoiBuilder::createRoi(seqan::BamAlignmentRecord const & record)
+void RoiBuilder::createRoi(seqan::BamAlignmentRecordView const & record)
 {
     clear(currentProfile);
     clear(connective);
@@ -72,7 +72,7 @@ void RoiBuilder::createRoi(seqan::BamAlignmentRecord const & record)
 // ---------------------------------------------------------------------------
 
 // Extend the current ROI.
-void RoiBuilder::extendRoi(seqan::BamAlignmentRecord const & record)
+void RoiBuilder::extendRoi(seqan::BamAlignmentRecordView const & record)
 {
     // We will use this for extending the connective array in case of using pairing.
     bool fillConnective = false;
@@ -105,9 +105,11 @@ void RoiBuilder::extendRoi(seqan::BamAlignmentRecord const & record)
 
     // Increase counts.
     typedef seqan::Iterator<seqan::String<seqan::CigarElement<> > const, seqan::Rooted>::Type TCigarIt;
+    getCigar(cigar, record);
+    getSeq(seq, record);
     unsigned beginPos = record.beginPos - currentRoi.beginPos;
     unsigned k = 0;
-    for (TCigarIt it = begin(record.cigar, seqan::Rooted()); !atEnd(it); goNext(it))
+    for (TCigarIt it = begin(cigar, seqan::Rooted()); !atEnd(it); goNext(it))
     {
         switch (it->operation)
         {
@@ -116,7 +118,7 @@ void RoiBuilder::extendRoi(seqan::BamAlignmentRecord const & record)
             case '=':
                 for (unsigned i = 0; i < it->count; ++i, ++beginPos, ++k)
                 {
-                    currentProfile[beginPos].count[ordValue(seqan::Dna5(record.seq[k]))] += 1;
+                    currentProfile[beginPos].count[ordValue(seq[k])] += 1;
                     currentRoi.count[beginPos] += 1;
                     connective[beginPos] = true;
                 }
@@ -152,7 +154,7 @@ void RoiBuilder::extendRoi(seqan::BamAlignmentRecord const & record)
 // Member Function RoiBuilder::pushRecord()
 // ---------------------------------------------------------------------------
 
-void RoiBuilder::pushRecord(seqan::BamAlignmentRecord const & record)
+void RoiBuilder::pushRecord(seqan::BamAlignmentRecordView const & record)
 {
     if (options.verbosity >= 2 && currentRoi.rID != record.rID)
         std::cerr << "switching to rId == " << record.rID << "\n";
@@ -112,6 +112,10 @@ public:
     // The number of reads in the current ROI.
     int readsInCurrentRoi;
 
+    // Buffers for the decoded CIGAR string and sequence of the current record.
+    seqan::String<seqan::CigarElement<> > cigar;
+    seqan::Dna5String seq;
+
     RoiBuilder(seqan::RoiFileOut & roiFileOut, RoiBuilderOptions const & options) :
         roiFileOut(roiFileOut), options(options), readsInCurrentRoi(0)
     {}
@@ -122,7 +126,7 @@ public:
     }
 
 	// Add a BAM alignment record to the current ROI, create a new one if no overlap with the current ROI
-    void pushRecord(seqan::BamAlignmentRecord const & record);
+    void pushRecord(seqan::BamAlignmentRecordView const & record);
 
     // write ROI file header
     void writeHeader();
@@ -136,10 +140,10 @@ private:
                     seqan::String<TProfileChar> const & profile);
 
     // Extend the current ROI.
-    void extendRoi(seqan::BamAlignmentRecord const & record);
+    void extendRoi(seqan::BamAlignmentRecordView const & record);
 
     // Create a new ROI.
-    void createRoi(seqan::BamAlignmentRecord const & record);
+    void createRoi(seqan::BamAlignmentRecordView const & record);
 };
 
 // ============================================================================
@@ -35,6 +35,7 @@
 #include <seqan/arg_parse.h>
 #include <seqan/bam_io.h>
 #include <seqan/basic.h>
+#include <seqan/parallel.h>
 #include <seqan/sequence.h>
 #include <seqan/store.h>
 #include <seqan/seq_io.h>
@@ -148,13 +149,50 @@ struct BuildGoldStandardOptions
     // Path to the perfect input SAM/BAM file.
     seqan::CharString inBamPath;
 
+    // Number of threads to use for building the error curves.
+    int numThreads;
+
+    // Number of SAM/BAM records to read in one batch and then process in parallel.
+    unsigned batchSize;
+
     BuildGoldStandardOptions() :
         verbosity(1),
         matchN(false),
         oracleMode(false),
         maxError(0),
         maxErrorSet(false),
-        distanceMetric(EDIT_DISTANCE)
+        distanceMetric(EDIT_DISTANCE),
+        numThreads(1),
+        batchSize(10000)
+    {}
+};
+
+// ----------------------------------------------------------------------------
+// Class ErrorCurveJob
+// ----------------------------------------------------------------------------
+
+// An alignment from the SAM/BAM file for which the error curve points are built, one batch of jobs is processed in
+// parallel.
+
+struct ErrorCurveJob
+{
+    // Id of the read and strand of the alignment.
+    unsigned readId;
+    bool isForward;
+
+    // The read sequence, reverse-complemented for alignments on the reverse strand.
+    Dna5String readSeq;
+
+    // End position of the alignment on the strand's contig sequence.
+    size_t endPos;
+
+    // The maximal error, maxValue<int>() in oracle mode where it is replaced by the error at the alignment.
+    int maxError;
+
+    // The resulting error curve points.
+    String<WeightedMatch> errorCurve;
+
+    ErrorCurveJob() : readId(0), isForward(true), endPos(0), maxError(0)
     {}
 };
 
@@ -740,6 +778,48 @@ void buildErrorCurvePoints(String<WeightedMatch> & errorCurve,
 //     std::cerr << __FILE__ << ":" << __LINE__ << " return " << right << std::endl;
 }
 
+// ----------------------------------------------------------------------------
+// Function buildErrorCurveBatch()
+// ----------------------------------------------------------------------------
+
+// Build the error curve points for the first jobCount jobs in parallel and append them to the error curves.
+//
+// The points are appended in the order of the jobs such that the result does not depend on the number of threads.
+
+template <typename TPatternSpec>
+void buildErrorCurveBatch(TErrorCurves & errorCurves,
+                          String<int> & readAlignmentDistances,  // only used in case of oracle mode
+                          String<ErrorCurveJob> & jobs,
+                          unsigned jobCount,
+                          Dna5String & contig,
+                          Dna5String & rcContig,
+                          int contigId,
+                          StringSet<CharString> const & readNameStore,
+                          BuildGoldStandardOptions const & options,
+                          TPatternSpec const & /*patternTag*/)
+{
+    SEQAN_OMP_PRAGMA(parallel for schedule(dynamic, 16) num_threads(options.numThreads))
+    for (int i = 0; i < (int)jobCount; ++i)
+    {
+        ErrorCurveJob & job = jobs[i];
+        clear(job.errorCurve);
+        buildErrorCurvePoints(job.errorCurve, job.maxError, job.isForward ? contig : rcContig, contigId,
+                              job.isForward, job.readSeq, job.readId, job.endPos, readNameStore, options.matchN,
+                              TPatternSpec());
+    }
+
+    for (unsigned i = 0; i < jobCount; ++i)
+    {
+        append(errorCurves[jobs[i].readId], jobs[i].errorCurve);
+#if ENABLE
+        std::cerr << "AFTER BUILD, readId == " << jobs[i].readId << ", read name == " << readNameStore[jobs[i].readId]
+                  << ", maxError == " << jobs[i].maxError << "\n";
+#endif  // #if ENABLE
+        if (options.oracleMode)
+            readAlignmentDistances[jobs[i].readId] = jobs[i].maxError;
+    }
+}
+
 // ----------------------------------------------------------------------------
 // Function matchesToErrorFunction()
 // ----------------------------------------------------------------------------
@@ -777,6 +857,8 @@ int matchesToErrorFunction(TErrorCurves & errorCurves,
     //     Build error curve for this read alignment on forward strand.
     //   Else:
     //     Build error curve for this read alignment on backward strand.
+    //
+    // The alignments are collected in batches of jobs for one contig which are then processed in parallel.
 
     startTime = sysTime();      // Time at beginning for total time display at end.
     int prevRefId = -1;      // Previous contig id.
@@ -785,8 +867,10 @@ int matchesToErrorFunction(TErrorCurves & errorCurves,
     BamAlignmentRecord record;  // Current read record.
     Dna5String contig;
     Dna5String rcContig;
-    Dna5String readSeq;
     CharString readName;
+    String<ErrorCurveJob> jobs;
+    resize(jobs, options.batchSize);
+    unsigned jobCount = 0;
     while (!atEnd(inBam))
     {
         // -------------------------------------------------------------------
@@ -812,12 +896,20 @@ int matchesToErrorFunction(TErrorCurves & errorCurves,
             std::cerr << "ERROR: File was not sorted by coordinate!\n";
             return 1;
         }
+        // Process the pending jobs before switching the contig or if the batch is full.
+        if (jobCount > 0u && (prevRefId != record.rID || jobCount == length(jobs)))
+        {
+            buildErrorCurveBatch(errorCurves, readAlignmentDistances, jobs, jobCount, contig, rcContig, prevRefId,
+                                 readNameStore, options, TPatternSpec());
+            jobCount = 0;
+        }
+        ErrorCurveJob & job = jobs[jobCount++];
         // Get read name and sequence from record.
-        readSeq = record.seq;  // Convert read sequence to Dna5.
+        job.readSeq = record.seq;  // Convert read sequence to Dna5.
         // Compute reverse complement since we align against reverse strand, SAM has aligned sequence against forward
         // strand.
         if (hasFlagRC(record))
-            reverseComplement(readSeq);
+            reverseComplement(job.readSeq);
         trimSeqHeaderToId(record.qName);  // Remove everything after the first whitespace.
         if (!hasFlagMultiple(record))
             append(record.qName, "/S");
@@ -883,35 +975,29 @@ int matchesToErrorFunction(TErrorCurves & errorCurves,
         }
 
         // -------------------------------------------------------------------
-        // Extend error curve points for read.
+        // Prepare extension of error curve points for read.
         // -------------------------------------------------------------------
 
         // In oracle mode, set max error to -1, buildErrorCurvePoints() will use the error at the alignment position
         // from the SAM/BAM file.  In normal mode, convert from error rate from options to error count.
-        int maxError = maxValue<int>();
+        job.maxError = maxValue<int>();
         if (!options.oracleMode)
-            maxError = static_cast<int>(floor(0.01 * options.maxError * length(record.seq)));
+            job.maxError = static_cast<int>(floor(0.01 * options.maxError * length(record.seq)));
 
         // Compute end position of alignment.
-        int endPos = record.beginPos + getAlignmentLengthInRef(record) - countPaddings(record.cigar);
-
-        if (!hasFlagRC(record))
-            buildErrorCurvePoints(errorCurves[readId], maxError, contig, record.rID, !hasFlagRC(record),
-                                  readSeq, readId, endPos, readNameStore, options.matchN, TPatternSpec());
+        job.readId = readId;
+        job.isForward = !hasFlagRC(record);
+        if (job.isForward)
+            job.endPos = record.beginPos + getAlignmentLengthInRef(record) - countPaddings(record.cigar);
         else
-            buildErrorCurvePoints(errorCurves[readId], maxError, rcContig, record.rID, !hasFlagRC(record),
-                                  readSeq, readId, length(rcContig) - record.beginPos, readNameStore, options.matchN,
-                                  TPatternSpec());
-#if ENABLE
-        std::cerr << "AFTER BUILD, readId == " << readId << ", read name == " << readNameStore[readId] << ", maxError == " << maxError << "\n";
-#endif  // #if ENABLE
-        if (options.oracleMode)
-            readAlignmentDistances[readId] = maxError;
+            job.endPos = length(rcContig) - record.beginPos;
 
         // Update variables storing the previous read/contig id and position.
         prevRefId = record.rID;
         prevPos = record.beginPos;
     }
+    buildErrorCurveBatch(errorCurves, readAlignmentDistances, jobs, jobCount, contig, rcContig, prevRefId,
+                         readNameStore, options, TPatternSpec());
     std::cerr << "\n\nTook " << sysTime() - startTime << " s\n";
 
     // For all reads:
@@ -1029,6 +1115,19 @@ parseCommandLine(BuildGoldStandardOptions & options, int argc, char const ** arg
                                             seqan::ArgParseArgument::INTEGER, "RATE"));
     setDefaultValue(parser, "max-error", 0);
 
+    addSection(parser, "Performance");
+    addOption(parser, seqan::ArgParseOption("t", "num-threads", "Number of threads to use for building the error "
+                                            "curves.", seqan::ArgParseArgument::INTEGER, "NUM"));
+    setMinValue(parser, "num-threads", "1");
+    setDefaultValue(parser, "num-threads", options.numThreads);
+#ifndef _OPENMP
+    hideOption(parser, "num-threads");
+#endif  // #ifndef _OPENMP
+    addOption(parser, seqan::ArgParseOption("", "batch-size", "Number of SAM/BAM records to read and process at "
+                                            "once.", seqan::ArgParseArgument::INTEGER, "NUM"));
+    setMinValue(parser, "batch-size", "1");
+    setDefaultValue(parser, "batch-size", options.batchSize);
+
     addTextSection(parser, "Return Values");
     addText(parser, "A return value of 0 indicates success, any other value indicates an error.");
 
@@ -1100,6 +1199,9 @@ parseCommandLine(BuildGoldStandardOptions & options, int argc, char const ** arg
     if (isSet(parser, "in-bam"))
         getOptionValue(options.inBamPath, parser, "in-bam");
 
+    getOptionValue(options.numThreads, parser, "num-threads");
+    getOptionValue(options.batchSize, parser, "batch-size");
+
     return res;
 }
 
@@ -1132,6 +1234,7 @@ int main(int argc, char const ** argv)
               << "GSI Output File       " << options.outGsiPath << '\n'
               << "SAM/BAM Input File    " << options.inBamPath << '\n'
               << "Reference File        " << options.referencePath << '\n'
+              << "Threads               " << options.numThreads << '\n'
               << "Verbosity             " << options.verbosity << "\n\n";
 
     std::cerr << "____LOADING FILES_____________________________________________________________\n\n";
@@ -37,8 +37,10 @@
 #include <seqan/bam_io.h>
 #include <seqan/arg_parse.h>
 
+#include <algorithm>
 #include <iostream>
 #include <fstream>
+#include <queue>
 #include <string>
 #include <vector>
 
@@ -62,6 +64,19 @@ struct AppOptions
     CharString outFile;
     bool bamFormat;
     bool verbose;
+    bool merge;
+    BamSortOrder sortOrder;
+    unsigned maxMemory;
+    unsigned threads;
+
+    AppOptions() :
+        bamFormat(false),
+        verbose(false),
+        merge(false),
+        sortOrder(BAM_SORT_UNSORTED),
+        maxMemory(512),
+        threads(1)
+    {}
 };
 
 // ==========================================================================
@@ -69,17 +84,17 @@ struct AppOptions
 // ==========================================================================
 
 // --------------------------------------------------------------------------
-// Function mergeBamFiles()
+// Function openInputFiles()
 // --------------------------------------------------------------------------
 
+// Opens all input files and merges their headers.  The readers share the name store of the writer, records of all
+// inputs refer to the same contig ids.
+
 template <typename TWriter>
-void catBamFiles(TWriter &writer, StringSet<CharString> &inFiles, AppOptions const &options)
+void openInputFiles(String<BamFileIn *> &readerPtr, BamHeader &header, TWriter &writer, StringSet<CharString> &inFiles)
 {
-    String<BamFileIn *> readerPtr;
     resize(readerPtr, length(inFiles));
 
-    // Step 1: Merge all headers (if available)
-    BamHeader header;
     for (unsigned i = 0; i < length(inFiles); ++i)
     {
         readerPtr[i] = new BamFileIn(writer);
@@ -102,13 +117,28 @@ void catBamFiles(TWriter &writer, StringSet<CharString> &inFiles, AppOptions con
         readHeader(header, *(readerPtr[i]));
     }
 
-    // Step 2: Remove duplicate header entries and write merged header
+    // Remove duplicate header entries
     if (length(inFiles) > 1)
         removeDuplicates(header);
+}
+
+// --------------------------------------------------------------------------
+// Function catBamFiles()
+// --------------------------------------------------------------------------
+
+template <typename TWriter>
+void catBamFiles(TWriter &writer, StringSet<CharString> &inFiles, AppOptions const &options)
+{
+    // Step 1: Merge all headers (if available)
+    String<BamFileIn *> readerPtr;
+    BamHeader header;
+    openInputFiles(readerPtr, header, writer, inFiles);
+
+    // Step 2: Write merged header
     writeHeader(writer, header);
 
     // Step 3: Read and output alignment records
-    BamAlignmentRecord record;
+    BamAlignmentRecordView view;
     String<BamAlignmentRecord> records;
     __uint64 numRecords = 0;
     double start = sysTime();
@@ -132,10 +162,11 @@ void catBamFiles(TWriter &writer, StringSet<CharString> &inFiles, AppOptions con
         }
         else
         {
+            // For Bam the records are copied without decoding them
             while (!atEnd(reader))
             {
-                readRecord(record, reader);
-                writeRecord(writer, record);
+                readRecord(view, reader);
+                writeRecord(writer, view);
                 ++numRecords;
             }
         }
@@ -150,6 +181,165 @@ void catBamFiles(TWriter &writer, StringSet<CharString> &inFiles, AppOptions con
     }
 }
 
+// --------------------------------------------------------------------------
+// Class MergeGreater
+// --------------------------------------------------------------------------
+
+// Orders the inputs by the coordinate of their current records, used for the min-heap of the k-way merge.
+// Ties are broken by the input number, such that records are taken from the first input first.
+
+struct MergeGreater
+{
+    String<String<BamAlignmentRecord> > const &batches;
+    String<unsigned> const &batchPos;
+
+    MergeGreater(String<String<BamAlignmentRecord> > const &batches, String<unsigned> const &batchPos) :
+        batches(batches), batchPos(batchPos)
+    {}
+
+    static bool less(BamAlignmentRecord const &a, BamAlignmentRecord const &b)
+    {
+        // unmapped records (rID == -1) come last
+        if (a.rID != b.rID)
+            return static_cast<__uint32>(a.rID) < static_cast<__uint32>(b.rID);
+        return a.beginPos < b.beginPos;
+    }
+
+    bool operator() (unsigned a, unsigned b) const
+    {
+        BamAlignmentRecord const &recA = batches[a][batchPos[a]];
+        BamAlignmentRecord const &recB = batches[b][batchPos[b]];
+        if (less(recB, recA))
+            return true;
+        if (less(recA, recB))
+            return false;
+        return b < a;
+    }
+};
+
+// --------------------------------------------------------------------------
+// Function mergeBamFiles()
+// --------------------------------------------------------------------------
+
+// K-way merge of coordinate-sorted input files.  Each input is inflated by its own BGZF thread, the records are
+// parsed batch-wise by options.threads threads.
+
+template <typename TWriter>
+bool mergeBamFiles(TWriter &writer, StringSet<CharString> &inFiles, AppOptions const &options)
+{
+    // Step 1: Merge all headers (if available)
+    String<BamFileIn *> readerPtr;
+    BamHeader header;
+    openInputFiles(readerPtr, header, writer, inFiles);
+
+    // Step 2: Write merged header
+    setSortOrder(header, BAM_SORT_COORDINATE);
+    writeHeader(writer, header);
+
+    // Step 3: Merge alignment records, keep at most about 256K records in memory
+    unsigned batchSize = std::max(64u, 262144u / (unsigned)length(inFiles));
+    String<String<BamAlignmentRecord> > batches;
+    String<unsigned> batchLength;
+    String<unsigned> batchPos;
+    resize(batches, length(inFiles));
+    resize(batchLength, length(inFiles), 0);
+    resize(batchPos, length(inFiles), 0);
+
+    MergeGreater greater(batches, batchPos);
+    std::priority_queue<unsigned, std::vector<unsigned>, MergeGreater> heap(greater);
+
+    for (unsigned i = 0; i < length(inFiles); ++i)
+    {
+        if (readerPtr[i] == NULL || atEnd(*readerPtr[i]))
+            continue;
+        batchLength[i] = readRecords(batches[i], *readerPtr[i], batchSize, options.threads);
+        heap.push(i);
+    }
+
+    BamAlignmentRecord last;
+    BamAlignmentRecord *prev;
+    __uint64 numRecords = 0;
+    bool success = true;
+    double start = sysTime();
+    while (!heap.empty())
+    {
+        unsigned i = heap.top();
+        heap.pop();
+
+        BamAlignmentRecord &record = batches[i][batchPos[i]];
+        writeRecord(writer, record);
+        ++numRecords;
+
+        if (++batchPos[i] == batchLength[i])
+        {
+            // keep the last record to check the sort order of the next batch
+            std::swap(last, record);
+            prev = &last;
+            batchPos[i] = 0;
+            batchLength[i] = atEnd(*readerPtr[i]) ? 0 : readRecords(batches[i], *readerPtr[i], batchSize, options.threads);
+            if (batchLength[i] == 0)
+                continue;
+        }
+        else
+        {
+            prev = &record;
+        }
+
+        if (MergeGreater::less(batches[i][batchPos[i]], *prev))
+        {
+            std::cerr << "ERROR: " << toCString(inFiles[i]) << " is not sorted by coordinate." << std::endl;
+            success = false;
+            break;
+        }
+        heap.push(i);
+    }
+    double stop = sysTime();
+
+    for (unsigned i = 0; i < length(inFiles); ++i)
+    {
+        if (readerPtr[i] == NULL)
+            continue;
+        close(*readerPtr[i]);
+        delete readerPtr[i];
+    }
+
+    if (options.verbose)
+    {
+        std::cerr << "Number of alignments: " << numRecords << std::endl;
+        std::cerr << "Elapsed time:         " << stop - start << " seconds" << std::endl;
+    }
+    return success;
+}
+
+// --------------------------------------------------------------------------
+// Function sortInputFile()
+// --------------------------------------------------------------------------
+
+template <typename TWriter>
+bool sortInputFile(TWriter &writer, CharString const &inFile, AppOptions const &options)
+{
+    BamFileIn reader(writer);
+
+    bool success;
+    if (inFile != "-")
+        success = open(reader, toCString(inFile));
+    else
+        // read from stdin (autodetect format from stream)
+        success = open(reader, std::cin);
+    if (!success)
+    {
+        std::cerr << "Couldn't open " << toCString(inFile) << " for reading." << std::endl;
+        return false;
+    }
+
+    double start = sysTime();
+    sortBamFile(writer, reader, options.sortOrder, (__uint64)options.maxMemory << 20, options.threads);
+    double stop = sysTime();
+    if (options.verbose)
+        std::cerr << "Elapsed time:         " << stop - start << " seconds" << std::endl;
+    return true;
+}
+
 // --------------------------------------------------------------------------
 // Function parseCommandLine()
 // --------------------------------------------------------------------------
@@ -175,6 +365,11 @@ parseCommandLine(AppOptions & options, int argc, char const ** argv)
 #endif
                            "and outputs the concatenation of them. "
                            "If the output file name is ommitted the result is written to stdout.");
+#if SEQAN_HAS_ZLIB
+    addDescription(parser, "With \\fB-s\\fP, a single input file is sorted by coordinate or query name. "
+                           "Inputs that exceed the memory limit are sorted in runs that are spilled into "
+                           "temporary BAM files in the directory given by TMPDIR and merged afterwards.");
+#endif
 
     addDescription(parser, "(c) Copyright in 2014 by David Weese.");
 
@@ -192,6 +387,25 @@ parseCommandLine(AppOptions & options, int argc, char const ** argv)
 #endif
     addOption(parser, ArgParseOption("v", "verbose", "Print some stats."));
 
+#if SEQAN_HAS_ZLIB
+    addSection(parser, "Merge Options");
+    addOption(parser, ArgParseOption("M", "merge", "Merge coordinate-sorted input files into a coordinate-sorted "
+                                     "output file. Each input is inflated by its own thread, the output is compressed "
+                                     "on all cores."));
+
+    addSection(parser, "Sort Options");
+    addOption(parser, ArgParseOption("s", "sort", "Sort the input file by the given order.", ArgParseOption::STRING));
+    setValidValues(parser, "sort", "coordinate queryname");
+    addOption(parser, ArgParseOption("m", "max-memory", "Maximal amount of memory in MB used to hold records.",
+                                     ArgParseOption::INTEGER));
+    setMinValue(parser, "max-memory", "16");
+    setDefaultValue(parser, "max-memory", options.maxMemory);
+    addOption(parser, ArgParseOption("t", "threads", "Number of threads used to parse, sort, and merge records.",
+                                     ArgParseOption::INTEGER));
+    setMinValue(parser, "threads", "1");
+    setDefaultValue(parser, "threads", options.threads);
+#endif
+
     // Add Examples Section.
     addTextSection(parser, "Examples");
     addListItem(parser, "\\fBsamcat\\fP \\fBmapped1.sam\\fP \\fBmapped2.sam\\fP \\fB-o\\fP \\fBmerged.sam\\fP",
@@ -199,6 +413,10 @@ parseCommandLine(AppOptions & options, int argc, char const ** argv)
 #if SEQAN_HAS_ZLIB
     addListItem(parser, "\\fBsamcat\\fP \\fBinput.sam\\fP \\fB-o\\fP \\fBouput.bam\\fP",
                 "Convert a SAM file into BAM format.");
+    addListItem(parser, "\\fBsamcat\\fP \\fB-M\\fP \\fBlane1.bam\\fP \\fBlane2.bam\\fP \\fB-o\\fP \\fBmerged.bam\\fP",
+                "Merge two coordinate-sorted BAM files.");
+    addListItem(parser, "\\fBsamcat\\fP \\fB-s\\fP \\fBcoordinate\\fP \\fBinput.bam\\fP \\fB-o\\fP \\fBsorted.bam\\fP",
+                "Sort a BAM file by coordinate.");
 #endif
 
     // Parse command line.
@@ -212,6 +430,25 @@ parseCommandLine(AppOptions & options, int argc, char const ** argv)
     getOptionValue(options.outFile, parser, "output");
 #if SEQAN_HAS_ZLIB
     getOptionValue(options.bamFormat, parser, "bam");
+
+    CharString sortOrder;
+    if (getOptionValue(sortOrder, parser, "sort"))
+    {
+        options.sortOrder = (sortOrder == "queryname") ? BAM_SORT_QUERYNAME : BAM_SORT_COORDINATE;
+        if (length(options.inFiles) != 1)
+        {
+            std::cerr << "ERROR: Sorting requires exactly one input file." << std::endl;
+            return ArgumentParser::PARSE_ERROR;
+        }
+    }
+    getOptionValue(options.merge, parser, "merge");
+    if (options.merge && options.sortOrder != BAM_SORT_UNSORTED)
+    {
+        std::cerr << "ERROR: Options --merge and --sort are mutually exclusive." << std::endl;
+        return ArgumentParser::PARSE_ERROR;
+    }
+    getOptionValue(options.maxMemory, parser, "max-memory");
+    getOptionValue(options.threads, parser, "threads");
 #endif
     getOptionValue(options.verbose, parser, "verbose");
 
@@ -236,6 +473,12 @@ int main(int argc, char const ** argv)
     if (res != ArgumentParser::PARSE_OK)
         return res == ArgumentParser::PARSE_ERROR;
 
+#if SEQAN_HAS_ZLIB
+    // When merging, inflate each input on its own thread and compress the output on all cores.
+    if (options.merge)
+        setBgzfThreads(std::max(omp_get_max_threads(), 1), 1);
+#endif
+
     bool success;
     BamFileOut writer;
     if (!empty(options.outFile))
@@ -255,6 +498,12 @@ int main(int argc, char const ** argv)
         return 1;
     }
 
+#if SEQAN_HAS_ZLIB
+    if (options.sortOrder != BAM_SORT_UNSORTED)
+        return sortInputFile(writer, options.inFiles[0], options) ? 0 : 1;
+    if (options.merge)
+        return mergeBamFiles(writer, options.inFiles, options) ? 0 : 1;
+#endif
     catBamFiles(writer, options.inFiles, options);
     return 0;
 }
@@ -310,8 +310,8 @@ void SeqConsAppImpl::performRealignment()
         std::cerr << "Performing realignment...";
     if (options.verbosity >= 3)
         std::cerr << "\n";
-    for (unsigned contigID = 0; contigID < length(store.contigStore); ++contigID)
-        reAlignment(store, contigID, /*method=*/2, options.reAlignmentBandwidth, /*includeReference=*/false);
+    reAlignmentAllContigs(store, /*method=*/2, options.reAlignmentBandwidth, /*includeReference=*/false,
+                          options.numThreads);
     if (options.verbosity >= 1)
         std::cerr << " OK\n";
     if (options.verbosity >= 2)
@@ -125,7 +125,8 @@ void SeqConsOptions::print(std::ostream & out) const
         << "K-MER MAX OCCURENCES   \t" << kMerMaxOcc << "\n"
         << "\n"
         << "REALIGNMENT BANDWIDTH  \t" << reAlignmentBandwidth << "\n"
-        << "REALIGNMENT ENVIRONMENT\t" << reAlignmentEnvironment << "\n";
+        << "REALIGNMENT ENVIRONMENT\t" << reAlignmentEnvironment << "\n"
+        << "REALIGNMENT THREADS    \t" << numThreads << "\n";
 }
 
 // --------------------------------------------------------------------------
@@ -228,6 +229,15 @@ parseCommandLine(SeqConsOptions & options, int argc, char const ** argv)
     setMinValue(parser, "realign-environment", "5");
     setDefaultValue(parser, "realign-environment", "20");
 
+    addOption(parser, seqan::ArgParseOption("t", "num-threads",
+                                            "Number of threads to use for realigning the contigs.",
+                                            seqan::ArgParseOption::INTEGER, "NUM"));
+    setMinValue(parser, "num-threads", "1");
+    setDefaultValue(parser, "num-threads", "1");
+#ifndef _OPENMP
+    hideOption(parser, "num-threads");
+#endif  // #ifndef _OPENMP
+
     // Add Methods Section
     addTextSection(parser, "Methods");
     addListItem(parser, "\\fBnop\\fP",
@@ -305,6 +315,7 @@ parseCommandLine(SeqConsOptions & options, int argc, char const ** argv)
 
     getOptionValue(options.reAlignmentBandwidth, parser, "realign-bandwidth");
     getOptionValue(options.reAlignmentEnvironment, parser, "realign-environment");
+    getOptionValue(options.numThreads, parser, "num-threads");
 
     return seqan::ArgumentParser::PARSE_OK;
 }
@@ -111,6 +111,8 @@ struct SeqConsOptions
     int reAlignmentBandwidth;
     // The environment for profile extraction.
     int reAlignmentEnvironment;
+    // The number of threads to use for realigning the contigs.
+    int numThreads;
 
     // -----------------------------------------------------------------------
     // Member Functions
@@ -126,7 +128,8 @@ struct SeqConsOptions
         kMerSize(20),
         kMerMaxOcc(200),
         reAlignmentBandwidth(10),
-        reAlignmentEnvironment(20)
+        reAlignmentEnvironment(20),
+        numThreads(1)
     {}
 
     // Check whether the combination of operation and input file is valid.  Throws an exception in the case that it is
@@ -35,6 +35,7 @@
 #include <seqan/consensus.h>
 #include <seqan/stream.h>
 #include <seqan/bam_io.h>
+#include <seqan/parallel.h>
 
 
 #ifdef PLATFORM_WINDOWS
@@ -588,6 +589,184 @@ _dumpMatches(TTmpReads & reads, TTmpMatches & matches, TTmpQualities & qualities
 
 
 
+//////////////////////////////////////////////////////////////////////////////
+// Parallel calling of parsed windows
+
+// collects the calls of one window, thus windows called in parallel can be written in genome order
+class WindowOutBuffer : public ::std::ostringstream
+{
+public:
+    bool isOpen;
+
+    WindowOutBuffer() : isOpen(false) {}
+
+    // the calling routines check whether their output file is open
+    bool is_open() const
+    {
+        return isOpen;
+    }
+};
+
+namespace seqan {
+
+template <>
+struct Value<WindowOutBuffer>
+{
+    typedef char Type;
+};
+
+template <>
+SEQAN_CONCEPT_IMPL((WindowOutBuffer), (OutputStreamConcept));
+
+}
+
+// a window whose matches and reads have been parsed
+template <typename TFragmentStore, typename TReadCounts, typename TReadClips, typename TReadCigars>
+struct ParsedWindow
+{
+    typedef typename TFragmentStore::TContigPos TContigPos;
+
+    TFragmentStore  fragmentStore;
+    TReadCounts     readCounts;
+    TReadClips      readClips;
+    TReadCigars     readCigars;
+    unsigned        contigId;
+    TContigPos      startCoord;
+    TContigPos      endCoord;
+    TContigPos      windowBegin;
+    TContigPos      windowEnd;
+    bool            clip;
+};
+
+// call SNPs/indels in a parsed window, only touches the window and its output buffers
+template<typename TWindow, typename TGenome, typename TGenomeName, typename TFile, typename TOptions>
+void
+callWindowVariants(TWindow &window,
+                   TGenome const &genome,
+                   TGenomeName const &genomeName,
+                   TFile &snpFile,
+                   TFile &indelFile,
+                   TFile &logFile,
+                   TOptions &options)
+{
+    typedef typename TWindow::TContigPos                TContigPos;
+    typedef FragmentStore<SnpStoreSpec_>                TFragmentStore;
+    typedef typename TFragmentStore::TContigStore       TContigStore;
+    typedef typename Value<TContigStore>::Type          TContig;
+
+    TFragmentStore &fragmentStore = window.fragmentStore;
+    TContigPos startCoord = window.startCoord;
+
+    // coordinates are relative to current chromosomal window (segment)
+    transformCoordinates(fragmentStore,startCoord,options);
+
+    // set the current chromosomal segment as contig sequence
+    TContig conti;
+    conti.seq = infix(genome,startCoord,window.endCoord);
+    appendValue(fragmentStore.contigStore, conti, Generous() );
+    appendValue(fragmentStore.contigNameStore, genomeName, Generous() );// internal id is always 0
+
+    // clip Reads if clipping is switched on and there were clip tags in the gff file
+    if(window.clip)
+        clipReads(fragmentStore,window.readClips,(unsigned)0,(unsigned)length(fragmentStore.alignedReadStore),options);
+
+    // check for indels
+    if (options.outputIndel != "")
+    {
+        if(options._debugLevel > 1) ::std::cout << "Check for indels..." << std::endl;
+        if(!options.realign) dumpShortIndelPolymorphismsBatch(fragmentStore, window.readCigars, fragmentStore.contigStore[0].seq, genomeName, startCoord, window.windowBegin, window.windowEnd, indelFile, options);
+    }
+
+    // // check for CNVs
+    //              if (*options.outputCNV != 0)
+    //                  dumpCopyNumberPolymorphismsBatch(fragmentStore, genomeName, startCoord, window.windowBegin, window.windowEnd, cnvFileStream, options);
+
+#ifdef SNPSTORE_DEBUG
+    CharString strstr = "test";
+    //              _dumpMatches(fragmentStore, strstr );
+#endif
+    if (options.outputSNP != "")
+    {
+        if(options._debugLevel > 1) ::std::cout << "Check for SNPs..." << std::endl;
+        if(options.realign)
+            dumpVariantsRealignBatchWrap(fragmentStore, window.readCigars, window.readCounts, genomeName, startCoord, window.windowBegin, window.windowEnd, snpFile,indelFile,logFile,options);
+        else
+            dumpSNPsBatch(fragmentStore, window.readCigars, window.readCounts, genomeName, startCoord, window.windowBegin, window.windowEnd, snpFile,logFile,options);
+    }
+}
+
+// call the windows [windowsBegin, windowsEnd) in parallel and write their output in genome order
+template<typename TWindows, typename TGenomeSet, typename TGenomeNames, typename TPosIterator, typename TOptions>
+void
+callAndWriteWindows(TWindows &windows,
+                    unsigned windowsBegin,
+                    unsigned windowsEnd,
+                    TGenomeSet const &genomes,
+                    TGenomeNames const &genomeNames,
+                    ::std::vector<WindowOutBuffer> &snpBuffers,
+                    ::std::vector<WindowOutBuffer> &indelBuffers,
+                    ::std::vector<WindowOutBuffer> &logBuffers,
+                    ::std::ofstream &snpFileStream,
+                    ::std::ofstream &indelFileStream,
+                    ::std::ofstream &logFileStream,
+                    ::std::ofstream &posFileStream,
+                    TPosIterator &inspectPosIt,
+                    TPosIterator inspectPosItEnd,
+                    bool positionStatsOnly,
+                    TOptions &options)
+{
+    SEQAN_OMP_PRAGMA(parallel for schedule(dynamic, 1) num_threads(options.threadCount))
+    for (int k = windowsBegin; k < (int)windowsEnd; ++k)
+    {
+        if (empty(windows[k].fragmentStore.alignedReadStore))
+            continue;
+        snpBuffers[k].isOpen = snpFileStream.is_open();
+        indelBuffers[k].isOpen = indelFileStream.is_open();
+        logBuffers[k].isOpen = logFileStream.is_open();
+        callWindowVariants(windows[k], genomes[windows[k].contigId], genomeNames[windows[k].contigId],
+                           snpBuffers[k], indelBuffers[k], logBuffers[k], options);
+    }
+
+    for (unsigned k = windowsBegin; k < windowsEnd; ++k)
+    {
+        unsigned contigId = windows[k].contigId;
+        if (!empty(windows[k].fragmentStore.alignedReadStore))
+        {
+            if (snpFileStream.is_open())
+                snpFileStream << snpBuffers[k].str();
+            if (indelFileStream.is_open())
+                indelFileStream << indelBuffers[k].str();
+            if (logFileStream.is_open())
+                logFileStream << logBuffers[k].str();
+            snpBuffers[k].str("");
+            snpBuffers[k].clear();
+            indelBuffers[k].str("");
+            indelBuffers[k].clear();
+            logBuffers[k].str("");
+            logBuffers[k].clear();
+
+            if(positionStatsOnly)
+            {
+                if(options._debugLevel > 1) ::std::cout << "Dumping info for query positions..." << std::endl;
+                if(options.realign)
+                    dumpPositionsRealignBatchWrap(windows[k].fragmentStore, inspectPosIt, inspectPosItEnd, windows[k].readCigars, windows[k].readCounts, genomeNames[contigId], windows[k].startCoord, windows[k].windowBegin, windows[k].windowEnd, posFileStream, options);
+                else dumpPosBatch(windows[k].fragmentStore, inspectPosIt, inspectPosItEnd, windows[k].readCigars, windows[k].readCounts, genomeNames[contigId], windows[k].startCoord, windows[k].windowBegin, windows[k].windowEnd, posFileStream, options);
+            }
+        }
+        if(positionStatsOnly)
+        {
+            while(inspectPosIt != inspectPosItEnd && *inspectPosIt < windows[k].windowEnd)
+            {
+                if(options.orientationAware)
+                    posFileStream << genomeNames[contigId] << '\t' << *inspectPosIt + options.positionFormat << "\t0\t0\t0\t0\t0\t0\t0\t0\t0\t0\t0" << std::endl;
+                else
+                    posFileStream << genomeNames[contigId] << '\t' << *inspectPosIt + options.positionFormat << "\t0\t0\t0\t0\t0\t0" << std::endl;
+                ++inspectPosIt;
+            }
+        }
+    }
+}
+
 //////////////////////////////////////////////////////////////////////////////
 // Main read mapper function
 template <typename TSpec>
@@ -605,8 +784,8 @@ int detectSNPs(SNPCallingOptions<TSpec> &options)
     typedef typename TFragmentStore::TAlignQualityStore TAlignQualityStore;     // TMatchQualities
     typedef typename TFragmentStore::TReadStore     TReadStore;             // TReadSet
     typedef typename TFragmentStore::TReadSeqStore      TReadSeqStore;              // TReadSet
-    typedef typename TFragmentStore::TContigStore       TContigStore;           // TGenomeSet
-    typedef typename Value<TContigStore>::Type      TContig;
+    //typedef typename TFragmentStore::TContigStore       TContigStore;           // TGenomeSet
+    //typedef typename Value<TContigStore>::Type      TContig;
     typedef              TContigSeq                    TGenome;
     typedef StringSet<TGenome>                         TGenomeSet;
 
@@ -618,6 +797,7 @@ int detectSNPs(SNPCallingOptions<TSpec> &options)
     typedef String<unsigned>                TReadCounts;
     typedef String<Pair<int,int> >              TReadClips;
     typedef StringSet<String<Pair<char,int> > >     TReadCigars;
+    typedef ParsedWindow<TFragmentStore, TReadCounts, TReadClips, TReadCigars> TWindow;
 
     TGenomeSet              genomes;
     StringSet<CharString>           genomeFileNameList; // filenamen
@@ -776,6 +956,14 @@ int detectSNPs(SNPCallingOptions<TSpec> &options)
             posFileStream << "#chr\tpos\tA\tC\tG\tT\tgap\n";
 
     }
+    // the window logs are appended to the log file in genome order
+    ::std::ofstream logFileStream;
+    if (options.outputLog != "")
+    {
+        logFileStream.open(toCString(options.outputLog), ::std::ios_base::out | ::std::ios_base::app);
+        if (!logFileStream.is_open())
+            ::std::cerr << "Failed to write to log file" << ::std::endl;
+    }
     /////////////////////////////////////////////////////////////////////////////
     // helper variables
     Pair<int,int> zeroPair(0,0);
@@ -783,7 +971,7 @@ int detectSNPs(SNPCallingOptions<TSpec> &options)
     int sumwindows = 0;
 
     bool positionStatsOnly = (options.outputSNP == "" && options.outputPosition != "");
-    TPosIterator inspectPosIt, inspectPosItEnd;
+    TPosIterator inspectPosIt = TPosIterator(), inspectPosItEnd = TPosIterator();
     // The iteration of the positions entries is convoluted with the rest of the code.  We create a
     // fake positions entry of the correct size (length(genomes)) but for positionStatsOnly to false
     // if no positions are given.
@@ -795,6 +983,14 @@ int detectSNPs(SNPCallingOptions<TSpec> &options)
 
     bool firstCall = true;
 
+    // parsed windows are called in parallel batches, the position statistics need the windows one by one
+    unsigned windowsInFlight = positionStatsOnly ? 1 : 2 * options.threadCount;
+    String<TWindow> windows;
+    reserve(windows, windowsInFlight, Exact());
+    ::std::vector<WindowOutBuffer> snpBuffers(windowsInFlight);
+    ::std::vector<WindowOutBuffer> indelBuffers(windowsInFlight);
+    ::std::vector<WindowOutBuffer> logBuffers(windowsInFlight);
+
     /////////////////////////////////////////////////////////////////////////////
     // Start scanning for SNPs/indels
     // for each chromosome
@@ -838,10 +1034,17 @@ int detectSNPs(SNPCallingOptions<TSpec> &options)
             if(options._debugLevel > 0)
                 ::std::cout << "Sequence number " << i << " window " << currentWindowBegin << ".." << currentWindowEnd << "\n";
 
-            TFragmentStore fragmentStore;
-            TReadCounts readCounts;  // Count number of reads that are identical to the given one. Useful for micro RNA data where there were millions of identical reads. Must be in GFF input, not supported for SAM input.
-            TReadClips readClips;  // Soft clipping information and/or clipping information from GFF/SAM tag. Clipping is postponed after pileup correction.
-            TReadCigars readCigars; // Currently only stored for split-mapped reads. Split-mapped reads need special handling, especially for realignment.
+            resize(windows, length(windows) + 1);
+            TWindow &window = back(windows);
+            window.contigId = i;
+            window.windowBegin = currentWindowBegin;
+            window.windowEnd = currentWindowEnd;
+            window.clip = false;
+
+            TFragmentStore &fragmentStore = window.fragmentStore;
+            TReadCounts &readCounts = window.readCounts;  // Count number of reads that are identical to the given one. Useful for micro RNA data where there were millions of identical reads. Must be in GFF input, not supported for SAM input.
+            TReadClips &readClips = window.readClips;  // Soft clipping information and/or clipping information from GFF/SAM tag. Clipping is postponed after pileup correction.
+            TReadCigars &readCigars = window.readCigars; // Currently only stored for split-mapped reads. Split-mapped reads need special handling, especially for realignment.
 
             // add the matches that were overlapping with this and the last window (copied in order to avoid 2 x makeGlobal)
             if(!empty(tmpMatches))
@@ -948,72 +1151,42 @@ int detectSNPs(SNPCallingOptions<TSpec> &options)
                 //  ::std::cout << "Min = " << options.minCoord << " Max = " << options.maxCoord << std::endl;
                 //  ::std::cout << "Min = " << startCoord << " Max = " << endCoord << std::endl;
 
-                // coordinates are relative to current chromosomal window (segment)
-                transformCoordinates(fragmentStore,startCoord,options);
-
-                // set the current chromosomal segment as contig sequence
-                TContig conti;
-                conti.seq = infix(genomes[i],startCoord,endCoord);
-                appendValue(fragmentStore.contigStore, conti, Generous() );
-                appendValue(fragmentStore.contigNameStore, genomeNames[i], Generous() );// internal id is always 0
+                window.startCoord = startCoord;
+                window.endCoord = endCoord;
 
                 // clip Reads if clipping is switched on and there were clip tags in the gff file
                 if((!options.dontClip && options.clipTagsInFile) || options.softClipTagsInFile)
                 {
+                    // windows parsed before must still be called in "base quality"-mode
+                    if(options.useBaseQuality)
+                    {
+                        callAndWriteWindows(windows, 0, length(windows) - 1, genomes, genomeNames, snpBuffers, indelBuffers, logBuffers,
+                                            snpFileStream, indelFileStream, logFileStream, posFileStream,
+                                            inspectPosIt, inspectPosItEnd, positionStatsOnly, options);
+                        erase(windows, 0, length(windows) - 1);
+                    }
                     options.useBaseQuality = false; // activate "average read quality"-mode for snp calling, low quality bases should be clipped anyway
-                    clipReads(fragmentStore,readClips,(unsigned)0,(unsigned)length(fragmentStore.alignedReadStore),options);
+                    back(windows).clip = true;
                 }
+            }
 
-                // check for indels
-                if (options.outputIndel != "")
-                {
-                    if(options._debugLevel > 1) ::std::cout << "Check for indels..." << std::endl;
-                    if(!options.realign) dumpShortIndelPolymorphismsBatch(fragmentStore, readCigars, fragmentStore.contigStore[0].seq, genomeNames[i], startCoord, currentWindowBegin, currentWindowEnd, indelFileStream, options);
-                }
-
-                // // check for CNVs
-                //              if (*options.outputCNV != 0)
-                //                  dumpCopyNumberPolymorphismsBatch(fragmentStore, genomeNames[i], startCoord, currentWindowBegin, currentWindowEnd, cnvFileStream, options);
-
-#ifdef SNPSTORE_DEBUG
-                CharString strstr = "test";
-                //              _dumpMatches(fragmentStore, strstr );
-#endif
-                if (options.outputSNP != "")
-                {
-                    if(options._debugLevel > 1) ::std::cout << "Check for SNPs..." << std::endl;
-                    if(options.realign)
-                        dumpVariantsRealignBatchWrap(fragmentStore, readCigars, readCounts, genomeNames[i], startCoord, currentWindowBegin, currentWindowEnd, snpFileStream,indelFileStream,options);
-                    else
-                        dumpSNPsBatch(fragmentStore, readCigars, readCounts, genomeNames[i], startCoord, currentWindowBegin, currentWindowEnd, snpFileStream,options);
-                }
-                if(positionStatsOnly)
-                {
-                    if(options._debugLevel > 1) ::std::cout << "Dumping info for query positions..." << std::endl;
-                    if(options.realign)
-                        dumpPositionsRealignBatchWrap(fragmentStore, inspectPosIt, inspectPosItEnd, readCigars, readCounts, genomeNames[i], startCoord, currentWindowBegin, currentWindowEnd, posFileStream, options);
-                    else dumpPosBatch(fragmentStore, inspectPosIt, inspectPosItEnd, readCigars, readCounts, genomeNames[i], startCoord, currentWindowBegin, currentWindowEnd, posFileStream, options);
-                }
+            if(length(windows) == windowsInFlight)
+            {
+                callAndWriteWindows(windows, 0, length(windows), genomes, genomeNames, snpBuffers, indelBuffers, logBuffers,
+                                    snpFileStream, indelFileStream, logFileStream, posFileStream,
+                                    inspectPosIt, inspectPosItEnd, positionStatsOnly, options);
+                clear(windows);
             }
-//            else
-//            {
-                if(positionStatsOnly && !empty(positions))
-                {
-                    while(inspectPosIt != inspectPosItEnd && *inspectPosIt < currentWindowEnd)
-                    {
-                        if(options.orientationAware)
-                            posFileStream << genomeNames[i] << '\t' << *inspectPosIt + options.positionFormat << "\t0\t0\t0\t0\t0\t0\t0\t0\t0\t0\t0" << std::endl;
-                        else
-                            posFileStream << genomeNames[i] << '\t' << *inspectPosIt + options.positionFormat << "\t0\t0\t0\t0\t0\t0" << std::endl;
-                        ++inspectPosIt;
-                    }
-                }
-//            }
             currentWindowBegin = currentWindowEnd;
             ++sumwindows;
         }
 
     }
+    callAndWriteWindows(windows, 0, length(windows), genomes, genomeNames, snpBuffers, indelBuffers, logBuffers,
+                        snpFileStream, indelFileStream, logFileStream, posFileStream,
+                        inspectPosIt, inspectPosItEnd, positionStatsOnly, options);
+    clear(windows);
+
     if (options.outputSNP != "")
         snpFileStream.close();
 
@@ -1023,6 +1196,9 @@ int detectSNPs(SNPCallingOptions<TSpec> &options)
     if (options.outputPosition != "")
         posFileStream.close();
 
+    if (options.outputLog != "")
+        logFileStream.close();
+
     //  if (options.outputCNV != "")
     //      cnvFileStream.close();
 
@@ -1163,6 +1339,12 @@ parseCommandLine(SNPCallingOptions<TSpec> & options, int argc, char const ** arg
     addOption(parser, ArgParseOption("pws", "parse-window-size", "Genomic window size for parsing reads (concerns memory consumption, choose smaller windows for higher coverage).", ArgParseArgument::INTEGER));
     setMinValue(parser, "parse-window-size", "1");
     setDefaultValue(parser, "parse-window-size", options.windowSize);
+    addOption(parser, ArgParseOption("tc", "thread-count", "Number of threads calling variants in parsed windows.", ArgParseArgument::INTEGER));
+    setMinValue(parser, "thread-count", "1");
+    setDefaultValue(parser, "thread-count", options.threadCount);
+#ifndef _OPENMP
+    hideOption(parser, "tc");
+#endif  // #ifndef _OPENMP
     addOption(parser, ArgParseOption("reb", "realign-border", "Realign border.", ArgParseArgument::INTEGER));
     setMinValue(parser, "realign-border", "0");
     setMaxValue(parser, "realign-border", "10");
@@ -1288,6 +1470,7 @@ parseCommandLine(SNPCallingOptions<TSpec> & options, int argc, char const ** arg
     options.realign = isSet(parser, "realign");
     getOptionValue(options.newQualityCalibrationFactor, parser, "corrected-quality");
     getOptionValue(options.windowSize, parser, "parse-window-size");
+    getOptionValue(options.threadCount, parser, "thread-count");
     getOptionValue(options.realignAddBorder, parser, "realign-border");
     // SNP Calling Options:
     getOptionValue(options.minMutT, parser, "min-mutations");
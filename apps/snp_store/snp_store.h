@@ -199,6 +199,7 @@ struct FragmentStoreConfig<SnpStoreGroupSpec_> :
 
         unsigned    windowSize;                 // genomic window size for read parsing
         unsigned    windowBuff;                 // reads within windowBuff base pairs of current window are also kept (-> overlapping windows)
+        unsigned    threadCount;                // number of threads calling variants in parsed windows
 
         // cnv calling related // not in use
         unsigned    expectedReadsPerBin;
@@ -297,6 +298,7 @@ struct FragmentStoreConfig<SnpStoreGroupSpec_> :
 
             windowSize = 1000000;
             windowBuff = 70;
+            threadCount = 1;
             minCoord = maxValue<unsigned>();
             maxCoord = 0;
             maxHitLength = 1;
@@ -2379,6 +2381,7 @@ void dumpVariantsRealignBatchWrap(
     typename TFragmentStore::TContigPos currWindowEnd,
     TFile                   &fileSNPs,
     TFile                   &fileIndels,
+    TFile                   &fileLog,
     TOptions                &options)
 {
 
@@ -2477,7 +2480,7 @@ void dumpVariantsRealignBatchWrap(
                 dumpVariantsRealignBatch(fragStoreGroup,readCigars,
                     readCounts,genomeID,
                     groupStartCoord,groupStartPos,groupEndPos,
-                    fileSNPs,fileIndels,options);
+                    fileSNPs,fileIndels,fileLog,options);
             }
             else
             {
@@ -2489,7 +2492,7 @@ void dumpVariantsRealignBatchWrap(
                     dumpSNPsBatch(fragStoreGroup,readCigars,
                         readCounts,genomeID,
                         groupStartCoord,groupStartPos,groupEndPos,
-                        fileSNPs,options);
+                        fileSNPs,fileLog,options);
             }
         }
 
@@ -3771,6 +3774,7 @@ void dumpVariantsRealignBatch(
     typename TFragmentStore::TContigPos currEnd,
     TFile                   &file,
     TFile                   &indelfile,
+    TFile                   &logfile,
     TOptions                &options)
 {
 
@@ -3811,15 +3815,9 @@ void dumpVariantsRealignBatch(
         return;
     }
 
-    // log file business
-    ::std::ofstream logfile;
+    // log file business, the caller collects the log of each window
     if(options.outputLog != "")
-    {
-        logfile.open(toCString(options.outputLog), ::std::ios_base::out | ::std::ios_base::app);
-        if (!logfile.is_open())
-            ::std::cerr << "Failed to write to log file" << ::std::endl;
         logfile << "#stats for window " << currStart << " " << currEnd << " of " << genomeID << std::endl;
-    }
 
     if(options._debugLevel > 1) ::std::cout << "Scanning chromosome " << genomeID << " window (" << currStart<<","<< currEnd << ") for SNPs..." << ::std::endl;
 
@@ -4535,8 +4533,6 @@ convertMatchesToGlobalAlignment(fragmentStore, scoreType, Nothing());
 
     if(options._debugLevel>1) std::cout <<"Finished scanning window.\n"<<std::flush;
 
-    if((options.outputLog != "") && logfile.is_open())
-        logfile.close();
 
 
 }
@@ -4563,6 +4559,7 @@ void dumpSNPsBatch(
     typename TFragmentStore::TContigPos currStart,
     typename TFragmentStore::TContigPos currEnd,
     TFile               &file,
+    TFile               &logfile,
     TOptions            &options)
 {
 
@@ -4598,14 +4595,9 @@ void dumpSNPsBatch(
         return;
     }
 
-    ::std::ofstream logfile;
+    // the caller collects the log of each window
     if(options.outputLog != "")
-    {
-        logfile.open(toCString(options.outputLog), ::std::ios_base::out | ::std::ios_base::app);
-        if (!logfile.is_open())
-            ::std::cerr << "Failed to write to log file" << ::std::endl;
         logfile << "#stats for window " << currStart << " " << currEnd << " of " << genomeID << std::endl;
-    }
 
     TMatchIterator matchIt  = begin(matches, Standard());
     TMatchIterator matchItEnd   = end(matches, Standard());
@@ -4851,8 +4843,6 @@ void dumpSNPsBatch(
 
     if(options._debugLevel>1) std::cout <<"Finished scanning window.\n"<<std::flush;
 
-    if((options.outputLog != "") && logfile.is_open())
-        logfile.close();
 
 
     return;
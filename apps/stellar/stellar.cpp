@@ -24,6 +24,9 @@
 #include <seqan/arg_parse.h>
 #include <seqan/index.h>
 #include <seqan/seq_io.h>
+#include <seqan/parallel.h>
+
+#include <sstream>
 
 #include "stellar.h"
 #include "stellar_output.h"
@@ -31,8 +34,9 @@
 using namespace seqan;
 
 ///////////////////////////////////////////////////////////////////////////////
-// Initializes a Finder object for a database sequence,
-//  calls stellar, and writes matches to file
+// Initializes a Finder object for a database sequence and computes the eps-matches
+//  with the given thresholds, without compacting them at the end.
+//  Progress is written to out.
 template <typename TSequence, typename TId, typename TPattern, typename TMatches>
 inline bool
 _stellarOnOne(TSequence & database,
@@ -40,12 +44,15 @@ _stellarOnOne(TSequence & database,
               TPattern & swiftPattern,
               bool databaseStrand,
               TMatches & matches,
-              StellarOptions & options)
+              StellarOptions const & options,
+              unsigned disableThresh,
+              unsigned & compactThresh,
+              std::ostream & out)
 {
-    std::cout << "  " << databaseID;
+    out << "  " << databaseID;
     if (!databaseStrand)
-        std::cout << ", complement";
-    std::cout << std::flush;
+        out << ", complement";
+    out << std::flush;
 
     // finder
     typedef Finder<TSequence, Swift<SwiftLocal> > TFinder;
@@ -53,28 +60,48 @@ _stellarOnOne(TSequence & database,
 
     // stellar
     if (options.fastOption == CharString("exact"))
-        stellar(swiftFinder, swiftPattern, options.epsilon, options.minLength, options.xDrop,
-                options.disableThresh, options.compactThresh, options.numMatches, options.verbose,
-                databaseID, databaseStrand, matches, AllLocal());
+        _stellarFindMatches(swiftFinder, swiftPattern, options.epsilon, options.minLength, options.xDrop,
+                            disableThresh, compactThresh, options.numMatches, options.verbose,
+                            databaseID, databaseStrand, matches, out, AllLocal());
     else if (options.fastOption == "bestLocal")
-        stellar(swiftFinder, swiftPattern, options.epsilon, options.minLength, options.xDrop,
-                options.disableThresh, options.compactThresh, options.numMatches, options.verbose,
-                databaseID, databaseStrand, matches, BestLocal());
+        _stellarFindMatches(swiftFinder, swiftPattern, options.epsilon, options.minLength, options.xDrop,
+                            disableThresh, compactThresh, options.numMatches, options.verbose,
+                            databaseID, databaseStrand, matches, out, BestLocal());
     else if (options.fastOption == "bandedGlobal")
-        stellar(swiftFinder, swiftPattern, options.epsilon, options.minLength, options.xDrop,
-                options.disableThresh, options.compactThresh, options.numMatches, options.verbose,
-                databaseID, databaseStrand, matches, BandedGlobal());
+        _stellarFindMatches(swiftFinder, swiftPattern, options.epsilon, options.minLength, options.xDrop,
+                            disableThresh, compactThresh, options.numMatches, options.verbose,
+                            databaseID, databaseStrand, matches, out, BandedGlobal());
     else if (options.fastOption == "bandedGlobalExtend")
-        stellar(swiftFinder, swiftPattern, options.epsilon, options.minLength, options.xDrop,
-                options.disableThresh, options.compactThresh, options.numMatches, options.verbose,
-                databaseID, databaseStrand, matches, BandedGlobalExtend());
+        _stellarFindMatches(swiftFinder, swiftPattern, options.epsilon, options.minLength, options.xDrop,
+                            disableThresh, compactThresh, options.numMatches, options.verbose,
+                            databaseID, databaseStrand, matches, out, BandedGlobalExtend());
     else
     {
         std::cerr << "\nUnknown verification strategy: " << options.fastOption << std::endl;
         return false;
     }
 
-    std::cout << std::endl;
+    out << std::endl;
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Initializes a Finder object for a database sequence,
+//  calls stellar, and writes matches to file
+template <typename TSequence, typename TId, typename TPattern, typename TMatches>
+inline bool
+_stellarOnOne(TSequence & database,
+              TId & databaseID,
+              TPattern & swiftPattern,
+              bool databaseStrand,
+              TMatches & matches,
+              StellarOptions & options)
+{
+    if (!_stellarOnOne(database, databaseID, swiftPattern, databaseStrand, matches, options,
+                       options.disableThresh, options.compactThresh, std::cout))
+        return false;
+
+    _compactAllMatches(matches, options.minLength, options.numMatches);
     return true;
 }
 
@@ -135,6 +162,150 @@ struct FunctorComplement<AminoAcid>:
 
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// Splits the queries into blocks of consecutive sequences and builds a q-gram index for each block.
+//  The abundance cut of a block index is scaled to mask the same number of q-gram occurrences
+//  as an index of all queries.
+template <typename TSequence, typename TIndex>
+inline void
+_stellarIndexQueryBlocks(String<TIndex> & blockIndices,
+                         String<StringSet<TSequence, Dependent<> > > & blockQueries,
+                         String<unsigned> & blockBegins,
+                         StringSet<TSequence> & queries,
+                         unsigned numBlocks,
+                         StellarOptions const & options)
+{
+    unsigned numQueries = length(queries);
+    resize(blockBegins, numBlocks + 1);
+    resize(blockQueries, numBlocks);
+    resize(blockIndices, numBlocks);
+    for (unsigned b = 0; b <= numBlocks; ++b)
+        blockBegins[b] = (unsigned)((__uint64)numQueries * b / numBlocks);
+
+    double queryLength = lengthSum(queries);
+    for (unsigned b = 0; b < numBlocks; ++b)
+    {
+        for (unsigned q = blockBegins[b]; q < blockBegins[b + 1]; ++q)
+            appendValue(blockQueries[b], queries[q]);
+        setValue(blockIndices[b].text, blockQueries[b]);
+        resize(indexShape(blockIndices[b]), options.qGram);
+        cargo(blockIndices[b]).abundanceCut = options.qgramAbundanceCut * queryLength / lengthSum(blockQueries[b]);
+    }
+
+    SEQAN_OMP_PRAGMA(parallel for schedule(dynamic, 1) num_threads(options.threads))
+    for (int b = 0; b < (int)numBlocks; ++b)
+        indexRequire(blockIndices[b], QGramSADir());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Calls _stellarOnOne for all (query block, database sequence, strand) tasks in parallel.
+//  Each task uses its own Pattern on the shared index of its block. The eps-matches are computed
+//  with the disable and compact thresholds of the serial search and compacted at the end of the task.
+//  Queries disabled by a task are skipped by the tasks started afterwards. The matches and the
+//  progress output are kept per task and inserted by _stellarMergeParallel.
+template <typename TSequence, typename TId, typename TIndex>
+inline bool
+_stellarOnAllParallel(StringSet<TSequence> & databases,
+                      StringSet<TSequence> & reverseDatabases,
+                      StringSet<TId> & databaseIDs,
+                      String<bool> const & strands,
+                      String<TIndex> & blockIndices,
+                      String<unsigned> const & blockBegins,
+                      String<StringSet<QueryMatches<StellarMatch<TSequence, TId> > > > & taskMatches,
+                      String<std::string> & taskProgress,
+                      String<bool> & disabled,
+                      StellarOptions const & options)
+{
+    typedef QueryMatches<StellarMatch<TSequence, TId> > TQueryMatches;
+
+    unsigned numBlocks = length(blockIndices);
+    unsigned numStrands = length(strands);
+    int numTasks = length(databases) * numStrands * numBlocks;
+    resize(taskMatches, numTasks);
+    resize(taskProgress, numTasks);
+    bool success = true;
+
+    SEQAN_OMP_PRAGMA(parallel for schedule(dynamic, 1) num_threads(options.threads) reduction(&&:success))
+    for (int task = 0; task < numTasks; ++task)
+    {
+        unsigned block = task % numBlocks;
+        unsigned strand = (task / numBlocks) % numStrands;
+        unsigned i = task / (numBlocks * numStrands);
+
+        StringSet<TQueryMatches> & localMatches = taskMatches[task];
+        resize(localMatches, blockBegins[block + 1] - blockBegins[block]);
+        SEQAN_OMP_PRAGMA(critical(stellar_disabled))
+        for (unsigned q = 0; q < length(localMatches); ++q)
+            localMatches[q].disabled = disabled[blockBegins[block] + q];
+
+        Pattern<TIndex, Swift<SwiftLocal> > swiftPattern(blockIndices[block]);
+        if (options.verbose)
+            swiftPattern.params.printDots = true;
+
+        unsigned compactThresh = options.compactThresh;
+        std::ostringstream progress;
+        TSequence & database = strands[strand] ? databases[i] : reverseDatabases[i];
+        success = _stellarOnOne(database, databaseIDs[i], swiftPattern, strands[strand], localMatches, options,
+                                options.disableThresh, compactThresh, progress) && success;
+        _compactAllMatches(localMatches, options.minLength, options.numMatches);
+        taskProgress[task] = progress.str();
+
+        SEQAN_OMP_PRAGMA(critical(stellar_disabled))
+        for (unsigned q = 0; q < length(localMatches); ++q)
+            if (localMatches[q].disabled)
+                disabled[blockBegins[block] + q] = true;
+    }
+
+    return success;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Inserts the eps-matches of the tasks of _stellarOnAllParallel in the order of the serial search,
+//  i.e. database by database, forward before reverse strand, and prints the progress output.
+//  A query disabled by any task is disabled.
+template <typename TSequence, typename TId>
+inline void
+_stellarMergeParallel(StringSet<QueryMatches<StellarMatch<TSequence, TId> > > & matches,
+                      String<StringSet<QueryMatches<StellarMatch<TSequence, TId> > > > & taskMatches,
+                      String<std::string> const & taskProgress,
+                      String<unsigned> const & blockBegins,
+                      StellarOptions & options)
+{
+    typedef StellarMatch<TSequence, TId> TMatch;
+    typedef typename Iterator<String<TMatch>, Standard>::Type TIterator;
+
+    unsigned numBlocks = length(blockBegins) - 1;
+    for (unsigned task = 0; task < length(taskMatches); ++task)
+    {
+        unsigned block = task % numBlocks;
+        std::cout << taskProgress[task];
+        for (unsigned q = 0; q < length(taskMatches[task]); ++q)
+        {
+            QueryMatches<TMatch> & taskQueryMatches = taskMatches[task][q];
+            QueryMatches<TMatch> & queryMatches = matches[blockBegins[block] + q];
+            if (taskQueryMatches.disabled)
+            {
+                queryMatches.disabled = true;
+                clear(queryMatches.matches);
+            }
+            if (queryMatches.disabled)
+                continue;
+
+            TIterator it = begin(taskQueryMatches.matches, Standard());
+            TIterator itEnd = end(taskQueryMatches.matches, Standard());
+            for (; it != itEnd; ++it)
+                if (!_insertMatch(queryMatches, *it, options.minLength, options.disableThresh,
+                                  options.compactThresh, options.numMatches))
+                    break;
+        }
+        clear(taskMatches[task]);
+
+        // after the last block of a database sequence and strand
+        if (block + 1 == numBlocks)
+            _compactAllMatches(matches, options.minLength, options.numMatches);
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // Initializes a Pattern object with the query sequences,
 //  and calls _stellarOnOne for each database sequence
@@ -156,17 +327,63 @@ _stellarOnAll(StringSet<TSequence> & databases,
     if (options.verbose)
         swiftPattern.params.printDots = true;
 
+    // database strands to search
+    String<bool> strands;
+    if (options.forward)
+        appendValue(strands, true);
+    if (options.reverse && options.alphabet != "protein" && options.alphabet != "char")
+        appendValue(strands, false);
+
+    // with more than one thread, the queries are split into blocks that are searched independently,
+    //  such that there are at least as many (query block, database sequence, strand) tasks as threads if possible
+    String<TQGramIndex> blockIndices;
+    String<StringSet<TSequence, Dependent<> > > blockQueries;
+    String<unsigned> blockBegins;
+
     // Construct index
     std::cout << "Constructing index..." << std::endl;
-    indexRequire(qgramIndex, QGramSADir());
+    if (options.threads > 1)
+    {
+        unsigned numStrandTasks = _max(1u, (unsigned)(length(databases) * length(strands)));
+        unsigned numBlocks = (options.threads + numStrandTasks - 1) / numStrandTasks;
+        numBlocks = _max(1u, _min(numBlocks, (unsigned)length(queries)));
+        _stellarIndexQueryBlocks(blockIndices, blockQueries, blockBegins, queries, numBlocks, options);
+    }
+    else
+        indexRequire(qgramIndex, QGramSADir());
     std::cout << std::endl;
 
     // container for eps-matches
     StringSet<QueryMatches<StellarMatch<TSequence, TId> > > matches;
     resize(matches, length(queries));
 
+    // reverse complemented database sequences the eps-matches on the negative strand of a threaded search
+    //  refer to, the output reverse complements the database sequences itself
+    StringSet<TSequence> reverseDatabases;
+
     std::cout << "Aligning all query sequences to database sequence..." << std::endl;
-    for (unsigned i = 0; i < length(databases); ++i)
+    if (options.threads > 1)
+    {
+        typedef StringSet<QueryMatches<StellarMatch<TSequence, TId> > > TTaskMatches;
+
+        String<TTaskMatches> taskMatches;
+        String<std::string> taskProgress;
+        String<bool> disabled;
+        resize(disabled, length(queries), false);
+
+        if (length(strands) > 0 && !back(strands))
+        {
+            reverseDatabases = databases;
+            reverseComplement(reverseDatabases);
+        }
+
+        if (!_stellarOnAllParallel(databases, reverseDatabases, databaseIDs, strands, blockIndices, blockBegins,
+                                   taskMatches, taskProgress, disabled, options))
+            return 1;
+
+        _stellarMergeParallel(matches, taskMatches, taskProgress, blockBegins, options);
+    }
+    else for (unsigned i = 0; i < length(databases); ++i)
     {
         // positive database strand
         if (options.forward)
@@ -397,6 +614,10 @@ _writeSpecifiedParams(TOptions & options)
     {
         std::cout << "  q-gram abundance cut ratio       : " << options.qgramAbundanceCut << std::endl;
     }
+    if (options.threads != 1)
+    {
+        std::cout << "  number of threads                : " << options.threads << std::endl;
+    }
     std::cout << std::endl;
 }
 
@@ -461,6 +682,7 @@ _parseOptions(ArgumentParser & parser, TOptions & options)
     getOptionValue(options.maxRepeatPeriod, parser, "repeatPeriod");
     getOptionValue(options.minRepeatLength, parser, "repeatLength");
     getOptionValue(options.qgramAbundanceCut, parser, "abundanceCut");
+    getOptionValue(options.threads, parser, "threads");
 
     getOptionValue(options.verbose, parser, "verbose");
 
@@ -562,6 +784,14 @@ void _setParser(ArgumentParser & parser)
                                      "space.", ArgParseArgument::INTEGER));
     setDefaultValue(parser, "s", "500");
 
+    addSection(parser, "Performance Options");
+
+    addOption(parser, ArgParseOption("p", "threads",
+                                     "Number of threads searching the database sequences in parallel.",
+                                     ArgParseArgument::INTEGER));
+    setDefaultValue(parser, "p", "1");
+    setMinValue(parser, "p", "1");
+
     addSection(parser, "Output Options");
 
     addOption(parser, ArgParseOption("o", "out", "Name of output file.", ArgParseArgument::OUTPUT_FILE));
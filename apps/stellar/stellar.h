@@ -646,23 +646,44 @@ verifySwiftHit(Segment<TInfix, InfixSegment> const & infH,
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-// Calls swift filter and verifies swift hits. = Computes eps-matches.
+// Removes overlaps and duplicates and keeps the <numMatches> longest matches of each query.
+template<typename TSource, typename TId, typename TSize, typename TSize1>
+void _compactAllMatches(StringSet<QueryMatches<StellarMatch<TSource, TId> > > & matches,
+                        TSize minLength,
+                        TSize1 numMatches) {
+	typedef StellarMatch<TSource, TId> TMatch;
+	typedef typename Iterator<StringSet<QueryMatches<TMatch> >, Standard>::Type TIterator;
+	TIterator it = begin(matches, Standard());
+	TIterator itEnd = end(matches, Standard());
+
+	for(; it < itEnd; ++it) {
+		QueryMatches<TMatch> &qm = *it;
+		if (length(qm) > 0 && !qm.disabled) {
+			maskOverlaps(qm.matches, minLength);	// remove overlaps and duplicates
+			compactMatches(qm.matches, numMatches);	// keep only the <numMatches> longest matches
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Calls swift filter and verifies swift hits, the eps-matches are not compacted at the end.
+//  Statistics are written to out in verbose mode.
 template<typename TText, typename TStringSetSpec, typename TIndexSpec, typename TSize, typename TDrop, typename TSize1,
          typename TMode, typename TSource, typename TId, typename TTag>
-void stellar(Finder<TText, Swift<SwiftLocal> > & finder,
-             Pattern<Index<StringSet<TText, TStringSetSpec>, TIndexSpec>, Swift<SwiftLocal> > & pattern,
-             double epsilon,
-             TSize minLength,
-             TDrop xDrop,
-			 TSize1 disableThresh,
-			 TSize1 & compactThresh,
-			 TSize1 numMatches,
-			 TMode verbose,
-			 TId & databaseID,
-			 bool dbStrand,
-             StringSet<QueryMatches<StellarMatch<TSource, TId> > > & matches,
-			 TTag tag) {
-	typedef StellarMatch<TSource, TId> TMatch;
+void _stellarFindMatches(Finder<TText, Swift<SwiftLocal> > & finder,
+                         Pattern<Index<StringSet<TText, TStringSetSpec>, TIndexSpec>, Swift<SwiftLocal> > & pattern,
+                         double epsilon,
+                         TSize minLength,
+                         TDrop xDrop,
+                         TSize1 disableThresh,
+                         TSize1 & compactThresh,
+                         TSize1 numMatches,
+                         TMode verbose,
+                         TId & databaseID,
+                         bool dbStrand,
+                         StringSet<QueryMatches<StellarMatch<TSource, TId> > > & matches,
+                         std::ostream & out,
+                         TTag tag) {
 	typedef typename GetSequenceByNo<StringSet<TText, TStringSetSpec> >::Type TPatternSeq;
 	typedef typename Infix<TText>::Type TInfix;
 
@@ -708,22 +729,32 @@ void stellar(Finder<TText, Swift<SwiftLocal> > & finder,
 	}
 
 	if (verbose && numSwiftHits > 0) {
-		std::cout << std::endl << "    # SWIFT hits      : " << numSwiftHits;
-		std::cout << std::endl << "    Longest hit       : " << maxLength;
-		std::cout << std::endl << "    Avg hit length    : " << totalLength/numSwiftHits;
+		out << std::endl << "    # SWIFT hits      : " << numSwiftHits;
+		out << std::endl << "    Longest hit       : " << maxLength;
+		out << std::endl << "    Avg hit length    : " << totalLength/numSwiftHits;
 	}
+}
 
-	typedef typename Iterator<StringSet<QueryMatches<TMatch> >, Standard>::Type TIterator;
-	TIterator it = begin(matches, Standard());
-	TIterator itEnd = end(matches, Standard());
-
-	for(; it < itEnd; ++it) {
-		QueryMatches<TMatch> &qm = *it;
-		if (length(qm) > 0 && !qm.disabled) {
-			maskOverlaps(qm.matches, minLength);	// remove overlaps and duplicates
-			compactMatches(qm.matches, numMatches);	// keep only the <numMatches> longest matches
-		}
-	}
+///////////////////////////////////////////////////////////////////////////////
+// Calls swift filter and verifies swift hits. = Computes eps-matches.
+template<typename TText, typename TStringSetSpec, typename TIndexSpec, typename TSize, typename TDrop, typename TSize1,
+         typename TMode, typename TSource, typename TId, typename TTag>
+void stellar(Finder<TText, Swift<SwiftLocal> > & finder,
+             Pattern<Index<StringSet<TText, TStringSetSpec>, TIndexSpec>, Swift<SwiftLocal> > & pattern,
+             double epsilon,
+             TSize minLength,
+             TDrop xDrop,
+			 TSize1 disableThresh,
+			 TSize1 & compactThresh,
+			 TSize1 numMatches,
+			 TMode verbose,
+			 TId & databaseID,
+			 bool dbStrand,
+             StringSet<QueryMatches<StellarMatch<TSource, TId> > > & matches,
+			 TTag tag) {
+	_stellarFindMatches(finder, pattern, epsilon, minLength, xDrop, disableThresh, compactThresh, numMatches, verbose,
+	                    databaseID, dbStrand, matches, std::cout, tag);
+	_compactAllMatches(matches, minLength, numMatches);
 }
 
 // Wrapper for stellar
@@ -357,23 +357,24 @@ _align_banded_nw_best_ends(TTrace& trace,
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-// Reverses the infixes of the left extension in place in hosts of infH and infV.
-template<typename TSequenceA, typename TSequenceB, typename TSeed>
+// Appends reversed copies of the infixes of the left extension to str.
+//   The hosts of infH and infV are not modified, so they can be searched concurrently.
+template<typename TString, typename TSequence, typename TSeed>
 void
-_reverseLeftExtension(Segment<TSequenceA, InfixSegment> const & infH,
-					  Segment<TSequenceB, InfixSegment> const & infV,
+_reverseLeftExtension(StringSet<TString> & str,
+					  Segment<TSequence, InfixSegment> const & infH,
+					  Segment<TSequence, InfixSegment> const & infV,
 					  TSeed & seed,
 					  TSeed & seedOld) {
-	Segment<TSequenceA, InfixSegment> infixH(host(infH), beginPositionH(seed), beginPositionH(seedOld));
-	Segment<TSequenceB, InfixSegment> infixV(host(infV), beginPositionV(seed), beginPositionV(seedOld));
-	reverse(infixH);
-	reverse(infixV);
+	appendValue(str, infix(host(infH), beginPositionH(seed), beginPositionH(seedOld)));
+	appendValue(str, infix(host(infV), beginPositionV(seed), beginPositionV(seedOld)));
+	reverse(str[0]);
+	reverse(str[1]);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 // Computes the banded alignment matrix for the left extension and 
 //   returns a string with possible start positions of an eps-match.
-// Caution: The infixes of the left extension is reversed in place in hosts of infH and infV!
 template<typename TMatrix, typename TPossEnd, typename TSequence, typename TSeed, typename TScore>
 void
 _fillMatrixBestEndsLeft(TMatrix & matrixLeft,
@@ -384,17 +385,10 @@ _fillMatrixBestEndsLeft(TMatrix & matrixLeft,
 						TSeed & seedOld,
 						TScore const & scoreMatrix) {
 
-	typedef Segment<TSequence, InfixSegment> TInfix;
-
-	TInfix infixH(host(infH), beginPositionH(seed), beginPositionH(seedOld));
-	TInfix infixV(host(infV), beginPositionV(seed), beginPositionV(seedOld));
+	typedef String<typename Value<TSequence>::Type> TReversed;
 
-	reverse(infixH);
-	reverse(infixV);
-
-	StringSet<TInfix> str;
-	appendValue(str, infixH);
-	appendValue(str, infixV);
+	StringSet<TReversed> str;
+	_reverseLeftExtension(str, infH, infV, seed, seedOld);
 
 	// _align_banded_nw_best_ends(matrixLeft, possibleEndsLeft, str, scoreMatrix,
 	// 						   upperDiagonal(seedOld) - upperDiagonal(seed),
@@ -579,6 +573,7 @@ _tracebackLeft(TMatrix const & matrixLeft,
 			   TPos const endLeftV,
 			   TAlign & align) {
 	typedef Segment<TSequence, InfixSegment>			TInfix;
+	typedef String<typename Value<TSequence>::Type>	TReversed;
 
 	StringSet<TInfix> str;
 	TInfix infixH(host(infH), beginPositionH(seed), beginPositionH(seedOld));
@@ -590,8 +585,11 @@ _tracebackLeft(TMatrix const & matrixLeft,
     TDiagonal diagLower = lowerDiagonal(seedOld) - upperDiagonal(seed);
     TDiagonal diagUpper = lowerDiagonal(seedOld) - lowerDiagonal(seed);
 
+	StringSet<TReversed> reversedStr;
+	_reverseLeftExtension(reversedStr, infH, infV, seed, seedOld);
+
 	AlignTraceback<TPos> traceBack;
-	_alignBandedNeedlemanWunschTrace(traceBack, str, matrixLeft, coordinate,
+	_alignBandedNeedlemanWunschTrace(traceBack, reversedStr, matrixLeft, coordinate,
                                      -diagUpper, -diagLower);
                                      // upperDiagonal(seedOld) - upperDiagonal(seed), upperDiagonal(seedOld) - lowerDiagonal(seed));
   //std::cerr << "TRACEBACK\n";
@@ -695,7 +693,6 @@ _bestExtension(TInfix const & infH,
 	// fill banded matrix and gaps string for ...
 	if (direction == EXTEND_BOTH || direction == EXTEND_LEFT) { // ... extension to the left
 		_fillMatrixBestEndsLeft(matrixLeft, possibleEndsLeft, infH, infV, seed, seedOld, scoreMatrix);
-		// Caution: left extension infix is now reversed in host(infH and infV) !!!
         SEQAN_ASSERT_NOT(empty(possibleEndsLeft));
 	} else appendValue(possibleEndsLeft, TEndInfo());
 	if (direction == EXTEND_BOTH || direction == EXTEND_RIGHT) { // ... extension to the right
@@ -706,11 +703,8 @@ _bestExtension(TInfix const & infH,
 	// longest eps match on poss ends string
 	Pair<TEndIterator> endPair = longestEpsMatch(possibleEndsLeft, possibleEndsRight, alignLen, alignErr, minLength, eps);
 
-	if (endPair == Pair<TEndIterator>(0, 0)) { // no eps-match found
-		if (direction != 1) 
-			_reverseLeftExtension(infH, infV, seed, seedOld); // back to original orientation
+	if (endPair == Pair<TEndIterator>(0, 0)) // no eps-match found
 		return false;
-	}
 
 	// determine end positions of maximal eps-match in ...
 	TPos endLeftH = 0, endLeftV = 0;
@@ -751,9 +745,6 @@ _bestExtension(TInfix const & infH,
 	}
     SEQAN_ASSERT_EQ(length(row(align, 0)), length(row(align, 1)));
 
-	if (direction == EXTEND_BOTH || direction == EXTEND_LEFT)
-		_reverseLeftExtension(infH, infV, seed, seedOld); // back to original orientation
-
 	return true;
 }
 
@@ -56,6 +56,7 @@ struct StellarOptions {
 	unsigned maxRepeatPeriod;	// maximal period of low complexity repeats to be filtered
 	unsigned minRepeatLength;	// minimal length of low complexity repeats to be filtered
 	double qgramAbundanceCut;
+	unsigned threads;			// number of threads searching database sequences in parallel
 	bool verbose;				// verbose mode
 
 
@@ -80,6 +81,7 @@ struct StellarOptions {
 		maxRepeatPeriod = 1;
 		minRepeatLength = 1000;
 		qgramAbundanceCut = 1;
+		threads = 1;
 		verbose = false;
 	}
 }; 
@@ -80,12 +80,14 @@ struct Options
     __uint64        contigsMaxLength;
     __uint64        contigsSum;
 
+    unsigned        maxMemory;
     bool            verbose;
 
     Options() :
         contigsSize(),
         contigsMaxLength(),
         contigsSum(),
+        maxMemory(0),
         verbose(false)
     {}
 };
@@ -141,6 +143,13 @@ void setupArgumentParser(ArgumentParser & parser, Options const & /* options */)
 
     addOption(parser, ArgParseOption("td", "tmp-dir", "Specify a temporary directory where to construct the index. \
                                      Default: use the output directory.", ArgParseOption::STRING));
+
+    addSection(parser, "Indexing Options");
+
+    addOption(parser, ArgParseOption("m", "max-memory", "Specify the memory in MB the suffix sorting buffers may use. \
+                                     Exceeding data is sorted externally in the temporary directory. \
+                                     Default: keep all buffers in memory.", ArgParseOption::INTEGER));
+    setMinValue(parser, "max-memory", "64");
 }
 
 // ----------------------------------------------------------------------------
@@ -177,6 +186,9 @@ parseCommandLine(Options & options, ArgumentParser & parser, int argc, char cons
     }
     setEnv("TMPDIR", tmpDir);
 
+    // Parse memory cap.
+    getOptionValue(options.maxMemory, parser, "max-memory");
+
     return ArgumentParser::PARSE_OK;
 }
 
@@ -261,11 +273,13 @@ void saveIndex(YaraIndexer<TSpec, TConfig> & me)
     clear(me.contigs);
     shrinkToFit(me.contigs);
 
+    // Bound all pools of the pipelined suffix sorter, the SA and BWT are streamed to disk anyway.
+    PoolMemoryBudget budget((__uint64)me.options.maxMemory << 20);
+
     try
     {
-        // Iterator instantiation triggers index construction.
-        typename Iterator<TIndex, TopDown<> >::Type it(index);
-        ignoreUnusedVariableWarning(it);
+        typedef typename DefaultIndexCreator<TIndex, FibreSA>::Type TAlgo;
+        indexCreate(index, FibreSALF(), TAlgo(), PoolParameters(budget));
     }
     catch (BadAlloc const & /* e */)
     {
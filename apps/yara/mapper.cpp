@@ -202,6 +202,9 @@ void setupArgumentParser(ArgumentParser & parser, Options const & options)
 #endif
     setDefaultValue(parser, "threads", options.threadsCount);
 
+    addOption(parser, ArgParseOption("", "huge-pages", "Back the memory-mapped reference index with huge pages, \
+                                     if supported by the system."));
+
     addOption(parser, ArgParseOption("rb", "reads-batch", "Specify the number of reads to process in one batch.",
                                      ArgParseOption::INTEGER));
     setMinValue(parser, "reads-batch", "1000");
@@ -286,6 +289,7 @@ parseCommandLine(Options & options, ArgumentParser & parser, int argc, char cons
     getOptionValue(options.libraryOrientation, parser, "library-orientation", options.libraryOrientationList);
 
     getOptionValue(options.threadsCount, parser, "threads");
+    getOptionValue(options.hugePages, parser, "huge-pages");
     getOptionValue(options.readsCount, parser, "reads-batch");
 
     if (isSet(parser, "verbose")) options.verbose = 1;
@@ -77,6 +77,7 @@ struct Options
 
     unsigned            readsCount;
     unsigned            threadsCount;
+    bool                hugePages;
     unsigned            hitsThreshold;
     bool                rabema;
     unsigned            verbose;
@@ -102,6 +103,7 @@ struct Options
 //        anchorOne(false),
         readsCount(100000),
         threadsCount(1),
+        hugePages(false),
         hitsThreshold(300),
         rabema(false),
         verbose(0)
@@ -301,6 +303,17 @@ inline void configureThreads(Mapper<TSpec, TConfig> & me)
         std::cerr << "Threads count:\t\t\t" << omp_get_max_threads() << std::endl;
 }
 
+// ----------------------------------------------------------------------------
+// Function _openMode()
+// ----------------------------------------------------------------------------
+// The reference is mapped read-only, thus concurrent mappers share its pages.
+
+template <typename TSpec, typename TConfig>
+inline int _openMode(Mapper<TSpec, TConfig> const & me)
+{
+    return me.options.hugePages ? OPEN_RDONLY | OPEN_HUGEPAGES : OPEN_RDONLY;
+}
+
 // ----------------------------------------------------------------------------
 // Function loadContigs()
 // ----------------------------------------------------------------------------
@@ -311,7 +324,7 @@ inline void loadContigs(Mapper<TSpec, TConfig> & me)
     start(me.timer);
     try
     {
-        if (!open(me.contigs, toCString(me.options.contigsIndexFile)))
+        if (!open(me.contigs, toCString(me.options.contigsIndexFile), _openMode(me)))
             throw RuntimeError("Error while opening reference file.");
     }
     catch (BadAlloc const & /* e */)
@@ -335,7 +348,7 @@ inline void loadContigsIndex(Mapper<TSpec, TConfig> & me)
     start(me.timer);
     try
     {
-        if (!open(me.index, toCString(me.options.contigsIndexFile)))
+        if (!open(me.index, toCString(me.options.contigsIndexFile), _openMode(me)))
             throw RuntimeError("Error while opening reference index file.");
     }
     catch (BadAlloc const & /* e */)
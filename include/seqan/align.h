@@ -50,6 +50,7 @@
 // ============================================================================
 
 #include <seqan/basic.h>
+#include <seqan/basic/basic_simd_vector.h>
 #include <seqan/modifier.h>  // ModifiedAlphabet<>.
 #include <seqan/align/align_metafunctions.h>
 #include <seqan/graph_align.h>  // TODO(holtgrew): We should not have to depend on this.
@@ -157,6 +158,10 @@
 #include <seqan/align/dp_traceback_impl.h>
 #include <seqan/align/dp_algorithm_impl.h>
 
+// Vectorized computation of the scores of many independent alignments.
+#include <seqan/align/dp_algorithm_impl_simd.h>
+#include <seqan/align/dp_algorithm_impl_striped.h>
+
 //################################################################################
 // Old module
 //################################################################################
@@ -119,6 +119,21 @@ typedef Tag<MyersBitVector_> MyersBitVector;
 struct MyersHirschberg_;
 typedef Tag<MyersHirschberg_> MyersHirschberg;
 
+/*!
+ * @tag AlignmentAlgorithmTags#Farrar
+ * @headerfile <seqan/align.h>
+ * @brief Tag for selecting Farrar's striped SIMD DP algorithm.
+ *
+ * @signature struct Farrar_;
+ * @signature typedef Tag<Farrar_> Farrar;
+ *
+ * Computes the score of a single alignment using a striped query profile.  Only the score is computed, there is no
+ * traceback.  Whether linear or affine gap costs are used is determined by the scoring scheme.
+ */
+
+struct Farrar_;
+typedef Tag<Farrar_> Farrar;
+
 // ----------------------------------------------------------------------------
 // Local Alignment Algorithm Tags
 // ----------------------------------------------------------------------------
@@ -0,0 +1,635 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2015, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Inter-sequence vectorization of the score-only DP algorithm.
+//
+// Computes the scores of many independent pairwise alignments at once.  Each
+// pair occupies one lane of a SimdVector and all lanes are advanced through
+// their DP matrices in lockstep, column by column.  Lanes of different
+// lengths are padded; since a DP cell only depends on cells above and to the
+// left of it, the padding never influences a valid cell and only the
+// extraction of the final scores has to take the individual lengths into
+// account.  The alignment configuration is given by the same DPProfile_ that
+// is used by the scalar implementation in dp_algorithm_impl.h.
+//
+// If no SIMD instruction set is enabled, the pairs are aligned one after the
+// other using the scalar implementation.
+// ==========================================================================
+
+#ifndef SEQAN_INCLUDE_SEQAN_ALIGN_DP_ALGORITHM_IMPL_SIMD_H_
+#define SEQAN_INCLUDE_SEQAN_ALIGN_DP_ALGORITHM_IMPL_SIMD_H_
+
+namespace seqan {
+
+// ============================================================================
+// Forwards
+// ============================================================================
+
+// ============================================================================
+// Tags, Classes, Enums
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Class DPBatchScoringScheme_
+// ----------------------------------------------------------------------------
+
+// Scalar description of a scoring scheme for the batch alignment.
+// The substitution scores are tabulated for all pairs of alphabet characters.
+template <typename TScoreValue>
+struct DPBatchScoringScheme_
+{
+    String<TScoreValue> table;
+    unsigned            alphabetSize;
+    bool                isSimple;       // table contains only match and mismatch scores
+    TScoreValue         match;
+    TScoreValue         mismatch;
+    TScoreValue         gapOpenH;
+    TScoreValue         gapExtendH;
+    TScoreValue         gapOpenV;
+    TScoreValue         gapExtendV;
+    TScoreValue         maxAbsScore;
+
+    DPBatchScoringScheme_() :
+        alphabetSize(0), isSimple(true), match(0), mismatch(0), gapOpenH(0), gapExtendH(0), gapOpenV(0),
+        gapExtendV(0), maxAbsScore(0)
+    {}
+};
+
+#ifdef SEQAN_SIMD_ENABLED
+
+// ----------------------------------------------------------------------------
+// Class DPBatchContext_
+// ----------------------------------------------------------------------------
+
+// Array of SIMD vectors.  The memory is aligned to the size of a vector, which
+// the default allocator does not guarantee for 32 byte vectors.
+template <typename TSimdVector>
+struct DPBatchVectorArray_
+{
+    String<char>    buffer;
+    TSimdVector *   data;
+
+    DPBatchVectorArray_() : data(NULL)
+    {}
+
+    TSimdVector & operator[](unsigned pos)
+    {
+        return data[pos];
+    }
+
+    TSimdVector const & operator[](unsigned pos) const
+    {
+        return data[pos];
+    }
+};
+
+// ----------------------------------------------------------------------------
+// Class DPBatchContext_
+// ----------------------------------------------------------------------------
+
+// Stores the transposed sequences and the current DP column of one batch.
+template <typename TSimdVector>
+struct DPBatchContext_
+{
+    typedef typename Value<TSimdVector>::Type TValue;
+    typedef DPBatchVectorArray_<TSimdVector>  TVectorArray;
+
+    TVectorArray    seqH;               // seqH[j] holds the j-th characters of all horizontal sequences
+    TVectorArray    seqV;               // seqV[i] holds the i-th characters of all vertical sequences
+    TVectorArray    scoreColumn;        // scores of the current column
+    TVectorArray    horizontalColumn;   // horizontal gap scores of the current column (affine gaps only)
+    TVectorArray    rowMask;            // rowMask[i] is set for lanes whose vertical sequence is not shorter than i
+    TVectorArray    bestScore;          // best score of each lane (local alignment only)
+
+    String<unsigned> lengthH;
+    String<unsigned> lengthV;
+    unsigned         maxLengthH;
+    unsigned         maxLengthV;
+
+    String<TValue>   laneScore;         // best score of each lane (global alignment only)
+
+    DPBatchContext_() : maxLengthH(0), maxLengthV(0)
+    {}
+};
+
+#endif  // #ifdef SEQAN_SIMD_ENABLED
+
+// ============================================================================
+// Metafunctions
+// ============================================================================
+
+// ============================================================================
+// Functions
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Function _initBatchScoringScheme()
+// ----------------------------------------------------------------------------
+
+template <typename TScoreValue, typename TScoreValue2, typename TScoreSpec, typename TAlphabet>
+inline void
+_initBatchScoringScheme(DPBatchScoringScheme_<TScoreValue> & batchScheme,
+                        Score<TScoreValue2, TScoreSpec> const & scoringScheme,
+                        TAlphabet const & /*tag*/)
+{
+    unsigned const alphSize = ValueSize<TAlphabet>::VALUE;
+    batchScheme.alphabetSize = alphSize;
+    resize(batchScheme.table, alphSize * alphSize, Exact());
+
+    batchScheme.match = score(scoringScheme, TAlphabet(0u), TAlphabet(0u));
+    batchScheme.mismatch = (alphSize > 1u) ? score(scoringScheme, TAlphabet(0u), TAlphabet(1u)) : batchScheme.match;
+    batchScheme.isSimple = true;
+    batchScheme.maxAbsScore = 0;
+
+    for (unsigned h = 0; h < alphSize; ++h)
+        for (unsigned v = 0; v < alphSize; ++v)
+        {
+            TScoreValue val = score(scoringScheme, TAlphabet(h), TAlphabet(v));
+            batchScheme.table[h * alphSize + v] = val;
+            if (val != ((h == v) ? batchScheme.match : batchScheme.mismatch))
+                batchScheme.isSimple = false;
+            batchScheme.maxAbsScore = _max(batchScheme.maxAbsScore, (TScoreValue)_abs(val));
+        }
+
+    TAlphabet c = TAlphabet(0u);
+    batchScheme.gapOpenH = scoreGapOpenHorizontal(scoringScheme, c, c);
+    batchScheme.gapExtendH = scoreGapExtendHorizontal(scoringScheme, c, c);
+    batchScheme.gapOpenV = scoreGapOpenVertical(scoringScheme, c, c);
+    batchScheme.gapExtendV = scoreGapExtendVertical(scoringScheme, c, c);
+
+    batchScheme.maxAbsScore = _max(batchScheme.maxAbsScore, (TScoreValue)_abs(batchScheme.gapOpenH));
+    batchScheme.maxAbsScore = _max(batchScheme.maxAbsScore, (TScoreValue)_abs(batchScheme.gapExtendH));
+    batchScheme.maxAbsScore = _max(batchScheme.maxAbsScore, (TScoreValue)_abs(batchScheme.gapOpenV));
+    batchScheme.maxAbsScore = _max(batchScheme.maxAbsScore, (TScoreValue)_abs(batchScheme.gapExtendV));
+}
+
+// ----------------------------------------------------------------------------
+// Function _computeAlignmentBatchScalar()
+// ----------------------------------------------------------------------------
+
+// Aligns the pairs [beginPos, endPos) one after another using the scalar DP.
+template <typename TScoreValue, typename TSetH, typename TSetV, typename TScoreValue2, typename TScoreSpec,
+          typename TDPType, typename TBand, typename TFreeEndGaps, typename TTraceConfig, typename TGapModel,
+          typename TPos>
+inline void
+_computeAlignmentBatchScalar(String<TScoreValue> & scores,
+                             TSetH const & setH,
+                             TSetV const & setV,
+                             Score<TScoreValue2, TScoreSpec> const & scoringScheme,
+                             AlignConfig2<TDPType, TBand, TFreeEndGaps, TTraceConfig> const & alignConfig,
+                             TGapModel const & gapModel,
+                             TPos beginPos,
+                             TPos endPos)
+{
+    String<TraceSegment_<unsigned, unsigned> > traceSegments;  // Dummy segments.
+    for (TPos pos = beginPos; pos < endPos; ++pos)
+    {
+        DPScoutState_<Default> dpScoutState;
+        scores[pos] = _setUpAndRunAlignment(traceSegments, dpScoutState, setH[pos], setV[pos], scoringScheme,
+                                            alignConfig, gapModel);
+    }
+}
+
+#ifdef SEQAN_SIMD_ENABLED
+
+// ----------------------------------------------------------------------------
+// Function resize()                                     [DPBatchVectorArray_]
+// ----------------------------------------------------------------------------
+
+// Resizes the array to hold newLength vectors.  The previous contents are discarded.
+template <typename TSimdVector, typename TSize>
+inline void
+resize(DPBatchVectorArray_<TSimdVector> & array, TSize newLength)
+{
+    resize(array.buffer, (newLength + 1) * sizeof(TSimdVector), Exact());
+    size_t addr = reinterpret_cast<size_t>(begin(array.buffer, Standard()));
+    addr = (addr + sizeof(TSimdVector) - 1) & ~(size_t)(sizeof(TSimdVector) - 1);
+    array.data = reinterpret_cast<TSimdVector *>(addr);
+}
+
+// ----------------------------------------------------------------------------
+// Function _initBatchContext()
+// ----------------------------------------------------------------------------
+
+// Transposes the sequences of the pairs [beginPos, endPos) into the lanes of the context.
+// Unused lanes are filled with copies of the first pair.
+template <typename TSimdVector, typename TSetH, typename TSetV, typename TPos>
+inline void
+_initBatchContext(DPBatchContext_<TSimdVector> & ctx,
+                  TSetH const & setH,
+                  TSetV const & setV,
+                  TPos beginPos,
+                  TPos endPos)
+{
+    typedef typename Value<TSimdVector>::Type TValue;
+    unsigned const LANES = LENGTH<TSimdVector>::VALUE;
+
+    resize(ctx.lengthH, LANES, Exact());
+    resize(ctx.lengthV, LANES, Exact());
+    ctx.maxLengthH = 0;
+    ctx.maxLengthV = 0;
+    for (unsigned l = 0; l < LANES; ++l)
+    {
+        TPos pos = (beginPos + l < endPos) ? beginPos + l : beginPos;
+        ctx.lengthH[l] = length(setH[pos]);
+        ctx.lengthV[l] = length(setV[pos]);
+        ctx.maxLengthH = _max(ctx.maxLengthH, ctx.lengthH[l]);
+        ctx.maxLengthV = _max(ctx.maxLengthV, ctx.lengthV[l]);
+    }
+
+    resize(ctx.seqH, ctx.maxLengthH);
+    resize(ctx.seqV, ctx.maxLengthV);
+    for (unsigned j = 0; j < ctx.maxLengthH; ++j)
+        clear(ctx.seqH[j]);
+    for (unsigned i = 0; i < ctx.maxLengthV; ++i)
+        clear(ctx.seqV[i]);
+    for (unsigned l = 0; l < LANES; ++l)
+    {
+        TPos pos = (beginPos + l < endPos) ? beginPos + l : beginPos;
+        for (unsigned j = 0; j < ctx.lengthH[l]; ++j)
+            ctx.seqH[j][l] = static_cast<TValue>(ordValue(setH[pos][j]));
+        for (unsigned i = 0; i < ctx.lengthV[l]; ++i)
+            ctx.seqV[i][l] = static_cast<TValue>(ordValue(setV[pos][i]));
+    }
+
+    resize(ctx.rowMask, ctx.maxLengthV + 1);
+    for (unsigned i = 0; i <= ctx.maxLengthV; ++i)
+        for (unsigned l = 0; l < LANES; ++l)
+            ctx.rowMask[i][l] = (i <= ctx.lengthV[l]) ? ~TValue(0) : TValue(0);
+
+    resize(ctx.scoreColumn, ctx.maxLengthV + 1);
+    resize(ctx.horizontalColumn, ctx.maxLengthV + 1);
+    resize(ctx.bestScore, 1);
+    clear(ctx.bestScore[0]);
+    resize(ctx.laneScore, LANES, Exact());
+    for (unsigned l = 0; l < LANES; ++l)
+        ctx.laneScore[l] = MinValue<TValue>::VALUE;
+}
+
+// ----------------------------------------------------------------------------
+// Function _batchSubstitutionScore()
+// ----------------------------------------------------------------------------
+
+template <typename TSimdVector, typename TScoreValue>
+inline TSimdVector
+_batchSubstitutionScore(TSimdVector const & valH,
+                        TSimdVector const & valV,
+                        TSimdVector const & matchVec,
+                        TSimdVector const & mismatchVec,
+                        DPBatchScoringScheme_<TScoreValue> const & batchScheme)
+{
+    typedef typename Value<TSimdVector>::Type TValue;
+
+    if (batchScheme.isSimple)
+        return blend(mismatchVec, matchVec, cmpEq(valH, valV));
+
+    TSimdVector result;
+    for (unsigned l = 0; l < LENGTH<TSimdVector>::VALUE; ++l)
+        result[l] = static_cast<TValue>(batchScheme.table[(unsigned)valH[l] * batchScheme.alphabetSize +
+                                                          (unsigned)valV[l]]);
+    return result;
+}
+
+// ----------------------------------------------------------------------------
+// Function _initBatchColumn()
+// ----------------------------------------------------------------------------
+
+// Initializes the first column and returns the "infinity" used for gap matrices.
+template <typename TSimdVector, typename TScoreValue, typename TDPProfile>
+inline void
+_initBatchColumn(DPBatchContext_<TSimdVector> & ctx,
+                 DPBatchScoringScheme_<TScoreValue> const & batchScheme,
+                 TSimdVector const & infinity,
+                 TDPProfile const &)
+{
+    typedef typename Value<TSimdVector>::Type TValue;
+
+    clear(ctx.scoreColumn[0]);
+    ctx.horizontalColumn[0] = infinity;
+    for (unsigned i = 1; i <= ctx.maxLengthV; ++i)
+    {
+        if (IsFreeEndGap_<TDPProfile, DPFirstColumn>::VALUE)
+            clear(ctx.scoreColumn[i]);
+        else
+            ctx.scoreColumn[i] = createVector<TSimdVector>(static_cast<TValue>(batchScheme.gapOpenV +
+                                                                               (i - 1) * batchScheme.gapExtendV));
+        ctx.horizontalColumn[i] = infinity;
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Function _computeBatchColumn()                                 [LinearGaps]
+// ----------------------------------------------------------------------------
+
+template <typename TSimdVector, typename TScoreValue, typename TDPProfile>
+inline void
+_computeBatchColumn(DPBatchContext_<TSimdVector> & ctx,
+                    DPBatchScoringScheme_<TScoreValue> const & batchScheme,
+                    unsigned j,
+                    TSimdVector const & /*infinity*/,
+                    TDPProfile const &,
+                    LinearGaps const &)
+{
+    typedef typename Value<TSimdVector>::Type TValue;
+
+    TSimdVector zero;
+    clear(zero);
+    TSimdVector const matchVec = createVector<TSimdVector>(batchScheme.match);
+    TSimdVector const mismatchVec = createVector<TSimdVector>(batchScheme.mismatch);
+    TSimdVector const gapH = createVector<TSimdVector>(batchScheme.gapExtendH);
+    TSimdVector const gapV = createVector<TSimdVector>(batchScheme.gapExtendV);
+    TSimdVector const valH = ctx.seqH[j - 1];
+
+    TSimdVector * col = &ctx.scoreColumn[0];
+    TSimdVector diagonal = col[0];
+    if (IsLocalAlignment_<TDPProfile>::VALUE || IsFreeEndGap_<TDPProfile, DPFirstRow>::VALUE)
+        col[0] = zero;
+    else
+        col[0] = createVector<TSimdVector>(static_cast<TValue>(batchScheme.gapExtendH * j));
+
+    for (unsigned i = 1; i <= ctx.maxLengthV; ++i)
+    {
+        TSimdVector horizontal = col[i];
+        TSimdVector current = diagonal + _batchSubstitutionScore(valH, ctx.seqV[i - 1], matchVec, mismatchVec,
+                                                                 batchScheme);
+        current = max(current, horizontal + gapH);
+        current = max(current, col[i - 1] + gapV);
+        if (IsLocalAlignment_<TDPProfile>::VALUE)
+            current = max(current, zero);
+        diagonal = horizontal;
+        col[i] = current;
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Function _computeBatchColumn()                                 [AffineGaps]
+// ----------------------------------------------------------------------------
+
+template <typename TSimdVector, typename TScoreValue, typename TDPProfile>
+inline void
+_computeBatchColumn(DPBatchContext_<TSimdVector> & ctx,
+                    DPBatchScoringScheme_<TScoreValue> const & batchScheme,
+                    unsigned j,
+                    TSimdVector const & infinity,
+                    TDPProfile const &,
+                    AffineGaps const &)
+{
+    typedef typename Value<TSimdVector>::Type TValue;
+
+    TSimdVector zero;
+    clear(zero);
+    TSimdVector const matchVec = createVector<TSimdVector>(batchScheme.match);
+    TSimdVector const mismatchVec = createVector<TSimdVector>(batchScheme.mismatch);
+    TSimdVector const gapOpenH = createVector<TSimdVector>(batchScheme.gapOpenH);
+    TSimdVector const gapExtendH = createVector<TSimdVector>(batchScheme.gapExtendH);
+    TSimdVector const gapOpenV = createVector<TSimdVector>(batchScheme.gapOpenV);
+    TSimdVector const gapExtendV = createVector<TSimdVector>(batchScheme.gapExtendV);
+    TSimdVector const valH = ctx.seqH[j - 1];
+
+    TSimdVector * col = &ctx.scoreColumn[0];
+    TSimdVector * colH = &ctx.horizontalColumn[0];
+    TSimdVector diagonal = col[0];
+    if (IsLocalAlignment_<TDPProfile>::VALUE || IsFreeEndGap_<TDPProfile, DPFirstRow>::VALUE)
+        col[0] = zero;
+    else
+        col[0] = createVector<TSimdVector>(static_cast<TValue>(batchScheme.gapOpenH +
+                                                               (j - 1) * batchScheme.gapExtendH));
+    colH[0] = col[0];
+    TSimdVector vertical = infinity;
+
+    for (unsigned i = 1; i <= ctx.maxLengthV; ++i)
+    {
+        TSimdVector left = col[i];
+        colH[i] = max(colH[i] + gapExtendH, left + gapOpenH);
+        vertical = max(vertical + gapExtendV, col[i - 1] + gapOpenV);
+
+        TSimdVector current = diagonal + _batchSubstitutionScore(valH, ctx.seqV[i - 1], matchVec, mismatchVec,
+                                                                 batchScheme);
+        current = max(current, colH[i]);
+        current = max(current, vertical);
+        if (IsLocalAlignment_<TDPProfile>::VALUE)
+            current = max(current, zero);
+        diagonal = left;
+        col[i] = current;
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Function _trackBatchColumn()
+// ----------------------------------------------------------------------------
+
+// Records the scores of all cells in column j that can end an alignment.
+template <typename TSimdVector, typename TDPProfile>
+inline void
+_trackBatchColumn(DPBatchContext_<TSimdVector> & ctx,
+                  unsigned j,
+                  TDPProfile const &)
+{
+    typedef typename Value<TSimdVector>::Type TValue;
+    unsigned const LANES = LENGTH<TSimdVector>::VALUE;
+
+    if (IsLocalAlignment_<TDPProfile>::VALUE)
+    {
+        // Local scores are non-negative, masking out invalid cells by 0 does not change the maximum.
+        TSimdVector colMask;
+        for (unsigned l = 0; l < LANES; ++l)
+            colMask[l] = (j <= ctx.lengthH[l]) ? ~TValue(0) : TValue(0);
+        for (unsigned i = 0; i <= ctx.maxLengthV; ++i)
+            ctx.bestScore[0] = max(ctx.bestScore[0], ctx.scoreColumn[i] & (ctx.rowMask[i] & colMask));
+        return;
+    }
+
+    for (unsigned l = 0; l < LANES; ++l)
+    {
+        if (j > ctx.lengthH[l])
+            continue;
+
+        TValue & best = ctx.laneScore[l];
+        if (IsFreeEndGap_<TDPProfile, DPLastRow>::VALUE || j == ctx.lengthH[l])
+            best = _max(best, static_cast<TValue>(ctx.scoreColumn[ctx.lengthV[l]][l]));
+
+        if (IsFreeEndGap_<TDPProfile, DPLastColumn>::VALUE && j == ctx.lengthH[l])
+            for (unsigned i = 0; i < ctx.lengthV[l]; ++i)
+                best = _max(best, static_cast<TValue>(ctx.scoreColumn[i][l]));
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Function _runAlignmentBatchSimd()
+// ----------------------------------------------------------------------------
+
+// Aligns the pairs [beginPos, endPos), at most one per lane.
+template <typename TScoreValue, typename TSimdVector, typename TSetH, typename TSetV, typename TScoreValue2,
+          typename TDPProfile, typename TGapModel, typename TPos>
+inline void
+_runAlignmentBatchSimd(String<TScoreValue> & scores,
+                       DPBatchContext_<TSimdVector> & ctx,
+                       TSetH const & setH,
+                       TSetV const & setV,
+                       DPBatchScoringScheme_<TScoreValue2> const & batchScheme,
+                       TDPProfile const & dpProfile,
+                       TGapModel const & gapModel,
+                       TPos beginPos,
+                       TPos endPos)
+{
+    typedef typename Value<TSimdVector>::Type TValue;
+
+    // Use half of the minimal value to avoid underflows when adding gap scores to "infinity".
+    TSimdVector const infinity = createVector<TSimdVector>(MinValue<TValue>::VALUE / 2);
+
+    _initBatchContext(ctx, setH, setV, beginPos, endPos);
+    _initBatchColumn(ctx, batchScheme, infinity, dpProfile);
+    _trackBatchColumn(ctx, 0u, dpProfile);
+
+    for (unsigned j = 1; j <= ctx.maxLengthH; ++j)
+    {
+        _computeBatchColumn(ctx, batchScheme, j, infinity, dpProfile, gapModel);
+        _trackBatchColumn(ctx, j, dpProfile);
+    }
+
+    for (TPos pos = beginPos; pos < endPos; ++pos)
+    {
+        if (IsLocalAlignment_<TDPProfile>::VALUE)
+            scores[pos] = static_cast<TScoreValue>(ctx.bestScore[0][pos - beginPos]);
+        else
+            scores[pos] = static_cast<TScoreValue>(ctx.laneScore[pos - beginPos]);
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Function _computeAlignmentBatchSimd()
+// ----------------------------------------------------------------------------
+
+// Aligns the pairs [beginPos, endPos) in batches of one pair per lane.
+template <typename TScoreValue, typename TSimdVector, typename TSetH, typename TSetV, typename TScoreValue2,
+          typename TDPProfile, typename TGapModel, typename TPos>
+inline void
+_computeAlignmentBatchSimd(String<TScoreValue> & scores,
+                           TSimdVector const & /*tag*/,
+                           TSetH const & setH,
+                           TSetV const & setV,
+                           DPBatchScoringScheme_<TScoreValue2> const & batchScheme,
+                           TDPProfile const & dpProfile,
+                           TGapModel const & gapModel,
+                           TPos beginPos,
+                           TPos endPos)
+{
+    typedef typename Size<TSetH>::Type TSize;
+    TSize const LANES = LENGTH<TSimdVector>::VALUE;
+
+    DPBatchContext_<TSimdVector> ctx;
+    for (TPos pos = beginPos; pos < endPos; pos += LANES)
+    {
+        TPos batchEnd = (endPos - pos < (TPos)LANES) ? endPos : pos + LANES;
+        _runAlignmentBatchSimd(scores, ctx, setH, setV, batchScheme, dpProfile, gapModel, pos, batchEnd);
+    }
+}
+
+#endif  // #ifdef SEQAN_SIMD_ENABLED
+
+// ----------------------------------------------------------------------------
+// Function _setUpAndRunAlignmentBatch()
+// ----------------------------------------------------------------------------
+
+// Computes the alignment scores of the pairs (setH[i], setV[i]).
+template <typename TScoreValue, typename TSetH, typename TSetV, typename TScoreValue2, typename TScoreSpec,
+          typename TDPType, typename TBand, typename TFreeEndGaps, typename TTraceConfig, typename TGapModel>
+inline void
+_setUpAndRunAlignmentBatch(String<TScoreValue> & scores,
+                           TSetH const & setH,
+                           TSetV const & setV,
+                           Score<TScoreValue2, TScoreSpec> const & scoringScheme,
+                           AlignConfig2<TDPType, TBand, TFreeEndGaps, TTraceConfig> const & alignConfig,
+                           TGapModel const & gapModel)
+{
+    typedef typename Size<TSetH>::Type TSize;
+
+    SEQAN_ASSERT_EQ(length(setH), length(setV));
+
+    TSize numPairs = length(setH);
+    resize(scores, numPairs, Exact());
+    if (numPairs == 0u)
+        return;
+
+#ifdef SEQAN_SIMD_ENABLED
+    typedef typename Value<typename Value<TSetH>::Type>::Type TAlphabetH;
+    typedef typename Value<typename Value<TSetV>::Type>::Type TAlphabetV;
+    typedef typename SetupAlignmentProfile_<TDPType, TFreeEndGaps, TGapModel, TracebackOff>::Type TDPProfile;
+
+    // The vectorized kernel only supports the static gap models of equal alphabets up to the size of a byte.
+    if (IsSameType<TAlphabetH, TAlphabetV>::VALUE && ValueSize<TAlphabetH>::VALUE <= 256u &&
+        !IsSameType<TGapModel, DynamicGaps>::VALUE)
+    {
+        DPBatchScoringScheme_<TScoreValue2> batchScheme;
+        _initBatchScoringScheme(batchScheme, scoringScheme, TAlphabetH());
+
+        TSize maxLength = 0;
+        for (TSize pos = 0; pos < numPairs; ++pos)
+            maxLength = _max(maxLength, (TSize)(length(setH[pos]) + length(setV[pos])));
+
+        // All scores and intermediate gap scores must be representable in a lane.
+        __uint64 bound = (__uint64)(maxLength + 2) * (__uint64)batchScheme.maxAbsScore;
+        if (2 * bound < (__uint64)MaxValue<short>::VALUE / 2)
+        {
+            _computeAlignmentBatchSimd(scores, typename SimdVector<short>::Type(), setH, setV, batchScheme,
+                                       TDPProfile(), gapModel, (TSize)0, numPairs);
+            return;
+        }
+        if (2 * bound < (__uint64)MaxValue<int>::VALUE / 2)
+        {
+            _computeAlignmentBatchSimd(scores, typename SimdVector<int>::Type(), setH, setV, batchScheme,
+                                       TDPProfile(), gapModel, (TSize)0, numPairs);
+            return;
+        }
+    }
+#endif  // #ifdef SEQAN_SIMD_ENABLED
+
+    _computeAlignmentBatchScalar(scores, setH, setV, scoringScheme, alignConfig, gapModel, (TSize)0, numPairs);
+}
+
+template <typename TScoreValue, typename TSetH, typename TSetV, typename TScoreValue2, typename TScoreSpec,
+          typename TDPType, typename TBand, typename TFreeEndGaps, typename TTraceConfig>
+inline void
+_setUpAndRunAlignmentBatch(String<TScoreValue> & scores,
+                           TSetH const & setH,
+                           TSetV const & setV,
+                           Score<TScoreValue2, TScoreSpec> const & scoringScheme,
+                           AlignConfig2<TDPType, TBand, TFreeEndGaps, TTraceConfig> const & alignConfig)
+{
+    if (!empty(setH) && _usesAffineGaps(scoringScheme, setH[0], setV[0]))
+        _setUpAndRunAlignmentBatch(scores, setH, setV, scoringScheme, alignConfig, AffineGaps());
+    else
+        _setUpAndRunAlignmentBatch(scores, setH, setV, scoringScheme, alignConfig, LinearGaps());
+}
+
+}  // namespace seqan
+
+#endif  // #ifndef SEQAN_INCLUDE_SEQAN_ALIGN_DP_ALGORITHM_IMPL_SIMD_H_
@@ -0,0 +1,350 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2015, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Intra-sequence vectorization of the score-only DP algorithm.
+//
+// Implements the striped algorithm of Farrar (2007).  The vertical sequence
+// is divided into LENGTH<TSimdVector> stripes of segLength rows each, row i
+// is stored in lane i / segLength of segment i % segLength.  This way the
+// cells of a segment do not depend on each other and a whole column can be
+// computed with one pass over the segments.  The vertical gaps crossing
+// stripe borders are corrected afterwards in the "lazy F" loop, which
+// usually stops after a few segments.
+//
+// The computation starts with 8 bit lanes.  If the scores leave the range
+// of the lanes, it is repeated with 16 and then 32 bit lanes.
+// ==========================================================================
+
+#ifndef SEQAN_INCLUDE_SEQAN_ALIGN_DP_ALGORITHM_IMPL_STRIPED_H_
+#define SEQAN_INCLUDE_SEQAN_ALIGN_DP_ALGORITHM_IMPL_STRIPED_H_
+
+namespace seqan {
+
+// ============================================================================
+// Forwards
+// ============================================================================
+
+// ============================================================================
+// Tags, Classes, Enums
+// ============================================================================
+
+#ifdef SEQAN_SIMD_ENABLED
+
+// ----------------------------------------------------------------------------
+// Class DPStripedContext_
+// ----------------------------------------------------------------------------
+
+template <typename TSimdVector>
+struct DPStripedContext_
+{
+    typedef DPBatchVectorArray_<TSimdVector> TVectorArray;
+
+    TVectorArray    profile;            // profile[c * segLength + s] holds the scores of c against segment s
+    TVectorArray    scoreLoad;          // scores of the previous column
+    TVectorArray    scoreStore;         // scores of the current column
+    TVectorArray    horizontal;         // horizontal gap scores of the next column
+    unsigned        segLength;
+
+    DPStripedContext_() : segLength(0)
+    {}
+};
+
+#endif  // #ifdef SEQAN_SIMD_ENABLED
+
+// ============================================================================
+// Metafunctions
+// ============================================================================
+
+// ============================================================================
+// Functions
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Function _stripedBorderScore()
+// ----------------------------------------------------------------------------
+
+// Returns the score of cell pos of the first row (or column) of the DP matrix.
+template <typename TScoreValue>
+inline TScoreValue
+_stripedBorderScore(TScoreValue gapOpen, TScoreValue gapExtend, unsigned pos, bool isFree)
+{
+    if (isFree || pos == 0u)
+        return 0;
+    return gapOpen + static_cast<TScoreValue>(pos - 1) * gapExtend;
+}
+
+#ifdef SEQAN_SIMD_ENABLED
+
+// ----------------------------------------------------------------------------
+// Function _shiftLanesUp()
+// ----------------------------------------------------------------------------
+
+// Moves each element to the next lane and sets the first lane to x.
+template <typename TSimdVector, typename TValue>
+inline TSimdVector
+_shiftLanesUp(TSimdVector const & vector, TValue x)
+{
+    TSimdVector result;
+    result[0] = x;
+    for (unsigned l = 1; l < LENGTH<TSimdVector>::VALUE; ++l)
+        result[l] = vector[l - 1];
+    return result;
+}
+
+// ----------------------------------------------------------------------------
+// Function _computeScoreStriped()
+// ----------------------------------------------------------------------------
+
+// Computes the alignment score using lanes of type TSimdVector.  Returns false if the scores do not fit into the
+// lanes.
+template <typename TScoreValue, typename TSimdVector, typename TSequenceH, typename TSequenceV, typename TDPProfile>
+inline bool
+_computeScoreStriped(TScoreValue & result,
+                     DPStripedContext_<TSimdVector> & ctx,
+                     TSequenceH const & seqH,
+                     TSequenceV const & seqV,
+                     DPBatchScoringScheme_<TScoreValue> const & batchScheme,
+                     TDPProfile const &)
+{
+    typedef typename Value<TSimdVector>::Type TValue;
+    typedef typename Value<TSequenceH>::Type TAlphabet;
+
+    unsigned const LANES = LENGTH<TSimdVector>::VALUE;
+    bool const isLocal = IsLocalAlignment_<TDPProfile>::VALUE;
+    bool const freeTop = isLocal || IsFreeEndGap_<TDPProfile, DPFirstRow>::VALUE;
+    bool const freeLeft = isLocal || IsFreeEndGap_<TDPProfile, DPFirstColumn>::VALUE;
+    bool const freeBottom = IsFreeEndGap_<TDPProfile, DPLastRow>::VALUE;
+    bool const freeRight = IsFreeEndGap_<TDPProfile, DPLastColumn>::VALUE;
+
+    unsigned const lenH = length(seqH);
+    unsigned const lenV = length(seqV);
+
+    // Each step changes a score by at most maxAbsScore.  As long as all scores are within [lower, upper], no
+    // intermediate result can overflow.  Values below lower are used as "minus infinity".
+    __int64 const maxAbs = batchScheme.maxAbsScore;
+    __int64 const lower = (__int64)MinValue<TValue>::VALUE + 4 * maxAbs;
+    __int64 const upper = (__int64)MaxValue<TValue>::VALUE - maxAbs;
+    if (lower >= upper)
+        return false;
+
+    __int64 const borderH = _stripedBorderScore((__int64)batchScheme.gapOpenH, (__int64)batchScheme.gapExtendH, lenH,
+                                                freeTop);
+    __int64 const borderV = _stripedBorderScore((__int64)batchScheme.gapOpenV, (__int64)batchScheme.gapExtendV, lenV,
+                                                freeLeft);
+    if (borderH < lower || borderH > upper || borderV < lower || borderV > upper)
+        return false;
+
+    TValue const minusInf = static_cast<TValue>(MinValue<TValue>::VALUE + 2 * maxAbs);
+    TSimdVector const minusInfVec = createVector<TSimdVector>(minusInf);
+    TSimdVector const lowerVec = createVector<TSimdVector>(lower);
+    TSimdVector const upperVec = createVector<TSimdVector>(upper);
+    TSimdVector const gapOpenH = createVector<TSimdVector>(batchScheme.gapOpenH);
+    TSimdVector const gapExtendH = createVector<TSimdVector>(batchScheme.gapExtendH);
+    TSimdVector const gapOpenV = createVector<TSimdVector>(batchScheme.gapOpenV);
+    TSimdVector const gapExtendV = createVector<TSimdVector>(batchScheme.gapExtendV);
+    // A vertical gap entering a cell can only improve cells further down if it exceeds the cell's score by more
+    // than lazyThreshold.
+    TSimdVector const lazyStep = createVector<TSimdVector>(_max(batchScheme.gapExtendV, batchScheme.gapOpenV));
+    TSimdVector const lazyThreshold = createVector<TSimdVector>(_min(batchScheme.gapOpenV - batchScheme.gapExtendV,
+                                                                     (TScoreValue)0));
+    TSimdVector zero;
+    clear(zero);
+
+    // Build the query profile.  Padding rows get a score of 0 and never exceed the scores of real rows.
+    unsigned const segLength = (lenV + LANES - 1) / LANES;
+    unsigned const alphSize = batchScheme.alphabetSize;
+    ctx.segLength = segLength;
+    resize(ctx.profile, alphSize * segLength);
+    for (unsigned c = 0; c < alphSize; ++c)
+        for (unsigned s = 0; s < segLength; ++s)
+            for (unsigned l = 0; l < LANES; ++l)
+            {
+                unsigned row = l * segLength + s;
+                ctx.profile[c * segLength + s][l] = (row < lenV) ? static_cast<TValue>(
+                    batchScheme.table[c * alphSize + ordValue(TAlphabet(seqV[row]))]) : TValue(0);
+            }
+
+    // Initialize the first column.
+    resize(ctx.scoreLoad, segLength);
+    resize(ctx.scoreStore, segLength);
+    resize(ctx.horizontal, segLength);
+    for (unsigned s = 0; s < segLength; ++s)
+    {
+        for (unsigned l = 0; l < LANES; ++l)
+        {
+            unsigned row = _min(l * segLength + s + 1, lenV);
+            ctx.scoreLoad[s][l] = static_cast<TValue>(_stripedBorderScore(batchScheme.gapOpenV,
+                                                                          batchScheme.gapExtendV, row, freeLeft));
+        }
+        ctx.horizontal[s] = ctx.scoreLoad[s] + gapOpenH;
+    }
+
+    unsigned const lastLane = (lenV - 1) / segLength;
+    unsigned const lastSeg = (lenV - 1) % segLength;
+    __int64 best = MinValue<__int64>::VALUE;
+    if (freeBottom)
+        best = _stripedBorderScore((__int64)batchScheme.gapOpenV, (__int64)batchScheme.gapExtendV, lenV, freeLeft);
+
+    TSimdVector maxScore = minusInfVec;
+    TSimdVector minScore = upperVec;
+    TSimdVector * pLoad = &ctx.scoreLoad[0];
+    TSimdVector * pStore = &ctx.scoreStore[0];
+    TSimdVector * pHorizontal = &ctx.horizontal[0];
+
+    for (unsigned j = 1; j <= lenH; ++j)
+    {
+        TSimdVector const * pProfile = &ctx.profile[ordValue(seqH[j - 1]) * segLength];
+        TScoreValue topLeft = _stripedBorderScore(batchScheme.gapOpenH, batchScheme.gapExtendH, j - 1, freeTop);
+        TScoreValue top = _stripedBorderScore(batchScheme.gapOpenH, batchScheme.gapExtendH, j, freeTop);
+
+        TSimdVector vertical = minusInfVec;
+        vertical[0] = static_cast<TValue>(top + batchScheme.gapOpenV);
+        TSimdVector current = _shiftLanesUp(pLoad[segLength - 1], static_cast<TValue>(topLeft));
+
+        for (unsigned s = 0; s < segLength; ++s)
+        {
+            current = current + pProfile[s];
+            current = max(current, pHorizontal[s]);
+            current = max(current, vertical);
+            if (isLocal)
+                current = max(current, zero);
+            maxScore = max(maxScore, current);
+            minScore = min(minScore, current);
+            pStore[s] = current;
+
+            pHorizontal[s] = max(pHorizontal[s] + gapExtendH, current + gapOpenH);
+            vertical = max(vertical + gapExtendV, current + gapOpenV);
+            current = pLoad[s];
+        }
+
+        // Lazy F loop: propagate the vertical gaps across the stripe borders.
+        vertical = _shiftLanesUp(vertical, minusInf);
+        for (unsigned s = 0, wraps = 0; wraps < LANES;)
+        {
+            TSimdVector improved = cmpGt(vertical, pStore[s] + lazyThreshold);
+            if (testAllZeros(improved, improved))
+                break;
+            current = max(pStore[s], vertical);
+            maxScore = max(maxScore, current);
+            pStore[s] = current;
+            pHorizontal[s] = max(pHorizontal[s], current + gapOpenH);
+            vertical = max(vertical + lazyStep, minusInfVec);
+            if (++s == segLength)
+            {
+                s = 0;
+                ++wraps;
+                vertical = _shiftLanesUp(vertical, minusInf);
+            }
+        }
+
+        TSimdVector overflow = cmpGt(maxScore, upperVec) | cmpGt(lowerVec, minScore);
+        if (!testAllZeros(overflow, overflow))
+            return false;
+
+        if (freeBottom || j == lenH)
+            best = _max(best, (__int64)pStore[lastSeg][lastLane]);
+
+        std::swap(pLoad, pStore);
+    }
+
+    if (isLocal)
+    {
+        best = 0;
+        for (unsigned l = 0; l < LANES; ++l)
+            best = _max(best, (__int64)maxScore[l]);
+    }
+    else if (freeRight)
+    {
+        best = _max(best, borderH);
+        for (unsigned i = 0; i < lenV; ++i)
+            best = _max(best, (__int64)pLoad[i % segLength][i / segLength]);
+    }
+
+    result = static_cast<TScoreValue>(best);
+    return true;
+}
+
+template <typename TScoreValue, typename TSimdVector, typename TSequenceH, typename TSequenceV, typename TDPProfile>
+inline bool
+_computeScoreStriped(TScoreValue & result,
+                     TSimdVector const & /*tag*/,
+                     TSequenceH const & seqH,
+                     TSequenceV const & seqV,
+                     DPBatchScoringScheme_<TScoreValue> const & batchScheme,
+                     TDPProfile const & dpProfile)
+{
+    DPStripedContext_<TSimdVector> ctx;
+    return _computeScoreStriped(result, ctx, seqH, seqV, batchScheme, dpProfile);
+}
+
+#endif  // #ifdef SEQAN_SIMD_ENABLED
+
+// ----------------------------------------------------------------------------
+// Function _setUpAndRunAlignmentStriped()
+// ----------------------------------------------------------------------------
+
+template <typename TSequenceH, typename TSequenceV, typename TScoreValue, typename TScoreSpec,
+          typename TDPType, typename TBand, typename TFreeEndGaps, typename TTraceConfig, typename TGapModel>
+inline TScoreValue
+_setUpAndRunAlignmentStriped(TSequenceH const & seqH,
+                             TSequenceV const & seqV,
+                             Score<TScoreValue, TScoreSpec> const & scoringScheme,
+                             AlignConfig2<TDPType, TBand, TFreeEndGaps, TTraceConfig> const & alignConfig,
+                             TGapModel const & gapModel)
+{
+#ifdef SEQAN_SIMD_ENABLED
+    typedef typename Value<TSequenceH>::Type TAlphabetH;
+    typedef typename SetupAlignmentProfile_<TDPType, TFreeEndGaps, TGapModel, TracebackOff>::Type TDPProfile;
+
+    if (ValueSize<TAlphabetH>::VALUE <= 256u && !empty(seqH) && !empty(seqV))
+    {
+        DPBatchScoringScheme_<TScoreValue> batchScheme;
+        _initBatchScoringScheme(batchScheme, scoringScheme, TAlphabetH());
+
+        TScoreValue result = 0;
+        if (_computeScoreStriped(result, typename SimdVector<signed char>::Type(), seqH, seqV, batchScheme,
+                                 TDPProfile()))
+            return result;
+        if (_computeScoreStriped(result, typename SimdVector<short>::Type(), seqH, seqV, batchScheme, TDPProfile()))
+            return result;
+        if (_computeScoreStriped(result, typename SimdVector<int>::Type(), seqH, seqV, batchScheme, TDPProfile()))
+            return result;
+    }
+#endif  // #ifdef SEQAN_SIMD_ENABLED
+
+    DPScoutState_<Default> dpScoutState;
+    String<TraceSegment_<unsigned, unsigned> > traceSegments;  // Dummy segments.
+    return _setUpAndRunAlignment(traceSegments, dpScoutState, seqH, seqV, scoringScheme, alignConfig, gapModel);
+}
+
+}  // namespace seqan
+
+#endif  // #ifndef SEQAN_INCLUDE_SEQAN_ALIGN_DP_ALGORITHM_IMPL_STRIPED_H_
@@ -32,7 +32,7 @@
 // Author: Manuel Holtgrewe <manuel.holtgrewe@fu-berlin.de>
 // ==========================================================================
 // Test for globalAlignmentScore() implementations that use Hirschberg and
-// MyersBitVector, MyersHirschberg.
+// MyersBitVector, MyersHirschberg, Farrar.
 // ==========================================================================
 
 #ifndef SEQAN_INCLUDE_SEQAN_ALIGN_GLOBAL_ALIGNMENT_SPECIALIZED_H_
@@ -194,6 +194,40 @@ int globalAlignmentScore(StringSet<TString, TSpec> const & strings,
     return _globalAlignmentScore(strings[0], strings[1], algorithmTag);
 }
 
+// ----------------------------------------------------------------------------
+// Function globalAlignmentScore()                                     [Farrar]
+// ----------------------------------------------------------------------------
+
+template <typename TSequenceH, typename TSequenceV,
+          typename TScoreValue, typename TScoreSpec,
+          bool TOP, bool LEFT, bool RIGHT, bool BOTTOM, typename TACSpec>
+TScoreValue globalAlignmentScore(TSequenceH const & seqH,
+                                 TSequenceV const & seqV,
+                                 Score<TScoreValue, TScoreSpec> const & scoringScheme,
+                                 AlignConfig<TOP, LEFT, RIGHT, BOTTOM, TACSpec> const & /*alignConfig*/,
+                                 Farrar const & /*algorithmTag*/)
+{
+    typedef AlignConfig<TOP, LEFT, RIGHT, BOTTOM, TACSpec> TAlignConfig;
+    typedef typename SubstituteAlignConfig_<TAlignConfig>::Type TFreeEndGaps;
+    typedef AlignConfig2<DPGlobal, DPBandConfig<BandOff>, TFreeEndGaps, TracebackOff> TAlignConfig2;
+
+    if (_usesAffineGaps(scoringScheme, seqH, seqV))
+        return _setUpAndRunAlignmentStriped(seqH, seqV, scoringScheme, TAlignConfig2(), AffineGaps());
+    else
+        return _setUpAndRunAlignmentStriped(seqH, seqV, scoringScheme, TAlignConfig2(), LinearGaps());
+}
+
+template <typename TSequenceH, typename TSequenceV,
+          typename TScoreValue, typename TScoreSpec>
+TScoreValue globalAlignmentScore(TSequenceH const & seqH,
+                                 TSequenceV const & seqV,
+                                 Score<TScoreValue, TScoreSpec> const & scoringScheme,
+                                 Farrar const & algorithmTag)
+{
+    AlignConfig<> alignConfig;
+    return globalAlignmentScore(seqH, seqV, scoringScheme, alignConfig, algorithmTag);
+}
+
 }  // namespace seqan
 
 #endif  // #ifndef SEQAN_INCLUDE_SEQAN_ALIGN_GLOBAL_ALIGNMENT_SPECIALIZED_H_
@@ -461,10 +461,15 @@ TScoreValue globalAlignment(String<Fragment<TSize, TFragmentSpec>, TStringSpec>
  * @signature TScoreVal globalAlignmentScore(strings,    scoringScheme[, alignConfig][, lowerDiag, upperDiag][, algorithmTag]);
  * @signature TScoreVal globalAlignmentScore(seqH, seqV, {MyersBitVector | MyersHirschberg});
  * @signature TScoreVal globalAlignmentScore(strings,    {MyersBitVector | MyersHirschberg});
+ * @signature TScoreVal globalAlignmentScore(seqH, seqV, scoringScheme[, alignConfig], Farrar());
+ * @signature TScoreString globalAlignmentScore(setH, setV, scoringScheme[, alignConfig][, algorithmTag]);
  *
  * @param[in] seqH          Horizontal gapped sequence in alignment matrix.  Types: String
  * @param[in] seqV          Vertical gapped sequence in alignment matrix.  Types: String
  * @param[in] strings       A @link StringSet @endlink containing two sequences.  Type: StringSet.
+ * @param[in] setH          A @link StringSet @endlink of horizontal sequences.  Type: StringSet.
+ * @param[in] setV          A @link StringSet @endlink of vertical sequences, of the same length as <tt>setH</tt>.
+ *                          Type: StringSet.
  * @param[in] alignConfig   The @link AlignConfig @endlink to use for the alignment.  Type: AlignConfig
  * @param[in] scoringScheme The scoring scheme to use for the alignment.  Note that the user is responsible for ensuring
  *                          that the scoring scheme is compatible with <tt>algorithmTag</tt>.  Type: @link Score @endlink.
@@ -475,11 +480,22 @@ TScoreValue globalAlignment(String<Fragment<TSize, TFragmentSpec>, TStringSpec>
  *
  * @return TScoreVal   Score value of the resulting alignment  (Metafunction: @link Score#Value @endlink of
  *                     the type of <tt>scoringScheme</tt>).
+ * @return TScoreString A <tt>String&lt;TScoreVal&gt;</tt> with the scores of the alignments of <tt>setH[i]</tt> and
+ *                      <tt>setV[i]</tt>.
  *
  * This function does not perform the (linear time) traceback step after the (mostly quadratic time) dynamic programming
  * step.  Note that Myers' bit-vector algorithm does not compute an alignment (only in the Myers-Hirschberg variant) but
  * scores can be computed using <tt>globalAlignmentScore</tt>.
  *
+ * Given two StringSets <tt>setH</tt> and <tt>setV</tt>, the pairs <tt>(setH[i], setV[i])</tt> are aligned
+ * independently of each other.  If SSE4 or AVX2 is enabled (e.g. by compiling with <tt>-msse4</tt> or
+ * <tt>-mavx2</tt>), multiple pairs are aligned at once, one per lane of a SIMD vector.  This is supported for linear
+ * and affine gap costs and alphabets with at most 256 characters, otherwise the pairs are aligned one by one.
+ *
+ * With the @link AlignmentAlgorithmTags#Farrar @endlink tag, the score is computed with Farrar's striped SIMD
+ * algorithm, which is considerably faster for long sequences.  It supports linear and affine gap costs and falls back
+ * to the standard DP algorithm if SIMD instructions are not enabled.
+ *
  * The same limitations to algorithms as in @link globalAlignment @endlink apply.  Furthermore, the
  * <tt>MyersBitVector</tt> and <tt>MyersHirschberg</tt> variants can only be used without any other parameter.
  *
@@ -622,6 +638,73 @@ TScoreValue globalAlignmentScore(StringSet<TString, TSpec> const & strings,
     return globalAlignmentScore(strings[0], strings[1], scoringScheme, alignConfig);
 }
 
+// ----------------------------------------------------------------------------
+// Function globalAlignmentScore()                  [unbanded, 2 StringSets]
+// ----------------------------------------------------------------------------
+
+template <typename TStringH, typename TSpecH,
+          typename TStringV, typename TSpecV,
+          typename TScoreValue, typename TScoreSpec,
+          bool TOP, bool LEFT, bool RIGHT, bool BOTTOM, typename TACSpec,
+          typename TAlgoTag>
+String<TScoreValue> globalAlignmentScore(StringSet<TStringH, TSpecH> const & setH,
+                                         StringSet<TStringV, TSpecV> const & setV,
+                                         Score<TScoreValue, TScoreSpec> const & scoringScheme,
+                                         AlignConfig<TOP, LEFT, RIGHT, BOTTOM, TACSpec> const & /*alignConfig*/,
+                                         TAlgoTag const & /*algoTag*/)
+{
+    typedef AlignConfig<TOP, LEFT, RIGHT, BOTTOM, TACSpec> TAlignConfig;
+    typedef typename SubstituteAlignConfig_<TAlignConfig>::Type TFreeEndGaps;
+    typedef AlignConfig2<DPGlobal, DPBandConfig<BandOff>, TFreeEndGaps, TracebackOff> TAlignConfig2;
+    typedef typename SubstituteAlgoTag_<TAlgoTag>::Type TGapModel;
+
+    String<TScoreValue> scores;
+    _setUpAndRunAlignmentBatch(scores, setH, setV, scoringScheme, TAlignConfig2(), TGapModel());
+    return scores;
+}
+
+// Interface without AlignConfig<>.
+template <typename TStringH, typename TSpecH,
+          typename TStringV, typename TSpecV,
+          typename TScoreValue, typename TScoreSpec,
+          typename TAlgoTag>
+String<TScoreValue> globalAlignmentScore(StringSet<TStringH, TSpecH> const & setH,
+                                         StringSet<TStringV, TSpecV> const & setV,
+                                         Score<TScoreValue, TScoreSpec> const & scoringScheme,
+                                         TAlgoTag const & algoTag)
+{
+    AlignConfig<> alignConfig;
+    return globalAlignmentScore(setH, setV, scoringScheme, alignConfig, algoTag);
+}
+
+// Interface without algorithm tag.
+template <typename TStringH, typename TSpecH,
+          typename TStringV, typename TSpecV,
+          typename TScoreValue, typename TScoreSpec,
+          bool TOP, bool LEFT, bool RIGHT, bool BOTTOM, typename TACSpec>
+String<TScoreValue> globalAlignmentScore(StringSet<TStringH, TSpecH> const & setH,
+                                         StringSet<TStringV, TSpecV> const & setV,
+                                         Score<TScoreValue, TScoreSpec> const & scoringScheme,
+                                         AlignConfig<TOP, LEFT, RIGHT, BOTTOM, TACSpec> const & alignConfig)
+{
+    if (scoreGapOpen(scoringScheme) == scoreGapExtend(scoringScheme))
+        return globalAlignmentScore(setH, setV, scoringScheme, alignConfig, NeedlemanWunsch());
+    else
+        return globalAlignmentScore(setH, setV, scoringScheme, alignConfig, Gotoh());
+}
+
+// Interface without AlignConfig<> and algorithm tag.
+template <typename TStringH, typename TSpecH,
+          typename TStringV, typename TSpecV,
+          typename TScoreValue, typename TScoreSpec>
+String<TScoreValue> globalAlignmentScore(StringSet<TStringH, TSpecH> const & setH,
+                                         StringSet<TStringV, TSpecV> const & setV,
+                                         Score<TScoreValue, TScoreSpec> const & scoringScheme)
+{
+    AlignConfig<> alignConfig;
+    return globalAlignmentScore(setH, setV, scoringScheme, alignConfig);
+}
+
 }  // namespace seqan
 
 #endif  // #ifndef SEQAN_INCLUDE_SEQAN_ALIGN_GLOBAL_ALIGNMENT_UNBANDED_H_
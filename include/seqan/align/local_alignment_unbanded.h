@@ -312,6 +312,125 @@ TScoreValue localAlignment(String<Fragment<TSize, TFragmentSpec>, TStringSpec> &
         return localAlignment(fragmentString, strings, scoringScheme, LinearGaps());
 }
 
+// ----------------------------------------------------------------------------
+// Function localAlignmentScore()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn localAlignmentScore
+ * @headerfile <seqan/align.h>
+ * @brief Computes the best pairwise local alignment score.
+ *
+ * @signature TScoreVal    localAlignmentScore(seqH, seqV, scoringScheme[, algorithmTag]);
+ * @signature TScoreVal    localAlignmentScore(seqH, seqV, scoringScheme, Farrar());
+ * @signature TScoreString localAlignmentScore(setH, setV, scoringScheme[, algorithmTag]);
+ *
+ * @param[in] seqH          Horizontal sequence in alignment matrix.  Types: String
+ * @param[in] seqV          Vertical sequence in alignment matrix.  Types: String
+ * @param[in] setH          A @link StringSet @endlink of horizontal sequences.  Type: StringSet.
+ * @param[in] setV          A @link StringSet @endlink of vertical sequences, of the same length as <tt>setH</tt>.
+ *                          Type: StringSet.
+ * @param[in] scoringScheme The @link Score scoring scheme @endlink to use for the alignment.
+ * @param[in] algorithmTag  The Tag for picking the alignment algorithm. Types: @link PairwiseLocalAlignmentAlgorithms
+ *                          @endlink.
+ *
+ * @return TScoreVal    Score value of the resulting alignment  (Metafunction: @link Score#Value @endlink of
+ *                      the type of <tt>scoringScheme</tt>).
+ * @return TScoreString A <tt>String&lt;TScoreVal&gt;</tt> with the scores of the alignments of <tt>setH[i]</tt> and
+ *                      <tt>setV[i]</tt>.
+ *
+ * This function does not perform the (linear time) traceback step after the (mostly quadratic time) dynamic programming
+ * step.
+ *
+ * With the @link AlignmentAlgorithmTags#Farrar @endlink tag, the score is computed with Farrar's striped SIMD
+ * algorithm, which is considerably faster for long sequences.  It falls back to the standard DP algorithm if SIMD
+ * instructions are not enabled.
+ *
+ * Given two StringSets <tt>setH</tt> and <tt>setV</tt>, the pairs <tt>(setH[i], setV[i])</tt> are aligned
+ * independently of each other.  If SSE4 or AVX2 is enabled (e.g. by compiling with <tt>-msse4</tt> or
+ * <tt>-mavx2</tt>), multiple pairs are aligned at once, one per lane of a SIMD vector.  This is supported for linear
+ * and affine gap costs and alphabets with at most 256 characters, otherwise the pairs are aligned one by one.
+ *
+ * @see localAlignment
+ * @see globalAlignmentScore
+ */
+
+// ----------------------------------------------------------------------------
+// Function localAlignmentScore()                         [unbanded, 2 Strings]
+// ----------------------------------------------------------------------------
+
+template <typename TSequenceH, typename TSequenceV, typename TScoreValue, typename TScoreSpec, typename TTag>
+TScoreValue localAlignmentScore(TSequenceH const & seqH,
+                                TSequenceV const & seqV,
+                                Score<TScoreValue, TScoreSpec> const & scoringScheme,
+                                TTag const & tag)
+{
+    typedef AlignConfig2<DPLocal, DPBandConfig<BandOff>, FreeEndGaps_<>, TracebackOff> TAlignConfig2;
+
+    DPScoutState_<Default> dpScoutState;
+    String<TraceSegment_<unsigned, unsigned> > traceSegments;  // Dummy segments.
+    return _setUpAndRunAlignment(traceSegments, dpScoutState, seqH, seqV, scoringScheme, TAlignConfig2(), tag);
+}
+
+template <typename TSequenceH, typename TSequenceV, typename TScoreValue, typename TScoreSpec>
+TScoreValue localAlignmentScore(TSequenceH const & seqH,
+                                TSequenceV const & seqV,
+                                Score<TScoreValue, TScoreSpec> const & scoringScheme)
+{
+    if (_usesAffineGaps(scoringScheme, seqH, seqV))
+        return localAlignmentScore(seqH, seqV, scoringScheme, AffineGaps());
+    else
+        return localAlignmentScore(seqH, seqV, scoringScheme, LinearGaps());
+}
+
+// ----------------------------------------------------------------------------
+// Function localAlignmentScore()                                      [Farrar]
+// ----------------------------------------------------------------------------
+
+template <typename TSequenceH, typename TSequenceV, typename TScoreValue, typename TScoreSpec>
+TScoreValue localAlignmentScore(TSequenceH const & seqH,
+                                TSequenceV const & seqV,
+                                Score<TScoreValue, TScoreSpec> const & scoringScheme,
+                                Farrar const & /*algorithmTag*/)
+{
+    typedef AlignConfig2<DPLocal, DPBandConfig<BandOff>, FreeEndGaps_<>, TracebackOff> TAlignConfig2;
+
+    if (_usesAffineGaps(scoringScheme, seqH, seqV))
+        return _setUpAndRunAlignmentStriped(seqH, seqV, scoringScheme, TAlignConfig2(), AffineGaps());
+    else
+        return _setUpAndRunAlignmentStriped(seqH, seqV, scoringScheme, TAlignConfig2(), LinearGaps());
+}
+
+// ----------------------------------------------------------------------------
+// Function localAlignmentScore()                      [unbanded, 2 StringSets]
+// ----------------------------------------------------------------------------
+
+template <typename TStringH, typename TSpecH, typename TStringV, typename TSpecV,
+          typename TScoreValue, typename TScoreSpec, typename TTag>
+String<TScoreValue> localAlignmentScore(StringSet<TStringH, TSpecH> const & setH,
+                                        StringSet<TStringV, TSpecV> const & setV,
+                                        Score<TScoreValue, TScoreSpec> const & scoringScheme,
+                                        TTag const & tag)
+{
+    typedef AlignConfig2<DPLocal, DPBandConfig<BandOff>, FreeEndGaps_<>, TracebackOff> TAlignConfig2;
+
+    String<TScoreValue> scores;
+    _setUpAndRunAlignmentBatch(scores, setH, setV, scoringScheme, TAlignConfig2(), tag);
+    return scores;
+}
+
+template <typename TStringH, typename TSpecH, typename TStringV, typename TSpecV,
+          typename TScoreValue, typename TScoreSpec>
+String<TScoreValue> localAlignmentScore(StringSet<TStringH, TSpecH> const & setH,
+                                        StringSet<TStringV, TSpecV> const & setV,
+                                        Score<TScoreValue, TScoreSpec> const & scoringScheme)
+{
+    String<TScoreValue> scores;
+    _setUpAndRunAlignmentBatch(scores, setH, setV, scoringScheme,
+                               AlignConfig2<DPLocal, DPBandConfig<BandOff>, FreeEndGaps_<>, TracebackOff>());
+    return scores;
+}
+
 }  // namespace seqan
 
 #endif  // #ifndef SEQAN_INCLUDE_SEQAN_ALIGN_LOCAL_ALIGNMENT_UNBANDED_H_
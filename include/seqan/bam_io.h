@@ -74,6 +74,7 @@
 // ===========================================================================
 
 #include <seqan/bam_io/bam_file.h>
+#include <seqan/bam_io/bam_alignment_record_view.h>
 
 // ===========================================================================
 // Utility Routines.
@@ -93,4 +94,13 @@
 #include <seqan/bam_io/bam_index_bai.h>
 #endif  // #if SEQAN_HAS_ZLIB
 
+// ===========================================================================
+// BAM Sorting.
+// ===========================================================================
+
+// Sorting spills runs into temporary BAM files and requires ZLIB.
+#if SEQAN_HAS_ZLIB
+#include <seqan/bam_io/bam_sort.h>
+#endif  // #if SEQAN_HAS_ZLIB
+
 #endif  // INCLUDE_SEQAN_BAM_IO_H_
@@ -0,0 +1,660 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2015, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// A lightweight view on a raw BAM record that decodes fields on access.
+// ==========================================================================
+
+#ifndef INCLUDE_SEQAN_BAM_IO_BAM_ALIGNMENT_RECORD_VIEW_H_
+#define INCLUDE_SEQAN_BAM_IO_BAM_ALIGNMENT_RECORD_VIEW_H_
+
+namespace seqan {
+
+// ============================================================================
+// Forwards
+// ============================================================================
+
+class BamAlignmentRecordView;
+inline void clear(BamAlignmentRecordView & view);
+
+// ============================================================================
+// Tags, Classes, Enums
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Class BamAlignmentRecordView
+// ----------------------------------------------------------------------------
+
+/*!
+ * @class BamAlignmentRecordView
+ * @headerfile <seqan/bam_io.h>
+ * @signature class BamAlignmentRecordView;
+ * @brief A view on a raw BAM record that decodes the variable-length fields only on access.
+ *
+ * The fixed-size fields <tt>rID</tt>, <tt>beginPos</tt>, <tt>mapQ</tt>, <tt>bin</tt>, <tt>flag</tt>,
+ * <tt>rNextId</tt>, <tt>pNext</tt>, and <tt>tLen</tt> are directly accessible as in @link BamAlignmentRecord
+ * @endlink and the <tt>hasFlag*()</tt> functions can be used as well.  Read name, CIGAR string, sequence,
+ * qualities, and tags are not decoded or copied when reading the view but can be obtained with
+ * @link BamAlignmentRecordView#getQName @endlink, @link BamAlignmentRecordView#getCigar @endlink,
+ * @link BamAlignmentRecordView#getSeq @endlink, @link BamAlignmentRecordView#getQual @endlink, and
+ * @link BamAlignmentRecordView#getTags @endlink.  This makes filtering and counting of BAM records considerably
+ * cheaper than reading full @link BamAlignmentRecord BamAlignmentRecords @endlink.
+ *
+ * When reading from a BAM file, the view points into the decompressed buffer of the file (unless the record spans
+ * the border of two buffer chunks, in that case it is copied).  The view is valid until the next operation on the
+ * file, including @link FormattedFile#atEnd @endlink.  When reading from a SAM file, the record is parsed and
+ * converted into the BAM representation.
+ *
+ * @section Examples
+ *
+ * @code{.cpp}
+ * BamFileIn bamFileIn("example.bam");
+ * BamHeader header;
+ * readHeader(header, bamFileIn);
+ *
+ * BamAlignmentRecordView view;
+ * while (!atEnd(bamFileIn))
+ * {
+ *     readRecord(view, bamFileIn);
+ *     if (hasFlagUnmapped(view) || view.mapQ < 20)
+ *         continue;
+ *     std::cout << getQName(view) << '\t' << getAlignmentLengthInRef(view) << '\n';
+ * }
+ * @endcode
+ *
+ * @see BamAlignmentRecord
+ */
+
+class BamAlignmentRecordView : public BamAlignmentRecordCore
+{
+public:
+    char const * _data;         // raw record behind the core: read name, cigar, seq, qual, and tags
+    __uint32 _dataSize;
+    CharString _buffer;         // owns the raw record if it cannot be referenced in place
+    BamAlignmentRecord _record; // used to convert SAM records
+
+    BamAlignmentRecordView() : _data(NULL), _dataSize(0)
+    {
+        clear(*this);
+    }
+
+    BamAlignmentRecordView(BamAlignmentRecordView const & other) :
+        BamAlignmentRecordCore(other), _data(other._data), _dataSize(other._dataSize), _buffer(other._buffer)
+    {
+        // A copy of a view referencing its own buffer must reference the copied buffer.
+        if (!empty(_buffer))
+            _data = begin(_buffer, Standard()) + sizeof(BamAlignmentRecordCore);
+    }
+
+    BamAlignmentRecordView & operator=(BamAlignmentRecordView const & other)
+    {
+        if (this == &other)
+            return *this;
+        static_cast<BamAlignmentRecordCore &>(*this) = other;
+        _data = other._data;
+        _dataSize = other._dataSize;
+        _buffer = other._buffer;
+        if (!empty(_buffer))
+            _data = begin(_buffer, Standard()) + sizeof(BamAlignmentRecordCore);
+        return *this;
+    }
+};
+
+// ============================================================================
+// Functions
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Function clear()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn BamAlignmentRecordView#clear
+ * @brief Clear BamAlignmentRecordView.
+ *
+ * @signature void clear(view);
+ *
+ * @param[in,out] view The BamAlignmentRecordView to clear.
+ */
+
+inline void
+clear(BamAlignmentRecordView & view)
+{
+    view.rID = BamAlignmentRecord::INVALID_REFID;
+    view.beginPos = BamAlignmentRecord::INVALID_POS;
+    view._l_qname = 1;
+    view.mapQ = 255;
+    view.bin = 0;
+    view._n_cigar = 0;
+    view.flag = 0;
+    view._l_qseq = 0;
+    view.rNextId = BamAlignmentRecord::INVALID_REFID;
+    view.pNext = BamAlignmentRecord::INVALID_POS;
+    view.tLen = BamAlignmentRecord::INVALID_LEN;
+    clear(view._buffer);
+    resize(view._buffer, sizeof(BamAlignmentRecordCore) + 1, '\0');
+    view._data = begin(view._buffer, Standard()) + sizeof(BamAlignmentRecordCore);
+    view._dataSize = 1;
+}
+
+// ----------------------------------------------------------------------------
+// Function _bamViewCigarBegin()                      BamAlignmentRecordView
+// ----------------------------------------------------------------------------
+
+// Offsets of the variable-length fields in the raw record.
+
+inline char const *
+_bamViewCigarBegin(BamAlignmentRecordView const & view)
+{
+    return view._data + view._l_qname;
+}
+
+inline char const *
+_bamViewSeqBegin(BamAlignmentRecordView const & view)
+{
+    return _bamViewCigarBegin(view) + view._n_cigar * 4;
+}
+
+inline char const *
+_bamViewQualBegin(BamAlignmentRecordView const & view)
+{
+    return _bamViewSeqBegin(view) + (view._l_qseq + 1) / 2;
+}
+
+inline char const *
+_bamViewTagsBegin(BamAlignmentRecordView const & view)
+{
+    return _bamViewQualBegin(view) + view._l_qseq;
+}
+
+// ----------------------------------------------------------------------------
+// Function getQName()                                BamAlignmentRecordView
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn BamAlignmentRecordView#getQName
+ * @brief Return the query name of a BamAlignmentRecordView without copying it.
+ *
+ * @signature TRange getQName(view);
+ *
+ * @param[in] view The BamAlignmentRecordView to query.
+ *
+ * @return TRange The query name, a @link Range @endlink of <tt>char const *</tt>.
+ */
+
+inline Range<char const *>
+getQName(BamAlignmentRecordView const & view)
+{
+    return Range<char const *>(view._data, view._data + view._l_qname - 1);
+}
+
+// ----------------------------------------------------------------------------
+// Function getCigar()                                BamAlignmentRecordView
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn BamAlignmentRecordView#getCigar
+ * @brief Decode the CIGAR string of a BamAlignmentRecordView.
+ *
+ * @signature void getCigar(cigar, view);
+ *
+ * @param[out] cigar The resulting CIGAR string.  Type: <tt>String&lt;CigarElement&lt;&gt; &gt;</tt>.
+ * @param[in]  view  The BamAlignmentRecordView to query.
+ */
+
+template <typename TCigarString>
+inline void
+getCigar(TCigarString & cigar, BamAlignmentRecordView const & view)
+{
+    typedef typename Iterator<TCigarString, Standard>::Type SEQAN_RESTRICT TCigarIter;
+
+    static char const * CIGAR_MAPPING = "MIDNSHP=X*******";
+
+    resize(cigar, view._n_cigar, Exact());
+    char const * it = _bamViewCigarBegin(view);
+    TCigarIter cigEnd = end(cigar, Standard());
+    for (TCigarIter cig = begin(cigar, Standard()); cig != cigEnd; ++cig)
+    {
+        __uint32 opAndCnt;
+        std::memcpy(&opAndCnt, it, sizeof(__uint32));
+        it += sizeof(__uint32);
+        cig->operation = CIGAR_MAPPING[opAndCnt & 15];
+        cig->count = opAndCnt >> 4;
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Function getAlignmentLengthInRef()                 BamAlignmentRecordView
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn BamAlignmentRecordView#getAlignmentLengthInRef
+ * @brief Return the alignment length in the view's projection in the reference.
+ *
+ * @signature unsigned getAlignmentLengthInRef(view);
+ *
+ * @param[in] view The BamAlignmentRecordView to compute length for.
+ *
+ * @return unsigned The alignment length, computed without decoding the CIGAR string.
+ */
+
+inline unsigned
+getAlignmentLengthInRef(BamAlignmentRecordView const & view)
+{
+    // Same as _getLengthInRef(): count all operations except S, H, and I.
+    char const * it = _bamViewCigarBegin(view);
+    unsigned l = 0;
+    for (unsigned i = 0; i < view._n_cigar; ++i)
+    {
+        __uint32 opAndCnt;
+        std::memcpy(&opAndCnt, it, sizeof(__uint32));
+        it += sizeof(__uint32);
+        if (((1u << (opAndCnt & 15)) & 0x32) == 0)
+            l += opAndCnt >> 4;
+    }
+    return l;
+}
+
+// ----------------------------------------------------------------------------
+// Function getSeq()                                  BamAlignmentRecordView
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn BamAlignmentRecordView#getSeq
+ * @brief Decode the sequence of a BamAlignmentRecordView.
+ *
+ * @signature void getSeq(seq, view);
+ *
+ * @param[out] seq  The resulting sequence, e.g. an @link IupacString @endlink or @link Dna5String @endlink.
+ * @param[in]  view The BamAlignmentRecordView to query.
+ */
+
+template <typename TSeqString>
+inline void
+getSeq(TSeqString & seq, BamAlignmentRecordView const & view)
+{
+    typedef typename Iterator<TSeqString, Standard>::Type SEQAN_RESTRICT TSeqIter;
+
+    resize(seq, view._l_qseq, Exact());
+    unsigned char const * it = reinterpret_cast<unsigned char const *>(_bamViewSeqBegin(view));
+    TSeqIter sit = begin(seq, Standard());
+    TSeqIter sitEnd = sit + (view._l_qseq & ~1);
+    while (sit != sitEnd)
+    {
+        unsigned char ui = *it++;
+        assignValue(sit, Iupac(ui >> 4));
+        ++sit;
+        assignValue(sit, Iupac(ui & 0x0f));
+        ++sit;
+    }
+    if (view._l_qseq & 1)
+        assignValue(sit, Iupac(*it >> 4));
+}
+
+// ----------------------------------------------------------------------------
+// Function getQual()                                 BamAlignmentRecordView
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn BamAlignmentRecordView#getQual
+ * @brief Decode the PHRED qualities of a BamAlignmentRecordView (as in SAM).
+ *
+ * @signature void getQual(qual, view);
+ *
+ * @param[out] qual The resulting quality string, empty for '*'.  Type: @link CharString @endlink.
+ * @param[in]  view The BamAlignmentRecordView to query.
+ */
+
+template <typename TQualString>
+inline void
+getQual(TQualString & qual, BamAlignmentRecordView const & view)
+{
+    typedef typename Iterator<TQualString, Standard>::Type SEQAN_RESTRICT TQualIter;
+
+    char const * it = _bamViewQualBegin(view);
+
+    // Same heuristic as samtools: qualities starting with 0xff represent '*'.
+    if (view._l_qseq == 0 || *it == '\xff')
+    {
+        clear(qual);
+        return;
+    }
+
+    resize(qual, view._l_qseq, Exact());
+    TQualIter qitEnd = end(qual, Standard());
+    for (TQualIter qit = begin(qual, Standard()); qit != qitEnd;)
+        *qit++ = '!' + *it++;
+}
+
+// ----------------------------------------------------------------------------
+// Function getTags()                                 BamAlignmentRecordView
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn BamAlignmentRecordView#getTags
+ * @brief Return the raw BAM tags of a BamAlignmentRecordView without copying them.
+ *
+ * @signature TRange getTags(view);
+ *
+ * @param[in] view The BamAlignmentRecordView to query.
+ *
+ * @return TRange The raw tags, a @link Range @endlink of <tt>char const *</tt>.  Assign it to a @link CharString
+ *                @endlink to use it with @link BamTagsDict @endlink.
+ */
+
+inline Range<char const *>
+getTags(BamAlignmentRecordView const & view)
+{
+    return Range<char const *>(_bamViewTagsBegin(view), view._data + view._dataSize);
+}
+
+// ----------------------------------------------------------------------------
+// Function assign()                                  BamAlignmentRecordView
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn BamAlignmentRecordView#assign
+ * @brief Decode all fields of a BamAlignmentRecordView into a BamAlignmentRecord.
+ *
+ * @signature void assign(record, view);
+ *
+ * @param[out] record The resulting @link BamAlignmentRecord @endlink.
+ * @param[in]  view   The BamAlignmentRecordView to decode.
+ */
+
+inline void
+assign(BamAlignmentRecord & record, BamAlignmentRecordView const & view)
+{
+    static_cast<BamAlignmentRecordCore &>(record) = view;
+    assign(record.qName, getQName(view));
+    getCigar(record.cigar, view);
+    getSeq(record.seq, view);
+    getQual(record.qual, view);
+    assign(record.tags, getTags(view));
+}
+
+inline void
+assign(BamAlignmentRecord & record, BamAlignmentRecordView & view)
+{
+    assign(record, static_cast<BamAlignmentRecordView const &>(view));
+}
+
+// ----------------------------------------------------------------------------
+// Function _assignRawRecord()                        BamAlignmentRecordView
+// ----------------------------------------------------------------------------
+
+// Let the view point to a raw BAM record (without the leading size), translate the reference ids.
+
+template <typename TNameStore, typename TNameStoreCache, typename TStorageSpec>
+inline void
+_assignRawRecord(BamAlignmentRecordView & view,
+                 char const * rawRecord,
+                 __int32 recordLen,
+                 BamIOContext<TNameStore, TNameStoreCache, TStorageSpec> & context)
+{
+    if (SEQAN_UNLIKELY(recordLen < (__int32)sizeof(BamAlignmentRecordCore)))
+        SEQAN_THROW(ParseError("BAM record is too short."));
+
+    std::memcpy(static_cast<BamAlignmentRecordCore *>(&view), rawRecord, sizeof(BamAlignmentRecordCore));
+    view._data = rawRecord + sizeof(BamAlignmentRecordCore);
+    view._dataSize = recordLen - sizeof(BamAlignmentRecordCore);
+
+    if (SEQAN_UNLIKELY(view._l_qseq < 0))
+        SEQAN_THROW(ParseError("BAM record has negative sequence length."));
+    __uint64 requiredSize = (__uint64)view._l_qname + (__uint64)view._n_cigar * 4 +
+                            ((__uint64)view._l_qseq + 1) / 2 + (__uint64)view._l_qseq;
+    if (SEQAN_UNLIKELY((__uint64)view._dataSize < requiredSize))
+        SEQAN_THROW(ParseError("BAM record is too short."));
+
+    // Translate file local rID into a global rID that is compatible with the context contigNames.
+    if (view.rID >= 0 && !empty(context.translateFile2GlobalRefId))
+        view.rID = context.translateFile2GlobalRefId[view.rID];
+    if (view.rNextId >= 0 && !empty(context.translateFile2GlobalRefId))
+        view.rNextId = context.translateFile2GlobalRefId[view.rNextId];
+}
+
+// ----------------------------------------------------------------------------
+// Function _readBamRecordView()
+// ----------------------------------------------------------------------------
+
+// Generic case: copy the record into the view's buffer.
+template <typename TForwardIter, typename TIChunk>
+inline char const *
+_readBamRecordView(BamAlignmentRecordView & view, TForwardIter & iter, __int32 recordLen, TIChunk)
+{
+    resize(view._buffer, recordLen, Exact());
+    char * ptr = begin(view._buffer, Standard());
+    write(ptr, iter, (size_t)recordLen);
+    return begin(view._buffer, Standard());
+}
+
+// Chunked input: reference the record in the current chunk if it is contained completely.
+template <typename TForwardIter, typename TIValue>
+inline char const *
+_readBamRecordView(BamAlignmentRecordView & view, TForwardIter & iter, __int32 recordLen, Range<TIValue *> *)
+{
+    Range<TIValue *> ichunk;
+    getChunk(ichunk, iter, Input());
+    if (length(ichunk) == 0u)
+    {
+        reserveChunk(iter, recordLen, Input());
+        getChunk(ichunk, iter, Input());
+    }
+
+    if (SEQAN_LIKELY((__int32)length(ichunk) >= recordLen))
+    {
+        char const * rawRecord = ichunk.begin;
+        iter += recordLen;
+        clear(view._buffer);
+        return rawRecord;
+    }
+
+    typedef Nothing * TNoChunking;
+    return _readBamRecordView(view, iter, recordLen, TNoChunking());
+}
+
+// ----------------------------------------------------------------------------
+// Function readRecord()                              BamAlignmentRecordView
+// ----------------------------------------------------------------------------
+
+template <typename TForwardIter, typename TNameStore, typename TNameStoreCache, typename TStorageSpec>
+inline void
+readRecord(BamAlignmentRecordView & view,
+           BamIOContext<TNameStore, TNameStoreCache, TStorageSpec> & context,
+           TForwardIter & iter,
+           Bam const & /* tag */)
+{
+    __int32 recordLen = 0;
+    readRawPod(recordLen, iter);
+
+    // fail, if we read "BAM\1" (did you miss to call readRecord(header, bamFile) first?)
+    if (recordLen == 0x014D4142)
+        SEQAN_THROW(ParseError("Unexpected BAM header encountered."));
+
+    char const * rawRecord = _readBamRecordView(view, iter, recordLen,
+                                                static_cast<typename Chunk<TForwardIter>::Type *>(NULL));
+    _assignRawRecord(view, rawRecord, recordLen, context);
+}
+
+template <typename TForwardIter, typename TNameStore, typename TNameStoreCache, typename TStorageSpec>
+inline void
+readRecord(BamAlignmentRecordView & view,
+           BamIOContext<TNameStore, TNameStoreCache, TStorageSpec> & context,
+           TForwardIter & iter,
+           Sam const & tag)
+{
+    // Parse the SAM record and convert it into the BAM representation.
+    readRecord(view._record, context, iter, tag);
+    __uint32 recordLen = updateLengths(view._record);
+    clear(view._buffer);
+    reserve(view._buffer, recordLen, Exact());
+    _writeBamRecord(view._buffer, view._record, Bam());
+
+    std::memcpy(static_cast<BamAlignmentRecordCore *>(&view), &view._record, sizeof(BamAlignmentRecordCore));
+    view._data = begin(view._buffer, Standard()) + sizeof(BamAlignmentRecordCore);
+    view._dataSize = recordLen - sizeof(BamAlignmentRecordCore);
+}
+
+// support for dynamically chosen file formats
+template <typename TForwardIter, typename TNameStore, typename TNameStoreCache, typename TStorageSpec>
+inline void
+readRecord(BamAlignmentRecordView & /* view */,
+           BamIOContext<TNameStore, TNameStoreCache, TStorageSpec> & /* context */,
+           TForwardIter & /* iter */,
+           TagSelector<> const & /* format */)
+{
+    SEQAN_FAIL("BamFileIn: File format not specified.");
+}
+
+template <typename TForwardIter, typename TNameStore, typename TNameStoreCache, typename TStorageSpec, typename TTagList>
+inline void
+readRecord(BamAlignmentRecordView & view,
+           BamIOContext<TNameStore, TNameStoreCache, TStorageSpec> & context,
+           TForwardIter & iter,
+           TagSelector<TTagList> const & format)
+{
+    typedef typename TTagList::Type TFormat;
+
+    if (isEqual(format, TFormat()))
+        readRecord(view, context, iter, TFormat());
+    else
+        readRecord(view, context, iter, static_cast<typename TagSelector<TTagList>::Base const &>(format));
+}
+
+/*!
+ * @fn BamAlignmentRecordView#readRecord
+ * @brief Read the next record of a @link BamFileIn @endlink into a BamAlignmentRecordView.
+ *
+ * @signature void readRecord(view, bamFileIn);
+ *
+ * @param[out]    view      The BamAlignmentRecordView to read into.
+ * @param[in,out] bamFileIn The @link BamFileIn @endlink to read from.
+ *
+ * @throw IOError On low-level I/O errors.
+ * @throw ParseError On high-level file format errors.
+ */
+
+template <typename TSpec>
+inline void
+readRecord(BamAlignmentRecordView & view, FormattedFile<Bam, Input, TSpec> & file)
+{
+    readRecord(view, context(file), file.iter, file.format);
+}
+
+// ----------------------------------------------------------------------------
+// Function writeRecord()                             BamAlignmentRecordView
+// ----------------------------------------------------------------------------
+
+template <typename TTarget, typename TNameStore, typename TNameStoreCache, typename TStorageSpec>
+inline void
+write(TTarget & target,
+      BamAlignmentRecordView const & view,
+      BamIOContext<TNameStore, TNameStoreCache, TStorageSpec> & context,
+      Bam const & /* tag */)
+{
+    SEQAN_ASSERT_LT_MSG(view.rID, static_cast<__int32>(length(contigNames(context))), "BAM IO Assertion: Unknown REF ID!");
+    SEQAN_ASSERT_LT_MSG(view.rNextId, static_cast<__int32>(length(contigNames(context))), "BAM IO Assertion: Unknown NEXT REF ID!");
+    ignoreUnusedVariableWarning(context);
+
+    // The raw record is written as is, only the core is taken from the view.
+    view.bin = _reg2Bin(view.beginPos, view.beginPos + std::max(1u, getAlignmentLengthInRef(view)));
+    __uint32 size = sizeof(BamAlignmentRecordCore) + view._dataSize;
+
+    // Reserve chunk memory (keeps records within a BGZF block, same as for BamAlignmentRecords)
+    reserveChunk(target, 4 + size, Output());
+
+    appendRawPod(target, size);
+    appendRawPod(target, static_cast<BamAlignmentRecordCore const &>(view));
+    Range<char const *> rawData(view._data, view._data + view._dataSize);
+    write(target, rawData);
+}
+
+template <typename TTarget, typename TNameStore, typename TNameStoreCache, typename TStorageSpec>
+inline void
+write(TTarget & target,
+      BamAlignmentRecordView const & view,
+      BamIOContext<TNameStore, TNameStoreCache, TStorageSpec> & context,
+      Sam const & tag)
+{
+    BamAlignmentRecord record;
+    assign(record, view);
+    write(target, record, context, tag);
+}
+
+// support for dynamically chosen file formats
+template <typename TTarget, typename TNameStore, typename TNameStoreCache, typename TStorageSpec>
+inline void
+write(TTarget & /* target */,
+      BamAlignmentRecordView const & /* view */,
+      BamIOContext<TNameStore, TNameStoreCache, TStorageSpec> & /* context */,
+      TagSelector<> const & /* format */)
+{
+    SEQAN_FAIL("BamFileOut: File format not specified.");
+}
+
+template <typename TTarget, typename TNameStore, typename TNameStoreCache, typename TStorageSpec, typename TTagList>
+inline void
+write(TTarget & target,
+      BamAlignmentRecordView const & view,
+      BamIOContext<TNameStore, TNameStoreCache, TStorageSpec> & context,
+      TagSelector<TTagList> const & format)
+{
+    typedef typename TTagList::Type TFormat;
+
+    if (isEqual(format, TFormat()))
+        write(target, view, context, TFormat());
+    else
+        write(target, view, context, static_cast<typename TagSelector<TTagList>::Base const &>(format));
+}
+
+/*!
+ * @fn BamAlignmentRecordView#writeRecord
+ * @brief Write a BamAlignmentRecordView to a @link BamFileOut @endlink.
+ *
+ * @signature void writeRecord(bamFileOut, view);
+ *
+ * @param[in,out] bamFileOut The @link BamFileOut @endlink to write to.
+ * @param[in]     view       The BamAlignmentRecordView to write.
+ *
+ * BAM records are copied without decoding them.
+ *
+ * @throw IOError On low-level I/O errors.
+ */
+
+template <typename TSpec>
+inline void
+writeRecord(FormattedFile<Bam, Output, TSpec> & file, BamAlignmentRecordView const & view)
+{
+    write(file.iter, view, context(file), file.format);
+}
+
+}  // namespace seqan
+
+#endif  // #ifndef INCLUDE_SEQAN_BAM_IO_BAM_ALIGNMENT_RECORD_VIEW_H_
@@ -106,6 +106,52 @@ struct BaiBamIndexBinData_
     String<Pair<__uint64, __uint64> > chunkBegEnds;
 };
 
+// ----------------------------------------------------------------------------
+// Helper Class BaiBuildRecordInfo_
+// ----------------------------------------------------------------------------
+
+// The information of one alignment record that is required for indexing.  It is extracted from the raw records on
+// the worker threads of build() and then fed in file order into _baiBuildPush().
+
+struct BaiBuildRecordInfo_
+{
+    __int32  rID;
+    __int32  beginPos;
+    __int32  endPos;
+    bool     isMapped;
+    __uint64 beginOffset;   // Virtual offset of the record.
+    __uint64 endOffset;     // Virtual offset behind the record.
+};
+
+// ----------------------------------------------------------------------------
+// Helper Class BaiBuildState_
+// ----------------------------------------------------------------------------
+
+// Book keeping of the sequential binning step of build(), mirrors hts_idx_push() of samtools.
+
+struct BaiBuildState_
+{
+    enum { INVALID_BIN = 0xffffffffu };
+
+    __int32  lastRefId;
+    __int32  lastPos;
+    __uint32 lastBin;
+    __int32  saveRefId;
+    __uint32 saveBin;
+    __uint64 saveOffset;
+    __uint64 lastOffset;
+    __uint64 metaBegOffset;
+    __uint64 numMapped;
+    __uint64 numUnmapped;
+
+    explicit
+    BaiBuildState_(__uint64 offset) :
+        lastRefId(BamAlignmentRecord::INVALID_REFID), lastPos(0), lastBin(INVALID_BIN),
+        saveRefId(BamAlignmentRecord::INVALID_REFID), saveBin(INVALID_BIN), saveOffset(offset), lastOffset(offset),
+        metaBegOffset(offset), numMapped(0), numUnmapped(0)
+    {}
+};
+
 // ----------------------------------------------------------------------------
 // Spec BAI BamIndex
 // ----------------------------------------------------------------------------
@@ -142,6 +188,8 @@ public:
 
     // 1<<14 is the size of the minimum bin.
     static const __int32 BAM_LIDX_SHIFT = 14;
+    // Number of regular bins, the pseudo-bin BAM_META_BIN stores the meta data of a reference.
+    enum { BAM_MAX_BIN = 37449, BAM_META_BIN = 37450 };
 
     String<TBinIndex_> _binIndices;
     String<TLinearIndex_> _linearIndices;
@@ -166,6 +214,7 @@ public:
  * jumps to the first alignment in this region, if any.
  *
  * @signature bool jumpToRegion(bamFileIn, hasAlignments, refID, pos, posEnd, index);
+ * @signature bool jumpToRegion(bamFileIn, regions, index, func[, numThreads]);
  *
  * @param[in,out] bamFileIn     The @link BamFileIn @endlink to jump with.
  * @param[out]    hasAlignments A <tt>bool</tt> that is set true if the region <tt>[pos, posEnd)</tt> has any
@@ -174,12 +223,25 @@ public:
  * @param[in]     pos           The begin of the region to jump to (<tt>__int32</tt>).
  * @param[in]     posEnd        The end of the region to jump to (<tt>__int32</tt>).
  * @param[in]     index         The @link BamIndex @endlink to use for the jumping.
+ * @param[in]     regions       A sequence of regions, e.g. a <tt>String&lt;GenomicRegion&gt;</tt>.  Each region must
+ *                              provide the members <tt>rID</tt>, <tt>beginPos</tt>, and <tt>endPos</tt>.  A negative
+ *                              <tt>beginPos</tt> or <tt>endPos</tt> selects the region from the begin of the reference
+ *                              or up to its end.
+ * @param[in]     func          A functor that is called as <tt>func(record, regionId)</tt> for every
+ *                              @link BamAlignmentRecord @endlink overlapping the region with index
+ *                              <tt>regionId</tt>.
+ * @param[in]     numThreads    The number of threads to use, defaults to <tt>omp_get_max_threads()</tt>.
  *
  * @return bool true if seeking was successful, false if not.
  *
  * @section Remarks
  *
  * This function fails if <tt>refID</tt>/<tt>pos</tt> are invalid.
+ *
+ * The second variant visits all alignments of a list of regions.  The records are read sequentially and then parsed
+ * and passed to <tt>func</tt> in batches on a pool of <tt>numThreads</tt> threads, hence <tt>func</tt> must be
+ * thread-safe and records may be visited in any order.  A record overlapping several regions is passed once for each
+ * of them.  If seeking to a region fails, false is returned and the following regions are not visited.
  */
 
 static inline void
@@ -319,6 +381,120 @@ jumpToRegion(FormattedFile<Bam, Input, TSpec> & bamFile,
     return true;
 }
 
+// Parse the raw records of a batch and pass the ones overlapping their region to the functor.
+
+template <typename TContext, typename TRegions, typename TFunctor>
+inline void
+_bamStreamRegionRecords(String<CharString> & buffers,
+                        String<unsigned> const & regionIds,
+                        unsigned numRecords,
+                        TContext const & bamContext,
+                        TRegions const & regions,
+                        TFunctor & func,
+                        unsigned numThreads)
+{
+    ignoreUnusedVariableWarning(numThreads);
+
+    SEQAN_OMP_PRAGMA(parallel num_threads(numThreads))
+    {
+        // readRecord() uses the buffer of the context, so each thread needs its own copy.
+        TContext threadContext(bamContext);
+        BamAlignmentRecord record;
+
+        SEQAN_OMP_PRAGMA(for schedule(dynamic, 64))
+        for (int i = 0; i < (int)numRecords; ++i)
+        {
+            CharIterator bufIter = begin(buffers[i]);
+            readRecord(record, threadContext, bufIter, Bam());
+
+            __int32 regionBegin = std::max(regions[regionIds[i]].beginPos, (__int32)0);
+            if (record.beginPos + (__int32)std::max(getAlignmentLengthInRef(record), 1u) > regionBegin)
+                func(record, regionIds[i]);
+        }
+    }
+}
+
+// Visit the records of a list of regions on a pool of threads.
+
+template <typename TSpec, typename TRegions, typename TFunctor>
+inline bool
+jumpToRegion(FormattedFile<Bam, Input, TSpec> & bamFile,
+             TRegions const & regions,
+             BamIndex<Bai> const & index,
+             TFunctor & func,
+             unsigned numThreads)
+{
+    typedef typename FormattedFileContext<FormattedFile<Bam, Input, TSpec>, Dependent<> >::Type TContext;
+    typedef typename Size<TRegions const>::Type                                                 TSize;
+
+    if (!isEqual(format(bamFile), Bam()))
+        return false;
+
+    if (numThreads == 0)
+        numThreads = 1;
+
+    // Each thread processes 1024 records per batch.
+    unsigned const batchSize = 1024 * numThreads;
+    String<CharString> buffers;
+    String<unsigned> regionIds;
+    resize(buffers, batchSize);
+    resize(regionIds, batchSize);
+    unsigned numRecords = 0;
+
+    TContext & bamContext = context(bamFile);
+    for (TSize i = 0; i < length(regions); ++i)
+    {
+        __int32 rID = regions[i].rID;
+        __int32 beginPos = std::max(regions[i].beginPos, (__int32)0);
+        __int32 endPos = (regions[i].endPos < 0) ? maxValue<__int32>() : regions[i].endPos;
+
+        bool hasAlignments = false;
+        if (!jumpToRegion(bamFile, hasAlignments, rID, beginPos, endPos, index))
+        {
+            _bamStreamRegionRecords(buffers, regionIds, numRecords, bamContext, regions, func, numThreads);
+            return false;
+        }
+
+        // Read the raw records up to the end of the region.
+        while (hasAlignments && !atEnd(bamFile))
+        {
+            CharString & buffer = buffers[numRecords];
+            _readBamRecord(buffer, bamFile.iter, Bam());
+
+            __int32 recordRefId = 0;
+            __int32 recordPos = 0;
+            arrayCopyForward(begin(buffer, Standard()) + 4, begin(buffer, Standard()) + 8,
+                             reinterpret_cast<char *>(&recordRefId));
+            arrayCopyForward(begin(buffer, Standard()) + 8, begin(buffer, Standard()) + 12,
+                             reinterpret_cast<char *>(&recordPos));
+            if (recordRefId >= 0 && !empty(bamContext.translateFile2GlobalRefId))
+                recordRefId = bamContext.translateFile2GlobalRefId[recordRefId];
+            if (recordRefId != rID || recordPos >= endPos)
+                break;
+
+            regionIds[numRecords] = i;
+            if (++numRecords == batchSize)
+            {
+                _bamStreamRegionRecords(buffers, regionIds, numRecords, bamContext, regions, func, numThreads);
+                numRecords = 0;
+            }
+        }
+    }
+
+    _bamStreamRegionRecords(buffers, regionIds, numRecords, bamContext, regions, func, numThreads);
+    return true;
+}
+
+template <typename TSpec, typename TRegions, typename TFunctor>
+inline bool
+jumpToRegion(FormattedFile<Bam, Input, TSpec> & bamFile,
+             TRegions const & regions,
+             BamIndex<Bai> const & index,
+             TFunctor & func)
+{
+    return jumpToRegion(bamFile, regions, index, func, omp_get_max_threads());
+}
+
 // ----------------------------------------------------------------------------
 // Function jumpToOrphans()
 // ----------------------------------------------------------------------------
@@ -597,197 +773,478 @@ inline bool save(BamIndex<Bai> const & index, char const * baiFilename)
 }
 
 
-inline void _baiAddAlignmentChunkToBin(BamIndex<Bai> & index,
-                                       __uint32 currBin,
-                                       __uint32 currOffset,
-                                       __uint64 prevOffset)
+// ---------------------------------------------------------------------------
+// Helper Functions for build()
+// ---------------------------------------------------------------------------
+
+// Compute the bin of the region [beg, end), cf. the SAM specification.
+
+inline __uint32
+_baiReg2bin(__int32 beg, __int32 end)
 {
-    // If this is not the first reference sequence then add previous reference data.
-    Pair<__uint64> newChunk(currOffset, prevOffset);
+    --end;
+    if (beg >> 14 == end >> 14) return 4681 + (beg >> 14);
+    if (beg >> 17 == end >> 17) return  585 + (beg >> 17);
+    if (beg >> 20 == end >> 20) return   73 + (beg >> 20);
+    if (beg >> 23 == end >> 23) return    9 + (beg >> 23);
+    if (beg >> 26 == end >> 26) return    1 + (beg >> 26);
+    return 0;
+}
+
+inline void _baiAddAlignmentChunkToBin(BamIndex<Bai>::TBinIndex_ & binIndex,
+                                       __uint32 bin,
+                                       __uint64 chunkBeg,
+                                       __uint64 chunkEnd)
+{
+    // The bin is created if it does not exist yet.
+    appendValue(binIndex[bin].chunkBegEnds, Pair<__uint64>(chunkBeg, chunkEnd));
+}
+
+// Store the offset of an alignment covering [beg, end) in all 16kb windows it overlaps and that have no offset yet.
+
+inline void _baiAddAlignmentToLinearIndex(BamIndex<Bai>::TLinearIndex_ & linearIndex,
+                                          __int32 beg,
+                                          __int32 end,
+                                          __uint64 offset)
+{
+    __int32 beginWindow = beg >> BamIndex<Bai>::BAM_LIDX_SHIFT;
+    __int32 endWindow = (end - 1) >> BamIndex<Bai>::BAM_LIDX_SHIFT;
+
+    if ((__int32)length(linearIndex) < endWindow + 1)
+        resize(linearIndex, endWindow + 1, maxValue<__uint64>());
+    for (__int32 i = beginWindow; i <= endWindow; ++i)
+        if (linearIndex[i] == maxValue<__uint64>())
+            linearIndex[i] = offset;
+}
+
+// Add the next record (in file order) to the index.  Returns false if the file is not sorted by coordinate.
+
+inline bool _baiBuildPush(BamIndex<Bai> & index, BaiBuildState_ & state, BaiBuildRecordInfo_ const & info)
+{
+    __int32 beginPos = info.beginPos;
+    __int32 endPos = info.endPos;
+    if (info.rID < 0)
+    {
+        beginPos = -1;
+        endPos = 0;
+    }
+    else if (info.rID >= (__int32)length(index._binIndices))
+    {
+        return false;  // Reference is not in the header.
+    }
+
+    if (state.lastRefId != info.rID)
+    {
+        // Records without coordinate must be at the end and the records of a reference must be contiguous.
+        if (info.rID >= 0 && (index._unalignedCount != 0u || !index._binIndices[info.rID].empty()))
+            return false;
+        state.lastRefId = info.rID;
+        state.lastBin = BaiBuildState_::INVALID_BIN;
+    }
+    else if (info.rID >= 0 && state.lastPos > beginPos)
+    {
+        return false;  // Not sorted by coordinate.
+    }
+
+    if (info.rID >= 0)
+    {
+        if (info.isMapped)
+            _baiAddAlignmentToLinearIndex(index._linearIndices[info.rID], beginPos, endPos, state.lastOffset);
+    }
+    else
+    {
+        ++index._unalignedCount;
+    }
 
-    // If no interest exists yet for this bin, create one and store alignment chunk.
-    BamIndex<Bai>::TBinIndex_::iterator binIter = back(index._binIndices).find(currBin);
-    if (binIter == back(index._binIndices).end())
+    // Handle the case if we changed to a new BAI bin.
+    __uint32 bin = _baiReg2bin(beginPos, endPos);
+    if (state.lastBin != bin)
     {
-        BaiBamIndexBinData_ binData;
-        appendValue(binData.chunkBegEnds, newChunk);
-        back(index._binIndices).insert(std::make_pair(currBin, binData));
+        if (state.saveBin != BaiBuildState_::INVALID_BIN && state.saveRefId >= 0)
+        {
+            BamIndex<Bai>::TBinIndex_ & binIndex = index._binIndices[state.saveRefId];
+            _baiAddAlignmentChunkToBin(binIndex, state.saveBin, state.saveOffset, state.lastOffset);
+
+            // The reference changed, store the meta data of the previous reference in its pseudo-bin.
+            if (state.lastBin == BaiBuildState_::INVALID_BIN)
+            {
+                _baiAddAlignmentChunkToBin(binIndex, BamIndex<Bai>::BAM_META_BIN, state.metaBegOffset,
+                                           state.lastOffset);
+                _baiAddAlignmentChunkToBin(binIndex, BamIndex<Bai>::BAM_META_BIN, state.numMapped,
+                                           state.numUnmapped);
+                state.numMapped = 0;
+                state.numUnmapped = 0;
+                state.metaBegOffset = state.lastOffset;
+            }
+        }
+        state.saveOffset = state.lastOffset;
+        state.saveBin = bin;
+        state.lastBin = bin;
+        state.saveRefId = info.rID;
     }
+
+    if (info.isMapped)
+        ++state.numMapped;
     else
+        ++state.numUnmapped;
+    state.lastOffset = info.endOffset;
+    state.lastPos = beginPos;
+    return true;
+}
+
+// Merge bins whose chunks span less than 64kb of compressed data into their parent bins and merge adjacent chunks
+// that start in the same BGZF block, as samtools does.
+
+inline void _baiCompressBins(BamIndex<Bai>::TBinIndex_ & binIndex)
+{
+    typedef BamIndex<Bai>::TBinIndex_::iterator       TBinIter;
+    typedef String<Pair<__uint64> >                   TChunks;
+    typedef Iterator<TChunks, Standard>::Type         TChunkIter;
+
+    for (int level = 5; level > 0; --level)
+    {
+        __uint32 firstBin = ((1u << (3 * level)) - 1) / 7;
+        for (TBinIter it = binIndex.lower_bound(firstBin); it != binIndex.end() && it->first < BamIndex<Bai>::BAM_MAX_BIN;)
+        {
+            TChunks & chunks = it->second.chunkBegEnds;
+            if (level < 5)
+                std::sort(begin(chunks, Standard()), end(chunks, Standard()));
+            if ((back(chunks).i2 >> 16) - (front(chunks).i1 >> 16) < 0x10000u)
+            {
+                TBinIter parentIt = binIndex.find((it->first - 1) >> 3);
+                if (parentIt != binIndex.end())
+                {
+                    append(parentIt->second.chunkBegEnds, chunks);
+                    binIndex.erase(it++);
+                    continue;
+                }
+            }
+            ++it;
+        }
+    }
+
+    TBinIter rootIt = binIndex.find(0);
+    if (rootIt != binIndex.end())
+        std::sort(begin(rootIt->second.chunkBegEnds, Standard()), end(rootIt->second.chunkBegEnds, Standard()));
+
+    for (TBinIter it = binIndex.begin(); it != binIndex.end() && it->first < BamIndex<Bai>::BAM_MAX_BIN; ++it)
+    {
+        TChunks & chunks = it->second.chunkBegEnds;
+        if (empty(chunks))
+            continue;
+        TChunkIter last = begin(chunks, Standard());
+        for (TChunkIter chunkIt = last + 1; chunkIt != end(chunks, Standard()); ++chunkIt)
+        {
+            if ((last->i2 >> 16) >= (chunkIt->i1 >> 16))
+                last->i2 = std::max(last->i2, chunkIt->i2);
+            else
+                *++last = *chunkIt;
+        }
+        resize(chunks, last - begin(chunks, Standard()) + 1);
+    }
+}
+
+// Store the last chunk and meta data, fill the holes in the linear indices and compress the bins.
+
+inline void _baiBuildFinish(BamIndex<Bai> & index, BaiBuildState_ & state)
+{
+    if (state.saveBin != BaiBuildState_::INVALID_BIN && state.saveRefId >= 0)
+    {
+        BamIndex<Bai>::TBinIndex_ & binIndex = index._binIndices[state.saveRefId];
+        _baiAddAlignmentChunkToBin(binIndex, state.saveBin, state.saveOffset, state.lastOffset);
+        _baiAddAlignmentChunkToBin(binIndex, BamIndex<Bai>::BAM_META_BIN, state.metaBegOffset, state.lastOffset);
+        _baiAddAlignmentChunkToBin(binIndex, BamIndex<Bai>::BAM_META_BIN, state.numMapped, state.numUnmapped);
+    }
+
+    for (unsigned i = 0; i < length(index._binIndices); ++i)
     {
-        // Otherwise, just append alignment chunk.
-        appendValue(binIter->second.chunkBegEnds, newChunk);
+        BamIndex<Bai>::TLinearIndex_ & linearIndex = index._linearIndices[i];
+        BamIndex<Bai>::TBinIndex_ & binIndex = index._binIndices[i];
+
+        // Windows in front of the first alignment point to the first alignment of the reference.
+        unsigned j = 0;
+        BamIndex<Bai>::TBinIndex_::const_iterator metaIt = binIndex.find(BamIndex<Bai>::BAM_META_BIN);
+        __uint64 firstOffset = (metaIt != binIndex.end()) ? front(metaIt->second.chunkBegEnds).i1 : 0;
+        for (; j < length(linearIndex) && linearIndex[j] == maxValue<__uint64>(); ++j)
+            linearIndex[j] = firstOffset;
+        for (; j < length(linearIndex); ++j)
+            if (linearIndex[j] == maxValue<__uint64>())
+                linearIndex[j] = linearIndex[j - 1];
+
+        _baiCompressBins(binIndex);
     }
 }
 
+// Translate a position in the decompressed data of a batch into a virtual offset.  Positions at the end of a block
+// are mapped to the beginning of the next block, as samtools does.
+
+inline __uint64
+_baiVirtualOffset(String<__uint64> const & blockEnds, String<__uint64> const & blockFileOffsets, __uint64 pos)
+{
+    typedef Iterator<String<__uint64> const, Standard>::Type TIter;
+
+    TIter it = std::lower_bound(begin(blockEnds, Standard()), end(blockEnds, Standard()), pos);
+    size_t blockId = it - begin(blockEnds, Standard());
+    if (it == end(blockEnds, Standard()) || *it == pos)
+        return blockFileOffsets[blockId + (it != end(blockEnds, Standard()))] << 16;
+
+    __uint64 blockBegin = (blockId == 0) ? 0 : blockEnds[blockId - 1];
+    return (blockFileOffsets[blockId] << 16) | (pos - blockBegin);
+}
+
+// Extract the information required for indexing from the raw record at pos (including the block_size field).
+
+inline bool
+_baiBuildRecordInfo(BaiBuildRecordInfo_ & info, CharString const & data, __uint64 pos)
+{
+    typedef Iterator<CharString const, Standard>::Type TIter;
+
+    TIter it = begin(data, Standard()) + pos;
+    __int32 recordLen = 0;
+    arrayCopyForward(it, it + 4, reinterpret_cast<char *>(&recordLen));
+    it += 4;
+
+    BamAlignmentRecordCore core;
+    arrayCopyForward(it, it + sizeof(BamAlignmentRecordCore), reinterpret_cast<char *>(&core));
+    it += sizeof(BamAlignmentRecordCore) + core._l_qname;
+    if (sizeof(BamAlignmentRecordCore) + core._l_qname + 4 * core._n_cigar > (unsigned)recordLen)
+        return false;
+
+    info.rID = core.rID;
+    info.beginPos = core.beginPos;
+    info.isMapped = (core.flag & BAM_FLAG_UNMAPPED) == 0;
+
+    // The end position is computed from the CIGAR string, like bam_endpos() does.
+    info.endPos = core.beginPos + 1;
+    if (info.isMapped && core._n_cigar > 0)
+    {
+        __uint32 lengthInRef = 0;
+        for (unsigned i = 0; i < core._n_cigar; ++i, it += 4)
+        {
+            __uint32 opAndCnt;
+            arrayCopyForward(it, it + 4, reinterpret_cast<char *>(&opAndCnt));
+            // M, D, N, =, X consume the reference.
+            if ((0x18du >> (opAndCnt & 15)) & 1)
+                lengthInRef += opAndCnt >> 4;
+        }
+        info.endPos = core.beginPos + lengthInRef;
+    }
+    return true;
+}
+
+// Read up to maxBlocks BGZF blocks from the compressed file and append their data to the uncompressed buffer.
+// Returns false on a corrupt file, atEof is set to true if the end of the file was reached.
+
+inline bool
+_baiReadBlocks(CharString & data,
+               String<__uint64> & blockEnds,
+               String<__uint64> & blockFileOffsets,
+               bool & atEof,
+               std::istream & file,
+               unsigned maxBlocks,
+               unsigned numThreads)
+{
+    const unsigned BLOCK_HEADER_LENGTH = DefaultPageSize<BgzfFile>::BLOCK_HEADER_LENGTH;
+    const unsigned BLOCK_FOOTER_LENGTH = DefaultPageSize<BgzfFile>::BLOCK_FOOTER_LENGTH;
+
+    // Read the compressed blocks sequentially.  The uncompressed size of each block is stored in its footer.
+    CharString compressed;
+    String<size_t> compressedEnds;
+    size_t firstBlock = length(blockEnds);
+    __uint64 fileOffset = back(blockFileOffsets);
+    char header[BLOCK_HEADER_LENGTH];
+
+    atEof = false;
+    for (unsigned i = 0; i < maxBlocks; ++i)
+    {
+        file.read(header, BLOCK_HEADER_LENGTH);
+        if (file.gcount() == 0)
+        {
+            atEof = true;
+            break;
+        }
+        if (file.gcount() != (std::streamsize)BLOCK_HEADER_LENGTH || !_bgzfCheckHeader(header))
+            return false;
+
+        size_t blockLength = _bgzfUnpack16(header + 16) + 1u;
+        if (blockLength <= BLOCK_HEADER_LENGTH + BLOCK_FOOTER_LENGTH)
+            return false;
+        size_t compressedBegin = length(compressed);
+        resize(compressed, compressedBegin + blockLength, Exact());
+        std::copy(header, header + BLOCK_HEADER_LENGTH, begin(compressed, Standard()) + compressedBegin);
+        file.read(&compressed[compressedBegin + BLOCK_HEADER_LENGTH], blockLength - BLOCK_HEADER_LENGTH);
+        if (file.gcount() != (std::streamsize)(blockLength - BLOCK_HEADER_LENGTH))
+            return false;
+
+        appendValue(compressedEnds, length(compressed));
+        __uint64 uncompressedBegin = empty(blockEnds) ? 0 : back(blockEnds);
+        appendValue(blockEnds, uncompressedBegin + _bgzfUnpack32(&compressed[length(compressed) - 4]));
+        fileOffset += blockLength;
+        appendValue(blockFileOffsets, fileOffset);
+    }
+    resize(data, empty(blockEnds) ? 0 : back(blockEnds), Exact());
+
+    // Decompress the blocks in parallel.
+    ignoreUnusedVariableWarning(numThreads);
+    bool success = true;
+    int numBlocks = length(compressedEnds);
+    SEQAN_OMP_PRAGMA(parallel for num_threads(numThreads) schedule(dynamic))
+    for (int i = 0; i < numBlocks; ++i)
+    {
+        size_t compressedBegin = (i == 0) ? 0 : compressedEnds[i - 1];
+        __uint64 dataBegin = (firstBlock + i == 0) ? 0 : blockEnds[firstBlock + i - 1];
+        size_t dataLength = blockEnds[firstBlock + i] - dataBegin;
+        CompressionContext<BgzfFile> ctx;
+
+        SEQAN_TRY
+        {
+            if (_decompressBlock(begin(data, Standard()) + dataBegin, dataLength,
+                                 begin(compressed, Standard()) + compressedBegin,
+                                 compressedEnds[i] - compressedBegin, ctx) != dataLength)
+                success = false;
+        }
+        SEQAN_CATCH(IOError const &)
+        {
+            success = false;
+        }
+    }
+    return success;
+}
+
 // ---------------------------------------------------------------------------
 // Function build()
 // ---------------------------------------------------------------------------
-// TODO(dadi): uncomment when BamIndex.build index is fixed. DOX commented out
-/*
+
+/*!
  * @fn BamIndex#build
  * @brief Create a BamIndex from BAM file.
  *
- * @signature bool build(baiIndex, bamFileName);
+ * @signature bool build(baiIndex, bamFileName[, numThreads]);
  *
  * @param[out] baiIndex    The BamIndex to build into.
  * @param[in]  bamFileName Path to the BAM file to build an index for.  Type: <tt>char const *</tt>.
+ * @param[in]  numThreads  The number of threads to use, defaults to <tt>omp_get_max_threads()</tt>.
+ *                         Type: <tt>unsigned</tt>.
  *
  * @return bool <tt>true</tt> on success, <tt>false</tt> otherwise.
+ *
+ * The BAM file must be sorted by coordinate.  The file is read in batches of BGZF blocks, the blocks of a batch are
+ * decompressed and the bins of their records are computed in parallel.  The result is identical to the index
+ * generated by <tt>samtools index</tt>.
  */
-inline bool build(BamIndex<Bai> & index, char const * bamFilename)
-{
-    // SEQAN_FAIL("This does not work yet!");
 
+inline bool _baiBuild(BamIndex<Bai> & index, char const * bamFilename, unsigned numThreads, unsigned blocksPerBatch)
+{
     index._unalignedCount = 0;
     clear(index._binIndices);
     clear(index._linearIndices);
 
-    // Open BAM file for reading.
-    BamFileIn bamFile;
-    if (!open(bamFile, bamFilename))
-        return false;  // Could not open BAM file.
-
-    // Read BAM header.
-    BamHeader header;
-    readHeader(header, bamFile);
-
-    __uint32 numRefSeqs = length(contigNames(context(bamFile)));
-
-    // Scan over BAM file and create index.
-    BamAlignmentRecord record;
-    __uint32 currBin    = maxValue<__uint32>();
-    __uint32 prevBin    = maxValue<__uint32>();
-    __int32 currRefId   = BamAlignmentRecord::INVALID_REFID;
-    __int32 prevRefId   = BamAlignmentRecord::INVALID_REFID;
-    __uint64 currOffset = position(bamFile);
-    __uint64 prevOffset = currOffset;
-    __int32 prevPos     = minValue<__int32>();
+    if (numThreads == 0)
+        numThreads = 1;
 
-    while (!atEnd(bamFile))
+    // Read the BAM header to get the number of references and the virtual offset of the first record.
+    __uint64 headerEnd = 0;
     {
-        // Load next record.
-        readRecord(record, bamFile);
-
-        // Check ordering.
-        if (prevRefId == record.rID && prevPos > record.beginPos)
+        BamFileIn bamFile;
+        if (!open(bamFile, bamFilename))
+            return false;  // Could not open BAM file.
+        if (!isEqual(format(bamFile), Bam()))
             return false;
 
-        // The reference sequence changed, close bins for previous reference.
-        if (prevRefId != record.rID)
-        {
-            if (prevRefId != BamAlignmentRecord::INVALID_REFID)
-            {
-                _baiAddAlignmentChunkToBin(index, currBin, currOffset, prevOffset);
+        BamHeader header;
+        readHeader(header, bamFile);
+        headerEnd = position(bamFile);
 
-                // Add an index for all empty references between prevRefId (excluded) and record.rID (included).
-                for (int i = prevRefId + 1; i < record.rID; ++i)
-                {
-                    BamIndex<Bai>::TBinIndex_ binIndex;
-                    appendValue(index._binIndices, binIndex);
-                    BamIndex<Bai>::TLinearIndex_ linearIndex;
-                    appendValue(index._linearIndices, linearIndex);
-                }
+        resize(index._binIndices, length(contigNames(context(bamFile))));
+        resize(index._linearIndices, length(contigNames(context(bamFile))));
+    }
 
-                // Update bin book keeping.
-                currOffset = prevOffset;
-                currBin    = record.bin;
-                prevBin    = record.bin;
-                currRefId  = record.rID;
-            }
-            else
-            {
-                // Otherwise, this is the first pass.  Create an index for all empty references up to and including
-                // current refId.
-                for (int i = 0; i < record.rID; ++i)
-                {
-                    BamIndex<Bai>::TBinIndex_ binIndex;
-                    appendValue(index._binIndices, binIndex);
-                    BamIndex<Bai>::TLinearIndex_ linearIndex;
-                    appendValue(index._linearIndices, linearIndex);
-                }
-            }
+    std::ifstream file(bamFilename, std::ios::binary | std::ios::in);
+    if (!file.good() || !file.seekg(headerEnd >> 16))
+        return false;
 
-            // Update reference book keeping.
-            prevRefId = record.rID;
-            prevBin = minValue<__int32>();
-        }
+    // The current batch consists of the uncompressed data, the uncompressed end positions of its blocks and the file
+    // offsets of its blocks (plus the offset of the following block).
+    CharString data;
+    String<__uint64> blockEnds;
+    String<__uint64> blockFileOffsets;
+    appendValue(blockFileOffsets, headerEnd >> 16);
+    __uint64 pos = headerEnd & 0xffff;
+
+    BaiBuildState_ state(headerEnd);
+    String<__uint64> recordPositions;
+    String<BaiBuildRecordInfo_> recordInfos;
+    bool atEof = false;
+    while (!atEof)
+    {
+        if (!_baiReadBlocks(data, blockEnds, blockFileOffsets, atEof, file, blocksPerBatch, numThreads))
+            return false;
 
-        // If the alignment's reference id is valid and its bin is not a leaf.
-        if (record.rID >= 0 && record.bin < 4681)
+        // Find the records that are completely contained in the batch.
+        clear(recordPositions);
+        for (__uint64 dataLength = length(data); pos + 4 <= dataLength;)
         {
-            __int32 beginOffset = record.beginPos >> BamIndex<Bai>::BAM_LIDX_SHIFT;
-            __int32 endPos      = getAlignmentLengthInRef(record);
-            __int32 endOffset   = (endPos - 1) >> BamIndex<Bai>::BAM_LIDX_SHIFT;
-
-            // Resize linear index if necessary.
-            unsigned oldSize = length(index._linearIndices);
-            unsigned newSize = endOffset + 1;
-            if (oldSize < newSize)
-                resize(back(index._linearIndices), newSize, 0);
-
-            // Store offset.
-            for (int i = beginOffset + 1; i <= endOffset; ++i)
-                if (back(index._linearIndices)[i] == 0u)
-                    back(index._linearIndices)[i] = prevOffset;
+            __int32 recordLen = 0;
+            arrayCopyForward(begin(data, Standard()) + pos, begin(data, Standard()) + pos + 4,
+                             reinterpret_cast<char *>(&recordLen));
+            if (recordLen < (__int32)sizeof(BamAlignmentRecordCore))
+                return false;  // Corrupt record.
+            if (pos + 4 + recordLen > dataLength)
+                break;
+            appendValue(recordPositions, pos);
+            pos += 4 + recordLen;
         }
-
-        // Handle the case if we changed to a new BAI bin.
-        if (record.bin != prevBin)
+        if (atEof && pos != length(data))
+            return false;  // Truncated file.
+
+        // Extract the bins and virtual offsets of the records in parallel.
+        bool success = true;
+        int numRecords = length(recordPositions);
+        resize(recordInfos, numRecords);
+        SEQAN_OMP_PRAGMA(parallel for num_threads(numThreads) schedule(static))
+        for (int i = 0; i < numRecords; ++i)
         {
-            // If not first bin of reference, save previous bin data.
-            if (currBin != maxValue<__uint32>())
-                _baiAddAlignmentChunkToBin(index, currBin, currOffset, prevOffset);
-
-            // Update markers.
-            currOffset = prevOffset;
-            currBin    = record.bin;
-            prevBin    = record.bin;
-            currRefId  = record.rID;
-
-            // If the reference id is invalid then break out.
-            if (currRefId < 0)
-                break;
+            BaiBuildRecordInfo_ & info = recordInfos[i];
+            if (!_baiBuildRecordInfo(info, data, recordPositions[i]))
+                success = false;
+            info.beginOffset = _baiVirtualOffset(blockEnds, blockFileOffsets, recordPositions[i]);
+            info.endOffset = _baiVirtualOffset(blockEnds, blockFileOffsets,
+                                               (i + 1 < numRecords) ? recordPositions[i + 1] : pos);
         }
+        if (!success)
+            return false;
 
-        // Make sure that the current file pointer is beyond prevOffset.
-        if (position(bamFile) <= static_cast<__int64>(prevOffset))
-            return false;  // Calculating offsets failed.
-
-        // Update prevOffset and prevPos.
-        prevOffset = position(bamFile);
-        prevPos    = record.beginPos;
-    }
-
-    // Count remaining unaligned records.
-    while (!atEnd(bamFile))
-    {
-        SEQAN_ASSERT_GT(index._unalignedCount, 0u);
-
-        readRecord(record, bamFile);
-        if (record.rID >= 0)
-            return false;  // Could not read record.
-
-        index._unalignedCount += 1;
-    }
-
-    // After loading all alignments, if any data was read, perform checks.
-    if (currRefId >= 0)
-    {
-        // Store last alignment chunk to its bin and then write last reference entry with data.
-        _baiAddAlignmentChunkToBin(index, currBin, currOffset, prevOffset);
+        // Merge the records into the bins and linear index in file order.
+        for (int i = 0; i < numRecords; ++i)
+            if (!_baiBuildPush(index, state, recordInfos[i]))
+                return false;
 
-        // Finally, write any empty references remaining at end of file.
-        SEQAN_ASSERT_GEQ(numRefSeqs, length(index._binIndices));
-        BamIndex<Bai>::TBinIndex_ binIndex;
-        resize(index._binIndices, numRefSeqs, binIndex);  // TODO(holtgrew): binIndex is unnecessary if resize used T() as default value as vector.resize() does.
+        // Keep the blocks of the incomplete last record for the next batch.
+        size_t keepBlock = std::upper_bound(begin(blockEnds, Standard()), end(blockEnds, Standard()), pos) -
+                           begin(blockEnds, Standard());
+        __uint64 keepBegin = (keepBlock == 0) ? 0 : blockEnds[keepBlock - 1];
+        erase(data, 0, keepBegin);
+        erase(blockEnds, 0, keepBlock);
+        erase(blockFileOffsets, 0, keepBlock);
+        for (size_t i = 0; i < length(blockEnds); ++i)
+            blockEnds[i] -= keepBegin;
+        pos -= keepBegin;
     }
 
-    // Merge small bins if possible.
-    // SEQAN_FAIL("TODO: Merge bins!");
+    _baiBuildFinish(index, state);
     return true;
 }
 
+inline bool build(BamIndex<Bai> & index, char const * bamFilename, unsigned numThreads)
+{
+    // Each thread decompresses 64 blocks (4MB) per batch.
+    return _baiBuild(index, bamFilename, numThreads, 64 * std::max(numThreads, 1u));
+}
+
+inline bool build(BamIndex<Bai> & index, char const * bamFilename)
+{
+    return build(index, bamFilename, omp_get_max_threads());
+}
 
 }  // namespace seqan
 
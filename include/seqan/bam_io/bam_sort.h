@@ -0,0 +1,531 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2015, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Author: David Weese <david.weese@fu-berlin.de>
+// ==========================================================================
+// External memory sorting of SAM/BAM files by coordinate or query name.
+// ==========================================================================
+
+#ifndef INCLUDE_SEQAN_BAM_IO_BAM_SORT_H_
+#define INCLUDE_SEQAN_BAM_IO_BAM_SORT_H_
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <queue>
+#include <vector>
+
+namespace seqan {
+
+// ============================================================================
+// Forwards
+// ============================================================================
+
+inline bool _bamSortTempFileName(CharString & fileName);
+
+// ============================================================================
+// Tags, Classes, Enums
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Class BamSortLess_
+// ----------------------------------------------------------------------------
+
+// Compares two records by the given BamSortOrder, BAM_SORT_COORDINATE sorts by (rID, beginPos, strand) with
+// unmapped records (rID == -1) at the end, BAM_SORT_QUERYNAME sorts by (qName, first/last mate flags).
+
+struct BamSortLess_
+{
+    BamSortOrder sortOrder;
+
+    explicit
+    BamSortLess_(BamSortOrder sortOrder) : sortOrder(sortOrder)
+    {}
+
+    bool operator() (BamAlignmentRecord const & a, BamAlignmentRecord const & b) const
+    {
+        if (sortOrder == BAM_SORT_QUERYNAME)
+        {
+            if (a.qName != b.qName)
+                return a.qName < b.qName;
+            return (a.flag & (BAM_FLAG_FIRST | BAM_FLAG_LAST)) < (b.flag & (BAM_FLAG_FIRST | BAM_FLAG_LAST));
+        }
+
+        if (a.rID != b.rID)
+            return static_cast<__uint32>(a.rID) < static_cast<__uint32>(b.rID);
+        if (a.beginPos != b.beginPos)
+            return a.beginPos < b.beginPos;
+        return (a.flag & BAM_FLAG_RC) < (b.flag & BAM_FLAG_RC);
+    }
+};
+
+// ----------------------------------------------------------------------------
+// Class BamSortRunLess_
+// ----------------------------------------------------------------------------
+
+// Orders a permutation of a run of records stored in batches of batchSize records.
+
+template <typename TBatches>
+struct BamSortRunLess_
+{
+    TBatches const & batches;
+    size_t batchSize;
+    BamSortLess_ less;
+
+    BamSortRunLess_(TBatches const & batches, size_t batchSize, BamSortOrder sortOrder) :
+        batches(batches), batchSize(batchSize), less(sortOrder)
+    {}
+
+    bool operator() (size_t a, size_t b) const
+    {
+        return less(batches[a / batchSize][a % batchSize], batches[b / batchSize][b % batchSize]);
+    }
+};
+
+// ----------------------------------------------------------------------------
+// Class BamSortMergeGreater_
+// ----------------------------------------------------------------------------
+
+// Inverse order on the current records of the runs, used for the min-heap of the k-way merge.
+// Ties are broken by the run number to keep the sort stable.
+
+struct BamSortMergeGreater_
+{
+    String<BamAlignmentRecord> const & records;
+    BamSortLess_ less;
+
+    BamSortMergeGreater_(String<BamAlignmentRecord> const & records, BamSortOrder sortOrder) :
+        records(records), less(sortOrder)
+    {}
+
+    bool operator() (unsigned a, unsigned b) const
+    {
+        if (less(records[b], records[a]))
+            return true;
+        if (less(records[a], records[b]))
+            return false;
+        return b < a;
+    }
+};
+
+// ----------------------------------------------------------------------------
+// Class BamSortRunFiles_
+// ----------------------------------------------------------------------------
+
+// Owns the temporary files of the sorted runs.  Each run consists of a unique empty file created by
+// _bamSortTempFileName() and the BAM file with the additional extension ".bam".  The files of all runs that have not
+// been removed yet are removed on destruction, also when an exception is thrown.
+
+struct BamSortRunFiles_
+{
+    StringSet<CharString> fileNames;
+
+    ~BamSortRunFiles_()
+    {
+        for (unsigned i = 0; i < length(fileNames); ++i)
+            remove(i);
+    }
+
+    // Create the files for a new run and return the path of the run's BAM file.
+    CharString add()
+    {
+        CharString fileName;
+        if (!_bamSortTempFileName(fileName))
+            SEQAN_THROW(IOError("Couldn't create temporary file for sorting."));
+        appendValue(fileNames, fileName);
+        return bamFileName(length(fileNames) - 1);
+    }
+
+    CharString bamFileName(unsigned runId) const
+    {
+        CharString fileName = fileNames[runId];
+        append(fileName, ".bam");
+        return fileName;
+    }
+
+    void remove(unsigned runId)
+    {
+        if (empty(fileNames[runId]))
+            return;
+        std::remove(toCString(bamFileName(runId)));
+        std::remove(toCString(fileNames[runId]));
+        clear(fileNames[runId]);
+    }
+};
+
+// ----------------------------------------------------------------------------
+// Class BamSortRunReaders_
+// ----------------------------------------------------------------------------
+
+// Owns the readers of the runs merged at the same time, they are closed on destruction, also when an exception is
+// thrown.  Each run is decompressed by a BGZF stream with a single thread of its own, as many runs are read at the
+// same time, the global setBgzfThreads() setting is left untouched.
+
+struct BamSortRunReaders_
+{
+    String<std::ifstream *> runFiles;
+    String<bgzf_istream *>  runStreams;
+    String<BamFileIn *>     files;
+
+    ~BamSortRunReaders_()
+    {
+        for (unsigned i = 0; i < length(files); ++i)
+        {
+            delete files[i];
+            delete runStreams[i];
+            delete runFiles[i];
+        }
+    }
+
+    template <typename TContext>
+    void open(TContext & context, CharString const & fileName)
+    {
+        appendValue(runFiles, (std::ifstream *)NULL);
+        appendValue(runStreams, (bgzf_istream *)NULL);
+        appendValue(files, (BamFileIn *)NULL);
+
+        back(runFiles) = new std::ifstream(toCString(fileName), std::ios_base::in | std::ios_base::binary);
+        if (!back(runFiles)->is_open())
+            SEQAN_THROW(FileOpenError(toCString(fileName)));
+        back(runStreams) = new bgzf_istream(*back(runFiles), 1);
+        back(files) = new BamFileIn(context, *back(runStreams));
+    }
+};
+
+// ============================================================================
+// Functions
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Function _bamSortRecordSize()
+// ----------------------------------------------------------------------------
+
+// Estimates the number of bytes a record occupies in memory.
+
+inline size_t
+_bamSortRecordSize(BamAlignmentRecord const & record)
+{
+    return sizeof(BamAlignmentRecord) +
+           length(record.qName) +
+           length(record.cigar) * sizeof(CigarElement<>) +
+           length(record.seq) * sizeof(Value<IupacString>::Type) +
+           length(record.qual) +
+           length(record.tags);
+}
+
+// ----------------------------------------------------------------------------
+// Function _bamSortTempFileName()
+// ----------------------------------------------------------------------------
+
+// Creates a unique empty file in the temporary directory and returns its name.  The run is stored in the file with
+// the additional extension ".bam", both files must be removed by the caller.
+
+inline bool
+_bamSortTempFileName(CharString & fileName)
+{
+#ifdef PLATFORM_WINDOWS
+# ifdef SEQAN_DEFAULT_TMPDIR
+    char * name = _tempnam(SEQAN_DEFAULT_TMPDIR, "SQN");
+# else  // #ifdef SEQAN_DEFAULT_TMPDIR
+    char * name = _tempnam(NULL, "SQN");
+# endif  // #ifdef SEQAN_DEFAULT_TMPDIR
+    if (name == NULL)
+        return false;
+    fileName = name;
+    free(name);
+    std::FILE * file = std::fopen(toCString(fileName), "wb");
+    if (file == NULL)
+        return false;
+    std::fclose(file);
+#else  // #ifdef PLATFORM_WINDOWS
+    char const * tmpDir = getenv("TMPDIR");
+    if (tmpDir == NULL)
+        tmpDir = getenv("TMP");
+# ifdef SEQAN_DEFAULT_TMPDIR
+    if (tmpDir == NULL)
+        tmpDir = SEQAN_DEFAULT_TMPDIR;
+# else  // #ifdef SEQAN_DEFAULT_TMPDIR
+    if (tmpDir == NULL)
+        tmpDir = "/tmp";
+# endif  // #ifdef SEQAN_DEFAULT_TMPDIR
+    fileName = tmpDir;
+    append(fileName, "/SQNXXXXXX");
+    int handle = ::mkstemp(toCString(fileName));
+    if (handle == -1)
+        return false;
+    ::close(handle);
+#endif  // #ifdef PLATFORM_WINDOWS
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+// Function _bamSortRun()
+// ----------------------------------------------------------------------------
+
+// Stable sorts a permutation, numThreads chunks are sorted concurrently and then merged pairwise.
+
+template <typename TPerm, typename TLess>
+inline void
+_bamSortRun(TPerm & perm, TLess const & less, unsigned numThreads)
+{
+    typedef typename Iterator<TPerm, Standard>::Type TIter;
+
+    size_t numChunks = std::max(std::min((size_t)numThreads, length(perm) / 1024), (size_t)1);
+    String<size_t> bounds;
+    resize(bounds, numChunks + 1, Exact());
+    for (size_t i = 0; i <= numChunks; ++i)
+        bounds[i] = length(perm) * i / numChunks;
+
+    TIter permBegin = begin(perm, Standard());
+    ignoreUnusedVariableWarning(numThreads);
+
+    SEQAN_OMP_PRAGMA(parallel for num_threads(numThreads) schedule(static, 1))
+    for (int i = 0; i < (int)numChunks; ++i)
+        std::stable_sort(permBegin + bounds[i], permBegin + bounds[i + 1], less);
+
+    for (size_t step = 1; step < numChunks; step *= 2)
+    {
+        SEQAN_OMP_PRAGMA(parallel for num_threads(numThreads) schedule(static, 1))
+        for (int i = 0; i < (int)numChunks - (int)step; i += 2 * step)
+            std::inplace_merge(permBegin + bounds[i],
+                               permBegin + bounds[i + step],
+                               permBegin + bounds[std::min(i + 2 * step, numChunks)],
+                               less);
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Function _bamSortMergeRuns()
+// ----------------------------------------------------------------------------
+
+// Merges the given sorted runs into fileOut, ties are resolved by the order of the runs in runIds.
+
+template <typename TFileOut, typename TContext>
+inline void
+_bamSortMergeRuns(TFileOut & fileOut,
+                  BamSortRunFiles_ const & runs,
+                  String<unsigned> const & runIds,
+                  TContext & context,
+                  BamSortOrder sortOrder)
+{
+    unsigned numRuns = length(runIds);
+    BamSortRunReaders_ readers;
+    String<BamAlignmentRecord> records;
+    resize(records, numRuns, Exact());
+
+    BamSortMergeGreater_ greater(records, sortOrder);
+    std::priority_queue<unsigned, std::vector<unsigned>, BamSortMergeGreater_> heap(greater);
+
+    BamHeader runHeader;
+    for (unsigned i = 0; i < numRuns; ++i)
+    {
+        readers.open(context, runs.bamFileName(runIds[i]));
+        readHeader(runHeader, *readers.files[i]);
+    }
+
+    for (unsigned i = 0; i < numRuns; ++i)
+        if (!atEnd(*readers.files[i]))
+        {
+            readRecord(records[i], *readers.files[i]);
+            heap.push(i);
+        }
+
+    while (!heap.empty())
+    {
+        unsigned i = heap.top();
+        heap.pop();
+        writeRecord(fileOut, records[i]);
+        if (!atEnd(*readers.files[i]))
+        {
+            readRecord(records[i], *readers.files[i]);
+            heap.push(i);
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Function sortBamFile()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn BamFileIn#sortBamFile
+ * @brief Sort the records of a SAM/BAM file by coordinate or query name.
+ *
+ * @signature void sortBamFile(bamFileOut, bamFileIn, sortOrder[, maxMemory[, numThreads]]);
+ *
+ * @param[in,out] bamFileOut The @link BamFileOut @endlink to write the header and the sorted records to.  It must
+ *                           share its context with <tt>bamFileIn</tt>, e.g. by constructing it with
+ *                           <tt>BamFileOut bamFileOut(bamFileIn)</tt>.
+ * @param[in,out] bamFileIn  The @link BamFileIn @endlink to read from, the header must not be read yet.
+ * @param[in]     sortOrder  The @link BamSortOrder @endlink, either <tt>BAM_SORT_COORDINATE</tt> or
+ *                           <tt>BAM_SORT_QUERYNAME</tt>.
+ * @param[in]     maxMemory  The maximal number of bytes used to hold records in memory, defaults to 512 MiB.
+ * @param[in]     numThreads The number of threads used to parse and sort the records, defaults to 1.
+ *
+ * The records are read in batches until <tt>maxMemory</tt> is exhausted.  Each batch is sorted in memory and, if the
+ * input does not fit into memory, written as a sorted run into a temporary BAM file.  The runs are compressed by the
+ * BGZF writer threads and eventually merged into <tt>bamFileOut</tt>.  At most 64 runs are merged at the same time,
+ * each read with a single BGZF decompression thread; more runs are merged in multiple passes.  Temporary files are
+ * created in the directory given by the environment variable <tt>TMPDIR</tt> and removed afterwards, also if an
+ * exception is thrown.
+ *
+ * The sort is stable.  Records are sorted by reference id, begin position and strand in coordinate order, unmapped
+ * records come last.  In query name order, they are sorted lexicographically by name and first/last mate flags.
+ * The <tt>SO</tt> tag of the written header is set accordingly.
+ *
+ * @throw IOError On low-level I/O errors.
+ * @throw ParseError On high-level file format errors.
+ */
+
+template <typename TSpecOut, typename TSpecIn>
+inline void
+_sortBamFile(FormattedFile<Bam, Output, TSpecOut> & bamFileOut,
+             FormattedFile<Bam, Input, TSpecIn> & bamFileIn,
+             BamSortOrder sortOrder,
+             __uint64 maxMemory,
+             unsigned numThreads,
+             unsigned maxFanIn)
+{
+    typedef String<String<BamAlignmentRecord> >     TBatches;
+    typedef String<size_t>                          TPerm;
+
+    static const size_t BATCH_SIZE = 1024;
+
+    BamHeader header;
+    readHeader(header, bamFileIn);
+    setSortOrder(header, sortOrder);
+
+    TBatches batches;
+    TPerm perm;
+    BamSortRunFiles_ runs;
+
+    // Step 1: Read runs that fit into memory, sort them, and write them into temporary files.
+    do
+    {
+        size_t numBatches = 0;
+        size_t numRecords = 0;
+        __uint64 runMemory = 0;
+        while (!atEnd(bamFileIn) && runMemory < maxMemory)
+        {
+            if (length(batches) <= numBatches)
+                resize(batches, numBatches + 1);
+            String<BamAlignmentRecord> & batch = batches[numBatches++];
+            size_t batchRecords = readRecords(batch, bamFileIn, BATCH_SIZE, numThreads);
+            for (size_t i = 0; i < batchRecords; ++i)
+                runMemory += _bamSortRecordSize(batch[i]);
+            numRecords += batchRecords;
+        }
+
+        resize(perm, numRecords, Exact());
+        for (size_t i = 0; i < numRecords; ++i)
+            perm[i] = i;
+        _bamSortRun(perm, BamSortRunLess_<TBatches>(batches, BATCH_SIZE, sortOrder), numThreads);
+
+        if (atEnd(bamFileIn) && empty(runs.fileNames))
+        {
+            // Everything fits into memory, no need for temporary files.
+            writeHeader(bamFileOut, header);
+            for (size_t i = 0; i < numRecords; ++i)
+                writeRecord(bamFileOut, batches[perm[i] / BATCH_SIZE][perm[i] % BATCH_SIZE]);
+            return;
+        }
+
+        BamFileOut runFile(context(bamFileIn), toCString(runs.add()));
+        writeHeader(runFile, header);
+        for (size_t i = 0; i < numRecords; ++i)
+            writeRecord(runFile, batches[perm[i] / BATCH_SIZE][perm[i] % BATCH_SIZE]);
+    }
+    while (!atEnd(bamFileIn));
+
+    clear(batches);
+    clear(perm);
+
+    // Step 2: Merge groups of at most maxFanIn consecutive runs into new runs until at most maxFanIn runs are left.
+    // Consecutive runs are merged to keep the sort stable.
+    String<unsigned> runIds;
+    for (unsigned i = 0; i < length(runs.fileNames); ++i)
+        appendValue(runIds, i);
+    while (length(runIds) > maxFanIn)
+    {
+        String<unsigned> mergedRunIds;
+        for (unsigned groupBegin = 0; groupBegin < length(runIds); groupBegin += maxFanIn)
+        {
+            unsigned groupEnd = std::min(groupBegin + maxFanIn, (unsigned)length(runIds));
+            if (groupEnd - groupBegin == 1u)
+            {
+                appendValue(mergedRunIds, runIds[groupBegin]);
+                continue;
+            }
+
+            String<unsigned> groupRunIds = infix(runIds, groupBegin, groupEnd);
+            {
+                BamFileOut runFile(context(bamFileIn), toCString(runs.add()));
+                appendValue(mergedRunIds, length(runs.fileNames) - 1);
+                writeHeader(runFile, header);
+                _bamSortMergeRuns(runFile, runs, groupRunIds, context(bamFileIn), sortOrder);
+            }
+            for (unsigned i = 0; i < length(groupRunIds); ++i)
+                runs.remove(groupRunIds[i]);
+        }
+        swap(runIds, mergedRunIds);
+    }
+
+    // Step 3: Merge the remaining runs into the output.  All records have been read at this point, so the header
+    // already contains all contigs added while reading SAM records.
+    writeHeader(bamFileOut, header);
+    _bamSortMergeRuns(bamFileOut, runs, runIds, context(bamFileIn), sortOrder);
+}
+
+template <typename TSpecOut, typename TSpecIn>
+inline void
+sortBamFile(FormattedFile<Bam, Output, TSpecOut> & bamFileOut,
+            FormattedFile<Bam, Input, TSpecIn> & bamFileIn,
+            BamSortOrder sortOrder,
+            __uint64 maxMemory,
+            unsigned numThreads)
+{
+    _sortBamFile(bamFileOut, bamFileIn, sortOrder, maxMemory, numThreads, 64u);
+}
+
+template <typename TSpecOut, typename TSpecIn>
+inline void
+sortBamFile(FormattedFile<Bam, Output, TSpecOut> & bamFileOut,
+            FormattedFile<Bam, Input, TSpecIn> & bamFileIn,
+            BamSortOrder sortOrder,
+            __uint64 maxMemory = 512ull << 20)
+{
+    sortBamFile(bamFileOut, bamFileIn, sortOrder, maxMemory, 1u);
+}
+
+}  // namespace seqan
+
+#endif  // #ifndef INCLUDE_SEQAN_BAM_IO_BAM_SORT_H_
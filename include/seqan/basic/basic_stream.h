@@ -37,6 +37,9 @@
 #ifndef SEQAN_INCLUDE_SEQAN_BASIC_BASIC_STREAM_H_
 #define SEQAN_INCLUDE_SEQAN_BASIC_BASIC_STREAM_H_
 
+#include <cmath>
+#include <cstring>
+
 namespace seqan {
 
 // ============================================================================
@@ -387,6 +390,81 @@ struct EmptyFieldError : ParseError
     {}
 };
 
+// ----------------------------------------------------------------------------
+// Class FirstException_
+// ----------------------------------------------------------------------------
+
+// Keeps the exception of the smallest item index failing in a parallel loop, it is rethrown after the loop.
+// Without C++11 only the message survives and the exception is rethrown as ParseError or RuntimeError.
+
+struct FirstException_
+{
+    bool        failed;
+    __uint64    index;
+#ifdef SEQAN_CXX11_STANDARD
+    std::exception_ptr error;
+#else
+    bool        parseError;
+    std::string message;
+#endif
+
+    FirstException_() :
+        failed(false),
+        index(0)
+    {}
+};
+
+// Must be called from within a catch block, concurrent calls must be serialized by the caller.
+inline void
+_captureException(FirstException_ & first, __uint64 index)
+{
+    if (first.failed && first.index <= index)
+        return;
+    first.failed = true;
+    first.index = index;
+#ifdef SEQAN_EXCEPTIONS
+#ifdef SEQAN_CXX11_STANDARD
+    first.error = std::current_exception();
+#else
+    try
+    {
+        throw;
+    }
+    catch (ParseError const & e)
+    {
+        first.parseError = true;
+        first.message = e.what();
+    }
+    catch (std::exception const & e)
+    {
+        first.parseError = false;
+        first.message = e.what();
+    }
+    catch (...)
+    {
+        first.parseError = false;
+        first.message = "Unknown exception.";
+    }
+#endif
+#endif
+}
+
+inline void
+_rethrowException(FirstException_ const & first)
+{
+    if (!first.failed)
+        return;
+#ifdef SEQAN_CXX11_STANDARD
+#ifdef SEQAN_EXCEPTIONS
+    std::rethrow_exception(first.error);
+#endif
+#else
+    if (first.parseError)
+        SEQAN_THROW(ParseError(first.message));
+    SEQAN_THROW(RuntimeError(first.message));
+#endif
+}
+
 // ============================================================================
 // Metafunctions
 // ============================================================================
@@ -673,6 +751,25 @@ struct IntegerFormatString_<TIsUnsigned, 8, T> :
        Int64FormatString_<TIsUnsigned, T> >::Type {};
 
 
+// ----------------------------------------------------------------------------
+// Struct DecimalDigitPairs_
+// ----------------------------------------------------------------------------
+// The decimal representations of 0..99 as consecutive pairs of characters.
+
+template <typename T = void>
+struct DecimalDigitPairs_
+{
+    static const char VALUE[201];
+};
+
+template <typename T>
+const char DecimalDigitPairs_<T>::VALUE[201] =
+    "0001020304050607080910111213141516171819"
+    "2021222324252627282930313233343536373839"
+    "4041424344454647484950515253545556575859"
+    "6061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
 // ============================================================================
 // Functions
 // ============================================================================
@@ -1099,6 +1196,63 @@ write(TTarget &target, TValue * ptr)
     write(target, ptr, length(ptr));
 }
 
+// ----------------------------------------------------------------------------
+// Function _formatUnsigned()
+// ----------------------------------------------------------------------------
+// Writes the decimal digits of i right-aligned into the buffer ending before bufEnd, two digits at a time.
+// Returns a pointer to the first digit.
+
+template <typename TUnsigned>
+inline char *
+_formatUnsigned(char * bufEnd, TUnsigned i)
+{
+    char * ptr = bufEnd;
+    while (i >= 100u)
+    {
+        char const * pair = DecimalDigitPairs_<>::VALUE + 2 * static_cast<unsigned>(i % 100u);
+        i /= 100u;
+        *--ptr = pair[1];
+        *--ptr = pair[0];
+    }
+    if (i >= 10u)
+    {
+        char const * pair = DecimalDigitPairs_<>::VALUE + 2 * static_cast<unsigned>(i);
+        *--ptr = pair[1];
+        *--ptr = pair[0];
+    }
+    else
+    {
+        *--ptr = '0' + static_cast<char>(i);
+    }
+    return ptr;
+}
+
+// ----------------------------------------------------------------------------
+// Function _formatInteger()
+// ----------------------------------------------------------------------------
+
+template <typename TInteger>
+inline char *
+_formatInteger(char * bufEnd, TInteger i, True /*unsigned*/)
+{
+    return _formatUnsigned(bufEnd, i);
+}
+
+template <typename TInteger>
+inline char *
+_formatInteger(char * bufEnd, TInteger i, False /*unsigned*/)
+{
+    typedef typename MakeUnsigned<TInteger>::Type TUnsigned;
+
+    if (i >= 0)
+        return _formatUnsigned(bufEnd, static_cast<TUnsigned>(i));
+
+    // Negate in 64 bit unsigned arithmetic to handle the minimal value (MakeUnsigned<long long> may be signed).
+    char * ptr = _formatUnsigned(bufEnd, (__uint64)0 - static_cast<__uint64>(static_cast<__int64>(i)));
+    *--ptr = '-';
+    return ptr;
+}
+
 // ----------------------------------------------------------------------------
 // Function appendNumber()
 // ----------------------------------------------------------------------------
@@ -1108,14 +1262,11 @@ template <typename TTarget, typename TInteger>
 inline SEQAN_FUNC_ENABLE_IF(Is<IntegerConcept<TInteger> >, typename Size<TTarget>::Type)
 appendNumber(TTarget & target, TInteger i)
 {
-    typedef IntegerFormatString_<typename Is<UnsignedIntegerConcept<TInteger> >::Type,
-                                 sizeof(TInteger)> TInt;
-
-    // 1 byte has at most 3 decimal digits (plus 2 for '-' and the NULL character)
-    char buffer[sizeof(TInteger) * 3 + 2];
-    size_t len = snprintf(buffer, sizeof(buffer),
-                          TInt::VALUE, static_cast<typename TInt::Type>(i));
-    char *bufPtr = buffer;
+    // 1 byte has at most 3 decimal digits (plus 1 for '-')
+    char buffer[sizeof(TInteger) * 3 + 1];
+    char * bufEnd = buffer + sizeof(buffer);
+    char * bufPtr = _formatInteger(bufEnd, i, typename Is<UnsignedIntegerConcept<TInteger> >::Type());
+    size_t len = bufEnd - bufPtr;
     write(target, bufPtr, len);
     return len;
 }
@@ -1133,17 +1284,83 @@ appendNumber(TTarget & target, bool source)
 }
 
 // ----------------------------------------------------------------------------
-// Function appendNumber(float)
+// Function _formatDouble()
 // ----------------------------------------------------------------------------
+// Formats v exactly like printf("%g", v) for values whose magnitude is in [1e-4, 1e6), i.e. the values printed in
+// fixed-point notation with 6 significant digits, and returns the number of characters written.  Returns 0 for all
+// other values and if v is too close to the midpoint between two 6-digit decimals to decide the rounding direction
+// in double precision.  The caller falls back to snprintf() in these cases.
 
-template <typename TTarget>
-inline typename Size<TTarget>::Type
-appendNumber(TTarget & target, float source)
+inline size_t
+_formatDouble(char * buffer, double v)
 {
-    char buffer[32];
-    size_t len = snprintf(buffer, sizeof(buffer), "%g", source);
-    write(target, (char *)buffer, len);
-    return len;
+    static const double POW10[10] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9 };
+    static const double EXP10_BOUNDS[10] = { 1e-4, 1e-3, 1e-2, 1e-1, 1e0, 1e1, 1e2, 1e3, 1e4, 1e5 };
+
+    char * ptr = buffer;
+    __uint64 bits;
+    std::memcpy(&bits, &v, sizeof(bits));
+    if (bits >> 63)
+    {
+        *ptr++ = '-';
+        v = -v;
+    }
+    if (v == 0.0)
+    {
+        *ptr++ = '0';
+        return ptr - buffer;
+    }
+    if (!(v >= 1e-4 && v < 999999.5))       // also excludes NaN and infinity
+        return 0;
+
+    // Scale v to [1e5, 1e6) with a single rounding error, which is below 1e-10.
+    int exp10 = 5;
+    while (exp10 > -4 && v < EXP10_BOUNDS[exp10 + 4])
+        --exp10;
+    double scaled = v * POW10[5 - exp10];
+    double digits = std::floor(scaled);
+    double frac = scaled - digits;
+    if (frac > 0.5 - 1e-9 && frac < 0.5 + 1e-9)
+        return 0;
+
+    __uint32 n = static_cast<__uint32>(digits) + (frac > 0.5);
+    if (n >= 1000000u)
+    {
+        if (++exp10 > 5)
+            return 0;                       // rounds up to 1e+06
+        n = 100000u;
+    }
+    if (n < 100000u)
+        return 0;
+
+    char digitBuffer[6];
+    _formatUnsigned(digitBuffer + 6, n);
+    unsigned numDigits = 6;
+    while (digitBuffer[numDigits - 1] == '0')
+        --numDigits;
+
+    if (exp10 >= 0)
+    {
+        unsigned intDigits = exp10 + 1;
+        for (unsigned i = 0; i < intDigits; ++i)
+            *ptr++ = digitBuffer[i];
+        if (numDigits > intDigits)
+        {
+            *ptr++ = '.';
+            for (unsigned i = intDigits; i < numDigits; ++i)
+                *ptr++ = digitBuffer[i];
+        }
+    }
+    else
+    {
+        *ptr++ = '0';
+        *ptr++ = '.';
+        for (int i = -1; i > exp10; --i)
+            *ptr++ = '0';
+        for (unsigned i = 0; i < numDigits; ++i)
+            *ptr++ = digitBuffer[i];
+    }
+    return ptr - buffer;
 }
 
 // ----------------------------------------------------------------------------
@@ -1155,11 +1372,25 @@ inline typename Size<TTarget>::Type
 appendNumber(TTarget & target, double source)
 {
     char buffer[32];
-    size_t len = snprintf(buffer, sizeof(buffer), "%g", source);
+    size_t len = _formatDouble(buffer, source);
+    if (len == 0)
+        len = snprintf(buffer, sizeof(buffer), "%g", source);
     write(target, (char *)buffer, len);
     return len;
 }
 
+// ----------------------------------------------------------------------------
+// Function appendNumber(float)
+// ----------------------------------------------------------------------------
+
+template <typename TTarget>
+inline typename Size<TTarget>::Type
+appendNumber(TTarget & target, float source)
+{
+    // printf() promotes float to double as well.
+    return appendNumber(target, static_cast<double>(source));
+}
+
 // ----------------------------------------------------------------------------
 // Function appendNumber(double)
 // ----------------------------------------------------------------------------
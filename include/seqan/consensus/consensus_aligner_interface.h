@@ -141,8 +141,7 @@ void consensusAlignment(FragmentStore<TSpec, TConfig> & store,
     aligner.run();
 
     if (options.runRealignment)
-        for (unsigned contigID = 0; contigID < length(store.contigStore); ++contigID)
-            reAlignment(store, contigID, /*method=*/1, /*bandwidth=*/10, /*includeReference=*/false);
+        reAlignmentAllContigs(store, /*method=*/1, /*bandwidth=*/10, /*includeReference=*/false);
 }
 
 }  // namespace seqan
@@ -123,6 +123,10 @@ class File;
  * @val FileOpenMode OPEN_QUIET
  * @brief Don't print any warning message if the file could not be opened.
  *
+ * @val FileOpenMode OPEN_HUGEPAGES
+ * @brief Back memory mappings of the file with huge pages if the platform supports it.  This is only a hint and
+ *        ignored by files that are not memory-mapped, see @link FileMapping @endlink.
+ *
  * @val FileOpenMode OPEN_MASK
  * @brief (Internal) Bitmask to extract the read/write open mode.
  *
@@ -148,6 +152,7 @@ enum FileOpenMode {
     OPEN_APPEND     = 8,
     OPEN_ASYNC      = 16,
     OPEN_TEMPORARY    = 32,
+    OPEN_HUGEPAGES    = 64,
     OPEN_QUIET        = 128
 }; //IOREV is it intended that two labels share the same value? What is OPEN_MASK anyway?
 
@@ -632,6 +632,11 @@ adviseFileSegment(FileMapping<TSpec> &, FileMappingAdvise advise, void *addr, TP
  *
  * @return TPtr A pointer to the beginning of the memory-mapped segment in memory or <tt>NULL</tt> on error.  TPtr is
  *              <tt>void *</tt>.
+ *
+ * @section Remarks
+ *
+ * If the file was opened with <tt>OPEN_HUGEPAGES</tt>, the segment is mapped with <tt>MAP_HUGETLB</tt> if possible
+ * and otherwise advised to use transparent huge pages.  This has no effect on Windows.
  */
 
 template <typename TSpec, typename TPos, typename TSize, typename TFileMappingMode>
@@ -670,13 +675,27 @@ mapFileSegment(FileMapping<TSpec> &mapping, TPos fileOfs, TSize size, TFileMappi
     else
         flags |= MAP_SHARED;
 
-    addr = mmap(
-        NULL,
-        size,
-        prot,
-        flags,
-        mapping.file.handle,
-        fileOfs);
+    addr = MAP_FAILED;
+#ifdef MAP_HUGETLB
+    // MAP_HUGETLB only succeeds for files on a hugetlbfs mount, otherwise we fall back to a regular mapping.
+    if (mapping.openMode & OPEN_HUGEPAGES)
+        addr = mmap(NULL, size, prot, flags | MAP_HUGETLB, mapping.file.handle, fileOfs);
+#endif
+    if (addr == MAP_FAILED)
+    {
+        addr = mmap(
+            NULL,
+            size,
+            prot,
+            flags,
+            mapping.file.handle,
+            fileOfs);
+#ifdef MADV_HUGEPAGE
+        // Transparent huge pages are only a hint, thus we ignore the result.
+        if (addr != MAP_FAILED && (mapping.openMode & OPEN_HUGEPAGES))
+            madvise(addr, size, MADV_HUGEPAGE);
+#endif
+    }
 //    std::cerr << "mmap(0,"<<size<<','<<prot<<','<<flags<<','<<mapping.file.handle<<','<<fileOfs<<")="<<addr<<std::endl;
 
     if (addr == MAP_FAILED)
@@ -181,17 +181,18 @@ _findPickState(TStates & pool, True)
 }
 
 // ----------------------------------------------------------------------------
-// Function find(text, needles, errors, [](...){}, Algorithm(), Parallel());
+// Function _findEach()
 // ----------------------------------------------------------------------------
+// Searches the needles one after another.
 
 template <typename TText, typename TNeedle_, typename TSSetSpec,
           typename TThreshold, typename TDelegate, typename TAlgorithm, typename TThreading>
-inline void find(TText & text,
-                 StringSet<TNeedle_, TSSetSpec> const & needles,
-                 TThreshold threshold,
-                 TDelegate && delegate,
-                 TAlgorithm,
-                 TThreading)
+inline void _findEach(TText & text,
+                      StringSet<TNeedle_, TSSetSpec> const & needles,
+                      TThreshold threshold,
+                      TDelegate && delegate,
+                      TAlgorithm,
+                      TThreading)
 {
     typedef StringSet<TNeedle_, TSSetSpec> const                    TNeedles;
     typedef typename Value<TNeedles>::Type                          TNeedle;
@@ -219,6 +220,22 @@ inline void find(TText & text,
     Rooted(), TThreading());
 }
 
+// ----------------------------------------------------------------------------
+// Function find(text, needles, errors, [](...){}, Algorithm(), Parallel());
+// ----------------------------------------------------------------------------
+
+template <typename TText, typename TNeedle_, typename TSSetSpec,
+          typename TThreshold, typename TDelegate, typename TAlgorithm, typename TThreading>
+inline void find(TText & text,
+                 StringSet<TNeedle_, TSSetSpec> const & needles,
+                 TThreshold threshold,
+                 TDelegate && delegate,
+                 TAlgorithm,
+                 TThreading)
+{
+    _findEach(text, needles, threshold, delegate, TAlgorithm(), TThreading());
+}
+
 // ----------------------------------------------------------------------------
 // Function find(text, needles, errors, [](...){}, Algorithm());
 // ----------------------------------------------------------------------------
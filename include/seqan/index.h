@@ -63,6 +63,10 @@
 #include <nmmintrin.h>
 #endif
 
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
 // ==========================================================================
 // Index construction.
 // ==========================================================================
@@ -98,6 +102,7 @@
 #include <seqan/index/index_sa_mm.h>
 #include <seqan/index/index_sa_qsort.h>
 #include <seqan/index/index_sa_bwtwalk.h>
+#include <seqan/index/index_sa_prefix_doubling.h>
 
 #include <seqan/index/pump_extender3.h>
 #include <seqan/index/pipe_merger3.h>
@@ -147,6 +152,7 @@
 #include <seqan/index/index_fm_rank_dictionary_base.h>
 #include <seqan/index/index_fm_rank_dictionary_naive.h>
 #include <seqan/index/index_fm_rank_dictionary_levels.h>
+#include <seqan/index/index_fm_rank_dictionary_interleaved.h>
 #include <seqan/index/index_fm_right_array_binary_tree.h>
 #include <seqan/index/index_fm_right_array_binary_tree_iterator.h>
 #include <seqan/index/index_fm_rank_dictionary_wt.h>
@@ -166,6 +172,7 @@
 #include <seqan/index/index_fm_compressed_sa_iterator.h>
 #include <seqan/index/index_fm.h>
 #include <seqan/index/index_fm_stree.h>
+#include <seqan/index/index_fm_bidirectional.h>
 
 // ----------------------------------------------------------------------------
 // Suffix tree algorithms.
@@ -222,6 +229,7 @@
 
 #include <seqan/index/find2_base.h>
 #include <seqan/index/find2_index.h>
+#include <seqan/index/find2_search_schemes.h>
 #include <seqan/index/find2_backtracking.h>
 #include <seqan/index/find2_vstree_factory.h>
 #include <seqan/index/find2_index_multi.h>
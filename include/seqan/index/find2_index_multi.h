@@ -495,6 +495,80 @@ _find(Finder_<TText, TPattern, Multiple<TSpec> > & finder,
     }
 }
 
+// ----------------------------------------------------------------------------
+// Function _find()                                [Finder; FMIndex; ExecHost]
+// ----------------------------------------------------------------------------
+// Searches each batch of needles by _goDownStrings(), or each needle on its own if the index fits into the cache.
+// The FM-index is used directly since its fibres have no views.
+
+template <typename TText, typename TOccSpec, typename TIndexSpec, typename TPattern, typename TDelegate>
+inline void
+_find(Finder_<Index<TText, FMIndex<TOccSpec, TIndexSpec> >, TPattern, Multiple<FinderSTree> > & finder,
+      TPattern & pattern,
+      TDelegate & delegate,
+      ExecHost const & /* tag */)
+{
+    typedef Index<TText, FMIndex<TOccSpec, TIndexSpec> >                    TIndex;
+    typedef typename Needle<TPattern>::Type                                 TNeedles;
+    typedef typename Iterator<TNeedles const, Standard>::Type               TNeedlesIt;
+    typedef typename Size<TNeedles>::Type                                   TSize;
+    typedef FinderContext_<TIndex, TPattern, Multiple<FinderSTree>, TDelegate> TFinderContext;
+    typedef typename TextIterator_<TIndex, TPattern, FinderSTree>::Type     TTextIterator;
+
+    const TSize BATCH_SIZE = FindBatchSize_<TIndex, FinderSTree>::VALUE;
+
+    // Initialize the iterator factory.
+    _initFactory(finder, maxLength(needle(pattern), Parallel()) + 1, omp_get_max_threads());
+
+    TNeedles const & needles = needle(pattern);
+    TSize needlesCount = length(needles);
+    TSize batchesCount = (needlesCount + BATCH_SIZE - 1) / BATCH_SIZE;
+
+    // Instantiate a thread context.
+    // NOTE(esiragusa): Each thread initializes its private context on firstprivate.
+    TFinderContext ctx(finder, delegate);
+
+    if (!_findUseBatches(container(_textIterator(ctx.baseFinder)), FinderSTree()))
+    {
+        // Find all needles in parallel.
+        SEQAN_OMP_PRAGMA(parallel for schedule(dynamic) firstprivate(ctx))
+        for (TSize needleId = 0; needleId < needlesCount; ++needleId)
+        {
+            clear(ctx.baseFinder);
+            _setScoreThreshold(ctx.baseFinder, _getScoreThreshold(finder));
+            ctx._patternIt = needleId;
+            _find(ctx.baseFinder, needles[ctx._patternIt], ctx);
+        }
+        return;
+    }
+
+    // Find all batches of needles in parallel.
+    SEQAN_OMP_PRAGMA(parallel for schedule(dynamic) firstprivate(ctx))
+    for (TSize batchId = 0; batchId < batchesCount; ++batchId)
+    {
+        TSize batchBegin = batchId * BATCH_SIZE;
+        TSize batchEnd = _min(batchBegin + BATCH_SIZE, needlesCount);
+
+        String<TTextIterator> textIts;
+        String<TSize> lcps;
+
+        clear(ctx.baseFinder);
+        resize(textIts, batchEnd - batchBegin, _textIterator(ctx.baseFinder), Exact());
+        _goDownStrings(textIts, TNeedlesIt(begin(needles, Standard()) + batchBegin), lcps);
+
+        for (TSize k = 0; k < length(textIts); ++k)
+        {
+            ctx._patternIt = batchBegin + k;
+
+            if (lcps[k] == length(needles[ctx._patternIt]))
+            {
+                _textIterator(ctx.baseFinder) = textIts[k];
+                delegate(ctx);
+            }
+        }
+    }
+}
+
 // ----------------------------------------------------------------------------
 // Function _find()                                        [Finder; ExecDevice]
 // ----------------------------------------------------------------------------
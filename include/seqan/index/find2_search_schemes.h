@@ -0,0 +1,385 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2015, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Approximate string matching with search schemes on a bidirectional index.
+// ==========================================================================
+
+#ifndef INDEX_FIND2_SEARCH_SCHEMES_H_
+#define INDEX_FIND2_SEARCH_SCHEMES_H_
+
+namespace seqan {
+
+// ============================================================================
+// Tags
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Tag SearchSchemes
+// ----------------------------------------------------------------------------
+
+/*!
+ * @tag SearchSchemes
+ * @headerfile <seqan/index.h>
+ * @brief Finder specialisation for approximate search in a @link BidirectionalIndex @endlink.
+ *
+ * @signature template <typename TDistance, typename TSpec>
+ *            struct SearchSchemes;
+ *
+ * @tparam TDistance The distance. Types: HammingDistance, EditDistance. Defaults to HammingDistance.
+ * @tparam TSpec     Specialisation tag, defaults to <tt>void</tt>.
+ *
+ * The pattern is split into <tt>k+1</tt> parts for <tt>k</tt> errors.  Each search starts with an exact match of
+ * one part and extends it first to the left, then to the right.  The searches bound the cumulative errors such
+ * that each error distribution is enumerated by exactly one search.  Under the Hamming distance each occurrence is
+ * reported once, under the edit distance an occurrence can be reported once per alignment.
+ */
+
+template <typename TDistance = HammingDistance, typename TSpec = void>
+struct SearchSchemes {};
+
+// ============================================================================
+// Classes
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Class SearchScheme_
+// ----------------------------------------------------------------------------
+
+// The order in which the parts of the pattern are searched and the lower and
+// upper bounds on the errors accumulated after each part.
+struct SearchScheme_
+{
+    String<unsigned char>   pi;
+    String<unsigned char>   l;
+    String<unsigned char>   u;
+};
+
+// ============================================================================
+// Metafunctions
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Metafunction TextIterator_                                          [Finder]
+// ----------------------------------------------------------------------------
+
+template <typename TText, typename TIndexSpec, typename TPattern, typename TDistance, typename TSpec>
+struct TextIterator_<Index<TText, BidirectionalIndex<TIndexSpec> >, TPattern, SearchSchemes<TDistance, TSpec> >
+{
+    typedef typename Iterator<Index<TText, BidirectionalIndex<TIndexSpec> >, TopDown<> >::Type  Type;
+};
+
+// ============================================================================
+// Functions
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Function _extend()                                                [Iterator]
+// ----------------------------------------------------------------------------
+
+template <typename TIter, typename TValue>
+SEQAN_HOST_DEVICE inline bool
+_extend(TIter & it, TValue c, bool right)
+{
+    return right ? extendRight(it, c) : extendLeft(it, c);
+}
+
+// ----------------------------------------------------------------------------
+// Function _pigeonholeSearchSchemes()
+// ----------------------------------------------------------------------------
+
+// Search i covers the error distributions in which part i is the leftmost
+// part whose prefix (parts 0..i) contains at most i errors. Thus part i is
+// error-free, parts i..0 contain exactly i errors and every shorter prefix
+// 0..j-1 contains at least j errors. Search i starts with part i, extends to
+// the left until part 0 and finishes with the parts to the right of part i.
+// Every distribution of at most errors = parts - 1 errors is enumerated by
+// exactly one search.
+template <typename TSchemes>
+inline void
+_pigeonholeSearchSchemes(TSchemes & schemes, unsigned parts, unsigned errors)
+{
+    typedef typename Value<TSchemes>::Type  TScheme;
+
+    clear(schemes);
+
+    // Too short patterns are searched by plain backtracking.
+    if (parts <= errors)
+    {
+        TScheme scheme;
+        for (unsigned p = 0; p < parts; ++p)
+        {
+            appendValue(scheme.pi, p);
+            appendValue(scheme.l, 0);
+            appendValue(scheme.u, errors);
+        }
+        appendValue(schemes, scheme);
+        return;
+    }
+
+    for (unsigned i = 0; i < parts; ++i)
+    {
+        TScheme scheme;
+
+        appendValue(scheme.pi, i);
+        appendValue(scheme.l, 0);
+        appendValue(scheme.u, 0);
+
+        for (unsigned p = i; p > 0; --p)
+        {
+            appendValue(scheme.pi, p - 1);
+            appendValue(scheme.l, (p == 1) ? i : 0);
+            appendValue(scheme.u, i - p + 1);
+        }
+
+        for (unsigned p = i + 1; p < parts; ++p)
+        {
+            appendValue(scheme.pi, p);
+            appendValue(scheme.l, i);
+            appendValue(scheme.u, errors);
+        }
+
+        appendValue(schemes, scheme);
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Function _partBegin()
+// ----------------------------------------------------------------------------
+
+template <typename TSize>
+inline TSize _partBegin(TSize patternLength, unsigned parts, unsigned part)
+{
+    return patternLength * part / parts;
+}
+
+// ----------------------------------------------------------------------------
+// Function _findSearchSchemeReport()
+// ----------------------------------------------------------------------------
+
+template <typename TFinder, typename TIter, typename TDelegate>
+inline void
+_findSearchSchemeReport(TFinder & finder, TIter const & it, unsigned errors, TDelegate & delegate)
+{
+    if (isRoot(it)) return;
+
+    _textIterator(finder) = it;
+    finder._score = errors;
+    delegate(finder);
+}
+
+// ----------------------------------------------------------------------------
+// Function _findSearchScheme()                                   [Hamming]
+// ----------------------------------------------------------------------------
+
+// The pattern infix [patternBegin, patternEnd) has been matched so far.
+template <typename TFinder, typename TIter, typename TPattern, typename TSize, typename TDelegate>
+inline void
+_findSearchScheme(TFinder & finder, TIter const & it, TPattern const & pattern, SearchScheme_ const & scheme,
+                  TSize patternBegin, TSize patternEnd, unsigned step, unsigned errors,
+                  TDelegate & delegate, HammingDistance)
+{
+    typedef typename Value<typename Container<TIter>::Type>::Type   TAlphabet;
+
+    unsigned parts = length(scheme.pi);
+    unsigned part = scheme.pi[step];
+    bool right = step == 0 || part > scheme.pi[step - 1];
+    TSize partBegin = _partBegin(length(pattern), parts, part);
+    TSize partEnd = _partBegin(length(pattern), parts, part + 1);
+    TSize remaining = right ? partEnd - patternEnd : patternBegin - partBegin;
+
+    // The part is complete.
+    if (remaining == 0)
+    {
+        if (errors < scheme.l[step]) return;
+
+        if (step + 1 == parts)
+            _findSearchSchemeReport(finder, it, errors, delegate);
+        else
+            _findSearchScheme(finder, it, pattern, scheme, patternBegin, patternEnd, step + 1, errors, delegate,
+                              HammingDistance());
+        return;
+    }
+
+    // The lower bound cannot be reached anymore.
+    if (errors + remaining < scheme.l[step]) return;
+
+    TSize nextBegin = right ? patternBegin : patternBegin - 1;
+    TSize nextEnd = right ? patternEnd + 1 : patternEnd;
+    TAlphabet p = pattern[right ? patternEnd : patternBegin - 1];
+
+    // Exact case.
+    if (errors == scheme.u[step])
+    {
+        TIter next = it;
+        if (_extend(next, p, right))
+            _findSearchScheme(finder, next, pattern, scheme, nextBegin, nextEnd, step, errors, delegate,
+                              HammingDistance());
+        return;
+    }
+
+    // Approximate case.
+    for (TAlphabet c = 0; ordValue(c) < ValueSize<TAlphabet>::VALUE; ++c)
+    {
+        TIter next = it;
+        if (_extend(next, c, right))
+            _findSearchScheme(finder, next, pattern, scheme, nextBegin, nextEnd, step, errors + !ordEqual(c, p),
+                              delegate, HammingDistance());
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Function _findSearchScheme()                                      [Edit]
+// ----------------------------------------------------------------------------
+
+enum SearchSchemeEditOp_
+{
+    SEARCH_SCHEME_MATCH,
+    SEARCH_SCHEME_INSERTION,
+    SEARCH_SCHEME_DELETION
+};
+
+// Insertions consume a pattern symbol only, deletions a text symbol only.
+// Deletions are only allowed in front of a pattern symbol of the current part,
+// thus never at the ends of the pattern. An insertion directly followed by a
+// deletion or vice versa is a mismatch and is not enumerated.
+template <typename TFinder, typename TIter, typename TPattern, typename TSize, typename TDelegate>
+inline void
+_findSearchScheme(TFinder & finder, TIter const & it, TPattern const & pattern, SearchScheme_ const & scheme,
+                  TSize patternBegin, TSize patternEnd, unsigned step, unsigned errors,
+                  TDelegate & delegate, EditDistance, SearchSchemeEditOp_ lastOp = SEARCH_SCHEME_MATCH)
+{
+    typedef typename Value<typename Container<TIter>::Type>::Type   TAlphabet;
+
+    unsigned parts = length(scheme.pi);
+    unsigned part = scheme.pi[step];
+    bool right = step == 0 || part > scheme.pi[step - 1];
+    TSize partBegin = _partBegin(length(pattern), parts, part);
+    TSize partEnd = _partBegin(length(pattern), parts, part + 1);
+    TSize remaining = right ? partEnd - patternEnd : patternBegin - partBegin;
+
+    // The part is complete.
+    if (remaining == 0)
+    {
+        if (errors < scheme.l[step]) return;
+
+        if (step + 1 == parts)
+            _findSearchSchemeReport(finder, it, errors, delegate);
+        else
+            _findSearchScheme(finder, it, pattern, scheme, patternBegin, patternEnd, step + 1, errors, delegate,
+                              EditDistance());
+        return;
+    }
+
+    // Deletions add errors without consuming the pattern, thus the lower
+    // bound cannot be used for pruning before the part is complete.
+    TSize nextBegin = right ? patternBegin : patternBegin - 1;
+    TSize nextEnd = right ? patternEnd + 1 : patternEnd;
+    TAlphabet p = pattern[right ? patternEnd : patternBegin - 1];
+
+    // Exact case.
+    if (errors == scheme.u[step])
+    {
+        TIter next = it;
+        if (_extend(next, p, right))
+            _findSearchScheme(finder, next, pattern, scheme, nextBegin, nextEnd, step, errors, delegate,
+                              EditDistance());
+        return;
+    }
+
+    // Match or mismatch.
+    for (TAlphabet c = 0; ordValue(c) < ValueSize<TAlphabet>::VALUE; ++c)
+    {
+        TIter next = it;
+        if (_extend(next, c, right))
+            _findSearchScheme(finder, next, pattern, scheme, nextBegin, nextEnd, step, errors + !ordEqual(c, p),
+                              delegate, EditDistance());
+    }
+
+    // Insertion.
+    if (lastOp != SEARCH_SCHEME_DELETION)
+        _findSearchScheme(finder, it, pattern, scheme, nextBegin, nextEnd, step, errors + 1, delegate,
+                          EditDistance(), SEARCH_SCHEME_INSERTION);
+
+    // Deletion.
+    if (lastOp != SEARCH_SCHEME_INSERTION)
+    {
+        for (TAlphabet c = 0; ordValue(c) < ValueSize<TAlphabet>::VALUE; ++c)
+        {
+            TIter next = it;
+            if (_extend(next, c, right))
+                _findSearchScheme(finder, next, pattern, scheme, patternBegin, patternEnd, step, errors + 1,
+                                  delegate, EditDistance(), SEARCH_SCHEME_DELETION);
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Function _find()                                                    [Finder]
+// ----------------------------------------------------------------------------
+
+template <typename TText, typename TIndexSpec, typename TPattern, typename TDistance, typename TSpec,
+          typename TDelegate>
+inline void
+_find(Finder_<Index<TText, BidirectionalIndex<TIndexSpec> >, TPattern, SearchSchemes<TDistance, TSpec> > & finder,
+      TPattern const & pattern,
+      TDelegate & delegate)
+{
+    typedef Index<TText, BidirectionalIndex<TIndexSpec> >                   TIndex;
+    typedef SearchSchemes<TDistance, TSpec>                                 TFinderSpec;
+    typedef typename TextIterator_<TIndex, TPattern, TFinderSpec>::Type     TTextIterator;
+    typedef typename Size<TPattern>::Type                                   TPatternSize;
+
+    TPatternSize patternLength = length(pattern);
+
+    if (patternLength == 0) return;
+
+    unsigned errors = _getScoreThreshold(finder);
+    unsigned parts = (patternLength < errors + 1) ? (unsigned)patternLength : errors + 1;
+
+    String<SearchScheme_> schemes;
+    _pigeonholeSearchSchemes(schemes, parts, errors);
+
+    TTextIterator root = _textIterator(finder);
+    goRoot(root);
+
+    for (unsigned i = 0; i < length(schemes); ++i)
+    {
+        TPatternSize patternBegin = _partBegin(patternLength, parts, schemes[i].pi[0]);
+        _findSearchScheme(finder, root, pattern, schemes[i], patternBegin, patternBegin, 0u, 0u, delegate,
+                          TDistance());
+    }
+
+    _textIterator(finder) = root;
+}
+
+}
+
+#endif  // #ifndef INDEX_FIND2_SEARCH_SCHEMES_H_
@@ -79,6 +79,65 @@ _findImpl(TState & /* state */,
     }
 }
 
+// ----------------------------------------------------------------------------
+// Function find(fmIndex, needles, errors, [](...){}, Backtracking<Exact>(), Parallel());
+// ----------------------------------------------------------------------------
+// Exact backward searches in large indices are bound by memory latency, thus the needles are searched in batches by
+// _goDownStrings(), which overlaps the cache misses of the needles within a batch.  Indices that fit into the cache
+// are searched one needle after another.
+
+template <typename TText, typename TOccSpec, typename TIndexSpec, typename TNeedle_, typename TSSetSpec,
+          typename TThreshold, typename TDelegate, typename TSpec, typename TThreading>
+inline void find(Index<TText, FMIndex<TOccSpec, TIndexSpec> > & index,
+                 StringSet<TNeedle_, TSSetSpec> const & needles,
+                 TThreshold /* threshold */,
+                 TDelegate && delegate,
+                 Backtracking<Exact, TSpec>,
+                 TThreading)
+{
+    typedef Index<TText, FMIndex<TOccSpec, TIndexSpec> >        TIndex;
+    typedef typename Iterator<TIndex, TopDown<> >::Type         TIndexIt;
+    typedef StringSet<TNeedle_, TSSetSpec> const                TNeedles;
+    typedef typename Iterator<TNeedles, Rooted>::Type           TNeedlesIt;
+    typedef typename Position<TNeedles>::Type                   TPos;
+    typedef typename Size<TNeedle_>::Type                       TSize;
+
+    const TPos BATCH_SIZE = FindBatchSize_<TIndex, Backtracking<Exact, TSpec> >::VALUE;
+
+    if (!_findUseBatches(index, Backtracking<Exact, TSpec>()))
+    {
+        _findEach(index, needles, TThreshold(), delegate, Backtracking<Exact, TSpec>(), TThreading());
+        return;
+    }
+
+    Splitter<TPos> splitter(0, length(needles), TThreading());
+
+    SEQAN_OMP_PRAGMA(parallel for if(IsSameType<TThreading, Parallel>::VALUE))
+    for (TPos i = 0; i < length(splitter); ++i)
+    {
+        String<TIndexIt> indexIts;
+        String<TSize> lcps;
+        TNeedlesIt needlesBegin = begin(needles, Rooted());
+
+        for (TPos batchBegin = splitter[i]; batchBegin < splitter[i + 1]; batchBegin += BATCH_SIZE)
+        {
+            TPos batchEnd = _min(batchBegin + BATCH_SIZE, splitter[i + 1]);
+
+            clear(indexIts);
+            resize(indexIts, batchEnd - batchBegin, TIndexIt(index), Exact());
+            _goDownStrings(indexIts, needlesBegin + batchBegin, lcps);
+
+            for (TPos k = 0; k < length(indexIts); ++k)
+            {
+                TNeedlesIt const needlesIt = needlesBegin + (batchBegin + k);
+
+                if (lcps[k] == length(value(needlesIt)))
+                    delegate(indexIts[k], needlesIt, TThreshold());
+            }
+        }
+    }
+}
+
 // ----------------------------------------------------------------------------
 // Function _findImpl(..., Backtracking<Edit/HammingDistance>)
 // ----------------------------------------------------------------------------
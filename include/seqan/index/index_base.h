@@ -51,6 +51,8 @@ namespace SEQAN_NAMESPACE_MAIN
     struct ManberMyers;
     struct SAQSort;
     struct QGramAlg;
+    template <typename TParallel>
+    struct PrefixDoubling;
 
     // inverse suffix array construction specs
     template <typename TParallel>
@@ -363,27 +363,17 @@ _findFirstIndex(Finder<Index<TText, FMIndex<TSpec, TConfig> >, TSpecFinder> & fi
 // Function indexCreate()
 // ----------------------------------------------------------------------------
 
-template <typename TText, typename TSpec, typename TConfig>
-inline bool indexCreate(Index<TText, FMIndex<TSpec, TConfig> > & index, FibreSALF)
+template <typename TText, typename TSpec, typename TConfig, typename TTempSA, typename TParallel>
+inline bool _indexCreateLFSA(Index<TText, FMIndex<TSpec, TConfig> > & index, TTempSA const & tempSA,
+                             Tag<TParallel> const & parallelTag)
 {
     typedef Index<TText, FMIndex<TSpec, TConfig> >               TIndex;
-    typedef typename Fibre<TIndex, FibreTempSA>::Type            TTempSA;
     typedef typename Size<TIndex>::Type                          TSize;
-    typedef typename DefaultIndexCreator<TIndex, FibreSA>::Type  TAlgo;
 
     TText const & text = indexText(index);
 
-    if (empty(text))
-        return false;
-
-    TTempSA tempSA;
-
-    // Create the full SA.
-    resize(tempSA, lengthSum(text), Exact());
-    createSuffixArray(tempSA, text, TAlgo());
-
     // Create the LF table.
-    createLF(indexLF(index), text, tempSA);
+    createLF(indexLF(index), text, tempSA, parallelTag);
 
     // Set the FMIndex LF as the CompressedSA LF.
     setFibre(indexSA(index), indexLF(index), FibreLF());
@@ -395,6 +385,75 @@ inline bool indexCreate(Index<TText, FMIndex<TSpec, TConfig> > & index, FibreSAL
     return true;
 }
 
+template <typename TText, typename TSpec, typename TConfig, typename TTempSA, typename TAlgo, typename TParallel>
+inline bool _indexCreateSALF(Index<TText, FMIndex<TSpec, TConfig> > & index, TTempSA & tempSA, TAlgo const & algo,
+                             Tag<TParallel> const & parallelTag)
+{
+    TText const & text = indexText(index);
+
+    if (empty(text))
+        return false;
+
+    // Create the full SA.
+    resize(tempSA, lengthSum(text), Exact());
+    createSuffixArray(tempSA, text, algo);
+
+    return _indexCreateLFSA(index, tempSA, parallelTag);
+}
+
+template <typename TText, typename TSpec, typename TConfig, typename TAlgo>
+inline bool indexCreate(Index<TText, FMIndex<TSpec, TConfig> > & index, FibreSALF, TAlgo const & algo)
+{
+    typename Fibre<Index<TText, FMIndex<TSpec, TConfig> >, FibreTempSA>::Type tempSA;
+    return _indexCreateSALF(index, tempSA, algo, Serial());
+}
+
+// The pools of the external SA construction are bounded by the given parameters.
+template <typename TText, typename TSpec, typename TConfig, typename TAlgo>
+inline bool indexCreate(Index<TText, FMIndex<TSpec, TConfig> > & index, FibreSALF, TAlgo const & algo,
+                        PoolParameters const & conf)
+{
+    typename Fibre<Index<TText, FMIndex<TSpec, TConfig> >, FibreTempSA>::Type tempSA;
+    TText const & text = indexText(index);
+
+    if (empty(text))
+        return false;
+
+    // Create the full SA.
+    resize(tempSA, lengthSum(text), Exact());
+    createSuffixArray(tempSA, text, algo, conf);
+
+    return _indexCreateLFSA(index, tempSA, Serial());
+}
+
+// The parallel construction keeps the temporary SA in memory.
+template <typename TText, typename TSpec, typename TConfig, typename TParallel>
+inline bool indexCreate(Index<TText, FMIndex<TSpec, TConfig> > & index, FibreSALF, PrefixDoubling<TParallel> const & algo)
+{
+    String<typename SAValue<Index<TText, FMIndex<TSpec, TConfig> > >::Type> tempSA;
+    return _indexCreateSALF(index, tempSA, algo, TParallel());
+}
+
+template <typename TText, typename TSpec, typename TConfig>
+inline bool indexCreate(Index<TText, FMIndex<TSpec, TConfig> > & index, FibreSALF)
+{
+    typedef typename DefaultIndexCreator<Index<TText, FMIndex<TSpec, TConfig> >, FibreSA>::Type  TAlgo;
+    return indexCreate(index, FibreSALF(), TAlgo());
+}
+
+template <typename TText, typename TSpec, typename TConfig, typename TAlgo>
+inline bool indexCreate(Index<TText, FMIndex<TSpec, TConfig> > & index, FibreSA, TAlgo const & algo)
+{
+    return indexCreate(index, FibreSALF(), algo);
+}
+
+template <typename TText, typename TSpec, typename TConfig, typename TAlgo>
+inline bool indexCreate(Index<TText, FMIndex<TSpec, TConfig> > & index, FibreSA, TAlgo const & algo,
+                        PoolParameters const & conf)
+{
+    return indexCreate(index, FibreSALF(), algo, conf);
+}
+
 template <typename TText, typename TSpec, typename TConfig>
 inline bool indexCreate(Index<TText, FMIndex<TSpec, TConfig> > & index, FibreSA)
 {
@@ -0,0 +1,511 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2015, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Bidirectional FM index.
+// ==========================================================================
+
+#ifndef INDEX_FM_BIDIRECTIONAL_H_
+#define INDEX_FM_BIDIRECTIONAL_H_
+
+namespace seqan {
+
+// ============================================================================
+// Tags
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Tag BidirectionalIndex
+// ----------------------------------------------------------------------------
+
+/*!
+ * @class BidirectionalIndex
+ * @extends Index
+ * @headerfile <seqan/index.h>
+ * @brief A pair of FM indices over a text and its reverse, allowing to extend a match to both sides.
+ *
+ * @signature template <typename TText, typename TIndexSpec>
+ *            class Index<TText, BidirectionalIndex<TIndexSpec> >;
+ *
+ * @tparam TText      The text type. Types: @link String @endlink, @link StringSet @endlink
+ * @tparam TIndexSpec The specialisation of both underlying indices, defaults to <tt>FMIndex&lt;&gt;</tt>.
+ *
+ * The forward index is built over the text, the reverse index over the text with each sequence reversed.
+ * Backward search in the forward index extends a match to the left, backward search in the reverse index extends
+ * it to the right.  The iterator of a bidirectional index keeps the suffix array ranges of both indices in sync.
+ */
+
+template <typename TIndexSpec = FMIndex<> >
+struct BidirectionalIndex {};
+
+// ----------------------------------------------------------------------------
+// Tag BidirectionalIndexIterator
+// ----------------------------------------------------------------------------
+
+template <typename TSpec = TopDown<> >
+struct BidirectionalIndexIterator {};
+
+// ============================================================================
+// Classes
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Class VertexBidirectionalFM
+// ----------------------------------------------------------------------------
+
+template <typename TSize>
+struct VertexBidirectionalFM
+{
+    Pair<TSize> range;
+    Pair<TSize> revRange;
+    TSize       repLen;
+
+    SEQAN_HOST_DEVICE
+    VertexBidirectionalFM() :
+        range(0, 0),
+        revRange(0, 0),
+        repLen(0)
+    {}
+
+    SEQAN_HOST_DEVICE
+    VertexBidirectionalFM(Pair<TSize> const & newRange, Pair<TSize> const & newRevRange, TSize newRepLen) :
+        range(newRange),
+        revRange(newRevRange),
+        repLen(newRepLen)
+    {}
+};
+
+// ============================================================================
+// Metafunctions
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Metafunction VertexDescriptor                                        [Index]
+// ----------------------------------------------------------------------------
+
+template <typename TText, typename TIndexSpec>
+struct VertexDescriptor<Index<TText, BidirectionalIndex<TIndexSpec> > >
+{
+    typedef Index<TText, BidirectionalIndex<TIndexSpec> >   TIndex_;
+    typedef typename Size<TIndex_>::Type                    TSize_;
+
+    typedef VertexBidirectionalFM<TSize_>                   Type;
+};
+
+// ----------------------------------------------------------------------------
+// Metafunction Iterator                                                [Index]
+// ----------------------------------------------------------------------------
+
+template <typename TText, typename TIndexSpec, typename TSpec>
+struct Iterator<Index<TText, BidirectionalIndex<TIndexSpec> >, TopDown<TSpec> >
+{
+    typedef Iter<Index<TText, BidirectionalIndex<TIndexSpec> >, BidirectionalIndexIterator<TopDown<TSpec> > > Type;
+};
+
+// ----------------------------------------------------------------------------
+// Class BidirectionalIndex
+// ----------------------------------------------------------------------------
+
+template <typename TText, typename TIndexSpec>
+class Index<TText, BidirectionalIndex<TIndexSpec> >
+{
+public:
+    Index<TText, TIndexSpec>    fwd;
+    Index<TText, TIndexSpec>    rev;
+
+    Index() {}
+
+    Index(TText & text) :
+        fwd(text)
+    {}
+};
+
+// ----------------------------------------------------------------------------
+// Class BidirectionalIndexIterator
+// ----------------------------------------------------------------------------
+
+template <typename TIndex, typename TSpec>
+class Iter<TIndex, BidirectionalIndexIterator<TopDown<TSpec> > >
+{
+public:
+    typedef typename VertexDescriptor<TIndex>::Type     TVertexDesc;
+
+    TIndex *        index;
+    TVertexDesc     vDesc;
+
+    SEQAN_HOST_DEVICE
+    Iter() :
+        index()
+    {}
+
+    Iter(TIndex & _index) :
+        index(&_index)
+    {
+        _indexRequireTopDownIteration(_index);
+        goRoot(*this);
+    }
+};
+
+// ============================================================================
+// Functions
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Function clear()                                                     [Index]
+// ----------------------------------------------------------------------------
+
+template <typename TText, typename TIndexSpec>
+inline void clear(Index<TText, BidirectionalIndex<TIndexSpec> > & index)
+{
+    clear(index.fwd);
+    clear(index.rev);
+}
+
+// ----------------------------------------------------------------------------
+// Function empty()                                                     [Index]
+// ----------------------------------------------------------------------------
+
+template <typename TText, typename TIndexSpec>
+inline bool empty(Index<TText, BidirectionalIndex<TIndexSpec> > const & index)
+{
+    return empty(index.fwd) && empty(index.rev);
+}
+
+// ----------------------------------------------------------------------------
+// Function indexCreate()                                               [Index]
+// ----------------------------------------------------------------------------
+
+template <typename TText, typename TIndexSpec>
+inline bool indexCreate(Index<TText, BidirectionalIndex<TIndexSpec> > & index, FibreSALF)
+{
+    // The reverse index owns a copy of the text with each sequence reversed.
+    indexText(index.rev) = indexText(index.fwd);
+    reverse(indexText(index.rev));
+
+    return indexCreate(index.fwd, FibreSALF()) && indexCreate(index.rev, FibreSALF());
+}
+
+template <typename TText, typename TIndexSpec>
+inline bool indexCreate(Index<TText, BidirectionalIndex<TIndexSpec> > & index)
+{
+    return indexCreate(index, FibreSALF());
+}
+
+// ----------------------------------------------------------------------------
+// Function indexSupplied()                                             [Index]
+// ----------------------------------------------------------------------------
+
+template <typename TText, typename TIndexSpec>
+inline bool indexSupplied(Index<TText, BidirectionalIndex<TIndexSpec> > & index, FibreSALF const)
+{
+    return indexSupplied(index.fwd, FibreSALF()) && indexSupplied(index.rev, FibreSALF());
+}
+
+template <typename TText, typename TIndexSpec>
+inline bool indexSupplied(Index<TText, BidirectionalIndex<TIndexSpec> > const & index, FibreSALF const)
+{
+    return indexSupplied(index.fwd, FibreSALF()) && indexSupplied(index.rev, FibreSALF());
+}
+
+// ----------------------------------------------------------------------------
+// Function _indexRequireTopDownIteration()                             [Index]
+// ----------------------------------------------------------------------------
+
+template <typename TText, typename TIndexSpec>
+inline void _indexRequireTopDownIteration(Index<TText, BidirectionalIndex<TIndexSpec> > & index)
+{
+    indexRequire(index, FibreSALF());
+}
+
+// ----------------------------------------------------------------------------
+// Function open()                                                      [Index]
+// ----------------------------------------------------------------------------
+
+// The reverse index is stored next to the forward index with the additional suffix ".rev".
+template <typename TText, typename TIndexSpec>
+inline bool open(Index<TText, BidirectionalIndex<TIndexSpec> > & index, const char * fileName, int openMode)
+{
+    String<char> name;
+
+    name = fileName;
+    if (!open(index.fwd, toCString(name), openMode)) return false;
+
+    append(name, ".rev");
+    if (!open(index.rev, toCString(name), openMode)) return false;
+
+    return true;
+}
+
+template <typename TText, typename TIndexSpec>
+inline bool open(Index<TText, BidirectionalIndex<TIndexSpec> > & index, const char * fileName)
+{
+    return open(index, fileName, DefaultOpenMode<Index<TText, TIndexSpec> >::VALUE);
+}
+
+// ----------------------------------------------------------------------------
+// Function save()                                                      [Index]
+// ----------------------------------------------------------------------------
+
+template <typename TText, typename TIndexSpec>
+inline bool save(Index<TText, BidirectionalIndex<TIndexSpec> > const & index, const char * fileName, int openMode)
+{
+    String<char> name;
+
+    name = fileName;
+    if (!save(index.fwd, toCString(name), openMode)) return false;
+
+    append(name, ".rev");
+    if (!save(index.rev, toCString(name), openMode)) return false;
+
+    return true;
+}
+
+template <typename TText, typename TIndexSpec>
+inline bool save(Index<TText, BidirectionalIndex<TIndexSpec> > const & index, const char * fileName)
+{
+    return save(index, fileName, DefaultOpenMode<Index<TText, TIndexSpec> >::VALUE);
+}
+
+// ----------------------------------------------------------------------------
+// Function _countSentinels()                                              [LF]
+// ----------------------------------------------------------------------------
+
+template <typename TText, typename TSpec, typename TConfig, typename TPos>
+SEQAN_HOST_DEVICE inline typename Size<LF<TText, TSpec, TConfig> const>::Type
+_countSentinels(LF<TText, TSpec, TConfig> const & lf, TPos i1, TPos i2)
+{
+    return i1 <= lf.sentinels && lf.sentinels < i2;
+}
+
+template <typename TText, typename TSSetSpec, typename TSpec, typename TConfig, typename TPos>
+SEQAN_HOST_DEVICE inline typename Size<LF<StringSet<TText, TSSetSpec>, TSpec, TConfig> const>::Type
+_countSentinels(LF<StringSet<TText, TSSetSpec>, TSpec, TConfig> const & lf, TPos i1, TPos i2)
+{
+    typedef typename Size<LF<StringSet<TText, TSSetSpec>, TSpec, TConfig> const>::Type TSize;
+
+    TSize count = (i2 > 0) ? _getSentinelsRank(lf, i2 - 1) : 0;
+    if (i1 > 0) count -= _getSentinelsRank(lf, i1 - 1);
+
+    return count;
+}
+
+// ----------------------------------------------------------------------------
+// Function _extendSync()                                                  [LF]
+// ----------------------------------------------------------------------------
+
+// Backward search by c on the ranges of one index and update of the range of
+// the opposite index. Within the old range the occurrences followed by c come
+// after those followed by a sentinel or by any symbol smaller than c.
+template <typename TLF, typename TSize, typename TValue>
+SEQAN_HOST_DEVICE inline bool
+_extendSync(TLF const & lf, Pair<TSize> & range, Pair<TSize> & syncRange, TValue c)
+{
+    typedef typename Value<TLF const>::Type     TAlphabet;
+
+    TSize i1 = lf(range.i1, c);
+    TSize i2 = lf(range.i2, c);
+
+    if (i1 >= i2) return false;
+
+    TSize smaller = _countSentinels(lf, range.i1, range.i2);
+    for (TAlphabet x = 0; ordLess(x, c); ++x)
+        smaller += lf(range.i2, x) - lf(range.i1, x);
+
+    syncRange.i1 += smaller;
+    syncRange.i2 = syncRange.i1 + (i2 - i1);
+    range.i1 = i1;
+    range.i2 = i2;
+
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+// Function container()                                              [Iterator]
+// ----------------------------------------------------------------------------
+
+template <typename TIndex, typename TSpec>
+SEQAN_HOST_DEVICE inline TIndex &
+container(Iter<TIndex, BidirectionalIndexIterator<TopDown<TSpec> > > const & it)
+{
+    return *it.index;
+}
+
+// ----------------------------------------------------------------------------
+// Function value()                                                  [Iterator]
+// ----------------------------------------------------------------------------
+
+template <typename TIndex, typename TSpec>
+SEQAN_HOST_DEVICE inline typename VertexDescriptor<TIndex>::Type &
+value(Iter<TIndex, BidirectionalIndexIterator<TopDown<TSpec> > > & it)
+{
+    return it.vDesc;
+}
+
+template <typename TIndex, typename TSpec>
+SEQAN_HOST_DEVICE inline typename VertexDescriptor<TIndex>::Type const &
+value(Iter<TIndex, BidirectionalIndexIterator<TopDown<TSpec> > > const & it)
+{
+    return it.vDesc;
+}
+
+// ----------------------------------------------------------------------------
+// Function goRoot()                                                 [Iterator]
+// ----------------------------------------------------------------------------
+
+template <typename TIndex, typename TSpec>
+SEQAN_HOST_DEVICE inline void
+goRoot(Iter<TIndex, BidirectionalIndexIterator<TopDown<TSpec> > > & it)
+{
+    typedef typename Size<TIndex>::Type     TSize;
+
+    value(it).range = Pair<TSize>(0, length(indexSA(container(it).fwd)));
+    value(it).revRange = Pair<TSize>(0, length(indexSA(container(it).rev)));
+    value(it).repLen = 0;
+}
+
+// ----------------------------------------------------------------------------
+// Function isRoot()                                                 [Iterator]
+// ----------------------------------------------------------------------------
+
+template <typename TIndex, typename TSpec>
+SEQAN_HOST_DEVICE inline bool
+isRoot(Iter<TIndex, BidirectionalIndexIterator<TopDown<TSpec> > > const & it)
+{
+    return value(it).repLen == 0;
+}
+
+// ----------------------------------------------------------------------------
+// Function repLength()                                              [Iterator]
+// ----------------------------------------------------------------------------
+
+template <typename TIndex, typename TSpec>
+SEQAN_HOST_DEVICE inline typename Size<TIndex>::Type
+repLength(Iter<TIndex, BidirectionalIndexIterator<TopDown<TSpec> > > const & it)
+{
+    return value(it).repLen;
+}
+
+// ----------------------------------------------------------------------------
+// Function range()                                                  [Iterator]
+// ----------------------------------------------------------------------------
+
+template <typename TIndex, typename TSpec>
+SEQAN_HOST_DEVICE inline Pair<typename Size<TIndex>::Type>
+range(Iter<TIndex, BidirectionalIndexIterator<TopDown<TSpec> > > const & it)
+{
+    return value(it).range;
+}
+
+// ----------------------------------------------------------------------------
+// Function countOccurrences()                                       [Iterator]
+// ----------------------------------------------------------------------------
+
+template <typename TIndex, typename TSpec>
+SEQAN_HOST_DEVICE inline typename Size<TIndex>::Type
+countOccurrences(Iter<TIndex, BidirectionalIndexIterator<TopDown<TSpec> > > const & it)
+{
+    return value(it).range.i2 - value(it).range.i1;
+}
+
+// ----------------------------------------------------------------------------
+// Function getOccurrences()                                         [Iterator]
+// ----------------------------------------------------------------------------
+
+// The occurrences are the begin positions of the representative in the text.
+template <typename TText, typename TIndexSpec, typename TSpec>
+inline typename Infix<typename Fibre<Index<TText, TIndexSpec>, FibreSA>::Type const>::Type
+getOccurrences(Iter<Index<TText, BidirectionalIndex<TIndexSpec> >, BidirectionalIndexIterator<TopDown<TSpec> > > const & it)
+{
+    Index<TText, TIndexSpec> const & index = container(it).fwd;
+
+    return infix(indexSA(index), value(it).range.i1, value(it).range.i2);
+}
+
+// ----------------------------------------------------------------------------
+// Function extendLeft()                                             [Iterator]
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn BidirectionalIndex#extendLeft
+ * @headerfile <seqan/index.h>
+ * @brief Prepends a symbol to the representative of a bidirectional index iterator.
+ *
+ * @signature bool extendLeft(iterator, c);
+ *
+ * @param[in,out] iterator A top down iterator of a @link BidirectionalIndex @endlink.
+ * @param[in]     c        The symbol to prepend.
+ *
+ * @return bool <tt>true</tt> if the extended representative occurs in the text, otherwise the iterator is left
+ *              unchanged and <tt>false</tt> is returned.
+ */
+
+template <typename TIndex, typename TSpec, typename TValue>
+SEQAN_HOST_DEVICE inline bool
+extendLeft(Iter<TIndex, BidirectionalIndexIterator<TopDown<TSpec> > > & it, TValue c)
+{
+    if (!_extendSync(indexLF(container(it).fwd), value(it).range, value(it).revRange, c))
+        return false;
+
+    value(it).repLen++;
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+// Function extendRight()                                            [Iterator]
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn BidirectionalIndex#extendRight
+ * @headerfile <seqan/index.h>
+ * @brief Appends a symbol to the representative of a bidirectional index iterator.
+ *
+ * @signature bool extendRight(iterator, c);
+ *
+ * @param[in,out] iterator A top down iterator of a @link BidirectionalIndex @endlink.
+ * @param[in]     c        The symbol to append.
+ *
+ * @return bool <tt>true</tt> if the extended representative occurs in the text, otherwise the iterator is left
+ *              unchanged and <tt>false</tt> is returned.
+ */
+
+template <typename TIndex, typename TSpec, typename TValue>
+SEQAN_HOST_DEVICE inline bool
+extendRight(Iter<TIndex, BidirectionalIndexIterator<TopDown<TSpec> > > & it, TValue c)
+{
+    if (!_extendSync(indexLF(container(it).rev), value(it).revRange, value(it).range, c))
+        return false;
+
+    value(it).repLen++;
+    return true;
+}
+
+}
+
+#endif  // #ifndef INDEX_FM_BIDIRECTIONAL_H_
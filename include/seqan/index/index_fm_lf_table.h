@@ -453,6 +453,19 @@ _getBwtRank(LF<TText, TSpec, TConfig> const & lf, TPos pos, TValue val)
     return rank;
 }
 
+// ----------------------------------------------------------------------------
+// Function _prefetchBwtRank(pos)
+// ----------------------------------------------------------------------------
+// Hints the cache about the bwt rank blocks read by a subsequent lf(pos, val).
+
+template <typename TText, typename TSpec, typename TConfig, typename TPos>
+SEQAN_HOST_DEVICE inline void
+_prefetchBwtRank(LF<TText, TSpec, TConfig> const & lf, TPos pos)
+{
+    if (pos > 0)
+        _prefetchRank(lf.bwt, pos - 1);
+}
+
 // ----------------------------------------------------------------------------
 // Function _getBwtRank(pos)
 // ----------------------------------------------------------------------------
@@ -584,6 +597,107 @@ _createBwt(LF<StringSet<TText, TSSetSpec>, TSpec, TConfig> & lf, TBwt & bwt, TOt
     updateRanks(lf.sentinels);
 }
 
+// ----------------------------------------------------------------------------
+// Function _createBwt()                                             [Parallel]
+// ----------------------------------------------------------------------------
+// This function computes the BWT of a text in parallel. The BWT must reside in memory.
+
+template <typename TText, typename TSpec, typename TConfig, typename TBwt, typename TOtherText, typename TSA>
+inline void
+_createBwt(LF<TText, TSpec, TConfig> & lf, TBwt & bwt, TOtherText const & text, TSA const & sa, Parallel)
+{
+    typedef typename GetValue<TSA>::Type                    TSAValue;
+    typedef typename Size<TSA>::Type                        TSize;
+    typedef typename MakeSigned<TSize>::Type                TSignedSize;
+
+    assignValue(bwt, 0, back(text));
+
+    Splitter<TSize> splitter(0, length(sa), Parallel());
+
+    SEQAN_OMP_PRAGMA(parallel for)
+    for (TSignedSize job = 0; job < static_cast<TSignedSize>(length(splitter)); ++job)
+    {
+        for (TSize i = splitter[job]; i < splitter[job + 1]; ++i)
+        {
+            TSAValue pos = getValue(sa, i);
+
+            if (pos != 0)
+            {
+                assignValue(bwt, i + 1, getValue(text, pos - 1));
+            }
+            else
+            {
+                assignValue(bwt, i + 1, lf.sentinelSubstitute);
+                lf.sentinels = i + 1;
+            }
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Function _createBwt()                                             [Parallel]
+// ----------------------------------------------------------------------------
+// This function computes the BWT of a text collection in parallel. The sentinels are marked afterwards in a
+// sequential scan over the suffix array.
+
+template <typename TText, typename TSSetSpec, typename TSpec, typename TConfig, typename TBwt, typename TOtherText, typename TSA>
+inline void
+_createBwt(LF<StringSet<TText, TSSetSpec>, TSpec, TConfig> & lf, TBwt & bwt, TOtherText const & text, TSA const & sa,
+           Parallel)
+{
+    typedef typename Value<TSA>::Type                       TSAValue;
+    typedef typename Size<TSA>::Type                        TSize;
+    typedef typename MakeSigned<TSize>::Type                TSignedSize;
+
+    TSize seqNum = countSequences(text);
+    TSize totalLen = lengthSum(text);
+
+    resize(lf.sentinels, seqNum + totalLen, Exact());
+
+    // Fill the sentinel positions (they are all at the beginning of the bwt).
+    for (TSize i = 1; i <= seqNum; ++i)
+    {
+        assignValue(bwt, i - 1, back(text[seqNum - i]));
+        setValue(lf.sentinels, i - 1, false);
+    }
+
+    // Compute the rest of the bwt.
+    Splitter<TSize> splitter(0, length(sa), Parallel());
+
+    SEQAN_OMP_PRAGMA(parallel for)
+    for (TSignedSize job = 0; job < static_cast<TSignedSize>(length(splitter)); ++job)
+    {
+        for (TSize i = splitter[job]; i < splitter[job + 1]; ++i)
+        {
+            TSAValue pos;    // = SA[i];
+            posLocalize(pos, getValue(sa, i), stringSetLimits(text));
+
+            if (getSeqOffset(pos) != 0)
+                assignValue(bwt, seqNum + i, getValue(getValue(text, getSeqNo(pos)), getSeqOffset(pos) - 1));
+            else
+                assignValue(bwt, seqNum + i, lf.sentinelSubstitute);
+        }
+    }
+
+    // Mark the sentinels.
+    for (TSize i = 0; i < length(sa); ++i)
+    {
+        TSAValue pos;
+        posLocalize(pos, getValue(sa, i), stringSetLimits(text));
+        setValue(lf.sentinels, seqNum + i, getSeqOffset(pos) == 0);
+    }
+
+    // Update the auxiliary RankDictionary of sentinel positions.
+    updateRanks(lf.sentinels);
+}
+
+template <typename TText, typename TSpec, typename TConfig, typename TBwt, typename TOtherText, typename TSA>
+inline void
+_createBwt(LF<TText, TSpec, TConfig> & lf, TBwt & bwt, TOtherText const & text, TSA const & sa, Serial)
+{
+    _createBwt(lf, bwt, text, sa);
+}
+
 // ----------------------------------------------------------------------------
 // Function createLF()
 // ----------------------------------------------------------------------------
@@ -594,21 +708,24 @@ _createBwt(LF<StringSet<TText, TSSetSpec>, TSpec, TConfig> & lf, TBwt & bwt, TOt
  *
  * @brief Creates the LF table
  *
- * @signature void createLF(lfTable, text, sa);
+ * @signature void createLF(lfTable, text, sa[, parallelTag]);
  *
  * @param[out] lfTable The LF table to be constructed.
  * @param[in]  text    The underlying text Types: @link String @endlink.
  * @param[in]  sa      The suffix array of the LF table underlying text. Types: @link String @endlink,
  *                     @link StringSet @endlink.
+ * @param[in]  parallelTag Tag to enable/disable parallel BWT derivation, one of <tt>Serial</tt>, <tt>Parallel</tt>.
+ *                     Default is <tt>Serial</tt>.
  *
  * @return TReturn Returns a <tt>bool</tt> which is <tt>true</tt> on successes and <tt>false</tt> otherwise.
  */
 // This function creates all table of the lf table given a text and a suffix array.
-template <typename TText, typename TSpec, typename TConfig, typename TOtherText, typename TSA>
-inline void createLF(LF<TText, TSpec, TConfig> & lf, TOtherText const & text, TSA const & sa)
+template <typename TText, typename TSpec, typename TConfig, typename TOtherText, typename TSA, typename TBwt,
+          typename TParallel>
+inline void _createLF(LF<TText, TSpec, TConfig> & lf, TOtherText const & text, TSA const & sa, TBwt & bwt,
+                      Tag<TParallel> const & parallelTag)
 {
     typedef LF<TText, TSpec, TConfig>                          TLF;
-    typedef typename Fibre<TLF, FibreTempBwt>::Type            TBwt;
     typedef typename Value<TLF>::Type                          TValue;
     typedef typename Size<TLF>::Type                           TSize;
 
@@ -622,9 +739,8 @@ inline void createLF(LF<TText, TSpec, TConfig> & lf, TOtherText const & text, TS
     _setSentinelSubstitute(lf);
 
     // Create BWT and mark sentinels.
-    TBwt bwt;
     resize(bwt, bwtLength(text), Exact());
-    _createBwt(lf, bwt, text, sa);
+    _createBwt(lf, bwt, text, sa, parallelTag);
 
     // Index BWT bwt for rank queries.
     createRankDictionary(lf.bwt, bwt);
@@ -635,6 +751,27 @@ inline void createLF(LF<TText, TSpec, TConfig> & lf, TOtherText const & text, TS
         lf.sums[i] += sentinelsCount;
 }
 
+template <typename TText, typename TSpec, typename TConfig, typename TOtherText, typename TSA>
+inline void createLF(LF<TText, TSpec, TConfig> & lf, TOtherText const & text, TSA const & sa)
+{
+    typename Fibre<LF<TText, TSpec, TConfig>, FibreTempBwt>::Type bwt;
+    _createLF(lf, text, sa, bwt, Serial());
+}
+
+template <typename TText, typename TSpec, typename TConfig, typename TOtherText, typename TSA>
+inline void createLF(LF<TText, TSpec, TConfig> & lf, TOtherText const & text, TSA const & sa, Serial)
+{
+    createLF(lf, text, sa);
+}
+
+// The parallel variant keeps the BWT in memory and expects an in-memory suffix array.
+template <typename TText, typename TSpec, typename TConfig, typename TOtherText, typename TSA>
+inline void createLF(LF<TText, TSpec, TConfig> & lf, TOtherText const & text, TSA const & sa, Parallel)
+{
+    String<typename Value<LF<TText, TSpec, TConfig> >::Type> bwt;
+    _createLF(lf, text, sa, bwt, Parallel());
+}
+
 // ----------------------------------------------------------------------------
 // Function open()
 // ----------------------------------------------------------------------------
@@ -262,6 +262,36 @@ createRankDictionary(RankDictionary<TValue, TSpec> & dict, TText const & text)
  */
 
 
+// ----------------------------------------------------------------------------
+// Function _prefetchRead()
+// ----------------------------------------------------------------------------
+// Hints the cache to load the lines holding value ahead of a read.
+
+template <typename TValue>
+SEQAN_HOST_DEVICE inline void
+_prefetchRead(TValue const & value)
+{
+#if defined(__GNUC__) && !defined(__CUDA_ARCH__)
+    __builtin_prefetch(&value, 0, 3);
+    __builtin_prefetch(reinterpret_cast<char const *>(&value) + sizeof(TValue) - 1, 0, 3);
+    // NOTE: Without a visible side effect gcc deems this function const and drops its calls.
+    __asm__ __volatile__("" : : "r"(&value));
+#else
+    ignoreUnusedVariableWarning(value);
+#endif
+}
+
+// ----------------------------------------------------------------------------
+// Function _prefetchRank()
+// ----------------------------------------------------------------------------
+// Hints the cache about the entries a subsequent getRank(dict, pos) will read.
+// Dictionaries without a cheap way to locate them do nothing.
+
+template <typename TValue, typename TSpec, typename TPos>
+SEQAN_HOST_DEVICE inline void
+_prefetchRank(RankDictionary<TValue, TSpec> const & /* dict */, TPos /* pos */)
+{}
+
 // ----------------------------------------------------------------------------
 // Function getValue()
 // ----------------------------------------------------------------------------
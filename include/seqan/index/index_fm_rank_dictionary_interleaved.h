@@ -0,0 +1,752 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2015, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Rank dictionary for Dna that stores symbol counts and bit-packed symbols
+// together in 64 byte aligned cache lines.
+// ==========================================================================
+
+#ifndef INDEX_FM_RANK_DICTIONARY_INTERLEAVED_H_
+#define INDEX_FM_RANK_DICTIONARY_INTERLEAVED_H_
+
+namespace seqan {
+
+// ============================================================================
+// Forwards
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Metafunction RankDictionarySuperBlock_
+// ----------------------------------------------------------------------------
+
+template <typename TValue, typename TSpec>
+struct RankDictionarySuperBlock_;
+
+// ============================================================================
+// Tags
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Tag InterleavedRDConfig
+// ----------------------------------------------------------------------------
+// The counts stored in each line are relative to the beginning of its
+// superblock and therefore fit into 32 bits.
+
+template <typename TSize = size_t, typename TFibre = Alloc<>, unsigned BLOCKS_PER_SUPERBLOCK_ = (1u << 20)>
+struct InterleavedRDConfig : RDConfig<TSize, TFibre>
+{
+    static const unsigned BLOCKS_PER_SUPERBLOCK = BLOCKS_PER_SUPERBLOCK_;
+};
+
+// ----------------------------------------------------------------------------
+// Tag Interleaved
+// ----------------------------------------------------------------------------
+
+template <typename TSpec = void, typename TConfig = InterleavedRDConfig<> >
+struct Interleaved {};
+
+// ============================================================================
+// Metafunctions
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Metafunction RankDictionaryWordSize_
+// ----------------------------------------------------------------------------
+
+template <typename TSpec, typename TConfig>
+struct RankDictionaryWordSize_<Dna, Interleaved<TSpec, TConfig> > :
+    BitsPerValue<__uint64> {};
+
+// ----------------------------------------------------------------------------
+// Metafunction RankDictionaryBlock_
+// ----------------------------------------------------------------------------
+
+template <typename TSpec, typename TConfig>
+struct RankDictionaryBlock_<Dna, Interleaved<TSpec, TConfig> >
+{
+    typedef Tuple<__uint32, ValueSize<Dna>::VALUE>                  Type;
+};
+
+// ----------------------------------------------------------------------------
+// Metafunction RankDictionarySuperBlock_
+// ----------------------------------------------------------------------------
+
+template <typename TSpec, typename TConfig>
+struct RankDictionarySuperBlock_<Dna, Interleaved<TSpec, TConfig> >
+{
+    typedef RankDictionary<Dna, Interleaved<TSpec, TConfig> >       TRankDictionary_;
+    typedef typename Size<TRankDictionary_>::Type                   TSize_;
+
+    typedef Tuple<TSize_, ValueSize<Dna>::VALUE>                    Type;
+};
+
+// ----------------------------------------------------------------------------
+// Metafunction RankDictionaryValues_
+// ----------------------------------------------------------------------------
+// Six words fill up a cache line together with the 16 bytes of the block.
+
+template <typename TSpec, typename TConfig>
+struct RankDictionaryValues_<Dna, Interleaved<TSpec, TConfig> >
+{
+    typedef __uint64                                                TWord;
+    typedef Tuple<TWord, 6>                                         Type;
+};
+
+// ----------------------------------------------------------------------------
+// Metafunction Fibre
+// ----------------------------------------------------------------------------
+
+template <typename TSpec, typename TConfig>
+struct Fibre<RankDictionary<Dna, Interleaved<TSpec, TConfig> >, FibreRanks>
+{
+    typedef RankDictionary<Dna, Interleaved<TSpec, TConfig> >           TRankDictionary_;
+    typedef RankDictionaryEntry_<Dna, Interleaved<TSpec, TConfig> >     TEntry_;
+    typedef typename DefaultIndexStringSpec<TRankDictionary_>::Type     TFibreSpec_;
+
+    typedef String<TEntry_, TFibreSpec_>                                Type;
+};
+
+// ============================================================================
+// Classes
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Struct Interleaved RankDictionaryEntry_
+// ----------------------------------------------------------------------------
+
+template <typename TSpec, typename TConfig>
+struct RankDictionaryEntry_<Dna, Interleaved<TSpec, TConfig> >
+{
+    // A summary of counts for each symbol from the beginning of the superblock.
+    typename RankDictionaryBlock_<Dna, Interleaved<TSpec, TConfig> >::Type    block;
+
+    // A bit-compressed block of Dna symbols, the i-th symbol of a word is stored in its bits 2i and 2i+1.
+    typename RankDictionaryValues_<Dna, Interleaved<TSpec, TConfig> >::Type   values;
+};
+
+// ----------------------------------------------------------------------------
+// Class Interleaved RankDictionary
+// ----------------------------------------------------------------------------
+
+/*!
+ * @class InterleavedRankDictionary
+ * @extends RankDictionary
+ * @headerfile <seqan/index.h>
+ *
+ * @brief A @link RankDictionary @endlink for @link Dna @endlink answering each rank query with a single cache line.
+ *
+ * @signature template <typename TSpec, typename TConfig>
+ *            class RankDictionary<Dna, Interleaved<TSpec, TConfig> >;
+ *
+ * @tparam TSpec   A tag for specialization purposes. Default: <tt>void</tt>
+ * @tparam TConfig A config type defining <tt>Size</tt>, <tt>Fibre</tt> and <tt>BLOCKS_PER_SUPERBLOCK</tt>.
+ *                 Default: <tt>InterleavedRDConfig<></tt>
+ *
+ * Each block of 192 symbols is stored in a 64 byte aligned cache line together with the 32 bit counts of all
+ * symbols from the beginning of its superblock up to the block.  A small table of superblock counts completes the
+ * ranks.  The four symbol counts of a block are computed at once using AVX2 or SSE4.2 instructions if the code
+ * is compiled with support for them.
+ */
+
+template <typename TSpec, typename TConfig>
+struct RankDictionary<Dna, Interleaved<TSpec, TConfig> >
+{
+    typedef typename RankDictionarySuperBlock_<Dna, Interleaved<TSpec, TConfig> >::Type TSuperBlock;
+
+    // ------------------------------------------------------------------------
+    // Constants
+    // ------------------------------------------------------------------------
+
+    static const unsigned _BITS_PER_VALUE        = BitsPerValue<Dna>::VALUE;
+    static const unsigned _BITS_PER_WORD         = RankDictionaryWordSize_<Dna, Interleaved<TSpec, TConfig> >::VALUE;
+    static const unsigned _WORDS_PER_BLOCK       = LENGTH<typename RankDictionaryValues_<Dna, Interleaved<TSpec, TConfig> >::Type>::VALUE;
+    static const unsigned _VALUES_PER_WORD       = _BITS_PER_WORD / _BITS_PER_VALUE;
+    static const unsigned _VALUES_PER_BLOCK      = _VALUES_PER_WORD * _WORDS_PER_BLOCK;
+    static const unsigned _BLOCKS_PER_SUPERBLOCK = TConfig::BLOCKS_PER_SUPERBLOCK;
+
+    // ------------------------------------------------------------------------
+    // Fibres
+    // ------------------------------------------------------------------------
+
+    typename Fibre<RankDictionary, FibreRanks>::Type    ranks;
+    String<TSuperBlock>                                 sblocks;
+    typename Size<RankDictionary>::Type                 _length;
+
+    // ------------------------------------------------------------------------
+    // Constructors
+    // ------------------------------------------------------------------------
+
+    RankDictionary() :
+        _length(0)
+    {}
+
+    template <typename TText>
+    RankDictionary(TText const & text) :
+        _length(0)
+    {
+        createRankDictionary(*this, text);
+    }
+};
+
+// ============================================================================
+// Functions
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Function allocate()                                   [RankDictionaryEntry_]
+// ----------------------------------------------------------------------------
+// The storage of the ranks fibre is aligned to cache lines, thus a rank query touches only one line.
+
+template <typename TSpec, typename TConfig>
+inline void
+_allocateCacheLines(RankDictionaryEntry_<Dna, Interleaved<TSpec, TConfig> > * & data, size_t count)
+{
+    typedef RankDictionaryEntry_<Dna, Interleaved<TSpec, TConfig> >    TEntry;
+
+#ifdef PLATFORM_WINDOWS_VS
+    data = (TEntry *) _aligned_malloc(count * sizeof(TEntry), 64);
+#else
+    if (posix_memalign(&(void* &)data, 64, count * sizeof(TEntry)))
+        data = NULL;
+#endif
+    if (data == NULL)
+        throw std::bad_alloc();
+}
+
+template <typename T, typename TSpec, typename TConfig, typename TSize>
+inline void
+allocate(T const &,
+         RankDictionaryEntry_<Dna, Interleaved<TSpec, TConfig> > * & data,
+         TSize count,
+         TagAllocateStorage const &)
+{
+    _allocateCacheLines(data, count);
+}
+
+template <typename T, typename TSpec, typename TConfig, typename TSize>
+inline void
+allocate(T &,
+         RankDictionaryEntry_<Dna, Interleaved<TSpec, TConfig> > * & data,
+         TSize count,
+         TagAllocateStorage const &)
+{
+    _allocateCacheLines(data, count);
+}
+
+// ----------------------------------------------------------------------------
+// Function deallocate()                                 [RankDictionaryEntry_]
+// ----------------------------------------------------------------------------
+
+template <typename T, typename TSpec, typename TConfig, typename TSize>
+inline void
+deallocate(T const &,
+           RankDictionaryEntry_<Dna, Interleaved<TSpec, TConfig> > * data,
+           TSize,
+           TagAllocateStorage const)
+{
+#ifdef PLATFORM_WINDOWS_VS
+    _aligned_free((void *) data);
+#else
+    ::free((void *) data);
+#endif
+}
+
+template <typename T, typename TSpec, typename TConfig, typename TSize>
+inline void
+deallocate(T &,
+           RankDictionaryEntry_<Dna, Interleaved<TSpec, TConfig> > * data,
+           TSize,
+           TagAllocateStorage const)
+{
+#ifdef PLATFORM_WINDOWS_VS
+    _aligned_free((void *) data);
+#else
+    ::free((void *) data);
+#endif
+}
+
+// ----------------------------------------------------------------------------
+// Function _toPosInBlock()
+// ----------------------------------------------------------------------------
+
+template <typename TSpec, typename TConfig, typename TPos>
+inline typename Size<RankDictionary<Dna, Interleaved<TSpec, TConfig> > >::Type
+_toPosInBlock(RankDictionary<Dna, Interleaved<TSpec, TConfig> > const & /* dict */, TPos pos)
+{
+    return pos % RankDictionary<Dna, Interleaved<TSpec, TConfig> >::_VALUES_PER_BLOCK;
+}
+
+// ----------------------------------------------------------------------------
+// Function _toBlockPos()
+// ----------------------------------------------------------------------------
+
+template <typename TSpec, typename TConfig, typename TPos>
+inline typename Size<RankDictionary<Dna, Interleaved<TSpec, TConfig> > >::Type
+_toBlockPos(RankDictionary<Dna, Interleaved<TSpec, TConfig> > const & /* dict */, TPos pos)
+{
+    return pos / RankDictionary<Dna, Interleaved<TSpec, TConfig> >::_VALUES_PER_BLOCK;
+}
+
+// ----------------------------------------------------------------------------
+// Function _toSuperBlockPos()
+// ----------------------------------------------------------------------------
+
+template <typename TSpec, typename TConfig, typename TBlockPos>
+inline typename Size<RankDictionary<Dna, Interleaved<TSpec, TConfig> > >::Type
+_toSuperBlockPos(RankDictionary<Dna, Interleaved<TSpec, TConfig> > const & /* dict */, TBlockPos blockPos)
+{
+    return blockPos / RankDictionary<Dna, Interleaved<TSpec, TConfig> >::_BLOCKS_PER_SUPERBLOCK;
+}
+
+// ----------------------------------------------------------------------------
+// Function _getWordMask()
+// ----------------------------------------------------------------------------
+// Returns the low bits of the symbols of a word which are located up to posInBlock.
+
+template <typename TSpec, typename TConfig, typename TPosInBlock, typename TWordPos>
+inline __uint64
+_getWordMask(RankDictionary<Dna, Interleaved<TSpec, TConfig> > const & /* dict */,
+             TPosInBlock posInBlock,
+             TWordPos wordPos)
+{
+    typedef RankDictionary<Dna, Interleaved<TSpec, TConfig> >       TRankDictionary;
+
+    TWordPos lastWordPos = posInBlock / TRankDictionary::_VALUES_PER_WORD;
+    TWordPos posInWord = posInBlock % TRankDictionary::_VALUES_PER_WORD;
+
+    if (wordPos < lastWordPos)
+        return RankDictionaryBitMask_<__uint64>::VALUE;
+    if (wordPos > lastWordPos)
+        return 0;
+    return RankDictionaryBitMask_<__uint64>::VALUE >>
+           (TRankDictionary::_BITS_PER_WORD - TRankDictionary::_BITS_PER_VALUE * (posInWord + 1));
+}
+
+// ----------------------------------------------------------------------------
+// Function _getValueRank()
+// ----------------------------------------------------------------------------
+// Symbols equal to c are the ones whose two bits are both zero after a xor with c.
+
+template <typename TSpec, typename TConfig, typename TValues, typename TPosInBlock>
+inline typename Size<RankDictionary<Dna, Interleaved<TSpec, TConfig> > const>::Type
+_getValueRank(RankDictionary<Dna, Interleaved<TSpec, TConfig> > const & dict,
+              TValues const & values,
+              TPosInBlock posInBlock,
+              Dna c)
+{
+    typedef RankDictionary<Dna, Interleaved<TSpec, TConfig> >       TRankDictionary;
+    typedef typename Size<TRankDictionary>::Type                    TSize;
+
+    __uint64 pattern = ordValue(c) * RankDictionaryBitMask_<__uint64>::VALUE;
+
+    TSize valueRank = 0;
+
+    for (unsigned wordPos = 0; wordPos < TRankDictionary::_WORDS_PER_BLOCK; ++wordPos)
+    {
+        __uint64 word = values.i[wordPos] ^ pattern;
+        valueRank += popCount(~(word | (word >> 1)) & _getWordMask(dict, posInBlock, wordPos));
+    }
+
+    return valueRank;
+}
+
+// ----------------------------------------------------------------------------
+// Function _getValuesRanks()
+// ----------------------------------------------------------------------------
+// Counts all four symbols at once, one symbol per 64 bit vector lane.
+
+template <typename TSpec, typename TConfig, typename TValues, typename TPosInBlock>
+inline typename RankDictionaryBlock_<Dna, Interleaved<TSpec, TConfig> >::Type
+_getValuesRanks(RankDictionary<Dna, Interleaved<TSpec, TConfig> > const & dict,
+                TValues const & values,
+                TPosInBlock posInBlock)
+{
+    typedef RankDictionary<Dna, Interleaved<TSpec, TConfig> >                   TRankDictionary;
+    typedef typename RankDictionaryBlock_<Dna, Interleaved<TSpec, TConfig> >::Type  TBlock;
+
+    TBlock blockRank;
+
+#if defined(__AVX2__)
+    __m256i const popCountTable = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                                   0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    __m256i const lowNibbles = _mm256_set1_epi8(0x0f);
+    __m256i const patterns = _mm256_setr_epi64x(0, 0x5555555555555555ll, (__int64)0xaaaaaaaaaaaaaaaaull, -1);
+    __m256i counts = _mm256_setzero_si256();
+
+    for (unsigned wordPos = 0; wordPos < TRankDictionary::_WORDS_PER_BLOCK; ++wordPos)
+    {
+        __m256i word = _mm256_xor_si256(_mm256_set1_epi64x(values.i[wordPos]), patterns);
+        __m256i mask = _mm256_set1_epi64x(_getWordMask(dict, posInBlock, wordPos));
+        __m256i hits = _mm256_andnot_si256(_mm256_or_si256(word, _mm256_srli_epi64(word, 1)), mask);
+
+        // Byte-wise population counts can not overflow as there are at most 4 * 6 hits per byte.
+        counts = _mm256_add_epi8(counts, _mm256_shuffle_epi8(popCountTable, _mm256_and_si256(hits, lowNibbles)));
+        counts = _mm256_add_epi8(counts, _mm256_shuffle_epi8(popCountTable,
+                                                             _mm256_and_si256(_mm256_srli_epi16(hits, 4), lowNibbles)));
+    }
+
+    __uint64 ranks[4];
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(ranks), _mm256_sad_epu8(counts, _mm256_setzero_si256()));
+
+    for (unsigned c = 0; c < 4; ++c)
+        assignValue(blockRank, c, ranks[c]);
+#elif defined(__SSE4_2__)
+    __m128i const popCountTable = _mm_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    __m128i const lowNibbles = _mm_set1_epi8(0x0f);
+    __m128i const patternsAC = _mm_set_epi64x(0x5555555555555555ll, 0);
+    __m128i const patternsGT = _mm_set_epi64x(-1, (__int64)0xaaaaaaaaaaaaaaaaull);
+    __m128i countsAC = _mm_setzero_si128();
+    __m128i countsGT = _mm_setzero_si128();
+
+    for (unsigned wordPos = 0; wordPos < TRankDictionary::_WORDS_PER_BLOCK; ++wordPos)
+    {
+        __m128i word = _mm_set1_epi64x(values.i[wordPos]);
+        __m128i mask = _mm_set1_epi64x(_getWordMask(dict, posInBlock, wordPos));
+        __m128i wordAC = _mm_xor_si128(word, patternsAC);
+        __m128i wordGT = _mm_xor_si128(word, patternsGT);
+        __m128i hitsAC = _mm_andnot_si128(_mm_or_si128(wordAC, _mm_srli_epi64(wordAC, 1)), mask);
+        __m128i hitsGT = _mm_andnot_si128(_mm_or_si128(wordGT, _mm_srli_epi64(wordGT, 1)), mask);
+
+        countsAC = _mm_add_epi8(countsAC, _mm_shuffle_epi8(popCountTable, _mm_and_si128(hitsAC, lowNibbles)));
+        countsAC = _mm_add_epi8(countsAC, _mm_shuffle_epi8(popCountTable,
+                                                           _mm_and_si128(_mm_srli_epi16(hitsAC, 4), lowNibbles)));
+        countsGT = _mm_add_epi8(countsGT, _mm_shuffle_epi8(popCountTable, _mm_and_si128(hitsGT, lowNibbles)));
+        countsGT = _mm_add_epi8(countsGT, _mm_shuffle_epi8(popCountTable,
+                                                           _mm_and_si128(_mm_srli_epi16(hitsGT, 4), lowNibbles)));
+    }
+
+    __uint64 ranks[4];
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(ranks), _mm_sad_epu8(countsAC, _mm_setzero_si128()));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(ranks + 2), _mm_sad_epu8(countsGT, _mm_setzero_si128()));
+
+    for (unsigned c = 0; c < 4; ++c)
+        assignValue(blockRank, c, ranks[c]);
+#else
+    // The odd bits tell G|T apart from A|C, the even bits C|T apart from A|G.
+    __uint32 total = 0;
+    clear(blockRank);
+
+    for (unsigned wordPos = 0; wordPos < TRankDictionary::_WORDS_PER_BLOCK; ++wordPos)
+    {
+        __uint64 mask = _getWordMask(dict, posInBlock, wordPos);
+        __uint64 odd  = values.i[wordPos] >> 1;
+        __uint64 even = values.i[wordPos];
+
+        total        += popCount(mask);
+        blockRank[1] += popCount(~odd & even & mask);
+        blockRank[2] += popCount(odd & ~even & mask);
+        blockRank[3] += popCount(odd & even & mask);
+    }
+
+    blockRank[0] = total - blockRank[1] - blockRank[2] - blockRank[3];
+#endif
+
+    return blockRank;
+}
+
+// ----------------------------------------------------------------------------
+// Function _getRanks()
+// ----------------------------------------------------------------------------
+// Returns the ranks of all symbols up to a specified position.
+
+template <typename TSpec, typename TConfig, typename TPos>
+inline typename RankDictionarySuperBlock_<Dna, Interleaved<TSpec, TConfig> >::Type
+_getRanks(RankDictionary<Dna, Interleaved<TSpec, TConfig> > const & dict, TPos pos)
+{
+    typedef RankDictionary<Dna, Interleaved<TSpec, TConfig> > const         TRankDictionary;
+    typedef typename Fibre<TRankDictionary, FibreRanks>::Type               TFibreRanks;
+    typedef typename Value<TFibreRanks>::Type                               TRankEntry;
+    typedef typename RankDictionaryBlock_<Dna, Interleaved<TSpec, TConfig> >::Type       TBlock;
+    typedef typename RankDictionarySuperBlock_<Dna, Interleaved<TSpec, TConfig> >::Type  TSuperBlock;
+    typedef typename Size<TRankDictionary>::Type                            TSize;
+
+    TSize blockPos   = _toBlockPos(dict, pos);
+    TSize posInBlock = _toPosInBlock(dict, pos);
+
+    TRankEntry const & entry = dict.ranks[blockPos];
+    TSuperBlock ranks = dict.sblocks[_toSuperBlockPos(dict, blockPos)];
+    TBlock valuesRanks = _getValuesRanks(dict, entry.values, posInBlock);
+
+    for (unsigned c = 0; c < ValueSize<Dna>::VALUE; ++c)
+        ranks[c] += entry.block[c] + valuesRanks[c];
+
+    return ranks;
+}
+
+// ----------------------------------------------------------------------------
+// Function _prefetchRank()
+// ----------------------------------------------------------------------------
+
+template <typename TSpec, typename TConfig, typename TPos>
+inline void
+_prefetchRank(RankDictionary<Dna, Interleaved<TSpec, TConfig> > const & dict, TPos pos)
+{
+    typedef RankDictionary<Dna, Interleaved<TSpec, TConfig> > const         TRankDictionary;
+    typedef typename Size<TRankDictionary>::Type                            TSize;
+
+    TSize blockPos = _toBlockPos(dict, pos);
+
+    _prefetchRead(dict.ranks[blockPos]);
+    _prefetchRead(dict.sblocks[_toSuperBlockPos(dict, blockPos)]);
+}
+
+// ----------------------------------------------------------------------------
+// Function getRank()
+// ----------------------------------------------------------------------------
+
+template <typename TSpec, typename TConfig, typename TPos, typename TChar>
+inline typename Size<RankDictionary<Dna, Interleaved<TSpec, TConfig> > const>::Type
+getRank(RankDictionary<Dna, Interleaved<TSpec, TConfig> > const & dict, TPos pos, TChar c)
+{
+    typedef RankDictionary<Dna, Interleaved<TSpec, TConfig> > const         TRankDictionary;
+    typedef typename Fibre<TRankDictionary, FibreRanks>::Type               TFibreRanks;
+    typedef typename Value<TFibreRanks>::Type                               TRankEntry;
+    typedef typename Size<TRankDictionary>::Type                            TSize;
+
+    TSize blockPos   = _toBlockPos(dict, pos);
+    TSize posInBlock = _toPosInBlock(dict, pos);
+    unsigned ordC    = ordValue(static_cast<Dna>(c));
+
+    TRankEntry const & entry = dict.ranks[blockPos];
+
+    return dict.sblocks[_toSuperBlockPos(dict, blockPos)][ordC] + entry.block[ordC] +
+           _getValueRank(dict, entry.values, posInBlock, static_cast<Dna>(c));
+}
+
+// ----------------------------------------------------------------------------
+// Function getValue()
+// ----------------------------------------------------------------------------
+
+template <typename TSpec, typename TConfig, typename TPos>
+inline Dna
+getValue(RankDictionary<Dna, Interleaved<TSpec, TConfig> > const & dict, TPos pos)
+{
+    typedef RankDictionary<Dna, Interleaved<TSpec, TConfig> >           TRankDictionary;
+    typedef typename Size<TRankDictionary>::Type                        TSize;
+
+    TSize posInBlock = _toPosInBlock(dict, pos);
+    __uint64 word = dict.ranks[_toBlockPos(dict, pos)].values.i[posInBlock / TRankDictionary::_VALUES_PER_WORD];
+
+    return Dna((word >> (TRankDictionary::_BITS_PER_VALUE * (posInBlock % TRankDictionary::_VALUES_PER_WORD))) & 3);
+}
+
+template <typename TSpec, typename TConfig, typename TPos>
+inline Dna
+getValue(RankDictionary<Dna, Interleaved<TSpec, TConfig> > & dict, TPos pos)
+{
+    return getValue(static_cast<RankDictionary<Dna, Interleaved<TSpec, TConfig> > const &>(dict), pos);
+}
+
+// ----------------------------------------------------------------------------
+// Function setValue()
+// ----------------------------------------------------------------------------
+
+template <typename TSpec, typename TConfig, typename TPos, typename TChar>
+inline void setValue(RankDictionary<Dna, Interleaved<TSpec, TConfig> > & dict, TPos pos, TChar c)
+{
+    typedef RankDictionary<Dna, Interleaved<TSpec, TConfig> >           TRankDictionary;
+    typedef typename Size<TRankDictionary>::Type                        TSize;
+
+    TSize posInBlock = _toPosInBlock(dict, pos);
+    unsigned shift = TRankDictionary::_BITS_PER_VALUE * (posInBlock % TRankDictionary::_VALUES_PER_WORD);
+    __uint64 & word = dict.ranks[_toBlockPos(dict, pos)].values.i[posInBlock / TRankDictionary::_VALUES_PER_WORD];
+
+    word = (word & ~((__uint64)3 << shift)) | ((__uint64)ordValue(static_cast<Dna>(c)) << shift);
+}
+
+// ----------------------------------------------------------------------------
+// Function appendValue()
+// ----------------------------------------------------------------------------
+
+template <typename TSpec, typename TConfig, typename TChar, typename TExpand>
+inline void appendValue(RankDictionary<Dna, Interleaved<TSpec, TConfig> > & dict, TChar c, Tag<TExpand> const tag)
+{
+    resize(dict, length(dict) + 1, tag);
+    setValue(dict, length(dict) - 1, c);
+}
+
+// ----------------------------------------------------------------------------
+// Function _padValues()
+// ----------------------------------------------------------------------------
+// Set values beyond length(dict) but still within the end of the ranks fibre.
+
+template <typename TSpec, typename TConfig>
+inline void _padValues(RankDictionary<Dna, Interleaved<TSpec, TConfig> > & dict)
+{
+    typedef RankDictionary<Dna, Interleaved<TSpec, TConfig> >       TRankDictionary;
+    typedef typename Size<TRankDictionary>::Type                    TSize;
+
+    TSize beginPos = length(dict);
+    TSize endPos   = length(dict.ranks) * TRankDictionary::_VALUES_PER_BLOCK;
+
+    for (TSize pos = beginPos; pos < endPos; ++pos)
+        setValue(dict, pos, Dna());
+}
+
+// ----------------------------------------------------------------------------
+// Function _updateSuperBlocks()
+// ----------------------------------------------------------------------------
+// Computes the superblock counts from the blocks, e.g. after opening the ranks fibre.
+
+template <typename TSpec, typename TConfig>
+inline void _updateSuperBlocks(RankDictionary<Dna, Interleaved<TSpec, TConfig> > & dict)
+{
+    typedef RankDictionary<Dna, Interleaved<TSpec, TConfig> >                           TRankDictionary;
+    typedef typename Size<TRankDictionary>::Type                                        TSize;
+    typedef typename RankDictionaryBlock_<Dna, Interleaved<TSpec, TConfig> >::Type       TBlock;
+    typedef typename RankDictionarySuperBlock_<Dna, Interleaved<TSpec, TConfig> >::Type  TSuperBlock;
+
+    TSize blocksCount = length(dict.ranks);
+    TSize superBlocksCount = (blocksCount + TRankDictionary::_BLOCKS_PER_SUPERBLOCK - 1) /
+                             TRankDictionary::_BLOCKS_PER_SUPERBLOCK;
+
+    resize(dict.sblocks, superBlocksCount, Exact());
+
+    if (superBlocksCount == 0) return;
+
+    TSuperBlock ranks;
+    clear(ranks);
+    dict.sblocks[0] = ranks;
+
+    // The last block of each superblock summarizes it.
+    for (TSize superBlockPos = 1; superBlockPos < superBlocksCount; ++superBlockPos)
+    {
+        TSize blockPos = superBlockPos * TRankDictionary::_BLOCKS_PER_SUPERBLOCK - 1;
+        TBlock valuesRanks = _getValuesRanks(dict, dict.ranks[blockPos].values, TRankDictionary::_VALUES_PER_BLOCK - 1);
+
+        for (unsigned c = 0; c < ValueSize<Dna>::VALUE; ++c)
+            ranks[c] += dict.ranks[blockPos].block[c] + valuesRanks[c];
+
+        dict.sblocks[superBlockPos] = ranks;
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Function updateRanks()
+// ----------------------------------------------------------------------------
+
+template <typename TSpec, typename TConfig>
+inline void updateRanks(RankDictionary<Dna, Interleaved<TSpec, TConfig> > & dict)
+{
+    typedef RankDictionary<Dna, Interleaved<TSpec, TConfig> >                       TRankDictionary;
+    typedef typename Size<TRankDictionary>::Type                                    TSize;
+    typedef typename RankDictionaryBlock_<Dna, Interleaved<TSpec, TConfig> >::Type   TBlock;
+
+    if (empty(dict)) return;
+
+    // Clear the uninitialized values.
+    _padValues(dict);
+
+    TBlock block;
+
+    // Iterate through the blocks, the counts restart at each superblock.
+    for (TSize blockPos = 0; blockPos < length(dict.ranks); ++blockPos)
+    {
+        if (blockPos % TRankDictionary::_BLOCKS_PER_SUPERBLOCK == 0)
+            clear(block);
+
+        dict.ranks[blockPos].block = block;
+
+        TBlock valuesRanks = _getValuesRanks(dict, dict.ranks[blockPos].values, TRankDictionary::_VALUES_PER_BLOCK - 1);
+
+        for (unsigned c = 0; c < ValueSize<Dna>::VALUE; ++c)
+            block[c] += valuesRanks[c];
+    }
+
+    _updateSuperBlocks(dict);
+}
+
+// ----------------------------------------------------------------------------
+// Function clear()
+// ----------------------------------------------------------------------------
+
+template <typename TSpec, typename TConfig>
+inline void clear(RankDictionary<Dna, Interleaved<TSpec, TConfig> > & dict)
+{
+    clear(dict.ranks);
+    clear(dict.sblocks);
+    dict._length = 0;
+}
+
+// ----------------------------------------------------------------------------
+// Function length()
+// ----------------------------------------------------------------------------
+
+template <typename TSpec, typename TConfig>
+inline typename Size<RankDictionary<Dna, Interleaved<TSpec, TConfig> > >::Type
+length(RankDictionary<Dna, Interleaved<TSpec, TConfig> > const & dict)
+{
+    return dict._length;
+}
+
+// ----------------------------------------------------------------------------
+// Function reserve()
+// ----------------------------------------------------------------------------
+
+template <typename TSpec, typename TConfig, typename TSize, typename TExpand>
+inline typename Size<RankDictionary<Dna, Interleaved<TSpec, TConfig> > >::Type
+reserve(RankDictionary<Dna, Interleaved<TSpec, TConfig> > & dict, TSize newCapacity, Tag<TExpand> const tag)
+{
+    return reserve(dict.ranks, (newCapacity + RankDictionary<Dna, Interleaved<TSpec, TConfig> >::_VALUES_PER_BLOCK - 1) /
+                               RankDictionary<Dna, Interleaved<TSpec, TConfig> >::_VALUES_PER_BLOCK, tag);
+}
+
+// ----------------------------------------------------------------------------
+// Function resize()
+// ----------------------------------------------------------------------------
+
+template <typename TSpec, typename TConfig, typename TSize, typename TExpand>
+inline typename Size<RankDictionary<Dna, Interleaved<TSpec, TConfig> > >::Type
+resize(RankDictionary<Dna, Interleaved<TSpec, TConfig> > & dict, TSize newLength, Tag<TExpand> const tag)
+{
+    dict._length = newLength;
+    return resize(dict.ranks, (newLength + RankDictionary<Dna, Interleaved<TSpec, TConfig> >::_VALUES_PER_BLOCK - 1) /
+                              RankDictionary<Dna, Interleaved<TSpec, TConfig> >::_VALUES_PER_BLOCK, tag);
+}
+
+// ----------------------------------------------------------------------------
+// Function open()
+// ----------------------------------------------------------------------------
+// Only the ranks fibre is stored, the superblocks are recomputed.
+
+template <typename TSpec, typename TConfig>
+inline bool open(RankDictionary<Dna, Interleaved<TSpec, TConfig> > & dict, const char * fileName, int openMode)
+{
+    if (!open(getFibre(dict, FibreRanks()), fileName, openMode)) return false;
+
+    dict._length = length(dict.ranks) * RankDictionary<Dna, Interleaved<TSpec, TConfig> >::_VALUES_PER_BLOCK;
+    _updateSuperBlocks(dict);
+
+    return true;
+}
+
+}
+
+#endif  // INDEX_FM_RANK_DICTIONARY_INTERLEAVED_H_
@@ -722,6 +722,17 @@ _getValuesRanks(RankDictionary<bool, Levels<TSpec, TConfig> > const & dict, TPos
     return _getValueRank(dict, _valuesAt(dict, pos), _toPosInBlock(dict, pos), true);
 }
 
+// ----------------------------------------------------------------------------
+// Function _prefetchRank()
+// ----------------------------------------------------------------------------
+
+template <typename TValue, typename TSpec, typename TConfig, typename TPos>
+SEQAN_HOST_DEVICE inline void
+_prefetchRank(RankDictionary<TValue, Levels<TSpec, TConfig> > const & dict, TPos pos)
+{
+    _prefetchRead(dict.ranks[_toBlockPos(dict, pos)]);
+}
+
 // ----------------------------------------------------------------------------
 // Function getRank()
 // ----------------------------------------------------------------------------
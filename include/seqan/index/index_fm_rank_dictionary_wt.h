@@ -269,6 +269,19 @@ inline TValue getValue(RankDictionary<TValue, WaveletTree<TSpec, TConfig> > cons
     return getValue(const_cast<RankDictionary<TValue, WaveletTree<TSpec, TConfig> > &>(dict), pos);
 }
 
+// ----------------------------------------------------------------------------
+// Function _prefetchRank()
+// ----------------------------------------------------------------------------
+// Only the root level is known in advance; the deeper levels depend on its ranks.
+
+template <typename TValue, typename TSpec, typename TConfig, typename TPos>
+inline void
+_prefetchRank(RankDictionary<TValue, WaveletTree<TSpec, TConfig> > const & dict, TPos pos)
+{
+    if (!empty(dict.ranks))
+        _prefetchRank(dict.ranks[0], pos);
+}
+
 // ----------------------------------------------------------------------------
 // Function getRank()
 // ----------------------------------------------------------------------------
@@ -168,6 +168,29 @@ struct EdgeLabel<Iter<Index<TText, FMIndex<TOccSpec, TIndexSpec> >, VSTree<TSpec
     typedef typename Value<Index<TText, FMIndex<TOccSpec, TIndexSpec> > >::Type Type;
 };
 
+// ----------------------------------------------------------------------------
+// Metafunction FindBatchSize_                                          [Index]
+// ----------------------------------------------------------------------------
+// Number of needles whose exact searches are interleaved by _goDownStrings().
+
+template <typename TIndex, typename TAlgorithm>
+struct FindBatchSize_
+{
+    static const unsigned VALUE = 32;
+};
+
+// ----------------------------------------------------------------------------
+// Metafunction FindBatchMinLength_                                     [Index]
+// ----------------------------------------------------------------------------
+// Minimal text length of an index whose exact searches are batched.  Smaller indices fit into the cache, there the
+// batch bookkeeping costs more than the overlapped cache misses save.
+
+template <typename TIndex, typename TAlgorithm>
+struct FindBatchMinLength_
+{
+    static const unsigned VALUE = 8 * 1024 * 1024;
+};
+
 
 // ============================================================================
 // Functions
@@ -367,6 +390,89 @@ _goDownString(Iter<Index<TText, FMIndex<TOccSpec, TIndexSpec> >, VSTree<TopDown<
     return stringIt == stringEnd;
 }
 
+// ----------------------------------------------------------------------------
+// Function _goDownStrings()                                         [Iterator]
+// ----------------------------------------------------------------------------
+// Batched _goDownString(): goes down each iterator its[i] along the string stringsIt[i] and stores the number of
+// matched characters in lcps[i]. The iterators are advanced in lockstep, one character per round. After each step
+// the rank blocks of the next step are prefetched, so that they are loaded while the other iterators are advanced.
+
+template <typename TText, typename TOccSpec, typename TIndexSpec, typename TSpec, typename TItsSpec,
+          typename TStringsIt, typename TLcps>
+inline void
+_goDownStrings(String<Iter<Index<TText, FMIndex<TOccSpec, TIndexSpec> >, VSTree<TopDown<TSpec> > >, TItsSpec> & its,
+               TStringsIt stringsIt,
+               TLcps & lcps)
+{
+    typedef Index<TText, FMIndex<TOccSpec, TIndexSpec> >        TIndex;
+    typedef Pair<typename Size<TIndex>::Type>                   TRange;
+    typedef typename Size<TLcps>::Type                          TSize;
+
+    TSize count = length(its);
+
+    resize(lcps, count, Exact());
+
+    String<TSize> active;
+    resize(active, count, Exact());
+
+    for (TSize i = 0; i < count; ++i)
+    {
+        TIndex const & index = container(its[i]);
+        TRange _range = range(index, value(its[i]));
+
+        _historyPush(its[i]);
+        _prefetchBwtRank(indexLF(index), _range.i1);
+        _prefetchBwtRank(indexLF(index), _range.i2);
+
+        lcps[i] = 0;
+        active[i] = i;
+    }
+
+    for (TSize activeCount = count; activeCount > 0;)
+    {
+        // Advance all active iterators by one character and retire those that stopped.
+        TSize nextCount = 0;
+        for (TSize k = 0; k < activeCount; ++k)
+        {
+            TSize i = active[k];
+            TRange _range;
+
+            if (lcps[i] == length(value(stringsIt + i)) || isLeaf(its[i]) ||
+                !_getNodeByChar(its[i], value(its[i]), _range, value(stringsIt + i)[lcps[i]]))
+                continue;
+
+            _prefetchBwtRank(indexLF(container(its[i])), _range.i1);
+            _prefetchBwtRank(indexLF(container(its[i])), _range.i2);
+
+            value(its[i]).range = _range;
+            ++lcps[i];
+            active[nextCount++] = i;
+        }
+        activeCount = nextCount;
+    }
+
+    for (TSize i = 0; i < count; ++i)
+    {
+        value(its[i]).repLen += lcps[i];
+
+        if (lcps[i]) value(its[i]).lastChar = value(stringsIt + i)[lcps[i] - 1];
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Function _findUseBatches()                                           [Index]
+// ----------------------------------------------------------------------------
+// Returns true if the exact searches of multiple needles should be batched by _goDownStrings().
+
+template <typename TText, typename TOccSpec, typename TIndexSpec, typename TAlgorithm>
+inline bool
+_findUseBatches(Index<TText, FMIndex<TOccSpec, TIndexSpec> > const & index, TAlgorithm)
+{
+    typedef Index<TText, FMIndex<TOccSpec, TIndexSpec> >        TIndex;
+
+    return length(indexSA(index)) >= FindBatchMinLength_<TIndex, TAlgorithm>::VALUE;
+}
+
 // ----------------------------------------------------------------------------
 // Function _goRight()                                               [Iterator]
 // ----------------------------------------------------------------------------
@@ -398,7 +398,8 @@ struct ContextLss_
         TSA        sa;
         TSource    in;
 
-        Pipe(TInput &_textIn):
+        // keeps everything in memory, there are no Pools to parametrize
+        Pipe(TInput &_textIn, PoolParameters const & = PoolParameters()):
             in(sa)
         {
             typedef typename Iterator<TText, Standard>::Type TIter;
@@ -0,0 +1,481 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2015, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// ==========================================================================
+// Parallel suffix array construction by prefix doubling.
+// ==========================================================================
+
+#ifndef INDEX_SA_PREFIX_DOUBLING_H_
+#define INDEX_SA_PREFIX_DOUBLING_H_
+
+namespace seqan {
+
+// ============================================================================
+// Tags
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Tag PrefixDoubling
+// ----------------------------------------------------------------------------
+
+/*!
+ * @tag PrefixDoubling
+ * @headerfile <seqan/index.h>
+ * @brief Suffix array construction by prefix doubling, optionally multi-threaded.
+ *
+ * @signature template <typename TParallel>
+ *            struct PrefixDoubling;
+ *
+ * @tparam TParallel Tag to enable/disable parallelism, one of <tt>Serial</tt>, <tt>Parallel</tt>.
+ *
+ * The suffixes are first sorted by their leading q-grams, q is chosen such that a q-gram fits into 64 bits.  Like in
+ * the algorithm of Larsson and Sadakane, each round then sorts only the groups of suffixes whose first <tt>h</tt>
+ * characters are equal, by the ranks of the <tt>h</tt> characters following them, until all ranks are distinct.
+ * Small groups are sorted by one thread each, large groups by all threads.  The algorithm works on texts and text
+ * collections, the suffix array must reside in memory.  Besides the suffix array it needs two rank strings of the
+ * suffix array's position type and, while sorting by q-grams, 8 bytes per character.
+ *
+ * @section Examples
+ *
+ * @code{.cpp}
+ * Index<StringSet<DnaString>, FMIndex<> > index(text);
+ * indexCreate(index, FibreSALF(), PrefixDoubling<Parallel>());
+ * @endcode
+ */
+
+template <typename TParallel>
+struct PrefixDoubling {};
+
+// ============================================================================
+// Classes
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Class PrefixDoublingLess_
+// ----------------------------------------------------------------------------
+// Compares two text positions by their rank and the rank of their successor.
+// Equal suffixes of different sequences are ordered by descending position.
+
+template <typename TKeys, typename TPos>
+struct PrefixDoublingLess_ :
+    public std::binary_function<TPos, TPos, bool>
+{
+    typedef typename Iterator<TKeys const, Standard>::Type  TIter;
+
+    TIter rank;
+    TIter rank2;
+
+    PrefixDoublingLess_(TKeys const & rank, TKeys const & rank2) :
+        rank(begin(rank, Standard())),
+        rank2(begin(rank2, Standard()))
+    {}
+
+    inline bool operator() (TPos a, TPos b) const
+    {
+        if (rank[a] != rank[b]) return rank[a] < rank[b];
+        if (rank2[a] != rank2[b]) return rank2[a] < rank2[b];
+        return a > b;
+    }
+};
+
+// ============================================================================
+// Functions
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Function _prefixDoublingLimits()
+// ----------------------------------------------------------------------------
+// Returns the length of the longest sequence.
+
+template <typename TLimits, typename TText>
+inline typename Value<TLimits>::Type
+_prefixDoublingLimits(TLimits & limits, TText const & text)
+{
+    resize(limits, 2, Exact());
+    limits[0] = 0;
+    limits[1] = length(text);
+    return limits[1];
+}
+
+template <typename TLimits, typename TString, typename TSSetSpec>
+inline typename Value<TLimits>::Type
+_prefixDoublingLimits(TLimits & limits, StringSet<TString, TSSetSpec> const & text)
+{
+    typedef typename Value<TLimits>::Type   TPos;
+
+    TPos maxLength = 0;
+    resize(limits, countSequences(text) + 1, Exact());
+    limits[0] = 0;
+    for (TPos i = 0; i < countSequences(text); ++i)
+    {
+        limits[i + 1] = limits[i] + length(text[i]);
+        maxLength = std::max(maxLength, (TPos)length(text[i]));
+    }
+    return maxLength;
+}
+
+// ----------------------------------------------------------------------------
+// Function _prefixDoublingSequence()
+// ----------------------------------------------------------------------------
+
+template <typename TText, typename TSeqNo>
+inline TText const &
+_prefixDoublingSequence(TText const & text, TSeqNo)
+{
+    return text;
+}
+
+template <typename TString, typename TSSetSpec, typename TSeqNo>
+inline typename Reference<StringSet<TString, TSSetSpec> const>::Type
+_prefixDoublingSequence(StringSet<TString, TSSetSpec> const & text, TSeqNo seqNo)
+{
+    return text[seqNo];
+}
+
+// ----------------------------------------------------------------------------
+// Function _prefixDoublingSeqNo()
+// ----------------------------------------------------------------------------
+// Returns the number of the sequence containing the global position pos.
+
+template <typename TLimits, typename TPos>
+inline typename Size<TLimits>::Type
+_prefixDoublingSeqNo(TLimits const & limits, TPos pos)
+{
+    return std::upper_bound(begin(limits, Standard()), end(limits, Standard()), pos) - begin(limits, Standard()) - 1;
+}
+
+// ----------------------------------------------------------------------------
+// Function _prefixDoublingInitialKeys()
+// ----------------------------------------------------------------------------
+// Packs the q characters following each position into one key, characters
+// beyond the end of the sequence are encoded as 0.
+
+template <typename TKeys, typename TText, typename TLimits, typename TParallel>
+inline void
+_prefixDoublingInitialKeys(TKeys & keys, TText const & text, TLimits const & limits,
+                           unsigned q, unsigned bitsPerChar, Tag<TParallel> const & parallelTag)
+{
+    typedef typename Value<TKeys>::Type                     TKey;
+    typedef typename Value<TLimits>::Type                   TPos;
+    typedef typename Size<TLimits>::Type                    TSeqNo;
+    typedef typename MakeSigned<TPos>::Type                 TSignedPos;
+
+    TKey mask = (q * bitsPerChar >= BitsPerValue<TKey>::VALUE) ? ~(TKey)0 : ((TKey)1 << (q * bitsPerChar)) - 1;
+    Splitter<TPos> splitter(0, back(limits), parallelTag);
+
+    SEQAN_OMP_PRAGMA(parallel for if(IsSameType<Tag<TParallel>, Parallel>::VALUE))
+    for (TSignedPos job = 0; job < static_cast<TSignedPos>(length(splitter)); ++job)
+    {
+        TPos pos = splitter[job];
+        TPos posEnd = splitter[job + 1];
+
+        for (TSeqNo seqNo = _prefixDoublingSeqNo(limits, pos); pos < posEnd; ++seqNo)
+        {
+            TPos seqBegin = limits[seqNo];
+            TPos seqEnd = limits[seqNo + 1];
+            if (pos >= seqEnd) continue;
+
+            TKey key = 0;
+            for (unsigned t = 0; t < q; ++t)
+                key = (key << bitsPerChar) | ((pos + t < seqEnd) ?
+                      ordValue(value(_prefixDoublingSequence(text, seqNo), pos + t - seqBegin)) + 1 : 0);
+            keys[pos] = key;
+
+            for (++pos; pos < posEnd && pos < seqEnd; ++pos)
+            {
+                key = ((key << bitsPerChar) & mask) | ((pos + q - 1 < seqEnd) ?
+                      ordValue(value(_prefixDoublingSequence(text, seqNo), pos + q - 1 - seqBegin)) + 1 : 0);
+                keys[pos] = key;
+            }
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Function _prefixDoublingShiftedRanks()
+// ----------------------------------------------------------------------------
+// Sets rank2[i] of each position i in the suffix array entries [saBegin, saEnd)
+// to the rank of position i + h or to 0 if i + h is beyond the end of the
+// sequence of i.
+
+template <typename TRanks, typename TSA, typename TLimits, typename TPos>
+inline void
+_prefixDoublingShiftedRanks(TRanks & rank2, TRanks const & rank, TSA const & sa, TLimits const & limits, TPos h,
+                            TPos saBegin, TPos saEnd)
+{
+    for (TPos j = saBegin; j < saEnd; ++j)
+    {
+        TPos pos = sa[j];
+        TPos seqEnd = limits[_prefixDoublingSeqNo(limits, pos) + 1];
+        rank2[pos] = (pos + h < seqEnd) ? rank[pos + h] : 0;
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Function _prefixDoublingSplit()
+// ----------------------------------------------------------------------------
+// Splits the entries [chunkBegin, chunkEnd) of the bucket [bucketBegin, bucketEnd)
+// of the suffix array, which is sorted by key, into buckets of equal keys.
+// Each position gets the first entry of its bucket + 1 as rank, start is the
+// first entry of the bucket containing chunkBegin. Buckets with more than one
+// entry are appended to unsorted by the chunk containing their end.
+
+template <typename TRanks, typename TBuckets, typename TSA, typename TKeys, typename TPos>
+inline void
+_prefixDoublingSplit(TRanks & rank, TBuckets & unsorted, TSA const & sa, TKeys const & key,
+                     TPos bucketBegin, TPos bucketEnd, TPos chunkBegin, TPos chunkEnd, TPos start)
+{
+    typedef typename Value<TBuckets>::Type                  TBucket;
+
+    for (TPos j = chunkBegin; j < chunkEnd; ++j)
+    {
+        if (j != bucketBegin && key[sa[j]] != key[sa[j - 1]])
+        {
+            if (j - start > 1)
+                appendValue(unsorted, TBucket(start, j));
+            start = j;
+        }
+        rank[sa[j]] = start + 1;
+    }
+    if (chunkEnd == bucketEnd && bucketEnd - start > 1)
+        appendValue(unsorted, TBucket(start, bucketEnd));
+}
+
+// ----------------------------------------------------------------------------
+// Function _prefixDoublingSplitParallel()
+// ----------------------------------------------------------------------------
+// Splits one bucket of the suffix array in parallel. The first entry of the
+// bucket containing each chunk is determined beforehand.
+
+template <typename TRanks, typename TBuckets, typename TSA, typename TKeys, typename TPos, typename TParallel>
+inline void
+_prefixDoublingSplitParallel(TRanks & rank, String<TBuckets> & threadUnsorted, TSA const & sa, TKeys const & key,
+                             TPos bucketBegin, TPos bucketEnd, Tag<TParallel> const & parallelTag)
+{
+    typedef typename MakeSigned<TPos>::Type                 TSignedPos;
+
+    Splitter<TPos> splitter(bucketBegin, bucketEnd, parallelTag);
+    String<TPos> start;
+    resize(start, length(splitter), bucketBegin, Exact());
+
+    // The last bucket start in each chunk but the last one, bucketBegin if there is none.
+    SEQAN_OMP_PRAGMA(parallel for if(IsSameType<Tag<TParallel>, Parallel>::VALUE))
+    for (TSignedPos job = 0; job < static_cast<TSignedPos>(length(splitter)) - 1; ++job)
+    {
+        TPos j = splitter[job + 1] - 1;
+        while (j > splitter[job] && key[sa[j]] == key[sa[j - 1]])
+            --j;
+        if (j > bucketBegin && key[sa[j]] != key[sa[j - 1]])
+            start[job + 1] = j;
+    }
+
+    for (unsigned job = 1; job < length(start); ++job)
+        start[job] = std::max(start[job], start[job - 1]);
+
+    SEQAN_OMP_PRAGMA(parallel for if(IsSameType<Tag<TParallel>, Parallel>::VALUE))
+    for (TSignedPos job = 0; job < static_cast<TSignedPos>(length(splitter)); ++job)
+        _prefixDoublingSplit(rank, threadUnsorted[omp_get_thread_num()], sa, key,
+                             bucketBegin, bucketEnd, splitter[job], splitter[job + 1], start[job]);
+}
+
+// ----------------------------------------------------------------------------
+// Function _prefixDoublingCollectBuckets()
+// ----------------------------------------------------------------------------
+// Moves the unsorted buckets found by all threads into a list of small buckets,
+// each sorted by one thread, and a list of large buckets, each sorted by all
+// threads. Returns the number of unsorted suffix array entries.
+
+template <typename TBuckets>
+inline __uint64
+_prefixDoublingCollectBuckets(TBuckets & small, TBuckets & large, String<TBuckets> & threadUnsorted,
+                              unsigned numThreads)
+{
+    typedef typename Iterator<TBuckets, Standard>::Type     TIter;
+
+    __uint64 total = 0;
+    for (unsigned t = 0; t < length(threadUnsorted); ++t)
+        for (TIter it = begin(threadUnsorted[t], Standard()); it != end(threadUnsorted[t], Standard()); ++it)
+            total += it->i2 - it->i1;
+
+    clear(small);
+    clear(large);
+    for (unsigned t = 0; t < length(threadUnsorted); ++t)
+    {
+        for (TIter it = begin(threadUnsorted[t], Standard()); it != end(threadUnsorted[t], Standard()); ++it)
+        {
+            if ((__uint64)(it->i2 - it->i1) * numThreads > total)
+                appendValue(large, *it);
+            else
+                appendValue(small, *it);
+        }
+        clear(threadUnsorted[t]);
+        shrinkToFit(threadUnsorted[t]);
+    }
+    return total;
+}
+
+// ----------------------------------------------------------------------------
+// Function _createSuffixArrayPrefixDoubling()
+// ----------------------------------------------------------------------------
+// Sorts the global positions of a text or text collection.
+// Like Larsson and Sadakane's algorithm, each round only sorts the buckets of
+// suffixes whose ranks are still equal, and a position's rank is the first
+// suffix array entry of its bucket + 1. Besides the suffix array it needs two
+// rank strings and the unsorted bucket lists, and for the leading q-grams one
+// 64 bit key per character that is freed before the doubling rounds.
+
+template <typename TSA, typename TText, typename TParallel>
+inline void
+_createSuffixArrayPrefixDoubling(TSA & sa, TText const & text, Tag<TParallel> const & parallelTag)
+{
+    typedef typename Value<TSA>::Type                       TPos;
+    typedef typename MakeSigned<TPos>::Type                 TSignedPos;
+    typedef typename Value<TText>::Type                     TTextValue;
+    typedef typename Value<TTextValue>::Type                TAlphabet;
+    typedef typename Infix<TSA>::Type                       TSAInfix;
+    typedef String<TPos>                                    TRanks;
+    typedef String<__uint64>                                TKeys;
+    typedef String<Pair<TPos> >                             TBuckets;
+
+    static const unsigned BITS_PER_CHAR = Log2<ValueSize<TAlphabet>::VALUE + 1>::VALUE;
+    static const unsigned Q = (BITS_PER_CHAR < 64) ? 64 / BITS_PER_CHAR : 1;
+
+    String<TPos> limits;
+    TPos maxLength = _prefixDoublingLimits(limits, text);
+    TPos n = back(limits);
+
+    SEQAN_ASSERT_EQ(length(sa), n);
+    if (n == 0) return;
+
+    Splitter<TPos> splitter(0, n, parallelTag);
+    unsigned numThreads = length(splitter);
+
+    SEQAN_OMP_PRAGMA(parallel for if(IsSameType<Tag<TParallel>, Parallel>::VALUE))
+    for (TSignedPos job = 0; job < static_cast<TSignedPos>(length(splitter)); ++job)
+        for (TPos i = splitter[job]; i < splitter[job + 1]; ++i)
+            sa[i] = i;
+
+    TRanks rank;
+    resize(rank, n, Exact());
+
+    // The buckets of more than one suffix with equal ranks, found by each thread.
+    String<TBuckets> threadUnsorted;
+    resize(threadUnsorted, omp_get_max_threads());
+
+    // Sort by the leading q-grams.
+    {
+        TKeys keys;
+        resize(keys, n, Exact());
+        _prefixDoublingInitialKeys(keys, text, limits, Q, BITS_PER_CHAR, parallelTag);
+        sort(sa, PrefixDoublingLess_<TKeys, TPos>(keys, keys), parallelTag);
+        _prefixDoublingSplitParallel(rank, threadUnsorted, sa, keys, (TPos)0, n, parallelTag);
+    }
+
+    // Double the sorted prefix length and sort the buckets with equal ranks by the ranks of the following h
+    // characters, until all ranks are distinct or all suffixes are sorted entirely.
+    TRanks rank2;
+    resize(rank2, n, Exact());
+    TBuckets small;
+    TBuckets large;
+    for (TPos h = Q; h < maxLength; h *= 2)
+    {
+        if (_prefixDoublingCollectBuckets(small, large, threadUnsorted, numThreads) == 0)
+            break;
+
+        // All shifted ranks must be computed before any rank is updated.
+        SEQAN_OMP_PRAGMA(parallel for if(IsSameType<Tag<TParallel>, Parallel>::VALUE) schedule(dynamic, 64))
+        for (TSignedPos k = 0; k < static_cast<TSignedPos>(length(small)); ++k)
+            _prefixDoublingShiftedRanks(rank2, rank, sa, limits, h, small[k].i1, small[k].i2);
+
+        for (unsigned k = 0; k < length(large); ++k)
+        {
+            Splitter<TPos> bucketSplitter(large[k].i1, large[k].i2, parallelTag);
+
+            SEQAN_OMP_PRAGMA(parallel for if(IsSameType<Tag<TParallel>, Parallel>::VALUE))
+            for (TSignedPos job = 0; job < static_cast<TSignedPos>(length(bucketSplitter)); ++job)
+                _prefixDoublingShiftedRanks(rank2, rank, sa, limits, h, bucketSplitter[job], bucketSplitter[job + 1]);
+        }
+
+        PrefixDoublingLess_<TRanks, TPos> less(rank2, rank2);
+        for (unsigned k = 0; k < length(large); ++k)
+        {
+            TSAInfix bucket = infix(sa, large[k].i1, large[k].i2);
+            sort(bucket, less, parallelTag);
+            _prefixDoublingSplitParallel(rank, threadUnsorted, sa, rank2, large[k].i1, large[k].i2, parallelTag);
+        }
+
+        SEQAN_OMP_PRAGMA(parallel for if(IsSameType<Tag<TParallel>, Parallel>::VALUE) schedule(dynamic, 64))
+        for (TSignedPos k = 0; k < static_cast<TSignedPos>(length(small)); ++k)
+        {
+            TSAInfix bucket = infix(sa, small[k].i1, small[k].i2);
+            sort(bucket, less, Serial());
+            _prefixDoublingSplit(rank, threadUnsorted[omp_get_thread_num()], sa, rank2,
+                                 small[k].i1, small[k].i2, small[k].i1, small[k].i2, small[k].i1);
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Function createSuffixArray()                                [PrefixDoubling]
+// ----------------------------------------------------------------------------
+
+template <typename TSA, typename TText, typename TParallel>
+inline void
+createSuffixArray(TSA & sa, TText const & text, PrefixDoubling<TParallel> const &)
+{
+    _createSuffixArrayPrefixDoubling(sa, text, TParallel());
+}
+
+template <typename TSA, typename TString, typename TSSetSpec, typename TParallel>
+inline void
+createSuffixArray(TSA & sa, StringSet<TString, TSSetSpec> const & text, PrefixDoubling<TParallel> const &)
+{
+    typedef typename Size<StringSet<TString, TSSetSpec> >::Type TPos;
+    typedef typename MakeSigned<TPos>::Type                 TSignedPos;
+
+    String<TPos> limits;
+    _prefixDoublingLimits(limits, text);
+
+    String<TPos> globalSa;
+    resize(globalSa, length(sa), Exact());
+    _createSuffixArrayPrefixDoubling(globalSa, text, TParallel());
+
+    Splitter<TPos> splitter(0, length(sa), TParallel());
+
+    SEQAN_OMP_PRAGMA(parallel for if(IsSameType<TParallel, Parallel>::VALUE))
+    for (TSignedPos job = 0; job < static_cast<TSignedPos>(length(splitter)); ++job)
+        for (TPos j = splitter[job]; j < splitter[job + 1]; ++j)
+            posLocalize(sa[j], globalSa[j], limits);
+}
+
+}
+
+#endif  // #ifndef INDEX_SA_PREFIX_DOUBLING_H_
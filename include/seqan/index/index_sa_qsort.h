@@ -220,7 +220,8 @@ namespace SEQAN_NAMESPACE_MAIN
         TSA        sa;
         TSource    in;
 
-        Pipe(TInput &_textIn):
+        // keeps everything in memory, there are no Pools to parametrize
+        Pipe(TInput &_textIn, PoolParameters const & = PoolParameters()):
             in(sa)
         {
             TText text;
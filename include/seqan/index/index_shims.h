@@ -51,7 +51,8 @@ namespace SEQAN_NAMESPACE_MAIN
     void _createSuffixArrayPipelining(
         TSA &suffixArray,
         TObject const &text,
-        TAlgSpec const)
+        TAlgSpec const,
+        PoolParameters const &conf = PoolParameters())
     {
     SEQAN_CHECKPOINT
         // signed characters behave different than unsigned when compared
@@ -67,7 +68,7 @@ namespace SEQAN_NAMESPACE_MAIN
         // instantiation and processing
         src_t        src(text);
         unsigner_t  unsigner(src);
-        creator_t    creator(unsigner);
+        creator_t    creator(unsigner, conf);
 
         suffixArray << creator;
         #ifdef SEQAN_TEST_INDEX
@@ -85,7 +86,8 @@ namespace SEQAN_NAMESPACE_MAIN
     void _createSuffixArrayPipelining(
         TSA &suffixArray,
         StringSet<TString, TSpec> const &stringSet,
-        TAlgSpec const)
+        TAlgSpec const,
+        PoolParameters const &conf = PoolParameters())
     {
     SEQAN_CHECKPOINT
         // signed characters behave different than unsigned when compared
@@ -106,7 +108,7 @@ namespace SEQAN_NAMESPACE_MAIN
         // instantiation and processing
         src_t        src(concat(stringSet));
         unsigner_t  unsigner(src);
-        creator_t    creator(unsigner, stringSetLimits(stringSet));
+        creator_t    creator(unsigner, stringSetLimits(stringSet), conf);
 
         suffixArray << creator;
         #ifdef SEQAN_TEST_INDEX
@@ -120,11 +122,13 @@ namespace SEQAN_NAMESPACE_MAIN
  * @headerfile <seqan/index.h>
  * @brief Creates a suffix array from a given text.
  *
- * @signature void createSuffixArray(suffixArray, text[, algoTag]);
+ * @signature void createSuffixArray(suffixArray, text[, algoTag[, poolParameters]]);
  *
  * @param[out] suffix  Array The resulting suffix array.
  * @param[in]  text    A given text. Types: @link ContainerConcept @endlink
  * @param[in]  algoTag A tag that identifies the algorithm which is used for creation.
+ * @param[in]  poolParameters The @link PoolParameters @endlink of the Pools of external algorithms like Skew7,
+ *                            e.g. to bound their memory by a @link PoolMemoryBudget @endlink.
  *
  * This function should not be called directly.  Please use @link Index#indexCreate
  * @endlink or @link Index#indexRequire @endlink.  The size of <tt>suffixArray</tt>
@@ -156,6 +160,7 @@ namespace SEQAN_NAMESPACE_MAIN
         TSA &sa,
         TText const &s,
         TAlgSpec const &alg,
+        PoolParameters const &,
         True)
     {
     SEQAN_CHECKPOINT
@@ -172,10 +177,11 @@ namespace SEQAN_NAMESPACE_MAIN
         TSA &sa,
         StringSet<TSequence, TSetSpec> const &s,
         TAlgSpec const &,
+        PoolParameters const &conf,
         True)
     {
     SEQAN_CHECKPOINT
-        _createSuffixArrayPipelining(sa, s, Skew7());
+        _createSuffixArrayPipelining(sa, s, Skew7(), conf);
     }
 
     template <
@@ -186,10 +192,25 @@ namespace SEQAN_NAMESPACE_MAIN
         TSA &sa,
         TText const &s,
         TAlgSpec const &alg,
+        PoolParameters const &conf,
         False)
     {
     SEQAN_CHECKPOINT
-        _createSuffixArrayPipelining(sa, s, alg);
+        _createSuffixArrayPipelining(sa, s, alg, conf);
+    }
+
+    template <
+        typename TSA,
+        typename TText,
+        typename TAlgSpec >
+    inline void createSuffixArray(
+        TSA &sa,
+        TText const &s,
+        TAlgSpec const &alg,
+        PoolParameters const &conf)
+    {
+    SEQAN_CHECKPOINT
+        _createSuffixArrayWrapper(sa, s, alg, conf, typename SACreatorRandomAccess_<TSA, TText, TAlgSpec>::Type());
     }
 
     template <
@@ -202,7 +223,7 @@ namespace SEQAN_NAMESPACE_MAIN
         TAlgSpec const &alg)
     {
     SEQAN_CHECKPOINT
-        _createSuffixArrayWrapper(sa, s, alg, typename SACreatorRandomAccess_<TSA, TText, TAlgSpec>::Type());
+        createSuffixArray(sa, s, alg, PoolParameters());
     }
 
 //____________________________________________________________________________
@@ -617,11 +638,13 @@ namespace SEQAN_NAMESPACE_MAIN
  * @headerfile <seqan/index.h>
  * @brief Creates a specific @link Fibre @endlink.
  *
- * @signature bool indexCreate(index, fibreTag[, algoTag]);
+ * @signature bool indexCreate(index, fibreTag[, algoTag[, poolParameters]]);
  *
  * @param[in]     fibreTag A tag that identifies the @link Fibre @endlink
  * @param[in]     algoTag  A tag that identifies the algorithm which is used to create the fibre.  Default: The
  *                         result of @link Index#DefaultIndexCreator @endlink.
+ * @param[in]     poolParameters The @link PoolParameters @endlink passed to @link createSuffixArray @endlink when
+ *                         creating the suffix array, e.g. to bound the memory of external algorithms.
  * @param[in,out] index    The @link Index @endlink object holding the fibre.
  *
  * @return bool <tt>true</tt> on a success and false <tt>otherwise</tt>
@@ -637,6 +660,13 @@ namespace SEQAN_NAMESPACE_MAIN
         return true;
     }
 
+    template <typename TText, typename TSpec, typename TSpecAlg>
+    inline bool indexCreate(Index<TText, TSpec> &index, FibreSA, TSpecAlg const alg, PoolParameters const &conf) {
+        resize(indexSA(index), length(indexRawText(index)), Exact());
+        createSuffixArray(indexSA(index), indexText(index), alg, conf);
+        return true;
+    }
+
     template <typename TText, typename TSpec, typename TParallel>
     inline bool indexCreate(Index<TText, TSpec> &index, FibreIsa, FromSortedSa<TParallel> const alg)
     {
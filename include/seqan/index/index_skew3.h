@@ -208,12 +208,17 @@ namespace SEQAN_NAMESPACE_MAIN
         TSorterS0   sortedS0;
         TSorterS12  sortedS12;
         TMerger     in;
+        PoolParameters  conf;
 
-        Pipe() :
-            in(bundle2(sortedS0, sortedS12)) {}
+        Pipe(PoolParameters const &_conf = PoolParameters()) :
+            sortedS0(_conf), sortedS12(_conf),
+            in(bundle2(sortedS0, sortedS12)),
+            conf(_conf) {}
 
-        Pipe(TInput& _textIn) :
-            in(bundle2(sortedS0, sortedS12))
+        Pipe(TInput& _textIn, PoolParameters const &_conf = PoolParameters()) :
+            sortedS0(_conf), sortedS12(_conf),
+            in(bundle2(sortedS0, sortedS12)),
+            conf(_conf)
         {
             process(_textIn);
         }
@@ -234,7 +239,7 @@ namespace SEQAN_NAMESPACE_MAIN
 
             // step 1
             TSamplerDC3                 sampler(textIn);
-            TSortTuples                 sorter;
+            TSortTuples                 sorter(conf);
             #ifdef SEQAN_DEBUG_INDEX
                 std::cerr << "  sort names (" << length(sampler)<< ")" << std::endl;
             #endif
@@ -244,7 +249,7 @@ namespace SEQAN_NAMESPACE_MAIN
             TNamer                      namer(sorter);
             nmap_sliced_t               map_sliced(length(namer));
             nmap_linear_t               map_linear(length(namer));
-            TNames_Sliced               names_sliced(map_sliced);
+            TNames_Sliced               names_sliced(map_sliced, conf);
             #ifdef SEQAN_DEBUG_INDEX
                 std::cerr << "  slice names" << std::endl;
             #endif
@@ -256,7 +261,7 @@ namespace SEQAN_NAMESPACE_MAIN
 
                 clear(sorter);
                 SEQAN_PROMARK("Mapper (4) - s12 konstruieren");
-                TNames_Linear_Unique        names_linear(map_linear);
+                TNames_Linear_Unique        names_linear(map_linear, conf);
 
                 #ifdef SEQAN_DEBUG_INDEX
                     std::cerr << "  make names linear" << std::endl;
@@ -277,7 +282,7 @@ namespace SEQAN_NAMESPACE_MAIN
                 SEQAN_PROMARK("Mapper (4) - s12 konstruieren");
 
                 TFilter                     filter(names_sliced);
-                TRecurse                    recurse(filter);
+                TRecurse                    recurse(filter, conf);
 
                 #ifdef SEQAN_TEST_SKEW3
                 {
@@ -292,7 +297,7 @@ namespace SEQAN_NAMESPACE_MAIN
                 TUnslicer                   unslicer(recurse, func);
                 TRenamer                    renamer(unslicer);
 
-                TNames_Linear               names_linear(map_linear);
+                TNames_Linear               names_linear(map_linear, conf);
                 #ifdef SEQAN_DEBUG_INDEX
                     std::cerr << "  rename names" << std::endl;
                 #endif
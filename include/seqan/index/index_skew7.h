@@ -302,12 +302,17 @@ namespace SEQAN_NAMESPACE_MAIN
         TSorterS6   sortedS6;
         TSorterS124 sortedS124;
         TMerger     in;
+        PoolParameters  conf;
 
-        Pipe():
-            in(bundle5(sortedS0, sortedS3, sortedS5, sortedS6, sortedS124)) {}
+        Pipe(PoolParameters const &_conf = PoolParameters()):
+            sortedS0(_conf), sortedS3(_conf), sortedS5(_conf), sortedS6(_conf), sortedS124(_conf),
+            in(bundle5(sortedS0, sortedS3, sortedS5, sortedS6, sortedS124)),
+            conf(_conf) {}
 
-        Pipe(TInput& _textIn):
-            in(bundle5(sortedS0, sortedS3, sortedS5, sortedS6, sortedS124))
+        Pipe(TInput& _textIn, PoolParameters const &_conf = PoolParameters()):
+            sortedS0(_conf), sortedS3(_conf), sortedS5(_conf), sortedS6(_conf), sortedS124(_conf),
+            in(bundle5(sortedS0, sortedS3, sortedS5, sortedS6, sortedS124)),
+            conf(_conf)
         {
             process(_textIn);
         }
@@ -328,7 +333,7 @@ namespace SEQAN_NAMESPACE_MAIN
 
             // step 1
             TSamplerDC7                 sampler(textIn);
-            TSortTuples                 sorter;
+            TSortTuples                 sorter(conf);
             #ifdef SEQAN_DEBUG_INDEX
                 std::cerr << "  sort names (" << length(sampler)<< ")" << std::endl;
             #endif
@@ -338,7 +343,7 @@ namespace SEQAN_NAMESPACE_MAIN
             TNamer                      namer(sorter);
             nmap_sliced_t               map_sliced(length(namer));
             nmap_linear_t               map_linear(length(namer));
-            TNames_Sliced               names_sliced(map_sliced);
+            TNames_Sliced               names_sliced(map_sliced, conf);
             #ifdef SEQAN_DEBUG_INDEX
                 std::cerr << "  slice names" << std::endl;
             #endif
@@ -349,7 +354,7 @@ namespace SEQAN_NAMESPACE_MAIN
 
                 clear(sorter);
                 SEQAN_PROMARK("Mapper (4) - construct s124");
-                TNames_Linear_Unique        names_linear(map_linear);
+                TNames_Linear_Unique        names_linear(map_linear, conf);
 
                 #ifdef SEQAN_DEBUG_INDEX
                     std::cerr << "  make names linear" << std::endl;
@@ -368,12 +373,15 @@ namespace SEQAN_NAMESPACE_MAIN
                 SEQAN_PROMARK("Mapper (4) - construct s124");
 
                 TFilter                     filter(names_sliced);
-                TNames_Linear               names_linear(map_linear);
+                TNames_Linear               names_linear(map_linear, conf);
 
-                if (length(filter) > 128*1024*1024)
+                // the in-memory shortcut keeps the renamed text and its suffix array
+                size_t inMemSize = 2 * ((size_t)length(filter) + 1) * sizeof(typename SAValue<TFilter>::Type);
+
+                if (length(filter) > 128*1024*1024 || !_poolBudgetFits(conf.budget, inMemSize))
                 {
                     // recursion
-                    TRecurse                    recurse(filter);
+                    TRecurse                    recurse(filter, conf);
 
                     #ifdef SEQAN_TEST_SKEW7
                     {
@@ -396,18 +404,22 @@ namespace SEQAN_NAMESPACE_MAIN
                 }
                 else
                 {
-                    TInMem                        inMem(filter);
+                    _poolBudgetCharge(conf.budget, inMemSize);
+                    {
+                        TInMem                        inMem(filter);
 
-                    clear(filter);
-                    unslicer_func_t                func(length(textIn));
-                    TUnslicerInMem              unslicer(inMem, func);
-                    TRenamerInMem               renamer(unslicer);
+                        clear(filter);
+                        unslicer_func_t                func(length(textIn));
+                        TUnslicerInMem              unslicer(inMem, func);
+                        TRenamerInMem               renamer(unslicer);
 
-                    #ifdef SEQAN_DEBUG_INDEX
-                        std::cerr << "  rename names" << std::endl;
-                    #endif
+                        #ifdef SEQAN_DEBUG_INDEX
+                            std::cerr << "  rename names" << std::endl;
+                        #endif
 
-                    names_linear << renamer;
+                        names_linear << renamer;
+                    }
+                    _poolBudgetRelease(conf.budget, inMemSize);
                 }
 
                 SEQAN_PROMARK("Mapper (10) - ISA124 konstruieren");
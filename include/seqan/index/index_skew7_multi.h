@@ -274,6 +274,7 @@ namespace SEQAN_NAMESPACE_MAIN
         TSorterS124            sortedS124;
         TMerger                in;
         TLimitsString       const &limits;
+        PoolParameters      conf;
 
         // (weese): The SEQAN_CTOR_ENABLE_IF is necessary to avoid implicit casts and references to temporaries
 
@@ -294,6 +295,18 @@ namespace SEQAN_NAMESPACE_MAIN
             process(_textIn);
         }
 
+        template <typename TLimitsString_>
+        Pipe(TInput& _textIn, TLimitsString_ const &_limits, PoolParameters const &_conf,
+             SEQAN_CTOR_ENABLE_IF(IsSameType<TLimitsString, TLimitsString_>)) :
+            sortedS0(_conf), sortedS3(_conf), sortedS5(_conf), sortedS6(_conf), sortedS124(_conf),
+            in(bundle5(sortedS0, sortedS3, sortedS5, sortedS6, sortedS124), _limits),
+            limits(_limits),
+            conf(_conf)
+        {
+            ignoreUnusedVariableWarning(dummy);
+            process(_textIn);
+        }
+
         template < typename TInput_ >
         bool process(TInput_ &textIn) {
 
@@ -310,7 +323,7 @@ namespace SEQAN_NAMESPACE_MAIN
 
             // step 1
             TSamplerDC7                 sampler(textIn, limits);
-            TSortTuples                 sorter;
+            TSortTuples                 sorter(conf);
             #ifdef SEQAN_DEBUG_INDEX
                 std::cerr << "  sort names (" << length(sampler)<< ")" << std::endl;
             #endif
@@ -321,7 +334,7 @@ namespace SEQAN_NAMESPACE_MAIN
             func_slice_t                func_slice(limits);
 
             TSlicedPos                    slicedPos(namer, func_slice);
-            TNames_Sliced               names_sliced;
+            TNames_Sliced               names_sliced(conf);
             #ifdef SEQAN_DEBUG_INDEX
                 std::cerr << "  slice names" << std::endl;
             #endif
@@ -333,7 +346,7 @@ namespace SEQAN_NAMESPACE_MAIN
                 clear(sorter);
                 SEQAN_PROMARK("Mapper (4) - construct s124");
 
-                TNames_Linear               names_S1, names_S2, names_S4;
+                TNames_Linear               names_S1(conf), names_S2(conf), names_S4(conf);
 
                 #ifdef SEQAN_DEBUG_INDEX
                     std::cerr << "  make names linear" << std::endl;
@@ -359,12 +372,12 @@ namespace SEQAN_NAMESPACE_MAIN
                 SEQAN_PROMARK("Mapper (4) - construct s124");
 
                 TFilter                     filter(names_sliced);
-                TNames_Linear               names_S1, names_S2, names_S4;
+                TNames_Linear               names_S1(conf), names_S2(conf), names_S4(conf);
 
 //                if (length(filter) > 128*1024*1024)
                 {
                     // recursion
-                    TRecurse                    recurse(filter);
+                    TRecurse                    recurse(filter, conf);
 
                     #ifdef SEQAN_TEST_SKEW7
                     {
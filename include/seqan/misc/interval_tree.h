@@ -53,6 +53,7 @@
 #define SEQAN_HEADER_MISC_INTERVAL_TREE_H
 
 #include <seqan/graph_types.h>
+#include <seqan/parallel.h>
 
 
 namespace SEQAN_NAMESPACE_MAIN {
@@ -1925,6 +1926,415 @@ struct Cargo<IntervalTree<TValue, TCargo> >
     typedef TCargo Type;
 };
 
+// ==========================================================================
+// FlatIntervalTree
+// ==========================================================================
+
+/*!
+ * @class FlatIntervalTree
+ * @headerfile <seqan/misc/interval_tree.h>
+ * @brief Read-only interval tree stored as an implicit augmented array.
+ *
+ * @signature template <[typename TValue[, typename TCargo]]>
+ *            class FlatIntervalTree;
+ *
+ * @tparam TValue The type to use for coordinates.  Default: <tt>int</tt>.
+ * @tparam TCargo The type to use for cargo.  Default: <tt>unsigned</tt>.
+ *
+ * @section Remarks
+ *
+ * The intervals are sorted by their begin position and the sorted array itself is used as a binary search tree in
+ * in-order layout, i.e. the node at index <tt>i</tt> has the level given by the number of trailing one bits of
+ * <tt>i</tt>.  Each node is augmented with the largest end position in its subtree.  Begin and end positions, subtree
+ * maxima, and cargos are kept in separate contiguous strings.  There are no per-node objects or child pointers and
+ * subtrees of up to 15 intervals are scanned linearly.
+ *
+ * The tree is built in bulk by @link FlatIntervalTree#createIntervalTree @endlink and cannot be modified afterwards.
+ * Queries report the same cargos as the corresponding @link IntervalTree#findIntervals @endlink call, but not
+ * necessarily in the same order.
+ *
+ * @fn FlatIntervalTree::FlatIntervalTree
+ * @brief Constructor
+ *
+ * @signature FlatIntervalTree::FlatIntervalTree();
+ * @signature FlatIntervalTree::FlatIntervalTree(intervals);
+ *
+ * @param[in] intervals A string of <tt>IntervalAndCargo&lt;TValue, TCargo&gt;</tt> objects, see
+ *                      @link IntervalAndCargo @endlink.
+ */
+
+template <typename TValue = int, typename TCargo = unsigned int>
+class FlatIntervalTree
+{
+public:
+    typedef IntervalAndCargo<TValue, TCargo> TInterval;
+
+    String<TValue> begins;      // begin positions in ascending order
+    String<TValue> ends;        // end positions, in the order of begins
+    String<TValue> maxEnds;     // largest end position in the subtree rooted at each index
+    String<TCargo> cargos;
+    unsigned rootLevel;         // the root is at index 2^rootLevel - 1
+
+    FlatIntervalTree() : rootLevel(0)
+    {}
+
+    FlatIntervalTree(String<TInterval> const & intervals) : rootLevel(0)
+    {
+        createIntervalTree(*this, intervals);
+    }
+};
+
+template <typename TValue, typename TCargo>
+struct Value<FlatIntervalTree<TValue, TCargo> >
+{
+    typedef TValue Type;
+};
+
+template <typename TValue, typename TCargo>
+struct Cargo<FlatIntervalTree<TValue, TCargo> >
+{
+    typedef TCargo Type;
+};
+
+/*!
+ * @fn FlatIntervalTree#createIntervalTree
+ * @brief Build a flat interval tree from a set of intervals.
+ *
+ * @signature void createIntervalTree(flatTree, intervals);
+ *
+ * @param[out] flatTree  The FlatIntervalTree to build.  Any previous content is discarded.
+ * @param[in]  intervals Container of <tt>IntervalAndCargo&lt;TValue, TCargo&gt;</tt> objects.  It is not modified.
+ */
+
+template <typename TValue, typename TCargo, typename TIntervals>
+inline void
+createIntervalTree(FlatIntervalTree<TValue, TCargo> & tree,
+                   TIntervals const & intervals)
+{
+    typedef IntervalAndCargo<TValue, TCargo> TInterval;
+
+    size_t n = length(intervals);
+    String<TInterval> sorted;
+    resize(sorted, n, Exact());
+    for (size_t i = 0; i < n; ++i)
+        sorted[i] = TInterval(leftBoundary(intervals[i]), rightBoundary(intervals[i]), cargo(intervals[i]));
+    std::sort(begin(sorted, Standard()), end(sorted, Standard()), _less_compI1_ITree<TInterval>);
+
+    resize(tree.begins, n, Exact());
+    resize(tree.ends, n, Exact());
+    resize(tree.maxEnds, n, Exact());
+    resize(tree.cargos, n, Exact());
+    tree.rootLevel = 0;
+    if (n == 0)
+        return;
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        tree.begins[i] = sorted[i].i1;
+        tree.ends[i] = sorted[i].i2;
+        tree.cargos[i] = sorted[i].cargo;
+    }
+
+    // Leaves (even indices) have no children.  For the inner nodes of each level, the right child may lie beyond the
+    // array.  Such a virtual child's subtree contains only the nodes on the path to the last array element, whose
+    // maximum is tracked in lastMax.
+    size_t lastIdx = 0;
+    TValue lastMax = TValue();
+    for (size_t i = 0; i < n; i += 2)
+    {
+        lastIdx = i;
+        lastMax = tree.maxEnds[i] = tree.ends[i];
+    }
+
+    unsigned k = 1;
+    for (; ((size_t)1 << k) <= n; ++k)
+    {
+        size_t half = (size_t)1 << (k - 1);
+        for (size_t i = (half << 1) - 1; i < n; i += half << 2)
+        {
+            TValue e = std::max(tree.ends[i], tree.maxEnds[i - half]);
+            tree.maxEnds[i] = std::max(e, (i + half < n) ? tree.maxEnds[i + half] : lastMax);
+        }
+        lastIdx = ((lastIdx >> k) & 1) ? lastIdx - half : lastIdx + half;
+        if (lastIdx < n && tree.maxEnds[lastIdx] > lastMax)
+            lastMax = tree.maxEnds[lastIdx];
+    }
+    tree.rootLevel = k - 1;
+}
+
+/*!
+ * @fn FlatIntervalTree#length
+ * @brief Return the number of intervals stored in the tree.
+ *
+ * @signature TSize length(flatTree);
+ *
+ * @param[in] flatTree The FlatIntervalTree to query.
+ *
+ * @return TSize The number of intervals.
+ */
+
+template <typename TValue, typename TCargo>
+inline typename Size<String<TValue> >::Type
+length(FlatIntervalTree<TValue, TCargo> const & tree)
+{
+    return length(tree.begins);
+}
+
+/*!
+ * @fn FlatIntervalTree#empty
+ * @brief Return whether the tree contains no intervals.
+ *
+ * @signature bool empty(flatTree);
+ *
+ * @param[in] flatTree The FlatIntervalTree to query.
+ */
+
+template <typename TValue, typename TCargo>
+inline bool
+empty(FlatIntervalTree<TValue, TCargo> const & tree)
+{
+    return empty(tree.begins);
+}
+
+/*!
+ * @fn FlatIntervalTree#clear
+ * @brief Remove all intervals from the tree.
+ *
+ * @signature void clear(flatTree);
+ *
+ * @param[in,out] flatTree The FlatIntervalTree to clear.
+ */
+
+template <typename TValue, typename TCargo>
+inline void
+clear(FlatIntervalTree<TValue, TCargo> & tree)
+{
+    clear(tree.begins);
+    clear(tree.ends);
+    clear(tree.maxEnds);
+    clear(tree.cargos);
+    tree.rootLevel = 0;
+}
+
+// ----------------------------------------------------------------------------
+// Function _findIntervalsFlat()
+// ----------------------------------------------------------------------------
+
+// Appends the cargos of all intervals [i1, i2) with queryBegin < i2 and i1 < queryEnd (or i1 <= queryEnd for point
+// queries where queryBegin == queryEnd) to result.
+
+struct FlatIntervalTreeStackEntry_
+{
+    size_t idx;
+    unsigned level;
+    bool leftDone;
+};
+
+template <typename TValue, typename TCargo>
+inline void
+_findIntervalsFlat(String<TCargo> & result,
+                   FlatIntervalTree<TValue, TCargo> const & tree,
+                   TValue queryBegin,
+                   TValue queryEnd,
+                   bool pointQuery)
+{
+    size_t n = length(tree.begins);
+    if (n == 0)
+        return;
+
+    TValue const * begins = begin(tree.begins, Standard());
+    TValue const * ends = begin(tree.ends, Standard());
+    TValue const * maxEnds = begin(tree.maxEnds, Standard());
+    TCargo const * cargos = begin(tree.cargos, Standard());
+
+    FlatIntervalTreeStackEntry_ stack[2 * sizeof(size_t) * 8 + 2];
+    unsigned top = 0;
+    FlatIntervalTreeStackEntry_ root = { ((size_t)1 << tree.rootLevel) - 1, tree.rootLevel, false };
+    stack[top++] = root;
+
+    while (top != 0)
+    {
+        FlatIntervalTreeStackEntry_ z = stack[--top];
+        if (z.level <= 3)
+        {
+            // Small subtree: the begin positions are sorted, so first determine the candidate range and then filter
+            // it by end position without branching.
+            size_t i0 = z.idx >> z.level << z.level;
+            size_t i1 = std::min(n, i0 + ((size_t)2 << z.level) - 1);
+            size_t iEnd = i0;
+            if (pointQuery)
+                while (iEnd < i1 && !(queryEnd < begins[iEnd]))
+                    ++iEnd;
+            else
+                while (iEnd < i1 && begins[iEnd] < queryEnd)
+                    ++iEnd;
+            if (iEnd == i0)
+                continue;
+
+            size_t pos = length(result);
+            resize(result, pos + (iEnd - i0), Generous());
+            TCargo * out = begin(result, Standard());
+            for (size_t i = i0; i < iEnd; ++i)
+            {
+                out[pos] = cargos[i];
+                pos += (queryBegin < ends[i]);
+            }
+            resize(result, pos);
+        }
+        else if (!z.leftDone)
+        {
+            // Revisit z after its left subtree.  A left child beyond the array may still have nodes in its subtree.
+            size_t left = z.idx - ((size_t)1 << (z.level - 1));
+            z.leftDone = true;
+            stack[top++] = z;
+            if (left >= n || queryBegin < maxEnds[left])
+            {
+                FlatIntervalTreeStackEntry_ child = { left, z.level - 1, false };
+                stack[top++] = child;
+            }
+        }
+        else if (z.idx < n && (pointQuery ? !(queryEnd < begins[z.idx]) : begins[z.idx] < queryEnd))
+        {
+            if (queryBegin < ends[z.idx])
+                appendValue(result, cargos[z.idx], Generous());
+            FlatIntervalTreeStackEntry_ child = { z.idx + ((size_t)1 << (z.level - 1)), z.level - 1, false };
+            stack[top++] = child;
+        }
+    }
+}
+
+/*!
+ * @fn FlatIntervalTree#findIntervals
+ * @brief Find all intervals that contain the query point or overlap with the query interval.
+ *
+ * @signature void findIntervals(result, flatTree, query);
+ * @signature void findIntervals(result, flatTree, queryBegin, queryEnd);
+ * @signature void findIntervals(results, flatTree, queries[, numThreads]);
+ *
+ * @param[out] result     A reference to the result string of <tt>TCargo</tt> objects. Types: @link String @endlink.
+ * @param[out] results    A string of result strings, one per query. Types: @link String @endlink.
+ * @param[in]  flatTree   A FlatIntervalTree.
+ * @param[in]  query      A query point.
+ * @param[in]  queryBegin The begin position of the query interval.
+ * @param[in]  queryEnd   The end position of the query interval.
+ * @param[in]  queries    A string of query points or of @link Pair @endlink objects holding query intervals.
+ *                        The queries are processed in the order of their begin positions and the
+ *                        <tt>i</tt>-th result string belongs to the <tt>i</tt>-th query.
+ * @param[in]  numThreads The number of threads answering the queries, defaults to 1.
+ */
+
+template <typename TValue, typename TCargo, typename TValue2>
+inline void
+findIntervals(
+        String<TCargo> & result,
+        FlatIntervalTree<TValue, TCargo> const & tree,
+        TValue2 query)
+{
+    resize(result, 0);
+    _findIntervalsFlat(result, tree, (TValue)query, (TValue)query, true);
+}
+
+template <typename TValue, typename TCargo, typename TValue2>
+inline void
+findIntervals(
+        String<TCargo> & result,
+        FlatIntervalTree<TValue, TCargo> const & tree,
+        TValue2 query_begin,
+        TValue2 query_end)
+{
+    resize(result, 0);
+    _findIntervalsFlat(result, tree, (TValue)query_begin, (TValue)query_end, false);
+}
+
+// Extract the query bounds from a point or from a Pair, returns true for point queries.
+
+template <typename TValue, typename TQuery>
+inline bool
+_flatIntervalQueryBounds(TValue & queryBegin, TValue & queryEnd, TQuery const & query)
+{
+    queryBegin = queryEnd = (TValue)query;
+    return true;
+}
+
+template <typename TValue, typename T1, typename T2, typename TPairSpec>
+inline bool
+_flatIntervalQueryBounds(TValue & queryBegin, TValue & queryEnd, Pair<T1, T2, TPairSpec> const & query)
+{
+    queryBegin = (TValue)query.i1;
+    queryEnd = (TValue)query.i2;
+    return false;
+}
+
+template <typename TQueries>
+struct FlatIntervalQueryLess_
+{
+    TQueries const & queries;
+
+    FlatIntervalQueryLess_(TQueries const & queries) : queries(queries)
+    {}
+
+    template <typename TQuery>
+    static TQuery const & _key(TQuery const & query)
+    {
+        return query;
+    }
+
+    template <typename T1, typename T2, typename TPairSpec>
+    static T1 const & _key(Pair<T1, T2, TPairSpec> const & query)
+    {
+        return query.i1;
+    }
+
+    bool operator()(size_t a, size_t b) const
+    {
+        return _key(queries[a]) < _key(queries[b]);
+    }
+};
+
+template <typename TValue, typename TCargo, typename TResultSpec, typename TResultsSpec, typename TQuery,
+          typename TQueriesSpec>
+inline void
+findIntervals(
+        String<String<TCargo, TResultSpec>, TResultsSpec> & results,
+        FlatIntervalTree<TValue, TCargo> const & tree,
+        String<TQuery, TQueriesSpec> const & queries,
+        unsigned numThreads)
+{
+    typedef String<TQuery, TQueriesSpec> TQueries;
+
+    // Answer the queries in the order of their begin positions, so consecutive queries touch the same nodes.
+    size_t numQueries = length(queries);
+    String<size_t> order;
+    resize(order, numQueries, Exact());
+    for (size_t i = 0; i < numQueries; ++i)
+        order[i] = i;
+    std::sort(begin(order, Standard()), end(order, Standard()), FlatIntervalQueryLess_<TQueries>(queries));
+
+    resize(results, numQueries);
+    ignoreUnusedVariableWarning(numThreads);
+
+    SEQAN_OMP_PRAGMA(parallel for num_threads(numThreads) schedule(dynamic, 64))
+    for (__int64 j = 0; j < (__int64)numQueries; ++j)
+    {
+        size_t i = order[j];
+        TValue queryBegin, queryEnd;
+        bool pointQuery = _flatIntervalQueryBounds(queryBegin, queryEnd, queries[i]);
+        resize(results[i], 0);
+        _findIntervalsFlat(results[i], tree, queryBegin, queryEnd, pointQuery);
+    }
+}
+
+template <typename TValue, typename TCargo, typename TResultSpec, typename TResultsSpec, typename TQuery,
+          typename TQueriesSpec>
+inline void
+findIntervals(
+        String<String<TCargo, TResultSpec>, TResultsSpec> & results,
+        FlatIntervalTree<TValue, TCargo> const & tree,
+        String<TQuery, TQueriesSpec> const & queries)
+{
+    findIntervals(results, tree, queries, 1u);
+}
+
 }  // namespace SEQAN_NAMESPACE_MAIN
 
 #endif  //#ifndef SEQAN_MISC_INTERVAL_TREE_H
@@ -40,6 +40,8 @@
 #ifndef SEQAN_HEADER_MISC_NAME_STORE_CACHE_H
 #define SEQAN_HEADER_MISC_NAME_STORE_CACHE_H
 
+#include <seqan/parallel.h>
+
 namespace seqan {
 
 // ============================================================================
@@ -171,6 +173,86 @@ public:
     }
 };
 
+// ----------------------------------------------------------------------------
+// class NameStoreHashCache
+// ----------------------------------------------------------------------------
+
+/*!
+ * @class NameStoreHashCache
+ * @headerfile <seqan/misc/name_store_cache.h>
+ * @brief Hash-based mapping from string names to numeric ids.
+ *
+ * @signature template <typename TNameStore[, typename TName]>
+ *            class NameStoreHashCache;
+ *
+ * @tparam TNameStore The type to use for the name store.  Usually a @link StringSet @endlink of
+ *                    @link CharString @endlink.
+ * @tparam TName      The type to use for the names, defaults to <tt>Value&lt;TNameStore&gt;::Type</tt>.
+ *
+ * NameStoreHashCache offers the same interface as @link NameStoreCache @endlink and can be used wherever a name store
+ * cache type is a template argument, e.g. for @link BamIOContext @endlink or @link VcfIOContext @endlink.  Instead of a
+ * binary search tree it keeps an open-addressing hash table of ids with linear probing, so a lookup computes one hash
+ * value and usually compares against a single name.
+ *
+ * The table is guarded by a @link ReadWriteLock @endlink.  @link NameStoreHashCache#getIdByName @endlink can be called
+ * concurrently by multiple threads, @link NameStoreHashCache#nameToId @endlink only takes the write lock if the name
+ * has to be added.
+ */
+
+/*!
+ * @fn NameStoreHashCache::NameStoreHashCache
+ * @brief Constructors.
+ *
+ * @signature NameStoreHashCache::NameStoreHashCache();
+ * @signature NameStoreHashCache::NameStoreHashCache(other);
+ * @signature NameStoreHashCache::NameStoreHashCache(nameStore);
+ *
+ * @param[in] other     The other NameStoreHashCache to copy from.
+ * @param[in] nameStore A NameStore for which a pointer is stored.
+ */
+
+template <typename TId>
+struct NameStoreHashSlot_
+{
+    unsigned hash;
+    TId id;
+};
+
+template <typename TNameStore, typename TName = String<typename Value<typename Value<TNameStore>::Type>::Type> >
+class NameStoreHashCache
+{
+public:
+    typedef typename Position<TNameStore>::Type TId;
+    typedef NameStoreHashSlot_<TId> TSlot;
+
+    TNameStore *nameStore;
+    String<TSlot> table;            // size is 0 or a power of 2, empty slots have id maxValue<TId>()
+    TId entries;
+    mutable ReadWriteLock lock;
+
+    NameStoreHashCache() :
+        nameStore(NULL), entries(0)
+    {}
+
+    NameStoreHashCache(TNameStore & nameStore) :
+        nameStore(&nameStore), entries(0)
+    {
+        refresh(*this);
+    }
+
+    NameStoreHashCache(NameStoreHashCache const & other) :
+        nameStore(other.nameStore), table(other.table), entries(other.entries)
+    {}
+
+    NameStoreHashCache & operator=(NameStoreHashCache const & other)
+    {
+        nameStore = other.nameStore;
+        table = other.table;
+        entries = other.entries;
+        return *this;
+    }
+};
+
 // ============================================================================
 // Metafunctions
 // ============================================================================
@@ -432,6 +514,309 @@ nameToId(NameStoreCache<TNameStore, TName> & cache, TName2 const & name)
     return nameId;
 }
 
+// ----------------------------------------------------------------------------
+// Function host()
+// ----------------------------------------------------------------------------
+
+template <typename TNameStore, typename TName>
+inline TNameStore &
+host(NameStoreHashCache<TNameStore, TName> & cache)
+{
+    return *cache.nameStore;
+}
+
+template <typename TNameStore, typename TName>
+inline TNameStore &
+host(NameStoreHashCache<TNameStore, TName> const & cache)
+{
+    return *cache.nameStore;
+}
+
+// ----------------------------------------------------------------------------
+// Function clear()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn NameStoreHashCache#clear
+ * @brief Reset the NameStoreHashCache (not the name store).
+ *
+ * @signature void clear(cache);
+ *
+ * @param[in,out] cache The NameStoreHashCache to clear.
+ */
+
+template <typename TNameStore, typename TName>
+inline void
+clear(NameStoreHashCache<TNameStore, TName> & cache)
+{
+    clear(cache.table);
+    cache.entries = 0;
+}
+
+// ----------------------------------------------------------------------------
+// Function empty()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn NameStoreHashCache#empty
+ * @brief Query whether there are any entries in the cache (not the name store).
+ *
+ * @signature bool empty(cache);
+ *
+ * @param[in] cache The NameStoreHashCache to query.
+ *
+ * @return bool <tt>true</tt> if the NameStoreHashCache is empty.
+ */
+
+template <typename TNameStore, typename TName>
+inline bool
+empty(NameStoreHashCache<TNameStore, TName> const & cache)
+{
+    return cache.entries == 0;
+}
+
+// ----------------------------------------------------------------------------
+// Function _nameStoreHash()
+// ----------------------------------------------------------------------------
+
+// FNV-1a over the ordinal values of the name.
+template <typename TName>
+inline unsigned
+_nameStoreHash(TName const & name)
+{
+    typedef typename Iterator<TName const, Standard>::Type TIter;
+
+    unsigned hash = 2166136261u;
+    TIter itEnd = end(name, Standard());
+    for (TIter it = begin(name, Standard()); it != itEnd; ++it)
+    {
+        hash ^= ordValue(*it);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// ----------------------------------------------------------------------------
+// Function _findSlot()
+// ----------------------------------------------------------------------------
+
+// Return the slot holding name or the empty slot where it would be inserted.  Must not be called on an empty table.
+template <typename TNameStore, typename TName, typename TName2>
+inline typename Size<String<typename NameStoreHashCache<TNameStore, TName>::TSlot> >::Type
+_findSlot(NameStoreHashCache<TNameStore, TName> const & cache, TName2 const & name, unsigned hash)
+{
+    typedef NameStoreHashCache<TNameStore, TName> TCache;
+    typedef typename Size<String<typename TCache::TSlot> >::Type TSize;
+    typedef typename TCache::TId TId;
+
+    TSize mask = length(cache.table) - 1;
+    for (TSize i = hash & mask; ; i = (i + 1) & mask)
+    {
+        typename TCache::TSlot const & slot = cache.table[i];
+        if (slot.id == maxValue<TId>())
+            return i;
+        if (slot.hash == hash && (*cache.nameStore)[slot.id] == name)
+            return i;
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Function _insertId()
+// ----------------------------------------------------------------------------
+
+// Register the id of a name that is not in the table yet, growing the table to keep the load factor below 1/2.
+template <typename TNameStore, typename TName>
+inline void
+_insertId(NameStoreHashCache<TNameStore, TName> & cache, typename NameStoreHashCache<TNameStore, TName>::TId id,
+          unsigned hash)
+{
+    typedef NameStoreHashCache<TNameStore, TName> TCache;
+    typedef typename TCache::TSlot TSlot;
+    typedef typename Size<String<TSlot> >::Type TSize;
+    typedef typename TCache::TId TId;
+
+    if (2 * (cache.entries + 1) > length(cache.table))
+    {
+        TSlot emptySlot = { 0u, maxValue<TId>() };
+        String<TSlot> oldTable;
+        swap(oldTable, cache.table);
+        resize(cache.table, std::max((TSize)16, 2 * length(oldTable)), emptySlot, Exact());
+
+        TSize mask = length(cache.table) - 1;
+        for (TSize j = 0; j < length(oldTable); ++j)
+        {
+            if (oldTable[j].id == maxValue<TId>())
+                continue;
+            TSize i = oldTable[j].hash & mask;
+            while (cache.table[i].id != maxValue<TId>())
+                i = (i + 1) & mask;
+            cache.table[i] = oldTable[j];
+        }
+    }
+
+    TSlot & slot = cache.table[_findSlot(cache, (*cache.nameStore)[id], hash)];
+    slot.hash = hash;
+    slot.id = id;
+    ++cache.entries;
+}
+
+// ----------------------------------------------------------------------------
+// Function refresh()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn NameStoreHashCache#refresh
+ * @brief Rebuild the name store cache.
+ *
+ * Use this after modifying the underlying NameStore before querying.  If a name occurs multiple times in the store,
+ * the cache maps it to its first occurrence.
+ *
+ * @signature void refresh(cache);
+ *
+ * @param[in,out] cache The NameStoreHashCache to rebuild.
+ */
+
+template <typename TNameStore, typename TName>
+inline void
+refresh(NameStoreHashCache<TNameStore, TName> & cache)
+{
+    typedef typename NameStoreHashCache<TNameStore, TName>::TId TId;
+
+    ScopedWriteLock<> writeLock(cache.lock);
+    clear(cache);
+    for (TId i = 0; i < (TId)length(*cache.nameStore); ++i)
+    {
+        unsigned hash = _nameStoreHash((*cache.nameStore)[i]);
+        if (empty(cache.table) || cache.table[_findSlot(cache, (*cache.nameStore)[i], hash)].id == maxValue<TId>())
+            _insertId(cache, i, hash);
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Function appendName()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn NameStoreHashCache#appendName
+ * @brief Append a name to a name store and register it in the cache.
+ *
+ * @signature void appendName(cache, name);
+ *
+ * @param[in,out] cache     The NameStoreHashCache to use for faster access.
+ * @param[in]     name      The name to append to the store (@link ContainerConcept#Value @endlink of
+ *                          <tt>TNameStore</tt>).
+ */
+
+template <typename TCNameStore, typename TCName, typename TName>
+void appendName(NameStoreHashCache<TCNameStore, TCName> & cache, TName const & name)
+{
+    ScopedWriteLock<> writeLock(cache.lock);
+    appendValue(host(cache), name, Generous());
+    _insertId(cache, length(host(cache)) - 1, _nameStoreHash(name));
+}
+
+// deprecated.
+template <typename TNameStore, typename TName, typename TCNameStore, typename TCName>
+void appendName(TNameStore & /*nameStore*/, TName const & name, NameStoreHashCache<TCNameStore, TCName> & context)
+{
+    appendName(context, name);
+}
+
+// ----------------------------------------------------------------------------
+// Function getIdByName()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn NameStoreHashCache#getIdByName
+ * @brief Get id/index of a string in a name store using a NameStoreHashCache.
+ *
+ * @signature bool getIdByName(idx, cache, name);
+ *
+ * @param[out]    idx       The variable to store the index in the store of (@link IntegerConcept @endlink).
+ * @param[in]     cache     The NameStoreHashCache to use for speeding up the lookup.
+ * @param[in]     name      The name to search in the name store (@link ContainerConcept#Value @endlink of
+ *                          <tt>TNameStore</tt>).
+ *
+ * @return bool <tt>true</tt> if the name could be found and <tt>false</tt> otherwise.
+ *
+ * This function is thread-safe.
+ */
+
+template <typename TCNameStore, typename TCName, typename TName, typename TPos>
+inline bool
+_getIdByName(TPos & pos, NameStoreHashCache<TCNameStore, TCName> const & cache, TName const & name, unsigned hash)
+{
+    typedef typename NameStoreHashCache<TCNameStore, TCName>::TId TId;
+
+    if (empty(cache.table))
+        return false;
+    TId id = cache.table[_findSlot(cache, name, hash)].id;
+    if (id == maxValue<TId>())
+        return false;
+    pos = id;
+    return true;
+}
+
+template <typename TCNameStore, typename TCName, typename TName, typename TPos>
+inline bool
+getIdByName(TPos & pos, NameStoreHashCache<TCNameStore, TCName> const & cache, TName const & name)
+{
+    unsigned hash = _nameStoreHash(name);
+    ScopedReadLock<> readLock(cache.lock);
+    return _getIdByName(pos, cache, name, hash);
+}
+
+// deprecated.
+template<typename TNameStore, typename TName, typename TPos, typename TCNameStore, typename TCName>
+inline bool
+getIdByName(TNameStore const & /*nameStore*/, TName const & name, TPos & pos,
+            NameStoreHashCache<TCNameStore, TCName> const & context)
+{
+    return getIdByName(pos, context, name);
+}
+
+// ----------------------------------------------------------------------------
+// Function nametoId()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn NameStoreHashCache#nameToId
+ * @brief Translate a name to a numeric id, adding the name to the store and cache if new.
+ *
+ * @signature TPos nameToId(cache, name);
+ *
+ * @param[in,out] cache The NameStoreHashCache use for translating the name to a numeric id.
+ * @param[in]     name  The name to add (@link ContainerConcept#Value @endlink of <tt>TNameStore</tt>).
+ *
+ * @return TPos The numeric id of the name in the store and cache (@link ContainerConcept#Position Position @endlink of
+ *              <tt>TNameStore</tt>).
+ *
+ * This function is thread-safe.  Known names are looked up under the shared read lock.
+ */
+
+template <typename TNameStore, typename TName, typename TName2>
+typename Position<TNameStore>::Type
+nameToId(NameStoreHashCache<TNameStore, TName> & cache, TName2 const & name)
+{
+    typename Position<TNameStore>::Type nameId = 0;
+    unsigned hash = _nameStoreHash(name);
+    {
+        ScopedReadLock<> readLock(cache.lock);
+        if (_getIdByName(nameId, cache, name, hash))
+            return nameId;
+    }
+
+    // Another thread may have added the name between the two locks.
+    ScopedWriteLock<> writeLock(cache.lock);
+    if (!_getIdByName(nameId, cache, name, hash))
+    {
+        nameId = length(host(cache));
+        appendValue(host(cache), name, Generous());
+        _insertId(cache, nameId, hash);
+    }
+    return nameId;
+}
+
 }  // namespace seqan
 
 #endif  // #ifndef SEQAN_HEADER_MISC_NAME_STORE_CACHE_H
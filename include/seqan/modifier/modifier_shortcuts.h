@@ -35,6 +35,10 @@
 #ifndef SEQAN_HEADER_MODIFIER_SHORTCUTS_H
 #define SEQAN_HEADER_MODIFIER_SHORTCUTS_H
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 namespace seqan
 {
 
@@ -272,20 +276,192 @@ complementString(THost const & host)
  */
 
 
+// Alphabets whose complement flips the two lowest bits of the ordinal value.
+// FIXED_POINT is the only value that is its own complement (N) or a value that
+// never occurs.
+template <typename TValue>
+struct XorComplement_ : False {};
+
+template <>
+struct XorComplement_<Dna> : True { enum { FIXED_POINT = 4 }; };
+
+template <>
+struct XorComplement_<Dna5> : True { enum { FIXED_POINT = 4 }; };
+
+template <>
+struct XorComplement_<Rna> : True { enum { FIXED_POINT = 4 }; };
+
+template <>
+struct XorComplement_<Rna5> : True { enum { FIXED_POINT = 4 }; };
+
+template <>
+struct XorComplement_<DnaQ> : True { enum { FIXED_POINT = Dna5QValueN_ }; };
+
+template <>
+struct XorComplement_<Dna5Q> : True { enum { FIXED_POINT = Dna5QValueN_ }; };
+
+// Complements left[0, count) and right[-count, 0) and swaps them pairwise.
+template <typename TValue>
+inline void _reverseComplementBlock(TValue * left, TValue * right, size_t count, False)
+{
+    FunctorComplement<TValue> func;
+    for (; count != 0; --count)
+    {
+        TValue tmp = func(*left);
+        *left++ = func(*--right);
+        *right = tmp;
+    }
+}
+
+#if defined(__SSE2__)
+template <typename TValue>
+inline __m128i _reverseComplementSimd(__m128i values)
+{
+    __m128i fixedPoints = _mm_cmpeq_epi8(values, _mm_set1_epi8(static_cast<char>(XorComplement_<TValue>::FIXED_POINT)));
+    values = _mm_xor_si128(values, _mm_andnot_si128(fixedPoints, _mm_set1_epi8(3)));
+
+    // reverse the byte order
+    values = _mm_or_si128(_mm_slli_epi16(values, 8), _mm_srli_epi16(values, 8));
+    values = _mm_shufflelo_epi16(values, _MM_SHUFFLE(0, 1, 2, 3));
+    values = _mm_shufflehi_epi16(values, _MM_SHUFFLE(0, 1, 2, 3));
+    return _mm_shuffle_epi32(values, _MM_SHUFFLE(1, 0, 3, 2));
+}
+#endif  // #if defined(__SSE2__)
+
+template <typename TValue>
+inline void _reverseComplementBlock(TValue * left, TValue * right, size_t count, True)
+{
+#if defined(__SSE2__)
+    SEQAN_ASSERT_EQ(sizeof(TValue), 1u);
+    for (; count >= 16; count -= 16, left += 16, right -= 16)
+    {
+        __m128i leftValues = _mm_loadu_si128(reinterpret_cast<__m128i const *>(left));
+        __m128i rightValues = _mm_loadu_si128(reinterpret_cast<__m128i const *>(right - 16));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(left), _reverseComplementSimd<TValue>(rightValues));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(right - 16), _reverseComplementSimd<TValue>(leftValues));
+    }
+#endif  // #if defined(__SSE2__)
+    _reverseComplementBlock(left, right, count, False());
+}
+
+// Contiguous sequences are complemented and reversed in a single pass.
 template < typename TSequence, typename TParallelTag >
-inline void reverseComplement(TSequence & sequence, Tag<TParallelTag> parallelTag)
+inline void _reverseComplement(TSequence & sequence, Tag<TParallelTag> parallelTag, True)
+{
+    typedef typename Value<TSequence>::Type                 TValue;
+    typedef typename Position<TSequence>::Type              TPos;
+    typedef typename XorComplement_<TValue>::Type           TXorComplement;
+
+    if (empty(sequence))
+        return;
+
+    TValue * itBeg = begin(sequence, Standard());
+    TValue * itEnd = end(sequence, Standard());
+    Splitter<TPos> splitter(0, length(sequence) / 2, parallelTag);
+
+    // disable multi-threading if sequence is too small
+    if (IsSameType<Tag<TParallelTag>, Parallel>::VALUE && _reverseDoSequential(length(sequence)))
+        resize(splitter, 1);
+
+    SEQAN_OMP_PRAGMA(parallel for num_threads((int)length(splitter)) schedule(static))
+    for (int job = 0; job < (int)length(splitter); ++job)
+        _reverseComplementBlock(itBeg + splitter[job], itEnd - splitter[job],
+                                splitter[job + 1] - splitter[job], TXorComplement());
+
+    // complement the central character of odd-length sequences
+    if (length(sequence) % 2 != 0)
+    {
+        TValue * center = itBeg + length(sequence) / 2;
+        *center = FunctorComplement<TValue>()(*center);
+    }
+}
+
+template < typename TSequence, typename TParallelTag >
+inline void _reverseComplement(TSequence & sequence, Tag<TParallelTag> parallelTag, False)
 {
     complement(sequence);
     reverse(sequence, parallelTag);
 }
 
+template < typename TSequence, typename TParallelTag >
+inline void reverseComplement(TSequence & sequence, Tag<TParallelTag> parallelTag)
+{
+    typedef typename Value<TSequence>::Type                 TValue;
+    typedef typename Iterator<TSequence, Standard>::Type    TIter;
+
+    _reverseComplement(sequence, parallelTag,
+                       typename And<IsContiguous<TSequence>, IsSameType<TIter, TValue *> >::Type());
+}
+
 // TODO(holtgrew): How is doing anything in-place on a const value possible?
 // (weese:) it is possible for rvalue references like temporary Segments/ModifiedStrings
 template < typename TSequence, typename TParallelTag >
 inline void reverseComplement(TSequence const & sequence, Tag<TParallelTag> parallelTag)
 {
-    complement(sequence);
-    reverse(sequence, parallelTag);
+    reverseComplement(const_cast<TSequence &>(sequence), parallelTag);
+}
+
+// Packed 2-bit strings are reverse-complemented word by word.
+inline __uint64 _reverseComplementWord(__uint64 word)
+{
+    word = ~word;
+    word = ((word >> 2) & 0x3333333333333333ull) | ((word & 0x3333333333333333ull) << 2);
+    word = ((word >> 4) & 0x0F0F0F0F0F0F0F0Full) | ((word & 0x0F0F0F0F0F0F0F0Full) << 4);
+    word = ((word >> 8) & 0x00FF00FF00FF00FFull) | ((word & 0x00FF00FF00FF00FFull) << 8);
+    word = ((word >> 16) & 0x0000FFFF0000FFFFull) | ((word & 0x0000FFFF0000FFFFull) << 16);
+    return (word >> 32) | (word << 32);
+}
+
+template <typename TValue, typename THostspec>
+inline void _reverseComplementPacked(String<TValue, Packed<THostspec> > & sequence)
+{
+    typedef String<TValue, Packed<THostspec> >              TSequence;
+    typedef PackedTraits_<TSequence>                        TTraits;
+    typedef typename Host<TSequence>::Type                  THost;
+    typedef typename Iterator<THost, Standard>::Type        THostIter;
+
+    SEQAN_ASSERT_EQ((int)TTraits::BITS_PER_VALUE, 2);
+    SEQAN_ASSERT_EQ((int)TTraits::WASTED_BITS, 0);
+
+    if (empty(sequence))
+        return;
+
+    // the first host value stores the length
+    THostIter wordsBeg = begin(host(sequence), Standard()) + 1;
+    THostIter wordsEnd = wordsBeg + TTraits::toHostLength(length(sequence));
+
+    THostIter left = wordsBeg;
+    THostIter right = wordsEnd;
+    for (; right - left > 1; ++left)
+    {
+        --right;
+        __uint64 tmp = _reverseComplementWord(left->i);
+        left->i = _reverseComplementWord(right->i);
+        right->i = tmp;
+    }
+    if (left != right)
+        left->i = _reverseComplementWord(left->i);
+
+    // the unused tail of the last word is now at the front and has to be shifted out
+    unsigned shift = ((wordsEnd - wordsBeg) * TTraits::VALUES_PER_HOST_VALUE - length(sequence)) * 2;
+    if (shift != 0)
+    {
+        for (THostIter it = wordsBeg; it + 1 != wordsEnd; ++it)
+            it->i = (it->i << shift) | ((it + 1)->i >> (64 - shift));
+        (wordsEnd - 1)->i <<= shift;
+    }
+}
+
+template <typename THostspec, typename TParallelTag>
+inline void reverseComplement(String<Dna, Packed<THostspec> > & sequence, Tag<TParallelTag>)
+{
+    _reverseComplementPacked(sequence);
+}
+
+template <typename THostspec, typename TParallelTag>
+inline void reverseComplement(String<Rna, Packed<THostspec> > & sequence, Tag<TParallelTag>)
+{
+    _reverseComplementPacked(sequence);
 }
 
 template < typename TSequence, typename TSpec, typename TParallelTag >
@@ -125,6 +125,110 @@ namespace SEQAN_NAMESPACE_MAIN
     struct Pool;
 
 
+/*!
+ * @class PoolMemoryBudget
+ * @headerfile <seqan/pipe.h>
+ * @brief Bounds the memory of all Pools sharing it.
+ *
+ * @signature struct PoolMemoryBudget;
+ *
+ * A budget is passed to the Pools of a pipeline via <tt>PoolParameters(budget)</tt>.  Every memory buffer, bucket
+ * buffer and page the Pools allocate is charged to the budget.  A Pool keeps its content in memory only while the
+ * charged memory stays below half of the limit, otherwise it is swapped to a temporary file.  The other half is left
+ * to the pages and bucket buffers of the Pools being streamed.  A budget must not be shared between threads.
+ *
+ * @var size_t PoolMemoryBudget::limit;
+ * @brief The maximal number of bytes, 0 for no limit.
+ *
+ * @var size_t PoolMemoryBudget::used;
+ * @brief The number of bytes currently allocated.
+ *
+ * @var size_t PoolMemoryBudget::peak;
+ * @brief The maximal number of bytes that were allocated at the same time.
+ */
+
+    struct PoolMemoryBudget
+    {
+        size_t  limit;
+        size_t  used;
+        size_t  peak;
+
+        PoolMemoryBudget(size_t _limit = 0):
+            limit(_limit),
+            used(0),
+            peak(0) {}
+    };
+
+    // can the budget grant <bytes> to content kept in memory?
+    inline bool _poolBudgetFits(PoolMemoryBudget const * budget, size_t bytes)
+    {
+        return budget == NULL || budget->limit == 0 || (budget->used <= budget->limit / 2 &&
+                                                        bytes <= budget->limit / 2 - budget->used);
+    }
+
+    inline void _poolBudgetCharge(PoolMemoryBudget * budget, size_t bytes)
+    {
+        if (budget == NULL) return;
+        budget->used += bytes;
+        budget->peak = _max(budget->peak, budget->used);
+    }
+
+    inline void _poolBudgetRelease(PoolMemoryBudget * budget, size_t bytes)
+    {
+        if (budget == NULL) return;
+        SEQAN_ASSERT_LEQ(bytes, budget->used);
+        budget->used -= bytes;
+    }
+
+    // allocator that forwards to <target> and charges the budget of a pool
+    template < typename TTarget >
+    struct PoolAllocator_
+    {
+        PoolMemoryBudget    *budget;
+        TTarget const       &target;
+
+        PoolAllocator_(PoolMemoryBudget *_budget, TTarget const &_target):
+            budget(_budget),
+            target(_target) {}
+    };
+
+    template < typename TPool, typename TTarget >
+    inline PoolAllocator_<TTarget>
+    _poolAllocator(TPool const &pool, TTarget const &target)
+    {
+        return PoolAllocator_<TTarget>(pool.budget, target);
+    }
+
+    template < typename TTarget, typename TValue, typename TSize >
+    inline void
+    allocate(PoolAllocator_<TTarget> const &me, TValue * &data, TSize count)
+    {
+        allocate(me.target, data, count);
+        if (data != NULL)
+            _poolBudgetCharge(me.budget, (size_t)count * sizeof(TValue));
+    }
+
+    template < typename TTarget, typename TValue, typename TSize >
+    inline void
+    deallocate(PoolAllocator_<TTarget> const &me, TValue *data, TSize count)
+    {
+        if (data != NULL)
+            _poolBudgetRelease(me.budget, (size_t)count * sizeof(TValue));
+        deallocate(me.target, data, count);
+    }
+
+/*!
+ * @class PoolParameters
+ * @headerfile <seqan/pipe.h>
+ * @brief Buffer sizes of a Pool.
+ *
+ * @signature struct PoolParameters;
+ *
+ * The default constructor keeps content of up to 8 GB in memory.  <tt>PoolParameters(budget)</tt> charges all
+ * Pools constructed with it to a shared @link PoolMemoryBudget @endlink and scales their pages and bucket buffers
+ * to its limit.
+ */
+
     struct PoolParameters
     {
 
@@ -176,6 +280,8 @@ namespace SEQAN_NAMESPACE_MAIN
         bool    absoluteSizes;      // when false, sizes are measured in units of TValue
                                     // when true, sizes are measured in bytes
 
+        PoolMemoryBudget    *budget;
+
         PoolParameters():
             memBufferSize((size_t)DefaultMemBufferSize * 1024ul),
             pageSize((size_t)DefaultPageSize * 1024ul),
@@ -183,7 +289,28 @@ namespace SEQAN_NAMESPACE_MAIN
             readAheadBuffers(DefaultReadAheadBuffers),
             writeBackBuffers(DefaultWriteBackBuffers),
             writeBackBuckets(DefaultWriteBackBuckets),
-            absoluteSizes(DefaultAbsoluteSizes) {}
+            absoluteSizes(DefaultAbsoluteSizes),
+            budget(NULL) {}
+
+        PoolParameters(PoolMemoryBudget &_budget):
+            memBufferSize((size_t)DefaultMemBufferSize * 1024ul),
+            pageSize((size_t)DefaultPageSize * 1024ul),
+            bucketBufferSize((size_t)DefaultBucketBufferSize * 1024ul),
+            readAheadBuffers(DefaultReadAheadBuffers),
+            writeBackBuffers(DefaultWriteBackBuffers),
+            writeBackBuckets(DefaultWriteBackBuckets),
+            absoluteSizes(DefaultAbsoluteSizes),
+            budget(&_budget)
+        {
+            if (_budget.limit == 0) return;
+
+            // Skew7 streams up to 9 pools at once (3 name readers, the text and 5 sorters), each holding at most
+            // 4 pages, this must fit into the half of the limit not granted to in-memory pools
+            size_t minPageSize = 64 * 1024ul;
+            memBufferSize = _min(memBufferSize, _budget.limit / 2);
+            pageSize = _min(pageSize, _max(_budget.limit / 128, minPageSize));
+            bucketBufferSize = _min(bucketBufferSize, 2 * pageSize);
+        }
 
         template < typename TValue >
         void absolutize(size_t aligning, TValue *)
@@ -342,7 +469,7 @@ namespace SEQAN_NAMESPACE_MAIN
             TPageFrame *p = chain.first;
             while (p) {
                 seqan::cancel(*p, pool.file);
-                freePage(*p, pool.file);
+                freePage(*p, _poolAllocator(pool, pool.file));
                 p = p->next;
             }
         }
@@ -360,7 +487,7 @@ namespace SEQAN_NAMESPACE_MAIN
             if (pf.pageNo < _pages) {
                 // alloc if empty
                 if (!pf.begin)
-                    allocPage(pf, pageSize, pool.file);
+                    allocPage(pf, pageSize, _poolAllocator(pool, pool.file));
 
                 // set buffer size according to read size
 //                std::cout << "poolsize="<<pool._size<<" pageno="<<pf.pageNo<<" pagesize="<<pageSize<<" resutl="<<pool.dataSize(pf.pageNo, pageSize)<<std::endl;
@@ -370,7 +497,7 @@ namespace SEQAN_NAMESPACE_MAIN
                 return readPage(pf, pool.file) || _error();
             } else {
                 // free if allocated
-                freePage(pf, pool.file);
+                freePage(pf, _poolAllocator(pool, pool.file));
                 return false;
             }
         }
@@ -426,7 +553,7 @@ namespace SEQAN_NAMESPACE_MAIN
             TPageFrame & pf = *chain.getReadyPage();
 
             if (!pf.begin)
-                allocPage(pf, pageSize, pool.file);
+                allocPage(pf, pageSize, _poolAllocator(pool, pool.file));
 
             writePageNo = 0;
             resize(pf, pool.dataSize(pf.pageNo = writePageNo++, pageSize));
@@ -442,7 +569,7 @@ namespace SEQAN_NAMESPACE_MAIN
             TPageFrame & pf = *chain.getReadyPage();
 
             if (!pf.begin)
-                allocPage(pf, pageSize, pool.file);
+                allocPage(pf, pageSize, _poolAllocator(pool, pool.file));
 
             resize(pf, pool.dataSize(pf.pageNo = writePageNo++, pageSize));
             return pf;
@@ -467,7 +594,7 @@ namespace SEQAN_NAMESPACE_MAIN
                                _pageFrameStatusString(p->status),
                                strerror(errno));
 
-                freePage(*p, pool.file);
+                freePage(*p, _poolAllocator(pool, pool.file));
                 p = p->next;
             }
             seqan::flush(pool.file);
@@ -478,7 +605,7 @@ namespace SEQAN_NAMESPACE_MAIN
             TPageFrame *p = chain.first;
             while (p) {
                 seqan::cancel(*p, pool.file);
-                freePage(*p, pool.file);
+                freePage(*p, _poolAllocator(pool, pool.file));
                 p = p->next;
             }
         }
@@ -500,7 +627,7 @@ namespace SEQAN_NAMESPACE_MAIN
                 return writePage(pf, pool.file) || _error();
             } else {
                 // free if allocated
-                freePage(pf, pool.file);
+                freePage(pf, _poolAllocator(pool, pool.file));
                 return false;
             }
         }
@@ -705,6 +832,7 @@ namespace SEQAN_NAMESPACE_MAIN
 
         TBuffer                memBuffer;
         size_t              memBufferSize;
+        PoolMemoryBudget    *budget;
         HandlerArgs         handlerArgs;
 
         bool                _partiallyFilled;        // the pool is partially filled (it contains undefined values)
@@ -808,7 +936,7 @@ namespace SEQAN_NAMESPACE_MAIN
             if (_temporary && _ownFile) {
                 if (_size != 0) {
                     if (memBuffer.begin)
-                        freePage(memBuffer, *this);
+                        freePage(memBuffer, _poolAllocator(*this, *this));
                     else {
                         close(file);
                         SEQAN_PROSUB(SEQAN_PROIOVOLUME, (_proFloat)((TFSize)_size * (TFSize)sizeof(TValue)));
@@ -816,8 +944,9 @@ namespace SEQAN_NAMESPACE_MAIN
                 }
 
                 if (_newSize != 0) {
-                    if (_newSize <= (size_type)memBufferSize)
-                        allocPage(memBuffer, _newSize, *this);
+                    if (_newSize <= (size_type)memBufferSize &&
+                        _poolBudgetFits(budget, (size_t)_newSize * sizeof(TValue)))
+                        allocPage(memBuffer, _newSize, _poolAllocator(*this, *this));
                     else {
                         openTemp(file);
                         SEQAN_PROADD(SEQAN_PROIOVOLUME, (_proFloat)((TFSize)_newSize * (TFSize)sizeof(TValue)));
@@ -961,13 +1090,22 @@ namespace SEQAN_NAMESPACE_MAIN
 
         void _init(PoolParameters _conf = PoolParameters())
         {
-            _conf.absolutize(16*1024/*sectorSize(file)*/, (TValue*)NULL);
+            // budgeted pools align their pages only to the 4KB needed for direct I/O, not to 16K values
+            size_t aligning = 16*1024/*sectorSize(file)*/;
+            if (_conf.budget != NULL)
+            {
+                aligning = 4096;
+                for (size_t bytes = sizeof(TValue); aligning > 1 && bytes % 2 == 0; bytes /= 2)
+                    aligning /= 2;
+            }
+            _conf.absolutize(aligning, (TValue*)NULL);
             memBufferSize    = _conf.memBufferSize;
             pageSize         = _conf.pageSize;
             bucketBufferSize = _conf.bucketBufferSize;
             readAheadBuffers = _conf.readAheadBuffers;
             writeBackBuffers = _conf.writeBackBuffers;
             writeBackBuckets = _conf.writeBackBuffers;
+            budget           = _conf.budget;
             _partiallyFilled = true;
             listeners = 0;
             reader = NULL;
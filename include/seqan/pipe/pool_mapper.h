@@ -363,7 +363,7 @@ namespace SEQAN_NAMESPACE_MAIN
         {
             cache.reserve(pool.pages);
             return equiDistantDistribution(
-                bucketBuffer, pool.bucketBufferSize, *this,
+                bucketBuffer, pool.bucketBufferSize, _poolAllocator(pool, *this),
                 pool._size, pool.pageSize,
                 insertBucket(*this));
         }
@@ -412,7 +412,7 @@ namespace SEQAN_NAMESPACE_MAIN
         {
             cache.clear();
             cache.reserve(0);
-            freePage(bucketBuffer, *this);
+            freePage(bucketBuffer, _poolAllocator(pool, *this));
         }
 
         inline bool eof() { return false; }
@@ -468,7 +468,7 @@ namespace SEQAN_NAMESPACE_MAIN
         {
             cache.reserve(pool.pages());
             clusterSize = equiDistantAlignedDistribution(
-                bucketBuffer, sectorSize(pool.file), pool.bucketBufferSize, pool.file,
+                bucketBuffer, sectorSize(pool.file), pool.bucketBufferSize, _poolAllocator(pool, pool.file),
                 pool._size, pool.pageSize,
                 insertBucket(*this));
 
@@ -478,7 +478,7 @@ namespace SEQAN_NAMESPACE_MAIN
                     std::cerr << "mapper switched to synchronous mode" << std::endl;
                 #endif
                 return equiDistantDistribution(
-                    bucketBuffer, pool.bucketBufferSize, pool.file,
+                    bucketBuffer, pool.bucketBufferSize, _poolAllocator(pool, pool.file),
                     pool._size, pool.pageSize,
                     insertBucket(*this));
             }
@@ -486,7 +486,7 @@ namespace SEQAN_NAMESPACE_MAIN
             #ifdef SEQAN_VERBOSE
                 std::cerr << "async mapper clustersize " << clusterSize << std::endl;
             #endif
-            allocPage(writeCache, chain.maxFrames * clusterSize, pool.file);
+            allocPage(writeCache, chain.maxFrames * clusterSize, _poolAllocator(pool, pool.file));
 
             // distribute write back buffers
             TValue *cur = writeCache.begin;
@@ -549,8 +549,8 @@ namespace SEQAN_NAMESPACE_MAIN
             chain.cancelAll(pool.file);
             cache.clear();
             cache.reserve(0);
-            freePage(writeCache, pool.file);
-            freePage(bucketBuffer, pool.file);
+            freePage(writeCache, _poolAllocator(pool, pool.file));
+            freePage(bucketBuffer, _poolAllocator(pool, pool.file));
         }
 
         inline bool eof() { return false; }
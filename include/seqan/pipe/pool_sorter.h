@@ -221,7 +221,7 @@ namespace SEQAN_NAMESPACE_MAIN
             // 1. initially fill priority queue
 //            pqueue.reserve(pool.pages);
             equiDistantDistribution(
-                bucketBuffer, pool.bucketBufferSize, *this,
+                bucketBuffer, pool.bucketBufferSize, _poolAllocator(pool, *this),
                 pool._size, pool.pageSize,
                 insertBucket(*this));
             return true;
@@ -276,7 +276,7 @@ namespace SEQAN_NAMESPACE_MAIN
         void cancel()
         {
             clear(pqueue);
-            freePage(bucketBuffer, *this);
+            freePage(bucketBuffer, _poolAllocator(pool, *this));
         }
 
         inline void process() {}
@@ -334,10 +334,10 @@ namespace SEQAN_NAMESPACE_MAIN
             // 1. initially fill priority queue
 //            pqueue.reserve(pool.pages);
             equiDistantDistribution(
-                bucketBuffer, pool.bucketBufferSize, *this,
+                bucketBuffer, pool.bucketBufferSize, _poolAllocator(pool, *this),
                 pool._size, pool.pageSize,
                 insertBucket(*this));
-            allocPage(mergeBuffer, mergeBufferSize, *this);
+            allocPage(mergeBuffer, mergeBufferSize, _poolAllocator(pool, *this));
             return merge();
         }
 
@@ -352,8 +352,8 @@ namespace SEQAN_NAMESPACE_MAIN
         void cancel()
         {
             clear(pqueue);
-            freePage(mergeBuffer, *this);
-            freePage(bucketBuffer, *this);
+            freePage(mergeBuffer, _poolAllocator(pool, *this));
+            freePage(bucketBuffer, _poolAllocator(pool, *this));
         }
 
         inline void process() {}
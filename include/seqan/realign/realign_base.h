@@ -197,6 +197,34 @@ struct WindowClippingInfo_
     }
 };
 
+// ----------------------------------------------------------------------------
+// Class AnsonMyersBuffers_
+// ----------------------------------------------------------------------------
+
+// Scratch buffers for the per-read profile strings of the realignment rounds.
+//
+// One object is owned by each realigner and handed to its rounds.  The strings are only cleared between reads, such
+// that their capacity is reused for all reads, rounds, and contigs instead of allocating new strings for each read.
+
+template <typename TFragmentStore>
+struct AnsonMyersBuffers_
+{
+    typedef typename TFragmentStore::TReadSeqStore      TReadSeqStore;
+    typedef typename Value<TReadSeqStore>::Type         TReadSeq;
+    typedef typename Value<TReadSeq>::Type              TStoreAlphabet;
+    typedef typename BaseAlphabet<TStoreAlphabet>::Type TAlphabet;
+    typedef String<ProfileChar<TAlphabet> >             TProfileString;
+
+    // The part of the contig profile extracted around the current read.
+    TProfileString profilePart;
+    // The profile part with the current read subtracted.
+    TProfileString subtractedPart;
+    // The profile part with the realigned read integrated.
+    TProfileString integratedPart;
+    // Positions of all-gaps columns to remove after integration.
+    String<unsigned> gapPositions;
+};
+
 
 // ----------------------------------------------------------------------------
 // Class AnsonMyersRealignmentRound_
@@ -228,6 +256,8 @@ public:
     TAlignedReadStore & contigAlignedReads;
     // The timing helper struct.
     AnsonMyersTimes_ & times;
+    // The scratch buffers for the profile parts.
+    AnsonMyersBuffers_<TFragmentStore> & buffers;
     // The options.
     RealignmentOptions_ const & options;
 
@@ -239,9 +269,10 @@ public:
                                 TProfileString & contigProfile,
                                 TAlignedReadStore & contigAlignedReads,
                                 AnsonMyersTimes_ & times,
+                                AnsonMyersBuffers_<TFragmentStore> & buffers,
                                 RealignmentOptions_ const & options) :
             store(store), contigProfile(contigProfile), contigAlignedReads(contigAlignedReads), times(times),
-            options(options)
+            buffers(buffers), options(options)
     {}
 
     // Run one round of realignment.
@@ -412,7 +443,8 @@ public:
         }
 
         // We will build a profileStr2 that has fewer gaps.
-        TProfileString profileStr2;
+        TProfileString & profileStr2 = buffers.subtractedPart;
+        clear(profileStr2);
         reserve(profileStr2, length(profileStr));
         // Append profile charactes without alignment by read.
         append(profileStr2, prefix(profileStr, info.aliBeginPos));
@@ -554,17 +586,24 @@ public:
 
     // The contig's profile sequence.
     TProfileString contigProfile;
+    // Scratch buffers for the realignment rounds, reused for all contigs run with this realigner.
+    AnsonMyersBuffers_<TFragmentStore> buffers;
 
     // Timing information.
     AnsonMyersTimes_ times;
 
+    // Whether the aligned read store is already sorted by contig id and begin position.  In this case, _beginContig()
+    // does not sort and the consistency checks are limited to the current contig, such that contigs with disjoint
+    // reads can be realigned concurrently on the same store.
+    bool sortedByContig;
+
     // -----------------------------------------------------------------------
     // Public Interface
     // -----------------------------------------------------------------------
 
     // Construct
     AnsonMyersRealigner_(TFragmentStore & store, RealignmentOptions_ const & options) :
-            store(store), options(options)
+            store(store), options(options), sortedByContig(false)
     {}
 
     // Run the realignment on the given contig.  If windowBegin != windowEnd then only the given window is realigned.
@@ -605,7 +644,8 @@ public:
 
     void _checkReadAlignments()
     {
-        _checkReadAlignments(store.alignedReadStore);
+        if (!sortedByContig)
+            _checkReadAlignments(store.alignedReadStore);
         _checkReadAlignments(contigAlignedReads);
     }
 
@@ -680,7 +720,8 @@ void AnsonMyersRealigner_<TFragmentStore>::run(unsigned contigID, unsigned windo
         if (options.debug)
             std::cerr << "Realignment round " << roundNo << "\n";
         oldScore = score;
-        AnsonMyersRealignmentRound_<TFragmentStore> round(store, contigProfile, contigAlignedReads, times, options);
+        AnsonMyersRealignmentRound_<TFragmentStore> round(store, contigProfile, contigAlignedReads, times, buffers,
+                                                          options);
         _checkReadAlignments();
         round.run(windowBegin, windowEnd);
         _checkReadAlignments();
@@ -717,15 +758,17 @@ void AnsonMyersRealigner_<TFragmentStore>::_beginContig(unsigned contigID)
     // ------------------------------------------------------------------------
 
     // Sort aligned reads by contig id and get iterators to begin/end of the alignments on the contig.
-    sortAlignedReads(store.alignedReadStore, SortContigId());
+    if (!sortedByContig)
+        sortAlignedReads(store.alignedReadStore, SortContigId());
     contigAlignmentInfos.alignedItBegin = lowerBoundAlignedReads(store.alignedReadStore, contigID, SortContigId());
     contigAlignmentInfos.alignedItEnd = upperBoundAlignedReads(store.alignedReadStore, contigID, SortContigId());
 
     // Sort the reads on the current contig according to their begin posiiton.
-    sortAlignedReads(infix(store.alignedReadStore,
-                           contigAlignmentInfos.alignedItBegin - begin(store.alignedReadStore, Standard()),
-                           contigAlignmentInfos.alignedItEnd - begin(store.alignedReadStore, Standard())),
-                     SortBeginPos());
+    if (!sortedByContig)
+        sortAlignedReads(infix(store.alignedReadStore,
+                               contigAlignmentInfos.alignedItBegin - begin(store.alignedReadStore, Standard()),
+                               contigAlignmentInfos.alignedItEnd - begin(store.alignedReadStore, Standard())),
+                         SortBeginPos());
 
     // ------------------------------------------------------------------------
     // Extract Alignment; Reverse-Complement Fragment Sequence
@@ -1034,7 +1077,7 @@ void AnsonMyersRealignmentRound_<TFragmentStore>::run(unsigned windowBegin, unsi
     }
 
     // The currently extracted part from the sequence and the read as profile (ord values stored in read[i].count[0].
-    TProfileString profilePart;
+    TProfileString & profilePart = buffers.profilePart;
 
     // Remove each read from the profile, realign it to the profile, and update the profile.
     TAlignedReadIter itEnd = end(contigAlignedReads, Standard());
@@ -1469,7 +1512,8 @@ void AnsonMyersRealignmentRound_<TFragmentStore>::_updateAlignments(
     TAlignedReadElement el = *it, el2 = *it;
 
     // We build a new profile part.
-    TProfileString newProfilePart;
+    TProfileString & newProfilePart = buffers.integratedPart;
+    clear(newProfilePart);
     // reserve(newProfilePart, length(source(row(align, 0))));
     reserve(newProfilePart, length(source(profileGaps)));
 
@@ -1547,7 +1591,8 @@ void AnsonMyersRealignmentRound_<TFragmentStore>::_updateAlignments(
     //
     // We record the positions of all-gaps columns and remove them later.  We also insert all-gaps columns into *it and
     // remove it together with the rest of the alignment.
-    seqan::String<unsigned> gapPositions;
+    seqan::String<unsigned> & gapPositions = buffers.gapPositions;
+    clear(gapPositions);
     for (; itP != itPEnd;)
     {
         SEQAN_ASSERT_NOT_MSG(isGap(itP) && isGap(itR), "No all-gaps columns in pairwise alignment.");
@@ -1719,6 +1764,51 @@ void AnsonMyersRealignmentRound_<TFragmentStore>::_updateAlignments(
 #endif  // #if SEQAN_ENABLE_TESTING
 }
 
+// ----------------------------------------------------------------------------
+// Function _initRealignmentOptions()
+// ----------------------------------------------------------------------------
+
+inline void _initRealignmentOptions(RealignmentOptions_ & options,
+                                    unsigned realignmentMethod,
+                                    unsigned bandwidth,
+                                    bool includeReference,
+                                    bool debug,
+                                    bool printTiming)
+{
+    options.method = realignmentMethod ? RealignmentOptions_::ANSON_MYERS_GOTOH : RealignmentOptions_::ANSON_MYERS_NW;
+    options.bandwidth = bandwidth;
+    options.environment = bandwidth / 2;
+    options.includeReference = includeReference;
+    options.debug = debug;
+    options.printTiming = printTiming;
+}
+
+// ----------------------------------------------------------------------------
+// Function _contigsHaveDisjointReads()
+// ----------------------------------------------------------------------------
+
+// Returns true if no read has alignments on more than one contig.  Only then, the contigs can be realigned
+// concurrently since the read sequences are reverse-complemented in place while their contig is realigned.
+
+template <typename TSpec, typename TConfig>
+bool _contigsHaveDisjointReads(FragmentStore<TSpec, TConfig> const & store)
+{
+    typedef FragmentStore<TSpec, TConfig> TFragmentStore;
+    typedef typename TFragmentStore::TAlignedReadStore TAlignedReadStore;
+    typedef typename Iterator<TAlignedReadStore const, Standard>::Type TAlignedReadIter;
+
+    String<unsigned> readContig;
+    resize(readContig, length(store.readSeqStore), maxValue<unsigned>());
+    TAlignedReadIter itEnd = end(store.alignedReadStore, Standard());
+    for (TAlignedReadIter it = begin(store.alignedReadStore, Standard()); it != itEnd; ++it)
+    {
+        if (readContig[it->readId] != maxValue<unsigned>() && readContig[it->readId] != (unsigned)it->contigId)
+            return false;
+        readContig[it->readId] = it->contigId;
+    }
+    return true;
+}
+
 // ----------------------------------------------------------------------------
 // Function reAlignment()
 // ----------------------------------------------------------------------------
@@ -1790,12 +1880,7 @@ void reAlignment(FragmentStore<TSpec, TConfig> & store,
                  bool printTiming = false)
 {
     RealignmentOptions_ options;
-    options.method = realignmentMethod ? RealignmentOptions_::ANSON_MYERS_GOTOH : RealignmentOptions_::ANSON_MYERS_NW;
-    options.bandwidth = bandwidth;
-    options.environment = bandwidth / 2;
-    options.includeReference = includeReference;
-    options.debug = debug;
-    options.printTiming = printTiming;
+    _initRealignmentOptions(options, realignmentMethod, bandwidth, includeReference, debug, printTiming);
 
     AnsonMyersRealigner_<FragmentStore<TSpec, TConfig> > realigner(store, options);
     realigner.run(contigID, windowBegin, windowEnd);
@@ -1818,6 +1903,74 @@ void reAlignment(FragmentStore<TSpec, TConfig> & store,
                 printTiming);
 }
 
+// ----------------------------------------------------------------------------
+// Function reAlignmentAllContigs()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn reAlignmentAllContigs
+ * @headerfile <seqan/realign.h>
+ * @brief Perform realignment of all contigs in a @link FragmentStore @endlink object, optionally in parallel.
+ *
+ * @signature void reAlignmentAllContigs(store, realignmentMethod, bandwidth, includeReference[, numThreads]
+ *                                       [, debug][, printTiming]);
+ *
+ * @param[in,out] store             The @link FragmentStore @endlink to perform realignment for.
+ * @param[in]     realignmentMethod The realignment algorithm to use, <tt>1</tt> for affine gap costs, <tt>0</tt>
+ *                                  for linear gap costs, affine gap costs are recommended, <tt>unsigned</tt>.
+ * @param[in]     bandwidth         Bandwidth to use in the pairwise DP alignment algorithms <tt>unsigned</tt>.
+ * @param[in]     includeReference  A <tt>bool</tt>, if <tt>true</tt> then the reference will be included as a
+ *                                  pseudo-read, see @link reAlignment @endlink.
+ * @param[in]     numThreads        Optional <tt>unsigned</tt> number of threads to use, default: <tt>1</tt>.
+ * @param[in]     debug             Optional <tt>bool</tt> to enable verbose logging, default: <tt>false</tt>.
+ * @param[in]     printTiming       Optional <tt>bool</tt> to enable printing of times, default: <tt>false</tt>.
+ *
+ * The result is the same as calling @link reAlignment @endlink for each contig in turn.  With more than one thread,
+ * the contigs are distributed over the threads, each of which keeps the working copy of one contig's alignment and
+ * profile at a time.
+ *
+ * The contigs are realigned one after another if <tt>includeReference</tt> or <tt>debug</tt> is set or if a read
+ * aligns to more than one contig.
+ */
+
+template <typename TSpec, typename TConfig>
+void reAlignmentAllContigs(FragmentStore<TSpec, TConfig> & store,
+                           unsigned realignmentMethod,
+                           unsigned bandwidth,
+                           bool includeReference,
+                           unsigned numThreads = 1,
+                           bool debug = false,
+                           bool printTiming = false)
+{
+    typedef FragmentStore<TSpec, TConfig> TFragmentStore;
+
+    if (numThreads <= 1u || includeReference || debug || !_contigsHaveDisjointReads(store))
+    {
+        for (unsigned contigID = 0; contigID < length(store.contigStore); ++contigID)
+            reAlignment(store, contigID, realignmentMethod, bandwidth, includeReference, 0, 0, debug, printTiming);
+        return;
+    }
+
+    RealignmentOptions_ options;
+    _initRealignmentOptions(options, realignmentMethod, bandwidth, includeReference, debug, printTiming);
+
+    // Sort once by contig and begin position such that each realigner only touches the alignments of its contig.
+    sortAlignedReads(store.alignedReadStore, SortBeginPos());
+    sortAlignedReads(store.alignedReadStore, SortContigId());
+
+    int numContigs = length(store.contigStore);
+    SEQAN_OMP_PRAGMA(parallel num_threads(numThreads))
+    {
+        // Each thread reuses its realigner and thus its profile buffers for all of its contigs.
+        AnsonMyersRealigner_<TFragmentStore> realigner(store, options);
+        realigner.sortedByContig = true;
+
+        SEQAN_OMP_PRAGMA(for schedule(dynamic, 1))
+        for (int contigID = 0; contigID < numContigs; ++contigID)
+            realigner.run(contigID);
+    }
+}
+
 }  // namespace seqan
 
 #endif  // INCLUDE_SEQAN_REALIGN_REALIGN_BASE_H_
@@ -426,6 +426,121 @@ inline void readRecord(TIdString & meta, TSeqString & seq, TQualString & qual, T
                          "length as the sequence! But was not.");
 }
 
+// ----------------------------------------------------------------------------
+// Function _readRawRecord(TagSelector)
+// ----------------------------------------------------------------------------
+
+// Copy the next record verbatim into raw, such that readRecord() can later parse it from raw.
+// TSeqAlphabet must be the alphabet of the sequence the record is parsed into.
+
+template <typename TSeqAlphabet, typename TFwdIterator>
+inline void
+_readRawRecord(CharString & /* raw */, TFwdIterator & /* iter */, TagSelector<> const & /* format */)
+{}
+
+template <typename TSeqAlphabet, typename TFwdIterator, typename TTagList>
+inline void
+_readRawRecord(CharString & raw, TFwdIterator & iter, TagSelector<TTagList> const & format)
+{
+    typedef typename TTagList::Type TFormat;
+
+    if (isEqual(format, TFormat()))
+        _readRawRecord<TSeqAlphabet>(raw, iter, TFormat());
+    else
+        _readRawRecord<TSeqAlphabet>(raw, iter, static_cast<typename TagSelector<TTagList>::Base const &>(format));
+}
+
+// Formats without raw record support (Embl, GenBank) are always read sequentially.
+template <typename TSeqAlphabet, typename TFwdIterator, typename TFormat>
+inline void
+_readRawRecord(CharString & /* raw */, TFwdIterator & /* iter */, TFormat const & /* format */)
+{
+    SEQAN_FAIL("Records of this file format cannot be read in parallel.");
+}
+
+// ----------------------------------------------------------------------------
+// Function _readRawRecord(Raw)
+// ----------------------------------------------------------------------------
+
+template <typename TSeqAlphabet, typename TFwdIterator>
+inline void
+_readRawRecord(CharString & raw, TFwdIterator & iter, Raw const & /* tag */)
+{
+    clear(raw);
+    readLine(raw, iter);
+    appendValue(raw, '\n');
+}
+
+// ----------------------------------------------------------------------------
+// Function _readRawRecord(Fasta)
+// ----------------------------------------------------------------------------
+
+template <typename TSeqAlphabet, typename TFwdIterator>
+inline void
+_readRawRecord(CharString & raw, TFwdIterator & iter, Fasta const & /* tag */)
+{
+    typedef EqualsChar<'>'>                                         TFastaBegin;
+
+    clear(raw);
+
+    skipUntil(iter, TFastaBegin());     // forward to the next '>'
+    skipOne(iter);                      // assert and skip '>'
+
+    appendValue(raw, '>');
+    readLine(raw, iter);                // copy Fasta id
+    appendValue(raw, '\n');
+    readUntil(raw, iter, TFastaBegin());    // copy Fasta sequence
+}
+
+// ----------------------------------------------------------------------------
+// Function _readRawRecord(Fastq)
+// ----------------------------------------------------------------------------
+
+template <typename TSeqAlphabet, typename TFwdIterator>
+inline void
+_readRawRecord(CharString & raw, TFwdIterator & iter, Fastq const & /* tag */)
+{
+    typedef typename FastaIgnoreFunctor_<TSeqAlphabet>::Type                TSeqIgnore;
+    typedef typename FastaIgnoreFunctor_<char>::Type                        TQualIgnore;
+    typedef EqualsChar<'@'>                                                 TFastqBegin;
+    typedef EqualsChar<'+'>                                                 TQualsBegin;
+
+    clear(raw);
+
+    skipUntil(iter, TFastqBegin());     // forward to the next '@'
+    skipOne(iter);                      // skip '@'
+
+    appendValue(raw, '@');
+    readLine(raw, iter);                // copy Fastq id
+    appendValue(raw, '\n');
+
+    // count the sequence characters the way readRecord() does to know how many qualities follow
+    size_t seqBegin = length(raw);
+    readUntil(raw, iter, TQualsBegin());    // copy Fastq sequence
+    TSeqIgnore seqIgnore;
+    __uint64 seqLength = 0;
+    for (size_t i = seqBegin; i < length(raw); ++i)
+        if (!seqIgnore(raw[i]))
+            ++seqLength;
+
+    readLine(raw, iter);                // copy '+' and optional 2nd Fastq id
+    appendValue(raw, '\n');
+
+    CountDownFunctor<NotFunctor<TQualIgnore> > qualCountDown(seqLength);
+    readUntil(raw, iter, qualCountDown);    // copy Fastq qualities
+
+    // next record should follow immediately
+    skipUntil(iter, NotFunctor<IsWhitespace>());     // ignore/skip white spaces
+    TFastqBegin fastqBegin;
+    if (!qualCountDown || (!atEnd(iter) && !fastqBegin(*(iter))))
+        throw ParseError("Fastq quality string is expected to be of the same "
+                         "length as the sequence! But was not.");
+
+    // readRecord() expects the beginning of the next record behind the qualities
+    appendValue(raw, '\n');
+    appendValue(raw, '@');
+}
+
 // ----------------------------------------------------------------------------
 // Function writeRecord(Raw); Qualities inside seq
 // ----------------------------------------------------------------------------
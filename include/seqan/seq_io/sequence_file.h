@@ -134,6 +134,7 @@ struct SeqFileContext_<Input>
 {
     Tuple<CharString, 3>    buffer;
     Dna5QString             hybrid;
+    String<CharString>      buffers;
 };
 
 template <>
@@ -230,7 +231,13 @@ readRecord(TIdString & meta, TSeqString & seq, TQualString & qual, FormattedFile
 /*!
  * @fn SeqFileIn#readRecords
  * @brief Read many @link FormattedFileRecordConcept @endlink from a @link SeqFileIn @endlink object.
- * @signature void readRecords(metas, seqs, quals, fileIn, numRecord);
+ * @signature void readRecords(metas, seqs, quals, fileIn, numRecord[, numThreads]);
+ *
+ * If <tt>numThreads</tt> is greater than 1, the raw FASTA, FASTQ, or raw records are split off the input
+ * sequentially and parsed concurrently by <tt>numThreads</tt> threads.  The records are appended in file order.
+ * EMBL and GenBank files are always read sequentially.  If parsing fails for several records, the exception of the
+ * first failing record is rethrown.
+ *
  * @see SeqFileIn#readRecord
  */
 
@@ -334,6 +341,105 @@ inline void readRecords(TIdStringSet & meta,
     readRecords(meta, seq, qual, file, MaxValue<__uint64>::VALUE);
 }
 
+// ----------------------------------------------------------------------------
+// Function _readRecordsParallel()
+// ----------------------------------------------------------------------------
+
+template <typename TIdStringSet, typename TSeqStringSet, typename TQualStringSet, typename TSpec, typename TSize>
+inline void _readRecordsParallel(TIdStringSet & meta,
+                                 TSeqStringSet & seq,
+                                 TQualStringSet * qual,
+                                 FormattedFile<Fastq, Input, TSpec> & file,
+                                 TSize maxRecords,
+                                 unsigned numThreads)
+{
+    typedef typename SeqFileBuffer_<TSeqStringSet, TSpec>::Type TSeqBuffer;
+    typedef typename Value<TSeqBuffer>::Type                    TSeqAlphabet;
+
+    String<CharString> & buffers = context(file).buffers;
+
+    // split off the raw records sequentially
+    size_t numRecords = 0;
+    for (; !atEnd(file) && maxRecords > 0; --maxRecords, ++numRecords)
+    {
+        if (length(buffers) <= numRecords)
+            resize(buffers, numRecords + 1);
+        _readRawRecord<TSeqAlphabet>(buffers[numRecords], file.iter, file.format);
+    }
+
+    String<CharString> metaBuffers;
+    String<TSeqBuffer> seqBuffers;
+    String<CharString> qualBuffers;
+    resize(metaBuffers, numRecords, Exact());
+    resize(seqBuffers, numRecords, Exact());
+    resize(qualBuffers, numRecords, Exact());
+
+    FirstException_ firstError;
+    ignoreUnusedVariableWarning(numThreads);
+
+    SEQAN_OMP_PRAGMA(parallel for num_threads(numThreads) schedule(dynamic, 64))
+    for (int i = 0; i < (int)numRecords; ++i)
+    {
+        SEQAN_TRY
+        {
+            CharIterator bufIter = begin(buffers[i]);
+            readRecord(metaBuffers[i], seqBuffers[i], qualBuffers[i], bufIter, file.format);
+            if (qual == NULL && HasQualities<TSeqAlphabet>::VALUE)
+                assignQualities(seqBuffers[i], qualBuffers[i]);
+        }
+        SEQAN_CATCH(...)
+        {
+            SEQAN_OMP_PRAGMA(critical (readRecordsError))
+            _captureException(firstError, i);
+        }
+    }
+
+    _rethrowException(firstError);
+
+    for (size_t i = 0; i < numRecords; ++i)
+    {
+        appendValue(meta, metaBuffers[i]);
+        appendValue(seq, seqBuffers[i]);
+        if (qual != NULL)
+            appendValue(*qual, qualBuffers[i]);
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Function readRecords(); With number of threads
+// ----------------------------------------------------------------------------
+
+template <typename TIdStringSet, typename TSeqStringSet, typename TSpec, typename TSize>
+inline void readRecords(TIdStringSet & meta,
+                        TSeqStringSet & seq,
+                        FormattedFile<Fastq, Input, TSpec> & file,
+                        TSize maxRecords,
+                        unsigned numThreads)
+{
+    if (numThreads <= 1 || isEqual(file.format, Embl()) || isEqual(file.format, GenBank()))
+        readRecords(meta, seq, file, maxRecords);
+    else
+        _readRecordsParallel(meta, seq, (StringSet<CharString> *)NULL, file, maxRecords, numThreads);
+}
+
+// ----------------------------------------------------------------------------
+// Function readRecords(); With separate qualities; With number of threads
+// ----------------------------------------------------------------------------
+
+template <typename TIdStringSet, typename TSeqStringSet, typename TQualStringSet, typename TSpec, typename TSize>
+inline void readRecords(TIdStringSet & meta,
+                        TSeqStringSet & seq,
+                        TQualStringSet & qual,
+                        FormattedFile<Fastq, Input, TSpec> & file,
+                        TSize maxRecords,
+                        unsigned numThreads)
+{
+    if (numThreads <= 1 || isEqual(file.format, Embl()) || isEqual(file.format, GenBank()))
+        readRecords(meta, seq, qual, file, maxRecords);
+    else
+        _readRecordsParallel(meta, seq, &qual, file, maxRecords, numThreads);
+}
+
 // ----------------------------------------------------------------------------
 // Function writeRecord()
 // ----------------------------------------------------------------------------
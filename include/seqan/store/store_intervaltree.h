@@ -179,8 +179,8 @@ findIntervalsForInterval(String<TCargo> & result, TIntervalTree & intervalTree,
     String<TCargo> result1;
     String<TCargo> result2;
 
-    findIntervals(result1, intervalTree.g, intervalTree.pm, interval.i1 + offsetInterval);
-    findIntervals(result2, intervalTree.g, intervalTree.pm, interval.i2 - offsetInterval);
+    findIntervals(result1, intervalTree, interval.i1 + offsetInterval);
+    findIntervals(result2, intervalTree, interval.i2 - offsetInterval);
 
     interSec(result, result1, result2);
 
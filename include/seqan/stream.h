@@ -95,6 +95,7 @@
 #include <seqan/stream/iostream_zip.h>
 #include <seqan/stream/iostream_zip_impl.h>
 #include <seqan/stream/iostream_bgzf.h>
+#include <seqan/stream/iostream_gz_index.h>
 #endif
 
 #if SEQAN_HAS_BZIP2
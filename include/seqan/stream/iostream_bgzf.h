@@ -35,6 +35,74 @@ const unsigned BGZF_BLOCK_SIZE = BGZF_MAX_BLOCK_SIZE - BGZF_BLOCK_HEADER_LENGTH
 // Classes
 // ===========================================================================
 
+// --------------------------------------------------------------------------
+// Class BgzfThreads_
+// --------------------------------------------------------------------------
+
+/*!
+ * @fn setBgzfThreads
+ * @headerfile <seqan/stream.h>
+ * @brief Sets the number of worker threads of all BGZF streams opened afterwards.
+ *
+ * @signature void setBgzfThreads(compressionThreads, decompressionThreads);
+ *
+ * @param[in] compressionThreads   The number of threads compressing each output stream, default is 16.
+ * @param[in] decompressionThreads The number of threads decompressing each input stream, default is 16.
+ *
+ * Every BGZF stream starts its own worker threads and keeps 8 blocks per thread in memory.  Reduce the number of
+ * decompression threads when reading many BGZF files at the same time, e.g. when merging BAM files.  A
+ * <tt>bgzf_istream</tt> or <tt>bgzf_ostream</tt> constructed with an explicit thread count ignores this setting.
+ */
+
+template <typename TDummy = void>
+struct BgzfThreads_
+{
+    static size_t COMPRESSION;
+    static size_t DECOMPRESSION;
+};
+
+template <typename TDummy>
+size_t BgzfThreads_<TDummy>::COMPRESSION = 16;
+
+template <typename TDummy>
+size_t BgzfThreads_<TDummy>::DECOMPRESSION = 16;
+
+inline void setBgzfThreads(size_t compressionThreads, size_t decompressionThreads)
+{
+    BgzfThreads_<>::COMPRESSION = std::max(compressionThreads, (size_t)1);
+    BgzfThreads_<>::DECOMPRESSION = std::max(decompressionThreads, (size_t)1);
+}
+
+/*!
+ * @fn bgzfCompressionThreads
+ * @headerfile <seqan/stream.h>
+ * @brief Returns the number of worker threads used by BGZF output streams opened afterwards.
+ *
+ * @signature size_t bgzfCompressionThreads();
+ *
+ * @see setBgzfThreads
+ */
+
+inline size_t bgzfCompressionThreads()
+{
+    return BgzfThreads_<>::COMPRESSION;
+}
+
+/*!
+ * @fn bgzfDecompressionThreads
+ * @headerfile <seqan/stream.h>
+ * @brief Returns the number of worker threads used by BGZF input streams opened afterwards.
+ *
+ * @signature size_t bgzfDecompressionThreads();
+ *
+ * @see setBgzfThreads
+ */
+
+inline size_t bgzfDecompressionThreads()
+{
+    return BgzfThreads_<>::DECOMPRESSION;
+}
+
 // --------------------------------------------------------------------------
 // Class basic_bgzf_streambuf
 // --------------------------------------------------------------------------
@@ -752,7 +820,13 @@ public:
     typedef basic_bgzf_streambuf<Elem, Tr, ElemA, ByteT, ByteAT> bgzf_streambuf_type;
 
     basic_bgzf_ostreambase(ostream_reference ostream_)
-        : m_buf(ostream_)
+        : m_buf(ostream_, BgzfThreads_<>::COMPRESSION)
+    {
+        this->init(&m_buf );
+    };
+
+    basic_bgzf_ostreambase(ostream_reference ostream_, size_t numThreads)
+        : m_buf(ostream_, std::max(numThreads, (size_t)1))
     {
         this->init(&m_buf );
     };
@@ -790,7 +864,13 @@ public:
     typedef basic_unbgzf_streambuf<Elem, Tr, ElemA, ByteT, ByteAT>  unbgzf_streambuf_type;
 
     basic_bgzf_istreambase(istream_reference ostream_)
-        : m_buf(ostream_)
+        : m_buf(ostream_, BgzfThreads_<>::DECOMPRESSION)
+    {
+        this->init(&m_buf );
+    };
+
+    basic_bgzf_istreambase(istream_reference ostream_, size_t numThreads)
+        : m_buf(ostream_, std::max(numThreads, (size_t)1))
     {
         this->init(&m_buf );
     };
@@ -836,6 +916,12 @@ public:
         ostream_type(bgzf_ostreambase_type::rdbuf())
     {}
 
+    // compress on numThreads threads instead of bgzfCompressionThreads()
+    basic_bgzf_ostream(ostream_reference ostream_, size_t numThreads) :
+        bgzf_ostreambase_type(ostream_, numThreads),
+        ostream_type(bgzf_ostreambase_type::rdbuf())
+    {}
+
     // flush inner buffer and zipper buffer
     basic_bgzf_ostream<Elem,Tr>& zflush()
     {
@@ -883,6 +969,14 @@ public:
         m_gbgzf_data_size(0)
     {};
 
+    // decompress on numThreads threads instead of bgzfDecompressionThreads()
+    basic_bgzf_istream(istream_reference istream_, size_t numThreads) :
+        bgzf_istreambase_type(istream_, numThreads),
+        istream_type(bgzf_istreambase_type::rdbuf()),
+        m_is_gzip(false),
+        m_gbgzf_data_size(0)
+    {};
+
     // returns true if it is a gzip file
     bool is_gzip() const                { return m_is_gzip; };
     // return data size check
@@ -0,0 +1,1137 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2015, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Access point index for ordinary gzip files and a stream buffer that uses
+// it to decompress several chunks of a gzip file in parallel.  The index is
+// built like in zran.c of the zlib examples, it stores the state of the
+// decompressor (bit offset and 32kb window) at deflate block boundaries.
+// ==========================================================================
+
+#ifndef INCLUDE_SEQAN_STREAM_IOSTREAM_GZ_INDEX_H_
+#define INCLUDE_SEQAN_STREAM_IOSTREAM_GZ_INDEX_H_
+
+namespace seqan {
+
+// ===========================================================================
+// Classes
+// ===========================================================================
+
+// --------------------------------------------------------------------------
+// Helper Class GZFileIndexPoint_
+// --------------------------------------------------------------------------
+
+// An access point, i.e. a deflate block boundary where decompression can be started.
+
+struct GZFileIndexPoint_
+{
+    __uint64    compressedOffset;       // Offset of the first complete byte of the block.
+    __uint64    uncompressedOffset;     // Offset of the block in the uncompressed data.
+    __uint64    windowEnd;              // End of the compressed window in GZFileIndex::windows.
+    unsigned    bits;                   // Number of bits of the block in the preceding byte.
+    __uint32    crc;                    // CRC32 of the uncompressed data up to the next access point.
+};
+
+// --------------------------------------------------------------------------
+// Helper Class GZFileIndexPointLess_
+// --------------------------------------------------------------------------
+
+struct GZFileIndexPointLess_
+{
+    bool operator()(__uint64 uncompressedOffset, GZFileIndexPoint_ const & point) const
+    {
+        return uncompressedOffset < point.uncompressedOffset;
+    }
+};
+
+// --------------------------------------------------------------------------
+// Class GZFileIndex
+// --------------------------------------------------------------------------
+
+/*!
+ * @class GZFileIndex
+ * @headerfile <seqan/stream.h>
+ * @brief Access point index for ordinary gzip files.
+ *
+ * @signature class GZFileIndex;
+ *
+ * Ordinary gzip files can only be decompressed sequentially.  The access point index stores the state of the
+ * decompressor every few megabytes of uncompressed data, which allows to decompress the chunks between the access
+ * points independently of each other, in parallel, and to seek in the uncompressed data.
+ *
+ * The index is built once with @link GZFileIndex#build @endlink and stored next to the gzip file with
+ * @link GZFileIndex#save @endlink using the name returned by @link GZFileIndex#getIndexFileName @endlink.
+ * A @link VirtualStream @endlink (and thus a @link SeqFileIn @endlink) that opens a gzip file with such an index
+ * automatically decompresses it with multiple threads.
+ *
+ * The index stores the size and a CRC32 of the head and tail of the compressed file, an index that does not match
+ * them is ignored.  Each decompressed chunk is verified against the CRC32 stored with its access point.
+ *
+ * @section Examples
+ *
+ * @code{.cpp}
+ * GZFileIndex index;
+ * if (build(index, "reads.fq.gz"))
+ *     save(index, toCString(getIndexFileName(index, "reads.fq.gz")));
+ *
+ * SeqFileIn seqFileIn("reads.fq.gz");  // decompresses reads.fq.gz in parallel
+ * @endcode
+ */
+
+class GZFileIndex
+{
+public:
+    // Window size of deflate and the default distance of the access points.
+    enum
+    {
+        WINDOW_SIZE = 32768,
+        DEFAULT_SPAN = 4 * 1024 * 1024,
+        FINGERPRINT_SIZE = 65536            // Bytes at both ends of the compressed file covered by the fingerprint.
+    };
+
+    String<GZFileIndexPoint_>   points;
+    CharString                  windows;            // The deflate-compressed windows of all access points.
+    __uint64                    compressedSize;
+    __uint64                    uncompressedSize;
+    __uint32                    fingerprint;        // CRC32 of the head and tail of the compressed file.
+
+    GZFileIndex() : compressedSize(0), uncompressedSize(0), fingerprint(0)
+    {}
+};
+
+// ===========================================================================
+// Functions
+// ===========================================================================
+
+// --------------------------------------------------------------------------
+// Function getIndexFileName()
+// --------------------------------------------------------------------------
+
+/*!
+ * @fn GZFileIndex#getIndexFileName
+ * @brief Returns the file name of the index of a gzip file.
+ *
+ * @signature CharString getIndexFileName(index, fileName);
+ *
+ * @param[in] index     The GZFileIndex.
+ * @param[in] fileName  The name of the gzip file.
+ *
+ * @return CharString The name of the index file, i.e. <tt>fileName</tt> with the extension <tt>.gzidx</tt> appended.
+ */
+
+template <typename TFileName>
+inline CharString
+getIndexFileName(GZFileIndex const & /* index */, TFileName const & fileName)
+{
+    CharString indexFileName = fileName;
+    append(indexFileName, ".gzidx");
+    return indexFileName;
+}
+
+// --------------------------------------------------------------------------
+// Function _gzFileIndexCrc()
+// --------------------------------------------------------------------------
+
+// crc32() of zlib takes the length as uInt, feed longer buffers in pieces.
+
+inline __uint32
+_gzFileIndexCrc(__uint32 crc, unsigned char const * data, __uint64 dataLength)
+{
+    while (dataLength != 0)
+    {
+        uInt pieceLength = (uInt)std::min(dataLength, (__uint64)1 << 30);
+        crc = crc32(crc, data, pieceLength);
+        data += pieceLength;
+        dataLength -= pieceLength;
+    }
+    return crc;
+}
+
+// --------------------------------------------------------------------------
+// Function _gzFileIndexFingerprint()
+// --------------------------------------------------------------------------
+
+// Compute the CRC32 of the first and last FINGERPRINT_SIZE bytes of the compressed file.  The tail contains the CRC32
+// and length of the last gzip member, which identifies its contents.
+
+inline bool
+_gzFileIndexFingerprint(__uint32 & fingerprint, std::istream & file, __uint64 compressedSize)
+{
+    __uint64 const FINGERPRINT_SIZE = GZFileIndex::FINGERPRINT_SIZE;
+
+    __uint64 headLength = std::min(compressedSize, FINGERPRINT_SIZE);
+    __uint64 tailBegin = (compressedSize > FINGERPRINT_SIZE) ? compressedSize - FINGERPRINT_SIZE : 0;
+    tailBegin = std::max(headLength, tailBegin);
+
+    String<unsigned char> buffer;
+    resize(buffer, headLength + compressedSize - tailBegin, Exact());
+    file.clear();
+    file.seekg(0, std::ios::beg);
+    file.read((char *)begin(buffer, Standard()), headLength);
+    file.seekg(tailBegin, std::ios::beg);
+    file.read((char *)begin(buffer, Standard()) + headLength, compressedSize - tailBegin);
+    if (!file.good())
+        return false;
+
+    fingerprint = _gzFileIndexCrc(crc32(0L, Z_NULL, 0), begin(buffer, Standard()), length(buffer));
+    return true;
+}
+
+// --------------------------------------------------------------------------
+// Function _gzFileIndexMatches()
+// --------------------------------------------------------------------------
+
+// Check whether the index belongs to the gzip file, i.e. whether the size and the fingerprint match.
+
+inline bool
+_gzFileIndexMatches(GZFileIndex const & index, char const * fileName)
+{
+    std::ifstream file(fileName, std::ios::binary | std::ios::in);
+    file.seekg(0, std::ios::end);
+    if (!file.good() || (__uint64)file.tellg() != index.compressedSize)
+        return false;
+
+    __uint32 fingerprint = 0;
+    return _gzFileIndexFingerprint(fingerprint, file, index.compressedSize) && fingerprint == index.fingerprint;
+}
+
+// --------------------------------------------------------------------------
+// Function _gzFileIndexAddPoint()
+// --------------------------------------------------------------------------
+
+// Add an access point and store the last 32kb of the circular window buffer.
+
+inline bool
+_gzFileIndexAddPoint(GZFileIndex & index,
+                     unsigned bits,
+                     __uint64 compressedOffset,
+                     __uint64 uncompressedOffset,
+                     unsigned windowLeft,
+                     unsigned char const * window)
+{
+    unsigned const WINDOW_SIZE = GZFileIndex::WINDOW_SIZE;
+
+    // The circular buffer contains the older data behind the next output position.
+    String<unsigned char> linearWindow;
+    resize(linearWindow, WINDOW_SIZE, Exact());
+    std::copy(window + WINDOW_SIZE - windowLeft, window + WINDOW_SIZE, begin(linearWindow, Standard()));
+    std::copy(window, window + WINDOW_SIZE - windowLeft, begin(linearWindow, Standard()) + windowLeft);
+
+    // Only the data behind the beginning of the file is valid.
+    unsigned windowLength = (uncompressedOffset < WINDOW_SIZE) ? (unsigned)uncompressedOffset : WINDOW_SIZE;
+
+    uLongf compressedLength = compressBound(windowLength);
+    size_t windowBegin = length(index.windows);
+    resize(index.windows, windowBegin + compressedLength, Exact());
+    if (compress2((Bytef *)begin(index.windows, Standard()) + windowBegin, &compressedLength,
+                  (Bytef const *)begin(linearWindow, Standard()) + WINDOW_SIZE - windowLength, windowLength,
+                  Z_BEST_COMPRESSION) != Z_OK)
+        return false;
+    resize(index.windows, windowBegin + compressedLength, Exact());
+
+    GZFileIndexPoint_ point;
+    point.compressedOffset = compressedOffset;
+    point.uncompressedOffset = uncompressedOffset;
+    point.windowEnd = length(index.windows);
+    point.bits = bits;
+    point.crc = crc32(0L, Z_NULL, 0);
+    appendValue(index.points, point);
+    return true;
+}
+
+// --------------------------------------------------------------------------
+// Function build()
+// --------------------------------------------------------------------------
+
+/*!
+ * @fn GZFileIndex#build
+ * @brief Build the access point index of a gzip file.
+ *
+ * @signature bool build(index, fileName[, span]);
+ *
+ * @param[out] index    The GZFileIndex to build.
+ * @param[in]  fileName The name of the gzip file.  Type: <tt>char const *</tt>.
+ * @param[in]  span     The minimal distance of access points in the uncompressed data, defaults to 4MB.  Larger
+ *                      distances give smaller indices but larger chunks to decompress.  Type: <tt>__uint64</tt>.
+ *
+ * @return bool <tt>true</tt> on success, <tt>false</tt> if the file could not be read or is no valid gzip file.
+ *
+ * The whole file is decompressed once.  Files consisting of multiple gzip members are supported.  Each access point
+ * costs the size of a compressed 32kb window in the index.
+ */
+
+inline bool
+build(GZFileIndex & index, char const * fileName, __uint64 span)
+{
+    unsigned const WINDOW_SIZE = GZFileIndex::WINDOW_SIZE;
+    unsigned const CHUNK_SIZE = 16384;
+
+    clear(index.points);
+    clear(index.windows);
+    index.compressedSize = 0;
+    index.uncompressedSize = 0;
+    index.fingerprint = 0;
+
+    std::ifstream file(fileName, std::ios::binary | std::ios::in);
+    if (!file.good())
+        return false;
+
+    z_stream strm;
+    memset(&strm, 0, sizeof(z_stream));
+    if (inflateInit2(&strm, 47) != Z_OK)    // Automatic zlib or gzip header detection.
+        return false;
+
+    String<unsigned char> input;
+    String<unsigned char> window;
+    resize(input, CHUNK_SIZE, Exact());
+    resize(window, WINDOW_SIZE, Exact());
+
+    __uint64 totalIn = 0;
+    __uint64 totalOut = 0;
+    __uint64 lastPoint = 0;
+    __uint32 chunkCrc = crc32(0L, Z_NULL, 0);
+    bool success = true;
+    bool memberEnd = false;     // true if a gzip member was finished and no data of the next one was read.
+    bool done = false;
+    int status = Z_OK;
+
+    strm.avail_out = 0;
+    while (success && !done)
+    {
+        file.read((char *)begin(input, Standard()), CHUNK_SIZE);
+        strm.avail_in = file.gcount();
+        strm.next_in = begin(input, Standard());
+        if (strm.avail_in == 0)
+            break;
+
+        do
+        {
+            if (strm.avail_out == 0)
+            {
+                strm.avail_out = WINDOW_SIZE;
+                strm.next_out = begin(window, Standard());
+            }
+
+            totalIn += strm.avail_in;
+            totalOut += strm.avail_out;
+            unsigned char * outBegin = strm.next_out;
+            status = inflate(&strm, Z_BLOCK);
+            totalIn -= strm.avail_in;
+            totalOut -= strm.avail_out;
+            chunkCrc = _gzFileIndexCrc(chunkCrc, outBegin, strm.next_out - outBegin);
+
+            if (status == Z_NEED_DICT || status == Z_DATA_ERROR || status == Z_MEM_ERROR)
+            {
+                // Ignore trailing garbage behind the last gzip member, as gzip does.
+                if (memberEnd)
+                    done = true;
+                else
+                    success = false;
+                break;
+            }
+
+            if (status == Z_STREAM_END)
+            {
+                // Continue with the next gzip member (if any).
+                memberEnd = true;
+                inflateReset(&strm);
+                continue;
+            }
+
+            memberEnd = false;
+
+            // Add an access point at the end of a deflate block, unless it is the last block of the member.
+            if ((strm.data_type & 128) && !(strm.data_type & 64) && (totalOut == 0 || totalOut - lastPoint > span))
+            {
+                // The data since the previous access point is its chunk.
+                if (!empty(index.points))
+                    back(index.points).crc = chunkCrc;
+                chunkCrc = crc32(0L, Z_NULL, 0);
+
+                if (!_gzFileIndexAddPoint(index, strm.data_type & 7, totalIn, totalOut, strm.avail_out,
+                                          begin(window, Standard())))
+                {
+                    success = false;
+                    break;
+                }
+                lastPoint = totalOut;
+            }
+        }
+        while (strm.avail_in != 0);
+    }
+
+    // The file must not be truncated.
+    if (success && !memberEnd)
+        success = false;
+    if (!empty(index.points))
+        back(index.points).crc = chunkCrc;
+
+    inflateEnd(&strm);
+    file.clear();
+    file.seekg(0, std::ios::end);
+    index.compressedSize = file.tellg();
+    index.uncompressedSize = totalOut;
+    return success && _gzFileIndexFingerprint(index.fingerprint, file, index.compressedSize);
+}
+
+inline bool
+build(GZFileIndex & index, char const * fileName)
+{
+    return build(index, fileName, GZFileIndex::DEFAULT_SPAN);
+}
+
+// --------------------------------------------------------------------------
+// Function save()
+// --------------------------------------------------------------------------
+
+/*!
+ * @fn GZFileIndex#save
+ * @brief Save a GZFileIndex to a file.
+ *
+ * @signature bool save(index, fileName);
+ *
+ * @param[in] index     The GZFileIndex to save.
+ * @param[in] fileName  The name of the index file.  Type: <tt>char const *</tt>.
+ *
+ * @return bool <tt>true</tt> on success, <tt>false</tt> otherwise.
+ */
+
+inline bool
+save(GZFileIndex const & index, char const * fileName)
+{
+    std::ofstream out(fileName, std::ios::binary | std::ios::out);
+
+    out.write("GZIX", 4);
+    __uint32 version = 2;
+    out.write(reinterpret_cast<char const *>(&version), 4);
+    out.write(reinterpret_cast<char const *>(&index.compressedSize), 8);
+    out.write(reinterpret_cast<char const *>(&index.uncompressedSize), 8);
+    out.write(reinterpret_cast<char const *>(&index.fingerprint), 4);
+    __uint64 numPoints = length(index.points);
+    out.write(reinterpret_cast<char const *>(&numPoints), 8);
+    for (unsigned i = 0; i < numPoints; ++i)
+    {
+        GZFileIndexPoint_ const & point = index.points[i];
+        __uint32 bits = point.bits;
+        out.write(reinterpret_cast<char const *>(&point.compressedOffset), 8);
+        out.write(reinterpret_cast<char const *>(&point.uncompressedOffset), 8);
+        out.write(reinterpret_cast<char const *>(&point.windowEnd), 8);
+        out.write(reinterpret_cast<char const *>(&bits), 4);
+        out.write(reinterpret_cast<char const *>(&point.crc), 4);
+    }
+    __uint64 windowsLength = length(index.windows);
+    out.write(reinterpret_cast<char const *>(&windowsLength), 8);
+    out.write(begin(index.windows, Standard()), windowsLength);
+
+    return out.good();  // false on error, true on success.
+}
+
+// --------------------------------------------------------------------------
+// Function open()
+// --------------------------------------------------------------------------
+
+/*!
+ * @fn GZFileIndex#open
+ * @brief Load a GZFileIndex from a file.
+ *
+ * @signature bool open(index, fileName);
+ *
+ * @param[out] index    The GZFileIndex to load into.
+ * @param[in]  fileName The name of the index file.  Type: <tt>char const *</tt>.
+ *
+ * @return bool <tt>true</tt> on success, <tt>false</tt> if the file could not be read or is no valid index.
+ */
+
+inline bool
+open(GZFileIndex & index, char const * fileName)
+{
+    std::ifstream in(fileName, std::ios::binary | std::ios::in);
+    if (!in.good())
+        return false;
+
+    char magic[4];
+    __uint32 version = 0;
+    in.read(magic, 4);
+    in.read(reinterpret_cast<char *>(&version), 4);
+    if (!in.good() || std::string(magic, 4) != "GZIX" || version != 2)
+        return false;
+
+    __uint64 numPoints = 0;
+    in.read(reinterpret_cast<char *>(&index.compressedSize), 8);
+    in.read(reinterpret_cast<char *>(&index.uncompressedSize), 8);
+    in.read(reinterpret_cast<char *>(&index.fingerprint), 4);
+    in.read(reinterpret_cast<char *>(&numPoints), 8);
+    if (!in.good())
+        return false;
+
+    // Each access point takes 32 bytes, followed by the length of the windows.  Don't trust numPoints before
+    // allocating memory for it.
+    std::streampos pointsBegin = in.tellg();
+    in.seekg(0, std::ios::end);
+    __uint64 bytesLeft = in.tellg() - pointsBegin;
+    in.seekg(pointsBegin);
+    if (!in.good() || bytesLeft < 8 || numPoints > (bytesLeft - 8) / 32)
+        return false;
+
+    clear(index.points);
+    reserve(index.points, numPoints, Exact());
+    for (__uint64 i = 0; i < numPoints; ++i)
+    {
+        GZFileIndexPoint_ point;
+        __uint32 bits = 0;
+        in.read(reinterpret_cast<char *>(&point.compressedOffset), 8);
+        in.read(reinterpret_cast<char *>(&point.uncompressedOffset), 8);
+        in.read(reinterpret_cast<char *>(&point.windowEnd), 8);
+        in.read(reinterpret_cast<char *>(&bits), 4);
+        in.read(reinterpret_cast<char *>(&point.crc), 4);
+        point.bits = bits;
+
+        // The access points must be ordered and lie within the file.
+        if (bits > 7 || (bits != 0 && point.compressedOffset == 0) || point.compressedOffset > index.compressedSize ||
+            point.uncompressedOffset > index.uncompressedSize ||
+            (i == 0 && point.uncompressedOffset != 0) ||
+            (i != 0 && (point.uncompressedOffset <= back(index.points).uncompressedOffset ||
+                        point.compressedOffset < back(index.points).compressedOffset ||
+                        point.windowEnd < back(index.points).windowEnd)))
+            return false;
+        appendValue(index.points, point);
+    }
+
+    __uint64 windowsLength = 0;
+    in.read(reinterpret_cast<char *>(&windowsLength), 8);
+    if (!in.good() || windowsLength > bytesLeft - 8 - 32 * numPoints ||
+        (numPoints == 0 && (index.uncompressedSize != 0 || windowsLength != 0)) ||
+        (numPoints != 0 && back(index.points).windowEnd != windowsLength))
+        return false;
+    resize(index.windows, windowsLength, Exact());
+    in.read(begin(index.windows, Standard()), windowsLength);
+
+    return in.good();
+}
+
+// --------------------------------------------------------------------------
+// Function _gzFileIndexChunkRange()
+// --------------------------------------------------------------------------
+
+// The chunk i spans from access point i to access point i+1.  Return the range of its compressed data in the file.
+
+inline void
+_gzFileIndexChunkRange(__uint64 & compressedBegin, __uint64 & compressedEnd, GZFileIndex const & index, size_t i)
+{
+    GZFileIndexPoint_ const & point = index.points[i];
+    compressedBegin = point.compressedOffset - (point.bits != 0);
+    compressedEnd = index.compressedSize;
+    if (i + 1 < length(index.points))
+        compressedEnd = std::min(index.points[i + 1].compressedOffset + 1, index.compressedSize);
+}
+
+inline __uint64
+_gzFileIndexChunkLength(GZFileIndex const & index, size_t i)
+{
+    __uint64 chunkEnd = (i + 1 < length(index.points)) ? index.points[i + 1].uncompressedOffset : index.uncompressedSize;
+    return chunkEnd - index.points[i].uncompressedOffset;
+}
+
+// --------------------------------------------------------------------------
+// Function _gzFileIndexInflateChunk()
+// --------------------------------------------------------------------------
+
+// Decompress the chunk i from its compressed data into dst (of the chunk's length) and verify its CRC32.  Throws an
+// IOError on failure.
+
+inline void
+_gzFileIndexInflateChunk(char * dst, char const * src, size_t srcLength, GZFileIndex const & index, size_t i)
+{
+    GZFileIndexPoint_ const & point = index.points[i];
+    size_t dstLength = _gzFileIndexChunkLength(index, i);
+
+    // Restore the window of the access point.
+    unsigned char window[GZFileIndex::WINDOW_SIZE];
+    uLongf windowLength = GZFileIndex::WINDOW_SIZE;
+    __uint64 windowBegin = (i == 0) ? 0 : index.points[i - 1].windowEnd;
+    if (uncompress(window, &windowLength, (Bytef const *)begin(index.windows, Standard()) + windowBegin,
+                   point.windowEnd - windowBegin) != Z_OK)
+        SEQAN_THROW(IOError("Invalid window in gzip index."));
+
+    z_stream strm;
+    memset(&strm, 0, sizeof(z_stream));
+    if (inflateInit2(&strm, -15) != Z_OK)   // Raw deflate data.
+        SEQAN_THROW(IOError("GZIP inflateInit2() failed."));
+
+    if (point.bits != 0)
+    {
+        inflatePrime(&strm, point.bits, (unsigned char)src[0] >> (8 - point.bits));
+        ++src;
+        --srcLength;
+    }
+    if (windowLength != 0)
+        inflateSetDictionary(&strm, window, windowLength);
+
+    strm.next_in = (Bytef *)src;
+    strm.avail_in = srcLength;
+    strm.next_out = (Bytef *)dst;
+    strm.avail_out = dstLength;
+
+    bool raw = true;
+    while (strm.avail_out != 0)
+    {
+        int status = inflate(&strm, Z_NO_FLUSH);
+        if (status == Z_STREAM_END)
+        {
+            // The gzip member ends within the chunk, skip its trailer and continue with the next member.
+            if (raw)
+            {
+                if (strm.avail_in < 8)
+                    break;
+                strm.next_in += 8;
+                strm.avail_in -= 8;
+            }
+            inflateReset2(&strm, 31);
+            raw = false;
+        }
+        else if (status != Z_OK)
+        {
+            break;
+        }
+    }
+
+    bool success = strm.avail_out == 0;
+    inflateEnd(&strm);
+    if (!success)
+        SEQAN_THROW(IOError("Inflation of gzip chunk failed."));
+    if (_gzFileIndexCrc(crc32(0L, Z_NULL, 0), (unsigned char const *)dst, dstLength) != point.crc)
+        SEQAN_THROW(IOError("CRC error in gzip chunk, the index does not match the file."));
+}
+
+// --------------------------------------------------------------------------
+// Class basic_gz_index_streambuf
+// --------------------------------------------------------------------------
+
+// Decompresses the chunks of a gzip file with an access point index on a pool of worker threads.  The design follows
+// basic_unbgzf_streambuf, positions are offsets in the uncompressed data.
+
+template<
+    typename Elem,
+    typename Tr = std::char_traits<Elem>,
+    typename ElemA = std::allocator<Elem>,
+    typename ByteT = char,
+    typename ByteAT = std::allocator<ByteT>
+>
+class basic_gz_index_streambuf :
+    public std::basic_streambuf<Elem, Tr>
+{
+public:
+    typedef std::basic_istream<Elem, Tr>& istream_reference;
+    typedef ElemA char_allocator_type;
+    typedef ByteT byte_type;
+    typedef ByteAT byte_allocator_type;
+    typedef typename Tr::char_type char_type;
+    typedef typename Tr::int_type int_type;
+    typedef typename Tr::off_type off_type;
+    typedef typename Tr::pos_type pos_type;
+
+    typedef std::vector<char_type, char_allocator_type>     TBuffer;
+    typedef ConcurrentQueue<int, Suspendable<Limit> >       TJobQueue;
+
+    static const size_t MAX_PUTBACK = 4;
+
+    struct Serializer
+    {
+        istream_reference   istream;
+        Mutex               lock;
+        IOError             *error;
+        size_t              nextChunk;
+
+        Serializer(istream_reference istream) :
+            istream(istream),
+            lock(false),
+            error(NULL),
+            nextChunk(0)
+        {}
+
+        ~Serializer()
+        {
+            delete error;
+        }
+    };
+
+    Serializer serializer;
+
+    struct DecompressionJob
+    {
+        typedef std::vector<byte_type, byte_allocator_type> TInputBuffer;
+
+        TInputBuffer    inputBuffer;
+        TBuffer         buffer;
+        size_t          chunkId;
+        int             size;
+
+        CriticalSection cs;
+        Condition       readyEvent;
+        bool            ready;
+
+        DecompressionJob() :
+            buffer(MAX_PUTBACK, 0),
+            chunkId(0),
+            size(0),
+            readyEvent(cs),
+            ready(true)
+        {}
+
+        DecompressionJob(DecompressionJob const &other) :
+            inputBuffer(other.inputBuffer),
+            buffer(other.buffer),
+            chunkId(other.chunkId),
+            size(other.size),
+            readyEvent(cs),
+            ready(other.ready)
+        {}
+    };
+
+    GZFileIndex                 index;
+
+    // string of recycable jobs
+    size_t                      numThreads;
+    size_t                      numJobs;
+    String<DecompressionJob>    jobs;
+    TJobQueue                   runningQueue;
+    TJobQueue                   todoQueue;
+    int                         currentJobId;
+
+    struct DecompressionThread
+    {
+        basic_gz_index_streambuf    *streamBuf;
+
+        void operator()()
+        {
+            ScopedReadLock<TJobQueue> readLock(streamBuf->todoQueue);
+            ScopedWriteLock<TJobQueue> writeLock(streamBuf->runningQueue);
+
+            GZFileIndex const & index = streamBuf->index;
+
+            // wait for a new job to become available
+            while (true)
+            {
+                int jobId = -1;
+                if (!popFront(jobId, streamBuf->todoQueue))
+                    return;
+
+                DecompressionJob &job = streamBuf->jobs[jobId];
+
+                // if seek() puts running jobs back into the todoQueue, wait for them to finish
+                if (!job.ready)
+                {
+                    ScopedLock<CriticalSection> lock(job.cs);
+                    if (!job.ready)
+                    {
+                        waitFor(job.readyEvent);
+                        job.ready = true;
+                    }
+                }
+
+                {
+                    ScopedLock<Mutex> scopedLock(streamBuf->serializer.lock);
+
+                    if (streamBuf->serializer.error != NULL)
+                        return;
+
+                    job.chunkId = streamBuf->serializer.nextChunk;
+                    job.size = -1;
+
+                    // only load if not at EOF
+                    if (job.chunkId < length(index.points))
+                    {
+                        __uint64 compressedBegin = 0;
+                        __uint64 compressedEnd = 0;
+                        _gzFileIndexChunkRange(compressedBegin, compressedEnd, index, job.chunkId);
+                        job.inputBuffer.resize(compressedEnd - compressedBegin);
+
+                        std::istream & istream = streamBuf->serializer.istream;
+                        istream.clear();
+                        if (istream.rdbuf()->pubseekpos(compressedBegin, std::ios_base::in) != (pos_type)compressedBegin ||
+                            !istream.read(&job.inputBuffer[0], job.inputBuffer.size()))
+                        {
+                            streamBuf->serializer.error = new IOError("Stream read error.");
+                            return;
+                        }
+
+                        ++streamBuf->serializer.nextChunk;
+                        job.ready = false;
+                    }
+
+                    if (!appendValue(streamBuf->runningQueue, jobId))
+                    {
+                        // signal that job is ready
+                        {
+                            ScopedLock<CriticalSection> lock(job.cs);
+                            job.ready = true;
+                            signal(job.readyEvent);
+                        }
+                        return;
+                    }
+                }
+
+                if (!job.ready)
+                {
+                    // decompress chunk
+                    size_t chunkLength = _gzFileIndexChunkLength(index, job.chunkId);
+                    job.buffer.resize(MAX_PUTBACK + chunkLength);
+                    SEQAN_TRY
+                    {
+                        _gzFileIndexInflateChunk(&job.buffer[0] + MAX_PUTBACK, &job.inputBuffer[0],
+                                                 job.inputBuffer.size(), index, job.chunkId);
+                        job.size = chunkLength;
+                    }
+                    SEQAN_CATCH(IOError const & e)
+                    {
+                        ScopedLock<Mutex> scopedLock(streamBuf->serializer.lock);
+                        if (streamBuf->serializer.error == NULL)
+                            streamBuf->serializer.error = new IOError(e);
+                    }
+
+                    // signal that job is ready
+                    {
+                        ScopedLock<CriticalSection> lock(job.cs);
+                        job.ready = true;
+                        signal(job.readyEvent);
+                    }
+                }
+            }
+        }
+    };
+
+    // array of worker threads
+    Thread<DecompressionThread> *threads;
+    TBuffer                     putbackBuffer;
+
+    basic_gz_index_streambuf(istream_reference istream_,
+                             GZFileIndex const & index_,
+                             size_t numThreads = 8,
+                             size_t jobsPerThread = 2) :
+        serializer(istream_),
+        index(index_),
+        numThreads(numThreads),
+        numJobs(numThreads * jobsPerThread),
+        runningQueue(numJobs),
+        todoQueue(numJobs),
+        putbackBuffer(MAX_PUTBACK)
+    {
+        resize(jobs, numJobs, Exact());
+        currentJobId = -1;
+
+        lockReading(runningQueue);
+        lockWriting(todoQueue);
+        setReaderWriterCount(runningQueue, 1, numThreads);
+        setReaderWriterCount(todoQueue, numThreads, 1);
+
+        for (unsigned i = 0; i < numJobs; ++i)
+        {
+            bool success = appendValue(todoQueue, i);
+            ignoreUnusedVariableWarning(success);
+            SEQAN_ASSERT(success);
+        }
+
+        threads = new Thread<DecompressionThread>[numThreads];
+        for (unsigned i = 0; i < numThreads; ++i)
+        {
+            threads[i].worker.streamBuf = this;
+            run(threads[i]);
+        }
+    }
+
+    ~basic_gz_index_streambuf()
+    {
+        unlockWriting(todoQueue);
+        unlockReading(runningQueue);
+
+        for (unsigned i = 0; i < numThreads; ++i)
+            waitFor(threads[i]);
+        delete[] threads;
+    }
+
+    void _throwError()
+    {
+        ScopedLock<Mutex> scopedLock(serializer.lock);
+        if (serializer.error != NULL)
+            SEQAN_THROW(*serializer.error);
+    }
+
+    // the position of the first character of the current job in the uncompressed data
+    __uint64 _jobBegin(DecompressionJob const & job) const
+    {
+        if (job.chunkId < length(index.points))
+            return index.points[job.chunkId].uncompressedOffset;
+        return index.uncompressedSize;
+    }
+
+    int_type underflow()
+    {
+        // no need to use the next buffer?
+        if (this->gptr() && this->gptr() < this->egptr())
+            return Tr::to_int_type(*this->gptr());
+
+        size_t putback = this->gptr() - this->eback();
+        if (putback > MAX_PUTBACK)
+            putback = MAX_PUTBACK;
+
+        // save at most MAX_PUTBACK characters from previous page to putback buffer
+        if (putback != 0)
+            std::copy(
+                this->gptr() - putback,
+                this->gptr(),
+                &putbackBuffer[0]);
+
+        if (currentJobId >= 0)
+            appendValue(todoQueue, currentJobId);
+
+        while (true)
+        {
+            if (!popFront(currentJobId, runningQueue))
+            {
+                currentJobId = -1;
+                _throwError();
+                return EOF;
+            }
+
+            DecompressionJob &job = jobs[currentJobId];
+
+            // wait for the end of decompression
+            {
+                ScopedLock<CriticalSection> lock(job.cs);
+                if (!job.ready)
+                    waitFor(job.readyEvent);
+            }
+
+            // restore putback buffer
+            if (putback != 0)
+                std::copy(
+                    &putbackBuffer[0],
+                    &putbackBuffer[0] + putback,
+                    &job.buffer[0] + (MAX_PUTBACK - putback));
+
+            size_t size = (job.size != -1)? job.size : 0;
+
+            // reset buffer pointers
+            this->setg(
+                  &job.buffer[0] + (MAX_PUTBACK - putback),     // beginning of putback area
+                  &job.buffer[0] + MAX_PUTBACK,                 // read position
+                  &job.buffer[0] + (MAX_PUTBACK + size));       // end of buffer
+
+            if (job.size == -1)
+            {
+                _throwError();
+                return EOF;
+            }
+            else if (job.size > 0)
+                return Tr::to_int_type(*this->gptr());      // return next character
+        }
+    }
+
+    pos_type seekoff(off_type ofs, std::ios_base::seekdir dir, std::ios_base::openmode openMode)
+    {
+        if ((openMode & (std::ios_base::in | std::ios_base::out)) != std::ios_base::in)
+            return pos_type(off_type(-1));
+
+        // compute the target position in the uncompressed data
+        if (currentJobId < 0 && dir == std::ios_base::cur)
+            this->underflow();
+
+        __uint64 curPos = index.uncompressedSize;
+        if (currentJobId >= 0)
+            curPos = _jobBegin(jobs[currentJobId]) + (this->gptr() - (&jobs[currentJobId].buffer[0] + MAX_PUTBACK));
+
+        off_type destPos = ofs;
+        if (dir == std::ios_base::cur)
+            destPos += curPos;
+        else if (dir == std::ios_base::end)
+            destPos += index.uncompressedSize;
+        if (destPos < 0 || destPos > (off_type)index.uncompressedSize)
+            return pos_type(off_type(-1));
+
+        // are we in the same chunk?
+        if (currentJobId >= 0)
+        {
+            DecompressionJob &job = jobs[currentJobId];
+            __uint64 jobBegin = _jobBegin(job);
+            if (job.size >= 0 && jobBegin <= (__uint64)destPos && (__uint64)destPos < jobBegin + job.size)
+            {
+                // reset buffer pointers
+                this->setg(
+                      this->eback(),                                            // beginning of putback area
+                      &job.buffer[0] + (MAX_PUTBACK + (destPos - jobBegin)),    // read position
+                      this->egptr());                                           // end of buffer
+                return pos_type(destPos);
+            }
+        }
+
+        // ok, different chunk
+        size_t destChunk = std::upper_bound(begin(index.points, Standard()), end(index.points, Standard()),
+                                            (__uint64)destPos, GZFileIndexPointLess_()) - begin(index.points, Standard());
+        destChunk = (destChunk == 0) ? 0 : destChunk - 1;
+        if ((__uint64)destPos == index.uncompressedSize)
+            destChunk = length(index.points);
+        {
+            ScopedLock<Mutex> scopedLock(serializer.lock);
+
+            // remove all running jobs and put them in the idle queue unless we
+            // find our seek target
+
+            if (currentJobId >= 0)
+                appendValue(todoQueue, currentJobId);
+            currentJobId = -1;
+
+            // empty is thread-safe in serializer.lock
+            while (!empty(runningQueue))
+            {
+                popFront(currentJobId, runningQueue);
+
+                if (jobs[currentJobId].chunkId == destChunk)
+                    break;
+
+                // push back useless job
+                appendValue(todoQueue, currentJobId);
+                currentJobId = -1;
+            }
+
+            if (currentJobId == -1)
+                serializer.nextChunk = destChunk;
+        }
+
+        // if our chunk wasn't in the running queue yet, it should now
+        // be the first that falls out after modifying serializer.nextChunk
+        if (currentJobId == -1 && !popFront(currentJobId, runningQueue))
+        {
+            currentJobId = -1;
+            _throwError();
+            return pos_type(off_type(-1));
+        }
+
+        // wait for the end of decompression
+        DecompressionJob &job = jobs[currentJobId];
+        {
+            ScopedLock<CriticalSection> lock(job.cs);
+            if (!job.ready)
+                waitFor(job.readyEvent);
+        }
+        if (job.size == -1 && destChunk < length(index.points))
+            _throwError();
+
+        SEQAN_ASSERT_EQ(job.chunkId, destChunk);
+        size_t size = (job.size != -1)? job.size : 0;
+
+        // reset buffer pointers
+        this->setg(
+              &job.buffer[0] + MAX_PUTBACK,                                     // no putback area
+              &job.buffer[0] + (MAX_PUTBACK + (destPos - _jobBegin(job))),      // read position
+              &job.buffer[0] + (MAX_PUTBACK + size));                           // end of buffer
+        return pos_type(destPos);
+    }
+
+    pos_type seekpos(pos_type pos, std::ios_base::openmode openMode)
+    {
+        return seekoff(off_type(pos), std::ios_base::beg, openMode);
+    }
+
+    // returns the compressed input istream
+    istream_reference get_istream()    { return serializer.istream; };
+};
+
+// --------------------------------------------------------------------------
+// Class basic_gz_index_istreambase
+// --------------------------------------------------------------------------
+
+template<
+    typename Elem,
+    typename Tr = std::char_traits<Elem>,
+    typename ElemA = std::allocator<Elem>,
+    typename ByteT = char,
+    typename ByteAT = std::allocator<ByteT>
+>
+class basic_gz_index_istreambase : virtual public std::basic_ios<Elem,Tr>
+{
+public:
+    typedef std::basic_istream<Elem, Tr>&                               istream_reference;
+    typedef basic_gz_index_streambuf<Elem, Tr, ElemA, ByteT, ByteAT>    gz_index_streambuf_type;
+
+    basic_gz_index_istreambase(istream_reference istream_, GZFileIndex const & index_)
+        : m_buf(istream_, index_)
+    {
+        this->init(&m_buf );
+    };
+
+    // returns the underlying unzip istream object
+    gz_index_streambuf_type* rdbuf() { return &m_buf; };
+
+private:
+    gz_index_streambuf_type m_buf;
+};
+
+// --------------------------------------------------------------------------
+// Class basic_gz_index_istream
+// --------------------------------------------------------------------------
+
+template<
+    typename Elem,
+    typename Tr = std::char_traits<Elem>,
+    typename ElemA = std::allocator<Elem>,
+    typename ByteT = char,
+    typename ByteAT = std::allocator<ByteT>
+>
+class basic_gz_index_istream :
+    public basic_gz_index_istreambase<Elem,Tr,ElemA,ByteT,ByteAT>,
+    public std::basic_istream<Elem,Tr>
+{
+public:
+    typedef basic_gz_index_istreambase<Elem,Tr,ElemA,ByteT,ByteAT>  gz_index_istreambase_type;
+    typedef std::basic_istream<Elem,Tr>                             istream_type;
+    typedef istream_type &                                          istream_reference;
+
+    basic_gz_index_istream(istream_reference istream_, GZFileIndex const & index_) :
+        gz_index_istreambase_type(istream_, index_),
+        istream_type(gz_index_istreambase_type::rdbuf())
+    {};
+
+#ifdef _WIN32
+private:
+    void _Add_vtordisp1() { } // Required to avoid VC++ warning C4250
+    void _Add_vtordisp2() { } // Required to avoid VC++ warning C4250
+#endif
+};
+
+// ===========================================================================
+// Typedefs
+// ===========================================================================
+
+// A typedef for basic_gz_index_istream<char>
+typedef basic_gz_index_istream<char> gz_index_istream;
+
+}  // namespace seqan
+
+#endif  // INCLUDE_SEQAN_STREAM_IOSTREAM_GZ_INDEX_H_
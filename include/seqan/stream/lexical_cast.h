@@ -228,11 +228,119 @@ lexicalCast(TInteger & target, TSource const & source)
     return true;
 }
 
+// Parses [+-]?digits[.digits][(e|E)[+-]?digits] into mantissa and decimal exponent.  Returns false if the source does
+// not match or if the mantissa has more than 19 significant digits.
+
+template <typename TSource>
+inline bool
+_parseDecimal(bool & negative, __uint64 & mantissa, int & exp10, TSource const & source)
+{
+    typedef typename Iterator<TSource const, Standard>::Type TIter;
+
+    TIter it = begin(source, Standard());
+    TIter itEnd = end(source, Standard());
+
+    negative = false;
+    mantissa = 0;
+    exp10 = 0;
+
+    if (it != itEnd && (*it == '-' || *it == '+'))
+        negative = (*it++ == '-');
+
+    unsigned numDigits = 0;
+    unsigned sigDigits = 0;
+    for (; it != itEnd; ++it, ++numDigits)
+    {
+        unsigned char digit = *it - '0';
+        if (digit > 9)
+            break;
+        if (mantissa != 0 || digit != 0)
+        {
+            if (SEQAN_UNLIKELY(++sigDigits > 19))
+                return false;
+            mantissa = mantissa * 10 + digit;
+        }
+    }
+    if (it != itEnd && *it == '.')
+    {
+        for (++it; it != itEnd; ++it, ++numDigits)
+        {
+            unsigned char digit = *it - '0';
+            if (digit > 9)
+                break;
+            if (mantissa != 0 || digit != 0)
+            {
+                if (SEQAN_UNLIKELY(++sigDigits > 19))
+                    return false;
+                mantissa = mantissa * 10 + digit;
+            }
+            --exp10;
+        }
+    }
+    if (SEQAN_UNLIKELY(numDigits == 0))
+        return false;
+
+    if (it != itEnd && (*it == 'e' || *it == 'E'))
+    {
+        bool negativeExp = false;
+        if (++it != itEnd && (*it == '-' || *it == '+'))
+            negativeExp = (*it++ == '-');
+        if (SEQAN_UNLIKELY(it == itEnd))
+            return false;
+        int exp = 0;
+        for (; it != itEnd; ++it)
+        {
+            unsigned char digit = *it - '0';
+            if (digit > 9 || exp > 10000)
+                return false;
+            exp = exp * 10 + digit;
+        }
+        exp10 += negativeExp ? -exp : exp;
+    }
+    return it == itEnd;
+}
+
+// Converts a decimal number to TFloat if this is exact up to a single rounding step, i.e. if the mantissa and
+// 10^|exp10| are both exactly representable in TFloat (Clinger's fast path).  Returns false otherwise.
+
+template <typename TFloat, typename TSource>
+inline bool
+_lexicalCastFloatFast(TFloat & target, TSource const & source)
+{
+    static const TFloat POW10[23] =
+    {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+    // float: 24 bit mantissa, 5^10 < 2^24; double: 53 bit mantissa, 5^22 < 2^53
+    static const __uint64 MAX_MANTISSA = (sizeof(TFloat) == sizeof(float)) ? ((__uint64)1 << 24) : ((__uint64)1 << 53);
+    static const int MAX_EXP10 = (sizeof(TFloat) == sizeof(float)) ? 10 : 22;
+
+    bool negative;
+    __uint64 mantissa;
+    int exp10;
+    if (!_parseDecimal(negative, mantissa, exp10, source))
+        return false;
+    if (mantissa > MAX_MANTISSA || exp10 > MAX_EXP10 || exp10 < -MAX_EXP10)
+        return false;
+
+    TFloat value = static_cast<TFloat>(mantissa);
+    if (exp10 >= 0)
+        value *= POW10[exp10];
+    else
+        value /= POW10[-exp10];
+    target = negative ? -value : value;
+    return true;
+}
+
 // Specialization for float.
 
 template <typename TSource>
 inline bool lexicalCast(float & target, TSource const & source)
 {
+    if (_lexicalCastFloatFast(target, source))
+        return true;
+
     int offset;
     return (sscanf(toCString(source), "%g%n", &target, &offset) == 1) &&
            (static_cast<typename Size<TSource>::Type>(offset) == length(source));
@@ -242,6 +350,9 @@ inline bool lexicalCast(float & target, TSource const & source)
 template <typename TSource>
 inline bool lexicalCast(double & target, TSource const & source)
 {
+    if (_lexicalCastFloatFast(target, source))
+        return true;
+
     int offset;
     return (sscanf(toCString(source), "%lg%n", &target, &offset) == 1) &&
            (static_cast<typename Size<TSource>::Type>(offset) == length(source));
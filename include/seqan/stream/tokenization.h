@@ -37,6 +37,12 @@
 #ifndef SEQAN_STREAM_TOKENIZATION_H_
 #define SEQAN_STREAM_TOKENIZATION_H_
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 namespace seqan {
 
 // ============================================================================
@@ -152,10 +158,239 @@ typedef OrFunctor<IsInRange<'a', 'z'>, IsInRange<'A', 'Z'> >    IsAlpha;
 typedef IsInRange<'0', '9'>                                     IsDigit;
 typedef OrFunctor<IsAlpha, IsDigit>                             IsAlphaNum;
 
+// ============================================================================
+// Metafunctions
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Metafunction HasSimdStopMask_
+// ----------------------------------------------------------------------------
+// Stateless character class functors that _findStop() can evaluate on 16 or
+// 32 characters at once.
+
+template <typename TFunctor>
+struct HasSimdStopMask_ : False {};
+
+template <typename TFunctor>
+struct HasSimdStopMask_<TFunctor const> : HasSimdStopMask_<TFunctor> {};
+
+template <char VALUE>
+struct HasSimdStopMask_<EqualsChar<VALUE> > : True {};
+
+template <char FIRST_CHAR, char LAST_CHAR>
+struct HasSimdStopMask_<IsInRange<FIRST_CHAR, LAST_CHAR> > : True {};
+
+template <typename TFunctor1, typename TFunctor2>
+struct HasSimdStopMask_<OrFunctor<TFunctor1, TFunctor2> > :
+    And<HasSimdStopMask_<TFunctor1>, HasSimdStopMask_<TFunctor2> > {};
+
+template <typename TFunctor1, typename TFunctor2>
+struct HasSimdStopMask_<AndFunctor<TFunctor1, TFunctor2> > :
+    And<HasSimdStopMask_<TFunctor1>, HasSimdStopMask_<TFunctor2> > {};
+
+template <typename TFunctor>
+struct HasSimdStopMask_<NotFunctor<TFunctor> > : HasSimdStopMask_<TFunctor> {};
+
+// ----------------------------------------------------------------------------
+// Metafunction SimdCharToRank_
+// ----------------------------------------------------------------------------
+// Nucleotide alphabets whose characters _convertChars() translates 16 at a
+// time. UNKNOWN is the rank of characters other than ACGTU (case-insensitive).
+
+template <typename TValue>
+struct SimdCharToRank_ : False {};
+
+template <>
+struct SimdCharToRank_<Dna> : True { enum { UNKNOWN = 0 }; };
+
+template <>
+struct SimdCharToRank_<Rna> : True { enum { UNKNOWN = 0 }; };
+
+template <>
+struct SimdCharToRank_<Dna5> : True { enum { UNKNOWN = 4 }; };
+
+template <>
+struct SimdCharToRank_<Rna5> : True { enum { UNKNOWN = 4 }; };
+
 // ============================================================================
 // Functions
 // ============================================================================
 
+#if defined(__SSE2__)
+
+// ----------------------------------------------------------------------------
+// Function _simdStopMask(); SSE2
+// ----------------------------------------------------------------------------
+// Returns a bit mask with bit i set iff the functor matches the i-th character.
+
+template <char VALUE>
+inline __uint32 _simdStopMask(__m128i chars, EqualsChar<VALUE> const &)
+{
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(chars, _mm_set1_epi8(VALUE)));
+}
+
+template <char FIRST_CHAR, char LAST_CHAR>
+inline __uint32 _simdStopMask(__m128i chars, IsInRange<FIRST_CHAR, LAST_CHAR> const &)
+{
+    // Signed comparison, just as the element-wise functor compares chars.
+    __m128i outside = _mm_or_si128(_mm_cmplt_epi8(chars, _mm_set1_epi8(FIRST_CHAR)),
+                                   _mm_cmpgt_epi8(chars, _mm_set1_epi8(LAST_CHAR)));
+    return ~_mm_movemask_epi8(outside) & 0xffffu;
+}
+
+template <typename TFunctor1, typename TFunctor2>
+inline __uint32 _simdStopMask(__m128i chars, OrFunctor<TFunctor1, TFunctor2> const & func)
+{
+    return _simdStopMask(chars, func.func1) | _simdStopMask(chars, func.func2);
+}
+
+template <typename TFunctor1, typename TFunctor2>
+inline __uint32 _simdStopMask(__m128i chars, AndFunctor<TFunctor1, TFunctor2> const & func)
+{
+    return _simdStopMask(chars, func.func1) & _simdStopMask(chars, func.func2);
+}
+
+template <typename TFunctor>
+inline __uint32 _simdStopMask(__m128i chars, NotFunctor<TFunctor> const & func)
+{
+    return ~_simdStopMask(chars, func.func) & 0xffffu;
+}
+
+#endif  // #if defined(__SSE2__)
+
+#if defined(__AVX2__)
+
+// ----------------------------------------------------------------------------
+// Function _simdStopMask(); AVX2
+// ----------------------------------------------------------------------------
+
+template <char VALUE>
+inline __uint32 _simdStopMask(__m256i chars, EqualsChar<VALUE> const &)
+{
+    return _mm256_movemask_epi8(_mm256_cmpeq_epi8(chars, _mm256_set1_epi8(VALUE)));
+}
+
+template <char FIRST_CHAR, char LAST_CHAR>
+inline __uint32 _simdStopMask(__m256i chars, IsInRange<FIRST_CHAR, LAST_CHAR> const &)
+{
+    __m256i outside = _mm256_or_si256(_mm256_cmpgt_epi8(_mm256_set1_epi8(FIRST_CHAR), chars),
+                                      _mm256_cmpgt_epi8(chars, _mm256_set1_epi8(LAST_CHAR)));
+    return ~static_cast<__uint32>(_mm256_movemask_epi8(outside));
+}
+
+template <typename TFunctor1, typename TFunctor2>
+inline __uint32 _simdStopMask(__m256i chars, OrFunctor<TFunctor1, TFunctor2> const & func)
+{
+    return _simdStopMask(chars, func.func1) | _simdStopMask(chars, func.func2);
+}
+
+template <typename TFunctor1, typename TFunctor2>
+inline __uint32 _simdStopMask(__m256i chars, AndFunctor<TFunctor1, TFunctor2> const & func)
+{
+    return _simdStopMask(chars, func.func1) & _simdStopMask(chars, func.func2);
+}
+
+template <typename TFunctor>
+inline __uint32 _simdStopMask(__m256i chars, NotFunctor<TFunctor> const & func)
+{
+    return ~_simdStopMask(chars, func.func);
+}
+
+#endif  // #if defined(__AVX2__)
+
+// ----------------------------------------------------------------------------
+// Function _findStop()
+// ----------------------------------------------------------------------------
+// Returns a pointer to the first element in [ptr, end) the functor stops at, or end.
+
+template <typename TValue, typename TStopFunctor, typename THasSimdStopMask>
+inline TValue const *
+_findStop(TValue const * ptr, TValue const * end, TStopFunctor & stopFunctor, THasSimdStopMask)
+{
+    for (; ptr != end; ++ptr)
+        if (SEQAN_UNLIKELY(stopFunctor(*ptr)))
+            break;
+    return ptr;
+}
+
+#if defined(__SSE2__)
+template <typename TStopFunctor>
+inline char const *
+_findStop(char const * ptr, char const * end, TStopFunctor & stopFunctor, True)
+{
+#if defined(__AVX2__)
+    for (; end - ptr >= 32; ptr += 32)
+    {
+        __m256i chars = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(ptr));
+        if (__uint32 mask = _simdStopMask(chars, stopFunctor))
+            return ptr + bitScanForward(mask);
+    }
+#endif
+    for (; end - ptr >= 16; ptr += 16)
+    {
+        __m128i chars = _mm_loadu_si128(reinterpret_cast<__m128i const *>(ptr));
+        if (__uint32 mask = _simdStopMask(chars, stopFunctor))
+            return ptr + bitScanForward(mask);
+    }
+    return _findStop(ptr, end, stopFunctor, False());
+}
+#endif  // #if defined(__SSE2__)
+
+template <typename TValue, typename TStopFunctor>
+inline TValue const *
+_findStop(TValue const * ptr, TValue const * end, TStopFunctor & stopFunctor)
+{
+    return _findStop(ptr, end, stopFunctor, typename HasSimdStopMask_<TStopFunctor>::Type());
+}
+
+// ----------------------------------------------------------------------------
+// Function _convertChars()
+// ----------------------------------------------------------------------------
+// Copies count input values to optr, converting them to the target alphabet.
+
+template <typename TOValue, typename TIValue, typename TSimdCharToRank>
+inline TOValue *
+_convertChars(TOValue * optr, TIValue const * iptr, size_t count, TSimdCharToRank)
+{
+    return std::copy(iptr, iptr + count, optr);
+}
+
+#if defined(__SSE2__)
+template <typename TOValue>
+inline TOValue *
+_convertChars(TOValue * optr, char const * iptr, size_t count, True)
+{
+    __m128i const upperCase = _mm_set1_epi8(static_cast<char>(0xdf));
+    __m128i const unknown = _mm_set1_epi8(SimdCharToRank_<TOValue>::UNKNOWN);
+
+    for (; count >= 16; count -= 16, iptr += 16, optr += 16)
+    {
+        __m128i chars = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<__m128i const *>(iptr)), upperCase);
+        __m128i isA = _mm_cmpeq_epi8(chars, _mm_set1_epi8('A'));
+        __m128i isC = _mm_cmpeq_epi8(chars, _mm_set1_epi8('C'));
+        __m128i isG = _mm_cmpeq_epi8(chars, _mm_set1_epi8('G'));
+        __m128i isT = _mm_or_si128(_mm_cmpeq_epi8(chars, _mm_set1_epi8('T')),
+                                   _mm_cmpeq_epi8(chars, _mm_set1_epi8('U')));
+
+        __m128i ranks = _mm_or_si128(_mm_and_si128(isC, _mm_set1_epi8(1)),
+                                     _mm_or_si128(_mm_and_si128(isG, _mm_set1_epi8(2)),
+                                                  _mm_and_si128(isT, _mm_set1_epi8(3))));
+        __m128i isKnown = _mm_or_si128(_mm_or_si128(isA, isC), _mm_or_si128(isG, isT));
+        ranks = _mm_or_si128(ranks, _mm_andnot_si128(isKnown, unknown));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(optr), ranks);
+    }
+    return _convertChars(optr, iptr, count, False());
+}
+#endif  // #if defined(__SSE2__)
+
+template <typename TOValue, typename TIValue>
+inline TOValue *
+_convertChars(TOValue * optr, TIValue const * iptr, size_t count)
+{
+    return _convertChars(optr, iptr, count, typename And<IsSameType<TIValue, char>,
+                                                         SimdCharToRank_<TOValue> >::Type());
+}
+
 // ----------------------------------------------------------------------------
 // Function _skipUntil(); Element-wise
 // ----------------------------------------------------------------------------
@@ -181,18 +416,11 @@ inline void _skipUntil(TFwdIterator &iter, TStopFunctor &stopFunctor, Range<TVal
         getChunk(ichunk, iter, Input());
         SEQAN_ASSERT(!empty(ichunk));
 
-        const TIValue* SEQAN_RESTRICT ptr = ichunk.begin;
-
-        for (; ptr != ichunk.end; ++ptr)
-        {
-            if (SEQAN_UNLIKELY(stopFunctor(*ptr)))
-            {
-                iter += ptr - ichunk.begin;    // advance input iterator
-                return;
-            }
-        }
+        const TIValue* ptr = _findStop(ichunk.begin, ichunk.end, stopFunctor);
 
         iter += ptr - ichunk.begin;            // advance input iterator
+        if (ptr != ichunk.end)
+            return;
     }
 }
 
@@ -317,6 +545,54 @@ inline void _readUntil(TTarget &target,
     advanceChunk(target, optr - ochunk.begin);
 }
 
+// ----------------------------------------------------------------------------
+// Function _readUntil(); Chunked, not ignoring
+// ----------------------------------------------------------------------------
+// Without an ignore functor the span up to the next delimiter is located first
+// and then copied as a whole.
+
+template <typename TTarget, typename TFwdIterator, typename TStopFunctor, typename TIValue, typename TOValue>
+inline void _readUntil(TTarget &target,
+                       TFwdIterator &iter,
+                       TStopFunctor &stopFunctor,
+                       False &,
+                       Range<TIValue*> *,
+                       Range<TOValue*> *)
+{
+    Range<TOValue*> ochunk(NULL, NULL);
+    TOValue* SEQAN_RESTRICT optr = NULL;
+
+    Range<TIValue*> ichunk;
+    for (; !atEnd(iter); )
+    {
+        getChunk(ichunk, iter, Input());
+        SEQAN_ASSERT(ichunk.begin < ichunk.end);
+
+        const TIValue* iptr = ichunk.begin;
+        const TIValue* stop = _findStop(iptr, static_cast<const TIValue*>(ichunk.end), stopFunctor);
+
+        while (iptr != stop)
+        {
+            if (SEQAN_UNLIKELY(optr == ochunk.end))
+            {
+                advanceChunk(target, optr - ochunk.begin);
+                reserveChunk(target, stop - iptr, Output());
+                getChunk(ochunk, target, Output());
+                optr = ochunk.begin;
+                SEQAN_ASSERT(optr < ochunk.end);
+            }
+            size_t count = std::min(stop - iptr, ochunk.end - optr);
+            optr = _convertChars(optr, iptr, count);
+            iptr += count;
+        }
+
+        iter += stop - ichunk.begin;                       // advance input iterator
+        if (stop != ichunk.end)
+            break;
+    }
+    advanceChunk(target, optr - ochunk.begin);            // extend target string size
+}
+
 // ----------------------------------------------------------------------------
 // Function readUntil()
 // ----------------------------------------------------------------------------
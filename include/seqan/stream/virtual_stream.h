@@ -99,9 +99,21 @@ struct Position<basic_bgzf_ostream<Elem, Tr, ElemA, ByteT, ByteAT> > :
     Position<std::basic_ostream<Elem, Tr> > {};
 
 
+template <typename Elem, typename Tr, typename ElemA, typename ByteT, typename ByteAT>
+struct Value<basic_gz_index_istream<Elem, Tr, ElemA, ByteT, ByteAT> > :
+    Value<std::basic_istream<Elem, Tr> > {};
+
+template <typename Elem, typename Tr, typename ElemA, typename ByteT, typename ByteAT>
+struct Position<basic_gz_index_istream<Elem, Tr, ElemA, ByteT, ByteAT> > :
+    Position<std::basic_istream<Elem, Tr> > {};
+
+
 template <typename Elem, typename Tr, typename ElemA, typename ByteT, typename ByteAT>
 SEQAN_CONCEPT_IMPL((basic_bgzf_istream<Elem, Tr, ElemA, ByteT, ByteAT>), (InputStreamConcept));
 
+template <typename Elem, typename Tr, typename ElemA, typename ByteT, typename ByteAT>
+SEQAN_CONCEPT_IMPL((basic_gz_index_istream<Elem, Tr, ElemA, ByteT, ByteAT>), (InputStreamConcept));
+
 template <typename Elem, typename Tr, typename ElemA, typename ByteT, typename ByteAT>
 SEQAN_CONCEPT_IMPL((basic_bgzf_ostream<Elem, Tr, ElemA, ByteT, ByteAT>), (OutputStreamConcept));
 
@@ -212,6 +224,38 @@ struct VirtualStreamContext_<TValue, TDirection, TTraits, Nothing>:
     }
 };
 
+#if SEQAN_HAS_ZLIB
+// special case: bgzf stream with a given number of (de)compression threads
+template <typename TValue, typename TDirection, typename TTraits>
+struct VirtualStreamContext_<TValue, TDirection, TTraits, BgzfFile>:
+    VirtualStreamContextBase_<TValue, TTraits>
+{
+    typename VirtualStreamSwitch_<TValue, TDirection, BgzfFile>::Type stream;
+
+    template <typename TObject>
+    VirtualStreamContext_(TObject &object, size_t numThreads):
+        stream(object, numThreads)
+    {
+        this->streamBuf = stream.rdbuf();
+    }
+};
+
+// special case: gzip file with an access point index, decompressed in parallel
+template <typename TValue, typename TTraits>
+struct VirtualStreamContext_<TValue, Input, TTraits, GZFileIndex>:
+    VirtualStreamContextBase_<TValue, TTraits>
+{
+    basic_gz_index_istream<TValue, TTraits> stream;
+
+    template <typename TObject>
+    VirtualStreamContext_(TObject &object, GZFileIndex const &index):
+        stream(object, index)
+    {
+        this->streamBuf = stream.rdbuf();
+    }
+};
+#endif
+
 // --------------------------------------------------------------------------
 // Class VirtualStream
 // --------------------------------------------------------------------------
@@ -251,6 +295,13 @@ public:
     TVirtualStreamContext   *context;
     TFormat                 format;
 
+    /*!
+     * @var size_t VirtualStream::bgzfThreads;
+     * @brief The number of threads (de)compressing a BGZF stream opened afterwards, 0 to use the global
+     *        @link setBgzfThreads @endlink setting (default).
+     */
+    size_t                  bgzfThreads;
+
     /*!
      * @fn VirtualStream::VirtualStream
      * @brief Default constructor and construction from stream, stream buffer, or filename.
@@ -268,19 +319,22 @@ public:
     VirtualStream():
         TStream(NULL),
         streamBuf(),
-        context()
+        context(),
+        bgzfThreads(0)
     {}
 
     VirtualStream(TStreamBuffer &streamBuf):
         TStream(NULL),
         streamBuf(streamBuf),
-        context()
+        context(),
+        bgzfThreads(0)
     {}
 
     VirtualStream(TStream &stream):
         TStream(NULL),
         streamBuf(),
-        context()
+        context(),
+        bgzfThreads(0)
     {
         open(*this, stream);
     }
@@ -289,7 +343,8 @@ public:
                   int openMode = DefaultOpenMode<VirtualStream>::VALUE):
         TStream(NULL),
         streamBuf(),
-        context()
+        context(),
+        bgzfThreads(0)
     {
         open(*this, fileName, openMode);
     }
@@ -434,8 +489,11 @@ struct VirtualStreamFactoryContext_<VirtualStream<TValue, TDirection, TTraits> >
     typedef typename TVirtualStream::TStream            TStream;
 
     TStream &stream;
-    VirtualStreamFactoryContext_(TStream &stream):
-        stream(stream) {}
+    size_t bgzfThreads;
+
+    VirtualStreamFactoryContext_(TStream &stream, size_t bgzfThreads):
+        stream(stream),
+        bgzfThreads(bgzfThreads) {}
 };
 
 template <typename TVirtualStream>
@@ -460,6 +518,24 @@ tagApply(VirtualStreamFactoryContext_<VirtualStream<TValue, TDirection, TTraits>
     return new VirtualStreamContext_<TValue, TDirection, TTraits, Tag<TFormat> >(ctx.stream);
 }
 
+#if SEQAN_HAS_ZLIB
+template <typename TValue, typename TTraits>
+inline VirtualStreamContextBase_<TValue, TTraits> *
+tagApply(VirtualStreamFactoryContext_<VirtualStream<TValue, Input, TTraits> > &ctx, BgzfFile)
+{
+    size_t numThreads = (ctx.bgzfThreads != 0) ? ctx.bgzfThreads : bgzfDecompressionThreads();
+    return new VirtualStreamContext_<TValue, Input, TTraits, BgzfFile>(ctx.stream, numThreads);
+}
+
+template <typename TValue, typename TTraits>
+inline VirtualStreamContextBase_<TValue, TTraits> *
+tagApply(VirtualStreamFactoryContext_<VirtualStream<TValue, Output, TTraits> > &ctx, BgzfFile)
+{
+    size_t numThreads = (ctx.bgzfThreads != 0) ? ctx.bgzfThreads : bgzfCompressionThreads();
+    return new VirtualStreamContext_<TValue, Output, TTraits, BgzfFile>(ctx.stream, numThreads);
+}
+#endif
+
 // ----------------------------------------------------------------------------
 // _guessFormat wrapper
 // ----------------------------------------------------------------------------
@@ -565,7 +641,7 @@ open(VirtualStream<TValue, TDirection, TTraits> &stream, TStream &fileStream, TC
         return open(stream, stream.bufferedStream, compressionType);
     }
 
-    VirtualStreamFactoryContext_<TVirtualStream> ctx(fileStream);
+    VirtualStreamFactoryContext_<TVirtualStream> ctx(fileStream, stream.bgzfThreads);
 
     // try to detect/verify format
     if (!_guessFormat(stream, fileStream, compressionType))
@@ -601,6 +677,39 @@ open(VirtualStream<TValue, Input> &stream, TStream &fileStream)
     return open(stream, fileStream, stream.format);
 }
 
+// --------------------------------------------------------------------------
+// Function _openIndexedContext()
+// --------------------------------------------------------------------------
+
+// Use the access point index stored next to a gzip file (if any) to decompress it in parallel.
+
+template <typename TValue, typename TDirection, typename TTraits>
+inline typename VirtualStream<TValue, TDirection, TTraits>::TVirtualStreamContext *
+_openIndexedContext(VirtualStream<TValue, TDirection, TTraits> &, const char *)
+{
+    return NULL;
+}
+
+#if SEQAN_HAS_ZLIB
+template <typename TValue, typename TTraits>
+inline typename VirtualStream<TValue, Input, TTraits>::TVirtualStreamContext *
+_openIndexedContext(VirtualStream<TValue, Input, TTraits> &stream, const char *fileName)
+{
+    if (!isEqual(stream.format, GZFile()))
+        return NULL;
+
+    GZFileIndex index;
+    if (!open(index, toCString(getIndexFileName(index, fileName))))
+        return NULL;
+
+    // the index must belong to the file
+    if (!_gzFileIndexMatches(index, fileName))
+        return NULL;
+
+    return new VirtualStreamContext_<TValue, Input, TTraits, GZFileIndex>(stream.file, index);
+}
+#endif
+
 template <typename TValue, typename TDirection, typename TTraits>
 inline bool
 open(VirtualStream<TValue, TDirection, TTraits> &stream,
@@ -618,14 +727,20 @@ open(VirtualStream<TValue, TDirection, TTraits> &stream,
     assign(stream.format, typename StreamFormat<TVirtualStream>::Type());
 
     if (IsSameType<TDirection, Input>::VALUE && _isPipe(fileName))
+    {
         open(stream, stream.file, stream.format);               // read from a pipe (without file extension)
+    }
     else
+    {
         guessFormatFromFilename(fileName, stream.format);       // read/write from/to a file (with extension)
+        stream.context = _openIndexedContext(stream, fileName);
+    }
 
-    VirtualStreamFactoryContext_<TVirtualStream> ctx(stream.file);
+    VirtualStreamFactoryContext_<TVirtualStream> ctx(stream.file, stream.bgzfThreads);
 
     // create a new (un)zipper buffer
-    stream.context = tagApply(ctx, stream.format);
+    if (stream.context == NULL)
+        stream.context = tagApply(ctx, stream.format);
     if (stream.context == NULL)
     {
         close(stream.file);
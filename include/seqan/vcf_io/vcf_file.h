@@ -209,6 +209,120 @@ readRecord(VcfRecord & record, FormattedFile<Vcf, Input, TSpec> & file)
     readRecord(record, context(file), file.iter, file.format);
 }
 
+// ----------------------------------------------------------------------------
+// Function readRecords(); VcfRecord
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn VcfFileIn#readRecords
+ * @brief Read a batch of @link VcfRecord @endlink objects from a @link VcfFileIn @endlink.
+ *
+ * @signature TSize readRecords(records, vcfFileIn, maxRecords[, numThreads]);
+ *
+ * @param[out]    records    A @link ContainerConcept container @endlink of @link VcfRecord @endlink objects.
+ *                           It is resized to hold at least <tt>maxRecords</tt> records.
+ * @param[in,out] vcfFileIn  The @link VcfFileIn @endlink to read from.
+ * @param[in]     maxRecords The maximal number of records to read.
+ * @param[in]     numThreads The number of threads parsing the records, defaults to 1.
+ *
+ * @return TSize The number of records read, they are stored in file order at the beginning of <tt>records</tt>.
+ *
+ * The record lines are split off the input sequentially, then they are parsed concurrently.  The contig names are
+ * looked up in thread-private name stores and translated into the ids of the file context afterwards, in file order,
+ * so contigs that are not declared in the header get the same ids as with sequential reading.
+ *
+ * @throw IOError On low-level I/O errors.
+ * @throw ParseError On high-level file format errors.
+ *
+ * If parsing fails for several records, the exception of the first failing record is rethrown.
+ */
+
+template <typename TRecords, typename TSpec, typename TSize>
+inline SEQAN_FUNC_ENABLE_IF(And<IsSameType<typename Value<TRecords>::Type, VcfRecord>,
+                                IsInteger<TSize> >, TSize)
+readRecords(TRecords & records, FormattedFile<Vcf, Input, TSpec> & file, TSize maxRecords, unsigned numThreads)
+{
+    typedef typename FormattedFileContext<FormattedFile<Vcf, Input, TSpec>, Dependent<> >::Type TContext;
+    typedef typename TContext::TNameStore                                                       TNameStore;
+    typedef typename TContext::TNameStoreCache                                                  TNameStoreCache;
+
+    String<CharString> & buffers = context(file).buffers;
+    if (static_cast<TSize>(length(buffers)) < maxRecords)
+        resize(buffers, maxRecords, Exact());
+    if (static_cast<TSize>(length(records)) < maxRecords)
+        resize(records, maxRecords, Exact());
+
+    TSize numRecords = 0;
+    for (; numRecords < maxRecords && !atEnd(file.iter); ++numRecords)
+    {
+        CharString & buffer = buffers[numRecords];
+        clear(buffer);
+        readLine(buffer, file.iter);
+        appendValue(buffer, '\n');
+    }
+
+    String<TNameStore> threadNames;
+    String<unsigned> recordThread;
+    resize(threadNames, std::max(numThreads, 1u));
+    resize(recordThread, numRecords, Exact());
+
+    FirstException_ firstError;
+
+    SEQAN_OMP_PRAGMA(parallel num_threads(numThreads))
+    {
+        // readRecord() uses the buffer of the context, so each thread needs its own context.
+        // It shares the sample names with the file context but looks up contig names in a private store.
+        unsigned threadId = omp_get_thread_num();
+        TNameStoreCache threadNamesCache(threadNames[threadId]);
+        TContext threadContext(context(file));
+        setContigNames(threadContext, threadNames[threadId]);
+        setContigNamesCache(threadContext, threadNamesCache);
+
+        SEQAN_OMP_PRAGMA(for schedule(dynamic, 64))
+        for (int i = 0; i < (int)numRecords; ++i)
+        {
+            SEQAN_TRY
+            {
+                CharIterator bufIter = begin(buffers[i]);
+                readRecord(records[i], threadContext, bufIter, file.format);
+                recordThread[i] = threadId;
+            }
+            SEQAN_CATCH(...)
+            {
+                SEQAN_OMP_PRAGMA(critical (readRecordsError))
+                _captureException(firstError, i);
+            }
+        }
+    }
+
+    _rethrowException(firstError);
+
+    // Translate the thread-local ids in file order, nameToId() appends unknown names like sequential reading.
+    String<String<__int32> > threadToGlobal;
+    resize(threadToGlobal, length(threadNames));
+    for (unsigned t = 0; t < length(threadNames); ++t)
+        resize(threadToGlobal[t], length(threadNames[t]), -1, Exact());
+
+    for (TSize i = 0; i < numRecords; ++i)
+    {
+        VcfRecord & record = records[i];
+        String<__int32> & toGlobal = threadToGlobal[recordThread[i]];
+        if (toGlobal[record.rID] < 0)
+            toGlobal[record.rID] = nameToId(contigNamesCache(context(file)), threadNames[recordThread[i]][record.rID]);
+        record.rID = toGlobal[record.rID];
+    }
+
+    return numRecords;
+}
+
+template <typename TRecords, typename TSpec, typename TSize>
+inline SEQAN_FUNC_ENABLE_IF(And<IsSameType<typename Value<TRecords>::Type, VcfRecord>,
+                                IsInteger<TSize> >, TSize)
+readRecords(TRecords & records, FormattedFile<Vcf, Input, TSpec> & file, TSize maxRecords)
+{
+    return readRecords(records, file, maxRecords, 1u);
+}
+
 // ----------------------------------------------------------------------------
 // Function writeHeader(); VcfHeader
 // ----------------------------------------------------------------------------
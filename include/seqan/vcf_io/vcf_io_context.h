@@ -88,6 +88,7 @@ public:
     TNameStoreCacheMember   _sampleNamesCache;
 
     CharString              buffer;
+    String<CharString>      buffers;
 
     VcfIOContext() :
         _contigNames(TNameStoreMember()),
@@ -157,6 +158,13 @@ contigNames(VcfIOContext<TNameStore, TNameStoreCache, TStorageSpec> const & cont
     return _referenceCast<TNameStore &>(context._contigNames);
 }
 
+template <typename TNameStore, typename TNameStoreCache>
+inline void
+setContigNames(VcfIOContext<TNameStore, TNameStoreCache, Dependent<> > & context, TNameStore & contigNames)
+{
+    context._contigNames = &contigNames;
+}
+
 /*!
  * @fn VcfIOContext#contigNamesCache
  * @brief Return reference to contig names cache from @link VcfIOContext @endlink.
@@ -182,6 +190,14 @@ contigNamesCache(VcfIOContext<TNameStore, TNameStoreCache, TStorageSpec> const &
     return _referenceCast<TNameStoreCache &>(context._contigNamesCache);
 }
 
+template <typename TNameStore, typename TNameStoreCache>
+inline void
+setContigNamesCache(VcfIOContext<TNameStore, TNameStoreCache, Dependent<> > & context,
+                    TNameStoreCache & contigNamesCache)
+{
+    context._contigNamesCache = &contigNamesCache;
+}
+
 /*!
  * @fn VcfIOContext#sampleNames
  * @brief Return reference to the sample names from @link VcfIOContext @endlink.
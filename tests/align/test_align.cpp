@@ -59,6 +59,8 @@
 #include "test_alignment_algorithms_local_banded.h"
 #include "test_alignment_algorithms_dynamic_gap.h"
 #include "test_align_global_alignment_specialized.h"
+#include "test_align_simd.h"
+#include "test_align_striped.h"
 
 #include "test_align_alignment_operations.h"
 #include "test_evaluate_alignment.h"
@@ -628,6 +630,24 @@ SEQAN_BEGIN_TESTSUITE(test_align)
     SEQAN_CALL_TEST(test_align_stream_align_write);
     SEQAN_CALL_TEST(test_align_stream_align_stream);
 
+    // -----------------------------------------------------------------------
+    // Test Alignment Scores of Many Pairs (without SIMD).
+    // -----------------------------------------------------------------------
+
+    SEQAN_CALL_TEST(test_align_simd_global_linear);
+    SEQAN_CALL_TEST(test_align_simd_global_affine);
+    SEQAN_CALL_TEST(test_align_simd_global_long);
+    SEQAN_CALL_TEST(test_align_simd_local);
+
+    // -----------------------------------------------------------------------
+    // Test Striped Alignment Scores (without SIMD).
+    // -----------------------------------------------------------------------
+
+    SEQAN_CALL_TEST(test_align_striped_global_linear);
+    SEQAN_CALL_TEST(test_align_striped_global_affine);
+    SEQAN_CALL_TEST(test_align_striped_global_long);
+    SEQAN_CALL_TEST(test_align_striped_local);
+
     // -----------------------------------------------------------------------
     // Test Alignment Evaluation
     // -----------------------------------------------------------------------
@@ -0,0 +1,187 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2015, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Tests for the computation of the scores of many independent alignments.
+// The results are compared with the scores of the alignments computed one by
+// one.  The tests are run both with and without SIMD instructions enabled.
+// ==========================================================================
+
+#ifndef TESTS_ALIGN_TEST_ALIGN_SIMD_H_
+#define TESTS_ALIGN_TEST_ALIGN_SIMD_H_
+
+#include <seqan/basic.h>
+#include <seqan/align.h>
+#include <seqan/score.h>
+
+// Fills the sets with numPairs random pairs of length in [minLength, maxLength].
+// Every second vertical sequence is a mutated copy of the horizontal one.
+template <typename TString>
+void testAlignSimdGenerateSets(seqan::StringSet<TString> & setH,
+                               seqan::StringSet<TString> & setV,
+                               unsigned numPairs,
+                               unsigned minLength,
+                               unsigned maxLength,
+                               unsigned seed)
+{
+    using namespace seqan;
+    typedef typename Value<TString>::Type TAlphabet;
+
+    unsigned const alphSize = ValueSize<TAlphabet>::VALUE;
+    __uint64 state = seed;
+    clear(setH);
+    clear(setV);
+    for (unsigned i = 0; i < numPairs; ++i)
+    {
+        TString seqH, seqV;
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        unsigned lenH = minLength + (unsigned)(state >> 33) % (maxLength - minLength + 1);
+        for (unsigned j = 0; j < lenH; ++j)
+        {
+            state = state * 6364136223846793005ull + 1442695040888963407ull;
+            appendValue(seqH, TAlphabet((unsigned)(state >> 33) % alphSize));
+        }
+
+        if (i % 2 == 0)
+        {
+            for (unsigned j = 0; j < lenH; ++j)
+            {
+                state = state * 6364136223846793005ull + 1442695040888963407ull;
+                unsigned r = (unsigned)(state >> 33) % 20;
+                if (r == 0)  // deletion
+                    continue;
+                if (r == 1)  // insertion
+                    appendValue(seqV, TAlphabet((unsigned)(state >> 40) % alphSize));
+                if (r == 2)  // substitution
+                    appendValue(seqV, TAlphabet((unsigned)(state >> 45) % alphSize));
+                else
+                    appendValue(seqV, seqH[j]);
+            }
+        }
+        else
+        {
+            state = state * 6364136223846793005ull + 1442695040888963407ull;
+            unsigned lenV = minLength + (unsigned)(state >> 33) % (maxLength - minLength + 1);
+            for (unsigned j = 0; j < lenV; ++j)
+            {
+                state = state * 6364136223846793005ull + 1442695040888963407ull;
+                appendValue(seqV, TAlphabet((unsigned)(state >> 33) % alphSize));
+            }
+        }
+        appendValue(setH, seqH);
+        appendValue(setV, seqV);
+    }
+}
+
+template <typename TString, typename TScore, typename TAlignConfig>
+void testAlignSimdGlobal(TScore const & scoringScheme, TAlignConfig const & alignConfig, unsigned minLength,
+                         unsigned maxLength)
+{
+    using namespace seqan;
+    typedef typename Value<TScore>::Type TScoreValue;
+
+    StringSet<TString> setH, setV;
+    testAlignSimdGenerateSets(setH, setV, 37, minLength, maxLength, 42);
+
+    String<TScoreValue> scores = globalAlignmentScore(setH, setV, scoringScheme, alignConfig);
+    SEQAN_ASSERT_EQ(length(scores), length(setH));
+    for (unsigned i = 0; i < length(setH); ++i)
+        SEQAN_ASSERT_EQ(scores[i], globalAlignmentScore(setH[i], setV[i], scoringScheme, alignConfig));
+}
+
+template <typename TString, typename TScore>
+void testAlignSimdLocal(TScore const & scoringScheme, unsigned minLength, unsigned maxLength)
+{
+    using namespace seqan;
+    typedef typename Value<TScore>::Type TScoreValue;
+
+    StringSet<TString> setH, setV;
+    testAlignSimdGenerateSets(setH, setV, 37, minLength, maxLength, 23);
+
+    String<TScoreValue> scores = localAlignmentScore(setH, setV, scoringScheme);
+    SEQAN_ASSERT_EQ(length(scores), length(setH));
+    for (unsigned i = 0; i < length(setH); ++i)
+    {
+        Align<TString> align;
+        resize(rows(align), 2);
+        assignSource(row(align, 0), setH[i]);
+        assignSource(row(align, 1), setV[i]);
+        SEQAN_ASSERT_EQ(scores[i], localAlignment(align, scoringScheme));
+        SEQAN_ASSERT_EQ(scores[i], localAlignmentScore(setH[i], setV[i], scoringScheme));
+    }
+}
+
+SEQAN_DEFINE_TEST(test_align_simd_global_linear)
+{
+    using namespace seqan;
+
+    Score<int, Simple> scoringScheme(2, -3, -2);
+    testAlignSimdGlobal<DnaString>(scoringScheme, AlignConfig<>(), 1, 40);
+    testAlignSimdGlobal<DnaString>(scoringScheme, AlignConfig<true, false, false, true>(), 1, 40);
+    testAlignSimdGlobal<DnaString>(scoringScheme, AlignConfig<false, true, true, false>(), 1, 40);
+    testAlignSimdGlobal<DnaString>(scoringScheme, AlignConfig<true, true, true, true>(), 1, 40);
+
+    testAlignSimdGlobal<Peptide>(Blosum62(-4), AlignConfig<>(), 1, 60);
+    testAlignSimdGlobal<Peptide>(Blosum62(-4), AlignConfig<true, true, true, true>(), 1, 60);
+}
+
+SEQAN_DEFINE_TEST(test_align_simd_global_affine)
+{
+    using namespace seqan;
+
+    Score<int, Simple> scoringScheme(2, -3, -1, -5);
+    testAlignSimdGlobal<Dna5String>(scoringScheme, AlignConfig<>(), 1, 40);
+    testAlignSimdGlobal<Dna5String>(scoringScheme, AlignConfig<true, false, false, true>(), 1, 40);
+    testAlignSimdGlobal<Dna5String>(scoringScheme, AlignConfig<false, true, true, false>(), 1, 40);
+    testAlignSimdGlobal<Dna5String>(scoringScheme, AlignConfig<true, true, true, true>(), 1, 40);
+
+    testAlignSimdGlobal<Peptide>(Blosum62(-1, -11), AlignConfig<>(), 1, 60);
+    testAlignSimdGlobal<Peptide>(Blosum62(-1, -11), AlignConfig<true, true, true, true>(), 1, 60);
+}
+
+SEQAN_DEFINE_TEST(test_align_simd_global_long)
+{
+    using namespace seqan;
+
+    // The scores exceed the range of 16 bit lanes.
+    Score<int, Simple> scoringScheme(20, -30, -10, -50);
+    testAlignSimdGlobal<DnaString>(scoringScheme, AlignConfig<>(), 300, 500);
+}
+
+SEQAN_DEFINE_TEST(test_align_simd_local)
+{
+    using namespace seqan;
+
+    testAlignSimdLocal<DnaString>(Score<int, Simple>(2, -3, -2), 1, 40);
+    testAlignSimdLocal<Dna5String>(Score<int, Simple>(2, -3, -1, -5), 1, 40);
+    testAlignSimdLocal<Peptide>(Blosum62(-1, -11), 1, 60);
+}
+
+#endif  // #ifndef TESTS_ALIGN_TEST_ALIGN_SIMD_H_
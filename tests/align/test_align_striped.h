@@ -0,0 +1,126 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2015, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Tests for Farrar's striped SIMD algorithm.  The scores are compared with
+// the scores computed by the standard DP algorithm.
+// ==========================================================================
+
+#ifndef TESTS_ALIGN_TEST_ALIGN_STRIPED_H_
+#define TESTS_ALIGN_TEST_ALIGN_STRIPED_H_
+
+#include <seqan/basic.h>
+#include <seqan/align.h>
+#include <seqan/score.h>
+
+#include "test_align_simd.h"
+
+template <typename TString, typename TScore, typename TAlignConfig>
+void testAlignStripedGlobal(TScore const & scoringScheme, TAlignConfig const & alignConfig, unsigned minLength,
+                            unsigned maxLength)
+{
+    using namespace seqan;
+    typedef typename Value<TScore>::Type TScoreValue;
+
+    StringSet<TString> setH, setV;
+    testAlignSimdGenerateSets(setH, setV, 12, minLength, maxLength, 7);
+
+    for (unsigned i = 0; i < length(setH); ++i)
+    {
+        TScoreValue res = globalAlignmentScore(setH[i], setV[i], scoringScheme, alignConfig, Farrar());
+        SEQAN_ASSERT_EQ(res, globalAlignmentScore(setH[i], setV[i], scoringScheme, alignConfig));
+    }
+}
+
+template <typename TString, typename TScore>
+void testAlignStripedLocal(TScore const & scoringScheme, unsigned minLength, unsigned maxLength)
+{
+    using namespace seqan;
+    typedef typename Value<TScore>::Type TScoreValue;
+
+    StringSet<TString> setH, setV;
+    testAlignSimdGenerateSets(setH, setV, 12, minLength, maxLength, 11);
+
+    for (unsigned i = 0; i < length(setH); ++i)
+    {
+        TScoreValue res = localAlignmentScore(setH[i], setV[i], scoringScheme, Farrar());
+        SEQAN_ASSERT_EQ(res, localAlignmentScore(setH[i], setV[i], scoringScheme));
+    }
+}
+
+SEQAN_DEFINE_TEST(test_align_striped_global_linear)
+{
+    using namespace seqan;
+
+    Score<int, Simple> scoringScheme(2, -3, -2);
+    testAlignStripedGlobal<DnaString>(scoringScheme, AlignConfig<>(), 1, 20);
+    testAlignStripedGlobal<DnaString>(scoringScheme, AlignConfig<>(), 100, 300);
+    testAlignStripedGlobal<DnaString>(scoringScheme, AlignConfig<true, false, false, true>(), 1, 300);
+    testAlignStripedGlobal<DnaString>(scoringScheme, AlignConfig<false, true, true, false>(), 1, 300);
+    testAlignStripedGlobal<DnaString>(scoringScheme, AlignConfig<true, true, true, true>(), 1, 300);
+
+    testAlignStripedGlobal<Peptide>(Blosum62(-4), AlignConfig<>(), 1, 200);
+    testAlignStripedGlobal<Peptide>(Blosum62(-4), AlignConfig<true, true, true, true>(), 1, 200);
+}
+
+SEQAN_DEFINE_TEST(test_align_striped_global_affine)
+{
+    using namespace seqan;
+
+    Score<int, Simple> scoringScheme(2, -3, -1, -5);
+    testAlignStripedGlobal<Dna5String>(scoringScheme, AlignConfig<>(), 1, 20);
+    testAlignStripedGlobal<Dna5String>(scoringScheme, AlignConfig<>(), 100, 300);
+    testAlignStripedGlobal<Dna5String>(scoringScheme, AlignConfig<true, false, false, true>(), 1, 300);
+    testAlignStripedGlobal<Dna5String>(scoringScheme, AlignConfig<false, true, true, false>(), 1, 300);
+    testAlignStripedGlobal<Dna5String>(scoringScheme, AlignConfig<true, true, true, true>(), 1, 300);
+
+    testAlignStripedGlobal<Peptide>(Blosum62(-1, -11), AlignConfig<>(), 1, 200);
+    testAlignStripedGlobal<Peptide>(Blosum62(-1, -11), AlignConfig<true, true, true, true>(), 1, 200);
+}
+
+SEQAN_DEFINE_TEST(test_align_striped_global_long)
+{
+    using namespace seqan;
+
+    // The scores exceed the range of 8 and 16 bit lanes.
+    testAlignStripedGlobal<DnaString>(Score<int, Simple>(20, -30, -10, -50), AlignConfig<>(), 1000, 2000);
+}
+
+SEQAN_DEFINE_TEST(test_align_striped_local)
+{
+    using namespace seqan;
+
+    testAlignStripedLocal<DnaString>(Score<int, Simple>(2, -3, -2), 1, 300);
+    testAlignStripedLocal<Dna5String>(Score<int, Simple>(2, -3, -1, -5), 1, 300);
+    testAlignStripedLocal<Dna5String>(Score<int, Simple>(2, -3, -1, -5), 1000, 2000);
+    testAlignStripedLocal<Peptide>(Blosum62(-1, -11), 1, 200);
+}
+
+#endif  // #ifndef TESTS_ALIGN_TEST_ALIGN_STRIPED_H_
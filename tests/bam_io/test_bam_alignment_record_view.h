@@ -0,0 +1,207 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2015, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Tests for the BamAlignmentRecordView.
+// ==========================================================================
+
+#ifndef TESTS_BAM_IO_TEST_BAM_ALIGNMENT_RECORD_VIEW_H_
+#define TESTS_BAM_IO_TEST_BAM_ALIGNMENT_RECORD_VIEW_H_
+
+#include <seqan/basic.h>
+#include <seqan/sequence.h>
+
+#include <seqan/bam_io.h>
+
+// Read a file with BamAlignmentRecords and BamAlignmentRecordViews in parallel and compare the results.
+void testBamIOBamAlignmentRecordViewRead(char const * pathFragment)
+{
+    seqan::CharString filePath = SEQAN_PATH_TO_ROOT();
+    append(filePath, pathFragment);
+
+    seqan::BamFileIn recordFile(toCString(filePath));
+    seqan::BamFileIn viewFile(toCString(filePath));
+    seqan::BamHeader header;
+    readHeader(header, recordFile);
+    readHeader(header, viewFile);
+
+    seqan::BamAlignmentRecord record;
+    seqan::BamAlignmentRecord decoded;
+    seqan::BamAlignmentRecordView view;
+    seqan::String<seqan::CigarElement<> > cigar;
+    seqan::Dna5String seq;
+    seqan::CharString qual;
+    unsigned numRecords = 0;
+    while (!atEnd(recordFile))
+    {
+        SEQAN_ASSERT_NOT(atEnd(viewFile));
+        readRecord(record, recordFile);
+        readRecord(view, viewFile);
+        ++numRecords;
+
+        SEQAN_ASSERT_EQ(view.rID, record.rID);
+        SEQAN_ASSERT_EQ(view.beginPos, record.beginPos);
+        SEQAN_ASSERT_EQ(view.mapQ, record.mapQ);
+        SEQAN_ASSERT_EQ(view.flag, record.flag);
+        SEQAN_ASSERT_EQ(view.rNextId, record.rNextId);
+        SEQAN_ASSERT_EQ(view.pNext, record.pNext);
+        SEQAN_ASSERT_EQ(view.tLen, record.tLen);
+        SEQAN_ASSERT_EQ(hasFlagUnmapped(view), hasFlagUnmapped(record));
+        SEQAN_ASSERT_EQ(hasFlagRC(view), hasFlagRC(record));
+        SEQAN_ASSERT_EQ(getAlignmentLengthInRef(view), getAlignmentLengthInRef(record));
+
+        SEQAN_ASSERT_EQ(seqan::CharString(getQName(view)), record.qName);
+        SEQAN_ASSERT_EQ(seqan::CharString(getTags(view)), record.tags);
+        getCigar(cigar, view);
+        SEQAN_ASSERT(cigar == record.cigar);
+        getSeq(seq, view);
+        SEQAN_ASSERT_EQ(seq, seqan::Dna5String(record.seq));
+        getQual(qual, view);
+        SEQAN_ASSERT_EQ(qual, record.qual);
+
+        assign(decoded, view);
+        SEQAN_ASSERT_EQ(decoded.qName, record.qName);
+        SEQAN_ASSERT(decoded.cigar == record.cigar);
+        SEQAN_ASSERT_EQ(decoded.seq, record.seq);
+        SEQAN_ASSERT_EQ(decoded.qual, record.qual);
+        SEQAN_ASSERT_EQ(decoded.tags, record.tags);
+    }
+    SEQAN_ASSERT(atEnd(viewFile));
+    SEQAN_ASSERT_GT(numRecords, 0u);
+}
+
+SEQAN_DEFINE_TEST(test_bam_io_bam_alignment_record_view_sam_read)
+{
+    testBamIOBamAlignmentRecordViewRead("/tests/bam_io/small.sam");
+}
+
+SEQAN_DEFINE_TEST(test_bam_io_bam_alignment_record_view_bam_read)
+{
+    testBamIOBamAlignmentRecordViewRead("/tests/bam_io/small.bam");
+    testBamIOBamAlignmentRecordViewRead("/tests/bam_io/ex1.bam");
+}
+
+SEQAN_DEFINE_TEST(test_bam_io_bam_alignment_record_view_copy)
+{
+    seqan::CharString filePath = SEQAN_PATH_TO_ROOT();
+    append(filePath, "/tests/bam_io/small.sam");
+
+    seqan::BamFileIn bamFile(toCString(filePath));
+    seqan::BamHeader header;
+    readHeader(header, bamFile);
+
+    // A copy of a converted SAM record must not reference the buffer of the original view.
+    seqan::BamAlignmentRecordView view;
+    readRecord(view, bamFile);
+    seqan::CharString qName = getQName(view);
+    seqan::BamAlignmentRecordView copy(view);
+    clear(view);
+    SEQAN_ASSERT_EQ(seqan::CharString(getQName(view)), "");
+    SEQAN_ASSERT_EQ(seqan::CharString(getQName(copy)), qName);
+}
+
+// Copy a file using BamAlignmentRecordViews and compare with the output for BamAlignmentRecords.
+void testBamIOBamAlignmentRecordViewWrite(char const * pathFragment, char const * extension)
+{
+    seqan::CharString filePath = SEQAN_PATH_TO_ROOT();
+    append(filePath, pathFragment);
+
+    seqan::CharString recordPath = SEQAN_TEMP_FILENAME();
+    append(recordPath, extension);
+    seqan::CharString viewPath = SEQAN_TEMP_FILENAME();
+    append(viewPath, extension);
+
+    {
+        seqan::BamHeader header;
+        seqan::BamFileIn bamFileIn(toCString(filePath));
+        seqan::BamFileOut bamFileOut(bamFileIn, toCString(recordPath));
+        readHeader(header, bamFileIn);
+        writeHeader(bamFileOut, header);
+        seqan::BamAlignmentRecord record;
+        while (!atEnd(bamFileIn))
+        {
+            readRecord(record, bamFileIn);
+            writeRecord(bamFileOut, record);
+        }
+    }
+    {
+        seqan::BamHeader header;
+        seqan::BamFileIn bamFileIn(toCString(filePath));
+        seqan::BamFileOut bamFileOut(bamFileIn, toCString(viewPath));
+        readHeader(header, bamFileIn);
+        writeHeader(bamFileOut, header);
+        seqan::BamAlignmentRecordView view;
+        while (!atEnd(bamFileIn))
+        {
+            readRecord(view, bamFileIn);
+            writeRecord(bamFileOut, view);
+        }
+    }
+
+    if (seqan::CharString(extension) == ".sam")
+    {
+        SEQAN_ASSERT(seqan::_compareTextFiles(toCString(recordPath), toCString(viewPath)));
+        return;
+    }
+
+    // BGZF block borders may differ, compare the records.
+    seqan::BamFileIn recordFile(toCString(recordPath));
+    seqan::BamFileIn viewFile(toCString(viewPath));
+    seqan::BamHeader header;
+    readHeader(header, recordFile);
+    readHeader(header, viewFile);
+    seqan::BamAlignmentRecord record1, record2;
+    while (!atEnd(recordFile))
+    {
+        SEQAN_ASSERT_NOT(atEnd(viewFile));
+        readRecord(record1, recordFile);
+        readRecord(record2, viewFile);
+        SEQAN_ASSERT_EQ(record1.rID, record2.rID);
+        SEQAN_ASSERT_EQ(record1.beginPos, record2.beginPos);
+        SEQAN_ASSERT_EQ(record1.bin, record2.bin);
+        SEQAN_ASSERT_EQ(record1.flag, record2.flag);
+        SEQAN_ASSERT_EQ(record1.qName, record2.qName);
+        SEQAN_ASSERT(record1.cigar == record2.cigar);
+        SEQAN_ASSERT_EQ(record1.seq, record2.seq);
+        SEQAN_ASSERT_EQ(record1.qual, record2.qual);
+        SEQAN_ASSERT_EQ(record1.tags, record2.tags);
+    }
+    SEQAN_ASSERT(atEnd(viewFile));
+}
+
+SEQAN_DEFINE_TEST(test_bam_io_bam_alignment_record_view_write)
+{
+    testBamIOBamAlignmentRecordViewWrite("/tests/bam_io/small.sam", ".sam");
+    testBamIOBamAlignmentRecordViewWrite("/tests/bam_io/small.sam", ".bam");
+    testBamIOBamAlignmentRecordViewWrite("/tests/bam_io/ex1.bam", ".sam");
+    testBamIOBamAlignmentRecordViewWrite("/tests/bam_io/ex1.bam", ".bam");
+}
+
+#endif  // TESTS_BAM_IO_TEST_BAM_ALIGNMENT_RECORD_VIEW_H_
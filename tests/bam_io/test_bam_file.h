@@ -35,6 +35,7 @@
 #ifndef TESTS_BAM_IO_TEST_EASY_BAM_IO_H_
 #define TESTS_BAM_IO_TEST_EASY_BAM_IO_H_
 
+#include <fstream>
 #include <sstream>
 
 #include <seqan/basic.h>
@@ -237,6 +238,143 @@ SEQAN_DEFINE_TEST(test_bam_io_bam_file_bam_read_ex1)
     SEQAN_ASSERT_EQ(counts[1], 1806);
 }
 
+// ---------------------------------------------------------------------------
+// Read Records in Batches
+// ---------------------------------------------------------------------------
+
+void testBamIOBamFileReadRecordsBatch(char const * pathFragment, unsigned batchSize, unsigned numThreads)
+{
+    seqan::CharString filePath = SEQAN_PATH_TO_ROOT();
+    append(filePath, pathFragment);
+
+    seqan::BamHeader header;
+    seqan::BamAlignmentRecord record;
+    seqan::String<seqan::BamAlignmentRecord> expected;
+
+    seqan::BamFileIn serialIO(toCString(filePath));
+    readHeader(header, serialIO);
+    while (!atEnd(serialIO))
+    {
+        readRecord(record, serialIO);
+        appendValue(expected, record);
+    }
+
+    seqan::BamFileIn batchIO(toCString(filePath));
+    readHeader(header, batchIO);
+    seqan::String<seqan::BamAlignmentRecord> records;
+    unsigned pos = 0;
+    while (!atEnd(batchIO))
+    {
+        unsigned numRecords = readRecords(records, batchIO, batchSize, numThreads);
+        SEQAN_ASSERT_LEQ(numRecords, batchSize);
+        SEQAN_ASSERT_LEQ(pos + numRecords, length(expected));
+        for (unsigned i = 0; i < numRecords; ++i, ++pos)
+        {
+            SEQAN_ASSERT_EQ(records[i].qName, expected[pos].qName);
+            SEQAN_ASSERT_EQ(records[i].flag, expected[pos].flag);
+            SEQAN_ASSERT_EQ(records[i].rID, expected[pos].rID);
+            SEQAN_ASSERT_EQ(records[i].beginPos, expected[pos].beginPos);
+            SEQAN_ASSERT_EQ(records[i].mapQ, expected[pos].mapQ);
+            SEQAN_ASSERT_EQ(length(records[i].cigar), length(expected[pos].cigar));
+            SEQAN_ASSERT_EQ(records[i].rNextId, expected[pos].rNextId);
+            SEQAN_ASSERT_EQ(records[i].pNext, expected[pos].pNext);
+            SEQAN_ASSERT_EQ(records[i].tLen, expected[pos].tLen);
+            SEQAN_ASSERT_EQ(records[i].seq, expected[pos].seq);
+            SEQAN_ASSERT_EQ(records[i].qual, expected[pos].qual);
+            SEQAN_ASSERT_EQ(records[i].tags, expected[pos].tags);
+        }
+    }
+    SEQAN_ASSERT_EQ(pos, length(expected));
+}
+
+SEQAN_DEFINE_TEST(test_bam_io_bam_file_sam_read_records_batch)
+{
+    testBamIOBamFileReadRecordsBatch("/tests/bam_io/small.sam", 2, 1);
+    testBamIOBamFileReadRecordsBatch("/tests/bam_io/small.sam", 2, 4);
+}
+
+SEQAN_DEFINE_TEST(test_bam_io_bam_file_bam_read_records_batch)
+{
+    testBamIOBamFileReadRecordsBatch("/tests/bam_io/ex1.bam", 1000, 1);
+    testBamIOBamFileReadRecordsBatch("/tests/bam_io/ex1.bam", 1000, 4);
+}
+
+// Contigs missing in the header must get the same ids as with sequential reading, the first bad record must fail.
+
+void testBamIOBamFileReadRecordsBatchNames(unsigned numThreads)
+{
+    seqan::CharString tmpPath = SEQAN_TEMP_FILENAME();
+    append(tmpPath, ".sam");
+    {
+        std::ofstream out(toCString(tmpPath), std::ios::binary);
+        out << "@HD\tVN:1.3\n@SQ\tSN:REFERENCE\tLN:10000\n";
+        for (unsigned i = 0; i < 500; ++i)
+        {
+            out << "READ" << i << "\t1\t";
+            if (i % 5 == 0)
+                out << "REFERENCE";
+            else
+                out << "CTG" << (i * 7) % 31;
+            out << "\t" << i + 1 << "\t8\t4M\tCTG" << (i * 11) % 37 << "\t1\t0\tACGT\t!!!!\n";
+        }
+        out << "BAD1\t1\tREFERENCE\tx\t8\t4M\t*\t0\t0\tACGT\t!!!!\n";
+        out << "BAD2\t1\tREFERENCE\t1\t8\t4M\t*\t0\t0\tACGT\t!!!!\n";
+        out << "BAD3\t1\tREFERENCE\ty\t8\t4M\t*\t0\t0\tACGT\t!!!!\n";
+    }
+
+    seqan::BamHeader header;
+    seqan::BamAlignmentRecord record;
+    seqan::String<seqan::BamAlignmentRecord> expected;
+    std::string expectedError;
+
+    seqan::BamFileIn serialIO(toCString(tmpPath));
+    readHeader(header, serialIO);
+    try
+    {
+        while (!atEnd(serialIO))
+        {
+            readRecord(record, serialIO);
+            appendValue(expected, record);
+        }
+    }
+    catch (seqan::ParseError const & e)
+    {
+        expectedError = e.what();
+    }
+    SEQAN_ASSERT_EQ(length(expected), 500u);
+    SEQAN_ASSERT_NOT(expectedError.empty());
+
+    seqan::BamFileIn batchIO(toCString(tmpPath));
+    readHeader(header, batchIO);
+    seqan::String<seqan::BamAlignmentRecord> records;
+    unsigned numRecords = readRecords(records, batchIO, 500u, numThreads);
+    SEQAN_ASSERT_EQ(numRecords, 500u);
+    for (unsigned i = 0; i < numRecords; ++i)
+    {
+        SEQAN_ASSERT_EQ(records[i].qName, expected[i].qName);
+        SEQAN_ASSERT_EQ(records[i].rID, expected[i].rID);
+        SEQAN_ASSERT_EQ(records[i].rNextId, expected[i].rNextId);
+    }
+    SEQAN_ASSERT(contigNames(context(batchIO)) == contigNames(context(serialIO)));
+
+    std::string error;
+    try
+    {
+        readRecords(records, batchIO, 10u, numThreads);
+    }
+    catch (seqan::ParseError const & e)
+    {
+        error = e.what();
+    }
+    SEQAN_ASSERT_EQ(error, expectedError);
+}
+
+SEQAN_DEFINE_TEST(test_bam_io_bam_file_sam_read_records_batch_names)
+{
+    testBamIOBamFileReadRecordsBatchNames(1);
+    testBamIOBamFileReadRecordsBatchNames(4);
+}
+
 // ---------------------------------------------------------------------------
 // Write Header
 // ---------------------------------------------------------------------------
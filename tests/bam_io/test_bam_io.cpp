@@ -49,6 +49,8 @@
 #if SEQAN_HAS_ZLIB
 #include "test_bam_index.h"
 #include "test_bam_file.h"
+#include "test_bam_alignment_record_view.h"
+#include "test_bam_sort.h"
 #endif
 
 SEQAN_BEGIN_TESTSUITE(test_bam_io)
@@ -78,6 +80,7 @@ SEQAN_BEGIN_TESTSUITE(test_bam_io)
     // Test BamIoContext.
     SEQAN_CALL_TEST(test_bam_io_bam_io_context_standalone);
     SEQAN_CALL_TEST(test_bam_io_bam_io_context_fragment_store);
+    SEQAN_CALL_TEST(test_bam_io_bam_io_context_hash_cache);
 
     // Test BAM<->SAM tag conversion.
     SEQAN_CALL_TEST(test_assign_tags_bam_to_sam_two_tags);
@@ -161,6 +164,8 @@ SEQAN_BEGIN_TESTSUITE(test_bam_io)
     SEQAN_CALL_TEST(test_bam_io_bam_file_sam_file_size);
     SEQAN_CALL_TEST(test_bam_io_bam_file_sam_read_header);
     SEQAN_CALL_TEST(test_bam_io_bam_file_sam_read_records);
+    SEQAN_CALL_TEST(test_bam_io_bam_file_sam_read_records_batch);
+    SEQAN_CALL_TEST(test_bam_io_bam_file_sam_read_records_batch_names);
     SEQAN_CALL_TEST(test_bam_io_bam_file_sam_write_header);
     SEQAN_CALL_TEST(test_bam_io_bam_file_sam_write_records);
 
@@ -168,6 +173,7 @@ SEQAN_BEGIN_TESTSUITE(test_bam_io)
     SEQAN_CALL_TEST(test_bam_io_bam_file_bam_read_header);
     SEQAN_CALL_TEST(test_bam_io_bam_file_bam_read_records);
     SEQAN_CALL_TEST(test_bam_io_bam_file_bam_read_ex1);
+    SEQAN_CALL_TEST(test_bam_io_bam_file_bam_read_records_batch);
     SEQAN_CALL_TEST(test_bam_io_bam_file_bam_write_header);
     SEQAN_CALL_TEST(test_bam_io_bam_file_bam_write_records);
     SEQAN_CALL_TEST(test_bam_io_bam_file_bam_file_seek);
@@ -175,11 +181,22 @@ SEQAN_BEGIN_TESTSUITE(test_bam_io)
     // Issue 489
     SEQAN_CALL_TEST(test_bam_io_sam_file_issue_489);
 
+    // Test BamAlignmentRecordView.
+    SEQAN_CALL_TEST(test_bam_io_bam_alignment_record_view_sam_read);
+    SEQAN_CALL_TEST(test_bam_io_bam_alignment_record_view_bam_read);
+    SEQAN_CALL_TEST(test_bam_io_bam_alignment_record_view_copy);
+    SEQAN_CALL_TEST(test_bam_io_bam_alignment_record_view_write);
+
     // Test BAM indices.
     SEQAN_CALL_TEST(test_bam_io_bam_index_save);
-//  TODO(dadi): uncomment when BamIndex.build index is fixed
-//    SEQAN_CALL_TEST(test_bam_io_bam_index_build);
+    SEQAN_CALL_TEST(test_bam_io_bam_index_build);
+    SEQAN_CALL_TEST(test_bam_io_bam_index_build_parallel);
+    SEQAN_CALL_TEST(test_bam_io_bam_index_jump_to_regions);
     SEQAN_CALL_TEST(test_bam_io_bam_index_open);
+
+    // Test BAM sorting.
+    SEQAN_CALL_TEST(test_bam_io_bam_sort_coordinate);
+    SEQAN_CALL_TEST(test_bam_io_bam_sort_queryname);
 #endif
 }
 SEQAN_END_TESTSUITE
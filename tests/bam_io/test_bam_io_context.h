@@ -68,4 +68,41 @@ SEQAN_DEFINE_TEST(test_bam_io_bam_io_context_fragment_store)
     SEQAN_ASSERT_EQ(&store.contigNameStoreCache, &contigNamesCache(bamIOContext));
 }
 
+SEQAN_DEFINE_TEST(test_bam_io_bam_io_context_hash_cache)
+{
+    using namespace seqan;
+
+    typedef StringSet<CharString>         TNameStore;
+    typedef NameStoreHashCache<TNameStore> TNameStoreCache;
+
+    CharString input =
+            "@HD\tVN:1.3\tSO:coordinate\n"
+            "@SQ\tSN:REF1\tLN:10000\n"
+            "@SQ\tSN:REF2\tLN:10000\n"
+            "READ0\t0\tREF2\t1\t8\t10M\t=\t31\t40\tAAAAAAAAAA\t!!!!!!!!!!\n"
+            "READ1\t0\tREF3\t1\t8\t10M\tREF1\t31\t40\tAAAAAAAAAA\t!!!!!!!!!!\n";
+    Iterator<CharString, Rooted>::Type iter = begin(input);
+
+    TNameStore contigNameStore;
+    TNameStoreCache contigNameStoreCache(contigNameStore);
+    BamIOContext<TNameStore, TNameStoreCache> bamIOContext(contigNameStore, contigNameStoreCache);
+    SEQAN_ASSERT_EQ(&contigNameStoreCache, &contigNamesCache(bamIOContext));
+
+    BamHeader header;
+    BamAlignmentRecord record;
+    readHeader(header, bamIOContext, iter, Sam());
+    SEQAN_ASSERT_EQ(length(contigNameStore), 2u);
+
+    readRecord(record, bamIOContext, iter, Sam());
+    SEQAN_ASSERT_EQ(record.rID, 1);
+    SEQAN_ASSERT_EQ(record.rNextId, 1);
+
+    // Unknown reference names are appended to the store.
+    readRecord(record, bamIOContext, iter, Sam());
+    SEQAN_ASSERT_EQ(record.rID, 2);
+    SEQAN_ASSERT_EQ(record.rNextId, 0);
+    SEQAN_ASSERT_EQ(length(contigNameStore), 3u);
+    SEQAN_ASSERT_EQ(contigNameStore[2], "REF3");
+}
+
 #endif  // TESTS_BAM_IO_TEST_BAM_BAM_IO_CONTEXT_H_
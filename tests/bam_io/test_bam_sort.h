@@ -0,0 +1,143 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2015, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Author: David Weese <david.weese@fu-berlin.de>
+// ==========================================================================
+
+#ifndef TESTS_BAM_IO_TEST_BAM_SORT_H_
+#define TESTS_BAM_IO_TEST_BAM_SORT_H_
+
+#include <seqan/basic.h>
+#include <seqan/sequence.h>
+
+#include <seqan/bam_io.h>
+
+using namespace seqan;
+
+// Sort inPath into outPath and return the header and records of outPath.
+
+void testBamIOSortFile(BamHeader & header,
+                       String<BamAlignmentRecord> & records,
+                       CharString const & inPath,
+                       CharString const & outPath,
+                       BamSortOrder sortOrder,
+                       __uint64 maxMemory,
+                       unsigned numThreads,
+                       unsigned maxFanIn = 64)
+{
+    {
+        BamFileIn bamFileIn(toCString(inPath));
+        BamFileOut bamFileOut(bamFileIn, toCString(outPath));
+        _sortBamFile(bamFileOut, bamFileIn, sortOrder, maxMemory, numThreads, maxFanIn);
+    }
+
+    BamFileIn bamFileIn(toCString(outPath));
+    readHeader(header, bamFileIn);
+    clear(records);
+    BamAlignmentRecord record;
+    while (!atEnd(bamFileIn))
+    {
+        readRecord(record, bamFileIn);
+        appendValue(records, record);
+    }
+
+    BamSortLess_ less(sortOrder);
+    for (unsigned i = 1; i < length(records); ++i)
+        SEQAN_ASSERT_NOT(less(records[i], records[i - 1]));
+    SEQAN_ASSERT_EQ(getSortOrder(header), sortOrder);
+}
+
+void testBamIOSortCompare(String<BamAlignmentRecord> const & a, String<BamAlignmentRecord> const & b)
+{
+    SEQAN_ASSERT_EQ(length(a), length(b));
+    for (unsigned i = 0; i < length(a); ++i)
+    {
+        SEQAN_ASSERT_EQ(a[i].qName, b[i].qName);
+        SEQAN_ASSERT_EQ(a[i].flag, b[i].flag);
+        SEQAN_ASSERT_EQ(a[i].rID, b[i].rID);
+        SEQAN_ASSERT_EQ(a[i].beginPos, b[i].beginPos);
+        SEQAN_ASSERT_EQ(a[i].seq, b[i].seq);
+        SEQAN_ASSERT_EQ(a[i].qual, b[i].qual);
+        SEQAN_ASSERT_EQ(a[i].tags, b[i].tags);
+    }
+}
+
+SEQAN_DEFINE_TEST(test_bam_io_bam_sort_coordinate)
+{
+    CharString bamPath = SEQAN_PATH_TO_ROOT();
+    append(bamPath, "/tests/bam_io/ex1.bam");
+    CharString queryNamePath = SEQAN_TEMP_FILENAME();
+    append(queryNamePath, ".bam");
+    CharString inMemoryPath = SEQAN_TEMP_FILENAME();
+    append(inMemoryPath, ".bam");
+    CharString externalPath = SEQAN_TEMP_FILENAME();
+    append(externalPath, ".bam");
+
+    BamHeader header;
+    String<BamAlignmentRecord> queryNameSorted;
+    String<BamAlignmentRecord> inMemory;
+    String<BamAlignmentRecord> external;
+
+    // ex1.bam is sorted by coordinate, shuffle it by sorting it by query name first.
+    testBamIOSortFile(header, queryNameSorted, bamPath, queryNamePath, BAM_SORT_QUERYNAME, 1ull << 30, 1u);
+    SEQAN_ASSERT_EQ(length(queryNameSorted), 3307u);
+
+    testBamIOSortFile(header, inMemory, queryNamePath, inMemoryPath, BAM_SORT_COORDINATE, 1ull << 30, 1u);
+
+    // Spill sorted runs into temporary files and merge them.
+    testBamIOSortFile(header, external, queryNamePath, externalPath, BAM_SORT_COORDINATE, 64ull << 10, 4u);
+    testBamIOSortCompare(external, inMemory);
+
+    // Merge the runs in multiple passes.
+    testBamIOSortFile(header, external, queryNamePath, externalPath, BAM_SORT_COORDINATE, 16ull << 10, 1u, 3u);
+    testBamIOSortCompare(external, inMemory);
+}
+
+SEQAN_DEFINE_TEST(test_bam_io_bam_sort_queryname)
+{
+    CharString bamPath = SEQAN_PATH_TO_ROOT();
+    append(bamPath, "/tests/bam_io/ex1.bam");
+    CharString inMemoryPath = SEQAN_TEMP_FILENAME();
+    append(inMemoryPath, ".sam");
+    CharString externalPath = SEQAN_TEMP_FILENAME();
+    append(externalPath, ".bam");
+
+    BamHeader header;
+    String<BamAlignmentRecord> inMemory;
+    String<BamAlignmentRecord> external;
+
+    // Sort into a SAM file in memory, then sort the SAM file using temporary files.
+    testBamIOSortFile(header, inMemory, bamPath, inMemoryPath, BAM_SORT_QUERYNAME, 1ull << 30, 2u);
+    testBamIOSortFile(header, external, inMemoryPath, externalPath, BAM_SORT_QUERYNAME, 16ull << 10, 1u);
+    testBamIOSortCompare(external, inMemory);
+}
+
+#endif  // TESTS_BAM_IO_TEST_BAM_SORT_H_
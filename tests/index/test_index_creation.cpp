@@ -57,6 +57,8 @@ SEQAN_BEGIN_TESTSUITE(test_index)
     SEQAN_CALL_TEST(testIndexModifiedStringViewEsa);
     SEQAN_CALL_TEST(testIndexModifiedStringViewFM);
     SEQAN_CALL_TEST(testIssue519);
+    SEQAN_CALL_TEST(testIndexCreationPrefixDoubling);
+    SEQAN_CALL_TEST(testIndexCreationPrefixDoublingRandom);
     SEQAN_CALL_TEST(testIndexCreation);
 }
 SEQAN_END_TESTSUITE
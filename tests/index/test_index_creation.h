@@ -126,6 +126,109 @@ SEQAN_DEFINE_TEST(testIssue519)
 //                  << suffix(getValue(strSet, getSeqNo(*iterSet)), getSeqOffset(*iterSet)) << std::endl;
 }
 
+SEQAN_DEFINE_TEST(testIndexCreationPrefixDoubling)
+{
+    // Texts with 64 bit positions.
+    DnaString text = "ACGTACGTACGTTTTTACGACGTACGTACGTAAAAACGTACGTAACGTGTGTGTGTGTGTGACGTACGATTTT";
+    String<__uint64> sa;
+    resize(sa, length(text));
+    createSuffixArray(sa, text, PrefixDoubling<Parallel>());
+    SEQAN_ASSERT(isSuffixArray(sa, text));
+
+    // Text collections with equal suffixes in different sequences.
+    StringSet<CharString> strSet;
+    appendValue(strSet, "bananamama");
+    appendValue(strSet, "bananajoe");
+    appendValue(strSet, "joesmama");
+    appendValue(strSet, "mama");
+    appendValue(strSet, "bananamama");
+    Index<StringSet<CharString>, IndexEsa<> > index1(strSet);
+    Index<StringSet<CharString>, IndexEsa<> > index2(strSet);
+
+    indexCreate(index1, EsaSA(), Skew7());
+    indexCreate(index2, EsaSA(), PrefixDoubling<Parallel>());
+    SEQAN_ASSERT_EQ(indexSA(index1), indexSA(index2));
+
+    // FM indices built with the default and the parallel algorithm are equal.
+    typedef StringSet<DnaString>                TDnaSet;
+    typedef Index<TDnaSet, FMIndex<> >          TFMIndex;
+    typedef Iterator<TFMIndex, TopDown<> >::Type TFMIterator;
+
+    TDnaSet dnaSet;
+    for (unsigned i = 0; i < 20; ++i)
+        appendValue(dnaSet, suffix(text, i * 3));
+    appendValue(dnaSet, text);
+
+    TFMIndex fmIndex1(dnaSet);
+    TFMIndex fmIndex2(dnaSet);
+    indexCreate(fmIndex1);
+    indexCreate(fmIndex2, FibreSALF(), PrefixDoubling<Parallel>());
+
+    for (unsigned i = 0; i + 6 <= length(text); ++i)
+    {
+        // The FM index iterator extends to the left, thus it goes down the reversed pattern.
+        DnaString pattern = infix(text, i, i + 6);
+        reverse(pattern);
+
+        TFMIterator it1(fmIndex1);
+        TFMIterator it2(fmIndex2);
+        SEQAN_ASSERT(goDown(it1, pattern));
+        SEQAN_ASSERT(goDown(it2, pattern));
+        SEQAN_ASSERT_EQ(range(it1), range(it2));
+        for (unsigned j = 0; j < countOccurrences(it1); ++j)
+            SEQAN_ASSERT_EQ(getOccurrences(it1)[j], getOccurrences(it2)[j]);
+    }
+}
+
+SEQAN_DEFINE_TEST(testIndexCreationPrefixDoublingRandom)
+{
+    typedef String<unsigned>                    TSA;
+    typedef StringSet<DnaString>                TDnaSet;
+    typedef Index<TDnaSet, IndexEsa<> >         TEsaIndex;
+
+    // A random text and a periodic text, which keeps large groups of equal prefixes for several rounds.
+    DnaString text;
+    generateText(text, 100000);
+    DnaString repeats;
+    for (unsigned i = 0; i < 1000; ++i)
+        append(repeats, prefix(text, 100));
+
+    TSA sa1, sa2, sa3;
+    resize(sa1, length(text));
+    resize(sa2, length(text));
+    resize(sa3, length(text));
+    createSuffixArray(sa1, text, Skew7());
+    createSuffixArray(sa2, text, PrefixDoubling<Serial>());
+    createSuffixArray(sa3, text, PrefixDoubling<Parallel>());
+    SEQAN_ASSERT(sa1 == sa2);
+    SEQAN_ASSERT(sa1 == sa3);
+
+    createSuffixArray(sa1, repeats, Skew7());
+    createSuffixArray(sa2, repeats, PrefixDoubling<Serial>());
+    createSuffixArray(sa3, repeats, PrefixDoubling<Parallel>());
+    SEQAN_ASSERT(sa1 == sa2);
+    SEQAN_ASSERT(sa1 == sa3);
+
+    // A random text collection with repeated and equal sequences.
+    TDnaSet dnaSet;
+    generateText(dnaSet, 100, 1000);
+    for (unsigned i = 0; i < 20; ++i)
+    {
+        appendValue(dnaSet, infix(repeats, i * 7, 2000 + i * 11));
+        DnaString copy = dnaSet[i];
+        appendValue(dnaSet, copy);
+    }
+
+    TEsaIndex index1(dnaSet);
+    TEsaIndex index2(dnaSet);
+    TEsaIndex index3(dnaSet);
+    indexCreate(index1, EsaSA(), Skew7());
+    indexCreate(index2, EsaSA(), PrefixDoubling<Serial>());
+    indexCreate(index3, EsaSA(), PrefixDoubling<Parallel>());
+    SEQAN_ASSERT(indexSA(index1) == indexSA(index2));
+    SEQAN_ASSERT(indexSA(index1) == indexSA(index3));
+}
+
 SEQAN_DEFINE_TEST(testIndexCreation)
 {
     typedef String<char>        TText;
@@ -181,6 +284,18 @@ SEQAN_DEFINE_TEST(testIndexCreation)
         std::cout << "suffix array creation (internal SAQSort) failed." << std::endl;
     }
 
+    blank(sa);
+    createSuffixArray(sa, text, PrefixDoubling<Serial>());
+    if (!isSuffixArray(sa, text)) {
+        std::cout << "suffix array creation (internal PrefixDoubling) failed." << std::endl;
+    }
+
+    blank(sa);
+    createSuffixArray(sa, text, PrefixDoubling<Parallel>());
+    if (!isSuffixArray(sa, text)) {
+        std::cout << "suffix array creation (parallel PrefixDoubling) failed." << std::endl;
+    }
+
 //    blank(sa);
 //    createSuffixArray(sa, text, QSQGSR(), 3);
 //    if (!isSuffixArray(sa, text)) {
@@ -108,6 +108,46 @@ class CSATest : public FibreTest<TFMIndex, FibreSA> {};
 
 SEQAN_TYPED_TEST_CASE(CSATest, FMIndexTypes2);
 
+// --------------------------------------------------------------------------
+// Class FMIndexFindTest
+// --------------------------------------------------------------------------
+
+template <typename TFMIndex>
+class FMIndexFindTest : public IndexTest<TFMIndex>
+{
+public:
+    typedef IndexTest<TFMIndex>                     TBase;
+    typedef typename TBase::TValue                  TValue;
+    typedef String<TValue>                          TNeedle;
+    typedef StringSet<TNeedle>                      TNeedles;
+
+    TNeedles needles;
+
+    void setUp()
+    {
+        TBase::setUp();
+
+        Rng<MersenneTwister> rng(SEED);
+        unsigned textLength = length(concat(this->text));
+
+        // Half of the needles occur in the text, the other half are random.
+        for (unsigned i = 0; i < 200; ++i)
+        {
+            unsigned needleLength = 1 + i % 13;
+            unsigned needlePos = pickRandomNumber(rng) % (textLength - needleLength);
+            TNeedle needle = infix(concat(this->text), needlePos, needlePos + needleLength);
+
+            if (i % 2)
+                for (unsigned j = 0; j < needleLength; ++j)
+                    needle[j] = TValue(pickRandomNumber(rng) % ValueSize<TValue>::VALUE);
+
+            appendValue(needles, needle);
+        }
+    }
+};
+
+SEQAN_TYPED_TEST_CASE(FMIndexFindTest, FMIndexTypes2);
+
 // ==========================================================================
 // LFTable Tests
 // ========================================================================== 
@@ -193,6 +233,115 @@ SEQAN_TYPED_TEST(CSATest, BeginEnd)
     SEQAN_ASSERT_EQ(position(itEnd), static_cast<TPos>(length(this->fibre)));
 }
 
+// ==========================================================================
+// Find Tests
+// ==========================================================================
+
+// --------------------------------------------------------------------------
+// Test _goDownStrings()
+// --------------------------------------------------------------------------
+
+SEQAN_TYPED_TEST(FMIndexFindTest, GoDownStrings)
+{
+    typedef typename TestFixture::TIndex                    TIndex;
+    typedef typename Iterator<TIndex, TopDown<> >::Type     TIter;
+    typedef typename Iterator<typename TestFixture::TNeedles const, Standard>::Type TNeedlesIt;
+
+    String<TIter> its;
+    String<unsigned> lcps;
+    resize(its, length(this->needles), TIter(this->index));
+
+    _goDownStrings(its, TNeedlesIt(begin(this->needles, Standard())), lcps);
+
+    for (unsigned i = 0; i < length(this->needles); ++i)
+    {
+        TIter it(this->index);
+        unsigned lcp = 0;
+        _goDownString(it, this->needles[i], lcp);
+
+        SEQAN_ASSERT_EQ(lcps[i], lcp);
+        SEQAN_ASSERT_EQ(repLength(its[i]), repLength(it));
+        SEQAN_ASSERT(value(its[i]).range == value(it).range);
+        if (lcp > 0)
+            SEQAN_ASSERT_EQ(parentEdgeLabel(its[i]), parentEdgeLabel(it));
+    }
+}
+
+// --------------------------------------------------------------------------
+// Test find(index, needles, Backtracking<Exact>())
+// --------------------------------------------------------------------------
+
+// The test indices fit into the cache, force batching to test it.
+struct FindBatchedTest_;
+
+namespace seqan {
+template <typename TIndex>
+struct FindBatchMinLength_<TIndex, Backtracking<Exact, FindBatchedTest_> >
+{
+    static const unsigned VALUE = 0;
+};
+}
+
+template <typename TIndex, typename TNeedles, typename TAlgorithm, typename TThreading>
+void testFMIndexFindExact(TIndex & index, TNeedles const & needles, TAlgorithm, TThreading)
+{
+    typedef typename Size<TIndex>::Type                     TSize;
+    typedef Pair<TSize, Pair<TSize> >                       TOcc;
+    typedef typename Iterator<TIndex, TopDown<> >::Type     TIter;
+
+    String<TOcc> expected;
+    for (unsigned i = 0; i < length(needles); ++i)
+    {
+        TIter it(index);
+        if (goDown(it, needles[i]))
+            appendValue(expected, TOcc(i, value(it).range));
+    }
+
+    SEQAN_ASSERT_NOT(empty(expected));
+
+    String<TOcc> occs;
+    find(index, needles, 0u, [&](TIter const & it, typename Iterator<TNeedles const, Rooted>::Type const & needlesIt,
+                                 unsigned errors)
+    {
+        SEQAN_ASSERT_EQ(errors, 0u);
+        SEQAN_OMP_PRAGMA(critical)
+        appendValue(occs, TOcc(position(needlesIt), value(it).range));
+    },
+    TAlgorithm(), TThreading());
+
+    std::sort(begin(occs, Standard()), end(occs, Standard()));
+    SEQAN_ASSERT(occs == expected);
+}
+
+SEQAN_TYPED_TEST(FMIndexFindTest, FindExact)
+{
+    testFMIndexFindExact(this->index, this->needles, Backtracking<Exact>(), Serial());
+    testFMIndexFindExact(this->index, this->needles, Backtracking<Exact>(), Parallel());
+    testFMIndexFindExact(this->index, this->needles, Backtracking<Exact, FindBatchedTest_>(), Serial());
+    testFMIndexFindExact(this->index, this->needles, Backtracking<Exact, FindBatchedTest_>(), Parallel());
+}
+
+// --------------------------------------------------------------------------
+// Test countOccurrences(index, needles)
+// --------------------------------------------------------------------------
+
+SEQAN_TYPED_TEST(FMIndexFindTest, CountOccurrences)
+{
+    typedef typename TestFixture::TIndex                    TIndex;
+    typedef typename Iterator<TIndex, TopDown<> >::Type     TIter;
+    typedef typename Size<TIndex>::Type                     TSize;
+
+    TSize expected = 0;
+    for (unsigned i = 0; i < length(this->needles); ++i)
+    {
+        TIter it(this->index);
+        if (goDown(it, this->needles[i]))
+            expected += countOccurrences(it);
+    }
+
+    SEQAN_ASSERT_EQ(countOccurrences(this->index, this->needles), expected);
+}
+
 // ========================================================================== 
 // Functions
 // ========================================================================== 
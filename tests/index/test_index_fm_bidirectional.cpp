@@ -0,0 +1,458 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2015, Knut Reinert, FU Berlin
+// Copyright (c) 2013 NVIDIA Corporation
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// Tests for the bidirectional FM index and search schemes.
+// ==========================================================================
+
+#include <set>
+
+#include <seqan/basic.h>
+#include <seqan/index.h>
+#include <seqan/random.h>
+
+using namespace seqan;
+
+// ==========================================================================
+// Types
+// ==========================================================================
+
+typedef
+    TagList<Index<DnaString, BidirectionalIndex<> >,
+    TagList<Index<StringSet<DnaString>, BidirectionalIndex<> >
+    > >
+    BidirectionalIndexTypes;
+
+typedef Pair<unsigned>  TOccurrence;
+
+// ==========================================================================
+// Functions
+// ==========================================================================
+
+inline DnaString & getSequence(DnaString & text, unsigned)
+{
+    return text;
+}
+
+inline DnaString & getSequence(StringSet<DnaString> & text, unsigned i)
+{
+    return text[i];
+}
+
+template <typename TRng>
+inline void generateSequence(DnaString & seq, TRng & rng, unsigned seqLength)
+{
+    resize(seq, seqLength);
+    for (unsigned j = 0; j < seqLength; ++j)
+        seq[j] = pickRandomNumber(rng) % ValueSize<Dna>::VALUE;
+}
+
+template <typename TRng>
+inline void generateText(DnaString & text, TRng & rng)
+{
+    generateSequence(text, rng, 3000);
+}
+
+template <typename TRng>
+inline void generateText(StringSet<DnaString> & text, TRng & rng)
+{
+    resize(text, 30);
+    for (unsigned i = 0; i < length(text); ++i)
+        generateSequence(text[i], rng, 50 + pickRandomNumber(rng) % 150);
+}
+
+// Mutate a pattern by substitutions or, if indels is set, by edit operations.
+template <typename TRng>
+inline void mutatePattern(DnaString & pattern, TRng & rng, unsigned errors, bool indels)
+{
+    for (unsigned e = 0; e < errors; ++e)
+    {
+        unsigned pos = pickRandomNumber(rng) % length(pattern);
+        unsigned op = indels ? pickRandomNumber(rng) % 3 : 0;
+
+        if (op == 0)
+            pattern[pos] = (ordValue(pattern[pos]) + 1 + pickRandomNumber(rng) % 3) % 4;
+        else if (op == 1)
+            insertValue(pattern, pos, Dna(pickRandomNumber(rng) % 4));
+        else
+            erase(pattern, pos);
+    }
+}
+
+// Minimal edit distance between the pattern and a text infix starting at pos.
+inline unsigned editDistanceFrom(DnaString const & seq, unsigned pos, DnaString const & pattern)
+{
+    unsigned m = length(pattern);
+    String<unsigned> column;
+    resize(column, m + 1);
+    for (unsigned i = 0; i <= m; ++i)
+        column[i] = i;
+
+    unsigned best = column[m];
+    for (unsigned t = pos; t < length(seq); ++t)
+    {
+        unsigned diag = column[0];
+        column[0]++;
+        for (unsigned i = 1; i <= m; ++i)
+        {
+            unsigned cell = std::min(diag + (seq[t] != pattern[i - 1]), std::min(column[i], column[i - 1]) + 1);
+            diag = column[i];
+            column[i] = cell;
+        }
+        best = std::min(best, column[m]);
+    }
+
+    return best;
+}
+
+inline unsigned editDistance(DnaString const & a, DnaString const & b)
+{
+    String<unsigned> column;
+    resize(column, length(b) + 1);
+    for (unsigned i = 0; i <= length(b); ++i)
+        column[i] = i;
+
+    for (unsigned t = 0; t < length(a); ++t)
+    {
+        unsigned diag = column[0];
+        column[0]++;
+        for (unsigned i = 1; i <= length(b); ++i)
+        {
+            unsigned cell = std::min(diag + (a[t] != b[i - 1]), std::min(column[i], column[i - 1]) + 1);
+            diag = column[i];
+            column[i] = cell;
+        }
+    }
+
+    return column[length(b)];
+}
+
+// ==========================================================================
+// Classes
+// ==========================================================================
+
+// --------------------------------------------------------------------------
+// Class BidirectionalIndexTest
+// --------------------------------------------------------------------------
+
+template <typename TIndex_>
+class BidirectionalIndexTest : public Test
+{
+public:
+    typedef TIndex_                                     TIndex;
+    typedef typename Fibre<TIndex, FibreText>::Type     TText;
+
+    TText   text;
+    TIndex  index;
+    Rng<MersenneTwister> rng;
+
+    BidirectionalIndexTest() :
+        index(text),
+        rng(41)
+    {}
+
+    void setUp()
+    {
+        generateText(text, rng);
+        indexCreate(index);
+    }
+
+    template <typename TPattern>
+    unsigned countNaive(TPattern const & pattern)
+    {
+        unsigned count = 0;
+        for (unsigned i = 0; i < countSequences(text); ++i)
+        {
+            DnaString & seq = getSequence(text, i);
+            for (unsigned j = 0; j + length(pattern) <= length(seq); ++j)
+                count += infix(seq, j, j + length(pattern)) == pattern;
+        }
+        return count;
+    }
+
+    template <typename TIter>
+    void getHits(std::multiset<TOccurrence> & hits, TIter const & it)
+    {
+        typedef typename Fibre<Index<TText, FMIndex<> >, FibreSA>::Type const  TSA;
+        typedef typename Infix<TSA>::Type                                       TOccs;
+
+        TOccs occs = getOccurrences(it);
+        for (unsigned i = 0; i < length(occs); ++i)
+            hits.insert(TOccurrence(getSeqNo(occs[i]), getSeqOffset(occs[i])));
+    }
+};
+
+SEQAN_TYPED_TEST_CASE(BidirectionalIndexTest, BidirectionalIndexTypes);
+
+// --------------------------------------------------------------------------
+// Class SearchSchemesDelegate_
+// --------------------------------------------------------------------------
+
+template <typename TText>
+struct SearchSchemesDelegate_
+{
+    std::multiset<TOccurrence> hits;
+    String<TOccurrence> occurrences;
+    String<unsigned> lengths;
+    String<unsigned> scores;
+
+    template <typename TFinder>
+    void operator()(TFinder const & finder)
+    {
+        typedef typename Fibre<Index<TText, FMIndex<> >, FibreSA>::Type const  TSA;
+        typedef typename Infix<TSA>::Type                                       TOccs;
+
+        TOccs occs = getOccurrences(_textIterator(finder));
+        for (unsigned i = 0; i < length(occs); ++i)
+        {
+            TOccurrence occ(getSeqNo(occs[i]), getSeqOffset(occs[i]));
+            hits.insert(occ);
+            appendValue(occurrences, occ);
+            appendValue(lengths, repLength(_textIterator(finder)));
+            appendValue(scores, _getScore(finder));
+        }
+    }
+};
+
+// ==========================================================================
+// Tests
+// ==========================================================================
+
+// --------------------------------------------------------------------------
+// Test extendLeft() and extendRight()
+// --------------------------------------------------------------------------
+
+SEQAN_TYPED_TEST(BidirectionalIndexTest, ExtendLeftRight)
+{
+    typedef typename TestFixture::TIndex                    TIndex;
+    typedef typename Iterator<TIndex, TopDown<> >::Type     TIter;
+
+    for (unsigned q = 0; q < 50; ++q)
+    {
+        // Half of the queries are random strings, mostly absent from the text.
+        DnaString query;
+        if (q % 2)
+        {
+            generateSequence(query, this->rng, 12);
+        }
+        else
+        {
+            DnaString & seq = getSequence(this->text, pickRandomNumber(this->rng) % countSequences(this->text));
+            unsigned pos = pickRandomNumber(this->rng) % (length(seq) - 12);
+            query = infix(seq, pos, pos + 12);
+        }
+
+        TIter it(this->index);
+        SEQAN_ASSERT(isRoot(it));
+
+        unsigned l = pickRandomNumber(this->rng) % length(query);
+        unsigned r = l;
+        while (l > 0 || r < length(query))
+        {
+            bool right = (l == 0) || (r < length(query) && pickRandomNumber(this->rng) % 2);
+            unsigned expected = this->countNaive(infix(query, right ? l : l - 1, right ? r + 1 : r));
+
+            bool found = right ? extendRight(it, query[r]) : extendLeft(it, query[l - 1]);
+            SEQAN_ASSERT_EQ(found, expected > 0);
+            if (!found) break;
+
+            if (right) ++r; else --l;
+
+            SEQAN_ASSERT_EQ(repLength(it), r - l);
+            SEQAN_ASSERT_EQ(countOccurrences(it), expected);
+            SEQAN_ASSERT_EQ(value(it).revRange.i2 - value(it).revRange.i1, expected);
+
+            std::multiset<TOccurrence> hits;
+            this->getHits(hits, it);
+            SEQAN_ASSERT_EQ(hits.size(), expected);
+            for (std::multiset<TOccurrence>::const_iterator h = hits.begin(); h != hits.end(); ++h)
+                SEQAN_ASSERT(infix(getSequence(this->text, h->i1), h->i2, h->i2 + r - l) == infix(query, l, r));
+        }
+    }
+}
+
+// --------------------------------------------------------------------------
+// Test search schemes
+// --------------------------------------------------------------------------
+
+// Every error distribution over the parts is enumerated by exactly one search.
+SEQAN_TEST(SearchSchemesTest, Pigeonhole)
+{
+    for (unsigned errors = 0; errors <= 4; ++errors)
+    {
+        unsigned parts = errors + 1;
+        String<SearchScheme_> schemes;
+        _pigeonholeSearchSchemes(schemes, parts, errors);
+        SEQAN_ASSERT_EQ(length(schemes), parts);
+
+        String<unsigned> distribution;
+        resize(distribution, parts, 0);
+        while (true)
+        {
+            unsigned total = 0;
+            for (unsigned p = 0; p < parts; ++p)
+                total += distribution[p];
+
+            if (total <= errors)
+            {
+                unsigned covering = 0;
+                for (unsigned s = 0; s < length(schemes); ++s)
+                {
+                    bool covers = true;
+                    for (unsigned t = 0, sum = 0; t < parts; ++t)
+                    {
+                        sum += distribution[schemes[s].pi[t]];
+                        covers &= schemes[s].l[t] <= sum && sum <= schemes[s].u[t];
+                    }
+                    covering += covers;
+                }
+                SEQAN_ASSERT_EQ(covering, 1u);
+            }
+
+            unsigned p = 0;
+            for (; p < parts && distribution[p] == errors; ++p)
+                distribution[p] = 0;
+            if (p == parts) break;
+            distribution[p]++;
+        }
+    }
+}
+
+// --------------------------------------------------------------------------
+// Test find() with Hamming distance
+// --------------------------------------------------------------------------
+
+SEQAN_TYPED_TEST(BidirectionalIndexTest, FindHamming)
+{
+    typedef typename TestFixture::TIndex                                    TIndex;
+    typedef typename TestFixture::TText                                     TText;
+    typedef Finder_<TIndex, DnaString, SearchSchemes<HammingDistance> >     TFinder;
+
+    for (unsigned errors = 0; errors <= 3; ++errors)
+    {
+        for (unsigned q = 0; q < 10; ++q)
+        {
+            DnaString & seq = getSequence(this->text, pickRandomNumber(this->rng) % countSequences(this->text));
+            unsigned patternLength = 8 + pickRandomNumber(this->rng) % 25;
+            unsigned pos = pickRandomNumber(this->rng) % (length(seq) - patternLength);
+            DnaString pattern = infix(seq, pos, pos + patternLength);
+            mutatePattern(pattern, this->rng, pickRandomNumber(this->rng) % (errors + 1), false);
+
+            TFinder finder(this->index);
+            _setScoreThreshold(finder, errors);
+            SearchSchemesDelegate_<TText> delegate;
+            _find(finder, pattern, delegate);
+
+            std::multiset<TOccurrence> expected;
+            for (unsigned i = 0; i < countSequences(this->text); ++i)
+            {
+                DnaString & seq = getSequence(this->text, i);
+                for (unsigned j = 0; j + patternLength <= length(seq); ++j)
+                {
+                    unsigned mismatches = 0;
+                    for (unsigned k = 0; k < patternLength; ++k)
+                        mismatches += seq[j + k] != pattern[k];
+                    if (mismatches <= errors)
+                        expected.insert(TOccurrence(i, j));
+                }
+            }
+
+            SEQAN_ASSERT_GT(delegate.hits.size(), 0u);
+            SEQAN_ASSERT(delegate.hits == expected);
+        }
+    }
+}
+
+// --------------------------------------------------------------------------
+// Test find() with edit distance
+// --------------------------------------------------------------------------
+
+SEQAN_TYPED_TEST(BidirectionalIndexTest, FindEdit)
+{
+    typedef typename TestFixture::TIndex                                    TIndex;
+    typedef typename TestFixture::TText                                     TText;
+    typedef Finder_<TIndex, DnaString, SearchSchemes<EditDistance> >        TFinder;
+
+    for (unsigned errors = 0; errors <= 2; ++errors)
+    {
+        for (unsigned q = 0; q < 10; ++q)
+        {
+            DnaString & seq = getSequence(this->text, pickRandomNumber(this->rng) % countSequences(this->text));
+            unsigned patternLength = 8 + pickRandomNumber(this->rng) % 20;
+            unsigned pos = pickRandomNumber(this->rng) % (length(seq) - patternLength);
+            DnaString pattern = infix(seq, pos, pos + patternLength);
+            mutatePattern(pattern, this->rng, pickRandomNumber(this->rng) % (errors + 1), true);
+
+            TFinder finder(this->index);
+            _setScoreThreshold(finder, errors);
+            SearchSchemesDelegate_<TText> delegate;
+            _find(finder, pattern, delegate);
+
+            // Every reported infix is within the reported number of errors.
+            for (unsigned h = 0; h < length(delegate.occurrences); ++h)
+            {
+                DnaString & seq = getSequence(this->text, delegate.occurrences[h].i1);
+                unsigned begin = delegate.occurrences[h].i2;
+                SEQAN_ASSERT_LEQ(begin + delegate.lengths[h], length(seq));
+                SEQAN_ASSERT_LEQ(editDistance(infix(seq, begin, begin + delegate.lengths[h]), pattern),
+                                 delegate.scores[h]);
+                SEQAN_ASSERT_LEQ(delegate.scores[h], errors);
+            }
+
+            std::set<TOccurrence> hits(delegate.hits.begin(), delegate.hits.end());
+
+            // Every begin position is reported whose best infix is not improved by starting one symbol later.
+            for (unsigned i = 0; i < countSequences(this->text); ++i)
+            {
+                DnaString & seq = getSequence(this->text, i);
+                unsigned next = editDistanceFrom(seq, 0, pattern);
+                for (unsigned j = 0; j < length(seq); ++j)
+                {
+                    unsigned current = next;
+                    next = (j + 1 < length(seq)) ? editDistanceFrom(seq, j + 1, pattern) : errors + 1;
+                    if (current <= errors && current <= next)
+                        SEQAN_ASSERT(hits.count(TOccurrence(i, j)) == 1u);
+                    if (current > errors)
+                        SEQAN_ASSERT(hits.count(TOccurrence(i, j)) == 0u);
+                }
+            }
+        }
+    }
+}
+
+// ==========================================================================
+// Functions
+// ==========================================================================
+
+int main(int argc, char const ** argv)
+{
+    TestSystem::init(argc, argv);
+    return TestSystem::runAll();
+}
@@ -69,6 +69,7 @@ typedef
     TagList<RankDictionary<bool,            Levels<> >,
     TagList<RankDictionary<Dna,             Levels<> >,
     TagList<RankDictionary<char,            Levels<> >,
+    TagList<RankDictionary<Dna,             Interleaved<> >,
     TagList<RankDictionary<Dna,             WaveletTree<> >,
     TagList<RankDictionary<Dna5,            WaveletTree<> >,
     TagList<RankDictionary<DnaQ,            WaveletTree<> >,
@@ -76,7 +77,7 @@ typedef
     TagList<RankDictionary<AminoAcid,       WaveletTree<> >,
     TagList<RankDictionary<char,            WaveletTree<> >,
     TagList<RankDictionary<unsigned char,   WaveletTree<> >
-    > > > > > > > > > > >
+    > > > > > > > > > > > >
     RankDictionaryTypes;
 
 // ========================================================================== 
@@ -116,6 +117,26 @@ public:
 
 SEQAN_TYPED_TEST_CASE(RankDictionaryTest, RankDictionaryTypes);
 
+// --------------------------------------------------------------------------
+// Class InterleavedRankDictionaryTest
+// --------------------------------------------------------------------------
+// Small superblocks make a longer text span several blocks and superblocks.
+
+class InterleavedRankDictionaryTest : public Test
+{
+public:
+    typedef RankDictionary<Dna, Interleaved<void, InterleavedRDConfig<size_t, Alloc<>, 4> > >  TRankDict;
+    typedef DnaString                                                                   TText;
+    typedef Size<TText>::Type                                                           TTextSize;
+
+    TText text;
+
+    void setUp()
+    {
+        generateText(text, 10000u);
+    }
+};
+
 // ========================================================================== 
 // Tests
 // ========================================================================== 
@@ -198,6 +219,60 @@ SEQAN_TYPED_TEST(RankDictionaryTest, GetRank)
     }
 }
 
+// ----------------------------------------------------------------------------
+// Test getRank() and getValue()                                  [Interleaved]
+// ----------------------------------------------------------------------------
+
+SEQAN_TEST_F(InterleavedRankDictionaryTest, GetRank)
+{
+    typedef RankDictionaryEntry_<Dna, Interleaved<> >   TEntry;
+
+    SEQAN_ASSERT_EQ(sizeof(TEntry), 64u);
+
+    TRankDict dict(text);
+
+    SEQAN_ASSERT_EQ((size_t)begin(dict.ranks, Standard()) % 64, 0u);
+    SEQAN_ASSERT_EQ(length(dict.sblocks), 14u);
+
+    Tuple<TTextSize, 4> prefixSum;
+    clear(prefixSum);
+
+    for (TTextSize pos = 0; pos < length(text); ++pos)
+    {
+        prefixSum[ordValue(text[pos])]++;
+
+        SEQAN_ASSERT_EQ(getValue(dict, pos), text[pos]);
+
+        Tuple<TTextSize, 4> ranks = _getRanks(dict, pos);
+
+        for (unsigned c = 0; c < 4; ++c)
+        {
+            SEQAN_ASSERT_EQ(getRank(dict, pos, Dna(c)), prefixSum[c]);
+            SEQAN_ASSERT_EQ(ranks[c], prefixSum[c]);
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Test open() and save()                                         [Interleaved]
+// ----------------------------------------------------------------------------
+
+SEQAN_TEST_F(InterleavedRankDictionaryTest, OpenSave)
+{
+    CharString fileName = SEQAN_TEMP_FILENAME();
+
+    TRankDict dict(text);
+    SEQAN_ASSERT(save(dict, toCString(fileName)));
+
+    TRankDict other;
+    SEQAN_ASSERT(open(other, toCString(fileName)));
+    SEQAN_ASSERT_EQ(length(other.sblocks), length(dict.sblocks));
+
+    for (TTextSize pos = 0; pos < length(text); pos += 17)
+        for (unsigned c = 0; c < 4; ++c)
+            SEQAN_ASSERT_EQ(getRank(other, pos, Dna(c)), getRank(dict, pos, Dna(c)));
+}
+
 // ----------------------------------------------------------------------------
 // Test setValue()
 // ----------------------------------------------------------------------------
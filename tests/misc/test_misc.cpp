@@ -56,6 +56,7 @@
 #include "test_misc_accumulators.h"
 #include "test_misc_edit_environment.h"
 #include "test_misc_bit_twiddling.h"
+#include "test_misc_name_store_cache.h"
 
 using namespace std;
 using namespace seqan;
@@ -116,6 +117,11 @@ SEQAN_BEGIN_TESTSUITE(test_misc) {
     SEQAN_CALL_TEST(Interval_Tree__IntervalTreeTest_GraphMap__int_ComputeCenter_StoreIntervals);
     SEQAN_CALL_TEST(Interval_Tree__IntervalTreeTest_FindIntervalsIntervals__int_ComputeCenter);
 
+    // Test FlatIntervalTree class
+    SEQAN_CALL_TEST(Interval_Tree__FlatIntervalTreeTest_Random);
+    SEQAN_CALL_TEST(Interval_Tree__FlatIntervalTreeTest_QueryAtBoundary);
+    SEQAN_CALL_TEST(Interval_Tree__FlatIntervalTreeTest_Batch);
+
     SEQAN_CALL_TEST(test_misc_accumulators_average_accumulator_int_average);
     SEQAN_CALL_TEST(test_misc_accumulators_average_accumulator_int_count);
     SEQAN_CALL_TEST(test_misc_accumulators_average_accumulator_int_sum);
@@ -130,6 +136,10 @@ SEQAN_BEGIN_TESTSUITE(test_misc) {
     SEQAN_CALL_TEST(test_misc_edit_environment_string_enumerator_iterator_hamming);
     SEQAN_CALL_TEST(test_misc_edit_environment_string_enumerator_edit);
     SEQAN_CALL_TEST(test_misc_edit_environment_string_enumerator_iterator_edit);
+
+    SEQAN_CALL_TEST(test_misc_name_store_hash_cache_lookup);
+    SEQAN_CALL_TEST(test_misc_name_store_hash_cache_many);
+    SEQAN_CALL_TEST(test_misc_name_store_hash_cache_concurrent);
 }
 SEQAN_END_TESTSUITE
 
@@ -723,6 +723,135 @@ SEQAN_DEFINE_TEST(Interval_Tree__IntervalTreeTest_FindIntervalsIntervals__int_Co
     IntervalTreeTest_FindIntervalsIntervals<int, ComputeCenter>();
 }
 
+// Build a FlatIntervalTree and an IntervalTree from the same random intervals for all small sizes and compare point
+// and range queries with the naive algorithm.
+template <typename TResult>
+inline void _flatIntervalTreeSortResult(TResult & result)
+{
+    std::sort(begin(result, Standard()), end(result, Standard()));
+}
+
+SEQAN_DEFINE_TEST(Interval_Tree__FlatIntervalTreeTest_Random)
+{
+    typedef IntervalAndCargo<int, unsigned> TInterval;
+
+    srand(42);
+    for (unsigned n = 0; n < 300; n += (n < 70) ? 1 : 23)
+    {
+        String<TInterval> intervals;
+        for (unsigned i = 0; i < n; ++i)
+        {
+            int b = rand() % 1000;
+            appendValue(intervals, TInterval(b, b + 1 + rand() % ((i % 7 == 0) ? 500 : 20), i));
+        }
+
+        FlatIntervalTree<int, unsigned> flatTree(intervals);
+        IntervalTree<int, unsigned> tree(intervals);
+        SEQAN_ASSERT_EQ(length(flatTree), n);
+
+        String<unsigned> result, expected, treeResult;
+        for (unsigned q = 0; q < 60; ++q)
+        {
+            int qBegin = rand() % 1100 - 50;
+            int qEnd = qBegin + 1 + rand() % 40;
+
+            clear(expected);
+            for (unsigned i = 0; i < n; ++i)
+                if (intervals[i].i1 <= qBegin && qBegin < intervals[i].i2)
+                    appendValue(expected, intervals[i].cargo);
+            findIntervals(result, flatTree, qBegin);
+            findIntervals(treeResult, tree, qBegin);
+            _flatIntervalTreeSortResult(result);
+            _flatIntervalTreeSortResult(treeResult);
+            SEQAN_ASSERT(result == expected);
+            SEQAN_ASSERT(result == treeResult);
+
+            clear(expected);
+            for (unsigned i = 0; i < n; ++i)
+                if (intervals[i].i1 < qEnd && qBegin < intervals[i].i2)
+                    appendValue(expected, intervals[i].cargo);
+            findIntervals(result, flatTree, qBegin, qEnd);
+            _flatIntervalTreeSortResult(result);
+            SEQAN_ASSERT(result == expected);
+        }
+    }
+}
+
+SEQAN_DEFINE_TEST(Interval_Tree__FlatIntervalTreeTest_QueryAtBoundary)
+{
+    typedef IntervalAndCargo<int, double> TInterval;
+
+    String<TInterval> intervals;
+    appendValue(intervals, TInterval(0, 30, 1.4));
+    appendValue(intervals, TInterval(30, 40, 2.2));
+    appendValue(intervals, TInterval(40, 60, 3.3));
+    FlatIntervalTree<int, double> flatTree(intervals);
+
+    String<double> result;
+    findIntervals(result, flatTree, 20, 30);
+    SEQAN_ASSERT_EQ(length(result), 1u);
+    SEQAN_ASSERT_EQ(result[0], 1.4);
+
+    findIntervals(result, flatTree, 30);
+    SEQAN_ASSERT_EQ(length(result), 1u);
+    SEQAN_ASSERT_EQ(result[0], 2.2);
+
+    findIntervals(result, flatTree, 60);
+    SEQAN_ASSERT(empty(result));
+
+    clear(flatTree);
+    SEQAN_ASSERT(empty(flatTree));
+    findIntervals(result, flatTree, 20);
+    SEQAN_ASSERT(empty(result));
+}
+
+SEQAN_DEFINE_TEST(Interval_Tree__FlatIntervalTreeTest_Batch)
+{
+    typedef IntervalAndCargo<int, unsigned> TInterval;
+
+    srand(4711);
+    String<TInterval> intervals;
+    for (unsigned i = 0; i < 5000; ++i)
+    {
+        int b = rand() % 100000;
+        appendValue(intervals, TInterval(b, b + 1 + rand() % 300, i));
+    }
+    FlatIntervalTree<int, unsigned> flatTree;
+    createIntervalTree(flatTree, intervals);
+
+    String<int> points;
+    String<Pair<int, int> > ranges;
+    for (unsigned q = 0; q < 1000; ++q)
+    {
+        int qBegin = rand() % 100000;
+        appendValue(points, qBegin);
+        appendValue(ranges, Pair<int, int>(qBegin, qBegin + 1 + rand() % 100));
+    }
+
+    String<String<unsigned> > pointResults, rangeResults, rangeResultsParallel;
+    findIntervals(pointResults, flatTree, points);
+    findIntervals(rangeResults, flatTree, ranges);
+    findIntervals(rangeResultsParallel, flatTree, ranges, 4u);
+    SEQAN_ASSERT_EQ(length(pointResults), length(points));
+    SEQAN_ASSERT_EQ(length(rangeResults), length(ranges));
+
+    String<unsigned> result;
+    for (unsigned q = 0; q < length(points); ++q)
+    {
+        findIntervals(result, flatTree, points[q]);
+        _flatIntervalTreeSortResult(result);
+        _flatIntervalTreeSortResult(pointResults[q]);
+        SEQAN_ASSERT(result == pointResults[q]);
+
+        findIntervals(result, flatTree, ranges[q].i1, ranges[q].i2);
+        _flatIntervalTreeSortResult(result);
+        _flatIntervalTreeSortResult(rangeResults[q]);
+        _flatIntervalTreeSortResult(rangeResultsParallel[q]);
+        SEQAN_ASSERT(result == rangeResults[q]);
+        SEQAN_ASSERT(result == rangeResultsParallel[q]);
+    }
+}
+
 }  // SEQAN_NAMESPACE_MAIN
 
 #endif
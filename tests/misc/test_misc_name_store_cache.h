@@ -0,0 +1,142 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2015, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Author: David Weese <david.weese@fu-berlin.de>
+// ==========================================================================
+// Tests for misc/name_store_cache.h.
+// ==========================================================================
+
+#ifndef TESTS_MISC_TEST_MISC_NAME_STORE_CACHE_H_
+#define TESTS_MISC_TEST_MISC_NAME_STORE_CACHE_H_
+
+#include <sstream>
+
+#include <seqan/basic.h>
+#include <seqan/sequence.h>
+#include <seqan/misc/name_store_cache.h>
+
+SEQAN_DEFINE_TEST(test_misc_name_store_hash_cache_lookup)
+{
+    using namespace seqan;
+
+    typedef StringSet<CharString> TNameStore;
+
+    TNameStore nameStore;
+    appendValue(nameStore, "I");
+    appendValue(nameStore, "II");
+    appendValue(nameStore, "I");    // duplicates map to the first occurrence
+
+    NameStoreHashCache<TNameStore> cache(nameStore);
+    SEQAN_ASSERT_NOT(empty(cache));
+    SEQAN_ASSERT_EQ(&host(cache), &nameStore);
+
+    unsigned idx = 0;
+    SEQAN_ASSERT(getIdByName(idx, cache, "I"));
+    SEQAN_ASSERT_EQ(idx, 0u);
+    SEQAN_ASSERT(getIdByName(idx, cache, CharString("II")));
+    SEQAN_ASSERT_EQ(idx, 1u);
+    SEQAN_ASSERT_NOT(getIdByName(idx, cache, "III"));
+
+    appendName(cache, "III");
+    SEQAN_ASSERT(getIdByName(idx, cache, "III"));
+    SEQAN_ASSERT_EQ(idx, 3u);
+
+    SEQAN_ASSERT_EQ(nameToId(cache, "II"), 1u);
+    SEQAN_ASSERT_EQ(nameToId(cache, "IV"), 4u);
+    SEQAN_ASSERT_EQ(length(nameStore), 5u);
+
+    // Modifications bypassing the cache need a refresh.
+    appendValue(nameStore, "V");
+    SEQAN_ASSERT_NOT(getIdByName(idx, cache, "V"));
+    refresh(cache);
+    SEQAN_ASSERT(getIdByName(idx, cache, "V"));
+    SEQAN_ASSERT_EQ(idx, 5u);
+
+    NameStoreHashCache<TNameStore> copy(cache);
+    SEQAN_ASSERT(getIdByName(idx, copy, "IV"));
+    SEQAN_ASSERT_EQ(idx, 4u);
+
+    clear(cache);
+    SEQAN_ASSERT(empty(cache));
+    SEQAN_ASSERT_NOT(getIdByName(idx, cache, "I"));
+    SEQAN_ASSERT_EQ(length(nameStore), 6u);
+}
+
+SEQAN_DEFINE_TEST(test_misc_name_store_hash_cache_many)
+{
+    using namespace seqan;
+
+    typedef StringSet<CharString> TNameStore;
+
+    TNameStore nameStore, treeNameStore;
+    NameStoreHashCache<TNameStore> cache(nameStore);
+    NameStoreCache<TNameStore> treeCache(treeNameStore);
+
+    for (unsigned i = 0; i < 20000; ++i)
+    {
+        std::stringstream ss;
+        ss << "chrUn_" << (i * 7919u) % 10007u;
+        SEQAN_ASSERT_EQ(nameToId(cache, ss.str()), nameToId(treeCache, ss.str()));
+    }
+    SEQAN_ASSERT_EQ(length(nameStore), 10007u);
+    SEQAN_ASSERT(nameStore == treeNameStore);
+}
+
+SEQAN_DEFINE_TEST(test_misc_name_store_hash_cache_concurrent)
+{
+    using namespace seqan;
+
+    typedef StringSet<CharString> TNameStore;
+
+    TNameStore nameStore;
+    NameStoreHashCache<TNameStore> cache(nameStore);
+    String<unsigned> ids;
+    resize(ids, 4000);
+
+    // All threads insert the same 1000 names, each name must get exactly one id.
+    SEQAN_OMP_PRAGMA(parallel for num_threads(4))
+    for (int i = 0; i < 4000; ++i)
+    {
+        std::stringstream ss;
+        ss << "contig" << (i % 1000);
+        ids[i] = nameToId(cache, ss.str());
+    }
+
+    SEQAN_ASSERT_EQ(length(nameStore), 1000u);
+    for (unsigned i = 0; i < 4000; ++i)
+    {
+        std::stringstream ss;
+        ss << "contig" << (i % 1000);
+        SEQAN_ASSERT_EQ(nameStore[ids[i]], ss.str());
+    }
+}
+
+#endif  // TESTS_MISC_TEST_MISC_NAME_STORE_CACHE_H_
@@ -60,6 +60,8 @@ SEQAN_BEGIN_TESTSUITE(test_modifier)
     SEQAN_CALL_TEST(test_modifer_shortcuts_complement_in_place_string_set);
     SEQAN_CALL_TEST(test_modifer_shortcuts_reverse_complement_in_place_string);
     SEQAN_CALL_TEST(test_modifer_shortcuts_reverse_complement_in_place_string_set);
+    SEQAN_CALL_TEST(test_modifer_shortcuts_reverse_complement_in_place_bulk);
+    SEQAN_CALL_TEST(test_modifer_shortcuts_reverse_complement_in_place_concat_string_set);
     SEQAN_CALL_TEST(test_modifer_shortcuts_reverse_in_place_string);
     SEQAN_CALL_TEST(test_modifer_shortcuts_reverse_in_place_string_set);
     SEQAN_CALL_TEST(test_modifier_reverse_iterator_metafunctions);
@@ -226,6 +226,75 @@ SEQAN_DEFINE_TEST(test_modifer_shortcuts_reverse_complement_in_place_string_set)
     }
 }
 
+template <typename TValue>
+inline void assignTestQuality(TValue &, int)
+{}
+
+inline void assignTestQuality(seqan::DnaQ & val, int qual)
+{
+    assignQualityValue(val, qual);
+}
+
+inline void assignTestQuality(seqan::Dna5Q & val, int qual)
+{
+    assignQualityValue(val, qual);
+}
+
+// Compares the in-place reverse complement with an element-wise reference.
+template <typename TString, typename TParallelTag>
+void testReverseComplementInPlace(unsigned maxLength, unsigned step, TParallelTag parallelTag)
+{
+    typedef typename seqan::Value<TString>::Type TValue;
+
+    for (unsigned len = 0; len <= maxLength; len += step)
+    {
+        TString str;
+        for (unsigned i = 0; i < len; ++i)
+        {
+            TValue val = "ACGTNacgtn"[(i * i + 7 * i / 3) % 10];
+            assignTestQuality(val, i % 40);
+            appendValue(str, val);
+        }
+
+        seqan::String<TValue> expected;
+        for (unsigned i = len; i != 0; --i)
+            appendValue(expected, seqan::FunctorComplement<TValue>()(str[i - 1]));
+        reverseComplement(str, parallelTag);
+
+        SEQAN_ASSERT_EQ(length(expected), length(str));
+        for (unsigned i = 0; i < len; ++i)
+            SEQAN_ASSERT(expected[i] == str[i]);
+    }
+}
+
+SEQAN_DEFINE_TEST(test_modifer_shortcuts_reverse_complement_in_place_bulk)
+{
+    testReverseComplementInPlace<seqan::DnaString>(200, 1, seqan::Serial());
+    testReverseComplementInPlace<seqan::Dna5String>(200, 1, seqan::Serial());
+    testReverseComplementInPlace<seqan::RnaString>(100, 1, seqan::Serial());
+    testReverseComplementInPlace<seqan::Rna5String>(100, 1, seqan::Serial());
+    testReverseComplementInPlace<seqan::String<seqan::DnaQ> >(100, 1, seqan::Serial());
+    testReverseComplementInPlace<seqan::String<seqan::Dna5Q> >(100, 1, seqan::Serial());
+    testReverseComplementInPlace<seqan::IupacString>(100, 1, seqan::Serial());
+    testReverseComplementInPlace<seqan::String<seqan::Dna, seqan::Packed<> > >(300, 1, seqan::Serial());
+    testReverseComplementInPlace<seqan::String<seqan::Rna, seqan::Packed<> > >(100, 1, seqan::Serial());
+    testReverseComplementInPlace<seqan::String<seqan::Dna5, seqan::Packed<> > >(100, 1, seqan::Serial());
+    testReverseComplementInPlace<seqan::Dna5String>(60000, 19999, seqan::Parallel());
+}
+
+SEQAN_DEFINE_TEST(test_modifer_shortcuts_reverse_complement_in_place_concat_string_set)
+{
+    seqan::StringSet<seqan::String<seqan::Dna5Q>, seqan::Owner<seqan::ConcatDirect<> > > seqs;
+    appendValue(seqs, seqan::Dna5String("CCGGTTAANNACGTACGTACGTACGTACGTACGTACGT"));
+    appendValue(seqs, seqan::Dna5String("CGTAN"));
+    assignQualityValue(seqs[0][0], 30);
+
+    reverseComplement(seqs);
+    SEQAN_ASSERT_EQ(seqan::Dna5String(seqs[0]), seqan::Dna5String("ACGTACGTACGTACGTACGTACGTACGTNNTTAACCGG"));
+    SEQAN_ASSERT_EQ(seqan::Dna5String(seqs[1]), seqan::Dna5String("NTACG"));
+    SEQAN_ASSERT_EQ(getQualityValue(seqs[0][length(seqs[0]) - 1]), 30);
+}
+
 SEQAN_DEFINE_TEST(test_modifer_shortcuts_reverse_in_place_string)
 {
     seqan::Dna5String str = "CGATN";
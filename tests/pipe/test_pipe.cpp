@@ -280,6 +280,24 @@ SEQAN_DEFINE_TEST(test_pipe_test_external_string) {
 }
 
 
+SEQAN_DEFINE_TEST(test_pipe_test_mmap_string_readonly) {
+    CharString fileName = SEQAN_TEMP_FILENAME();
+    {
+        String<unsigned, MMap<> > str;
+        SEQAN_ASSERT(open(str, toCString(fileName), OPEN_RDWR | OPEN_CREATE));
+        for (unsigned i = 0; i < 100000; ++i)
+            appendValue(str, i * 7);
+    }
+
+    String<unsigned, MMap<> > str;
+    SEQAN_ASSERT(open(str, toCString(fileName), OPEN_RDONLY | OPEN_HUGEPAGES));
+    SEQAN_ASSERT_EQ(length(str), 100000u);
+    for (unsigned i = 0; i < 100000; ++i)
+        SEQAN_ASSERT_EQ(str[i], i * 7);
+    SEQAN_ASSERT(close(str));
+}
+
+
 SEQAN_DEFINE_TEST(test_pipe_test_simple_pool) {
     testPool(MAX_SIZE);
 }
@@ -299,6 +317,77 @@ SEQAN_DEFINE_TEST(test_pipe_test_sorter) {
     testSorter(MAX_SIZE);
 }
 
+
+SEQAN_DEFINE_TEST(test_pipe_test_sorter_memory_budget) {
+    // every buffer the sorter allocates is charged to the budget
+    PoolMemoryBudget budget(1024 * 1024);
+    PoolParameters conf(budget);
+
+    Buffer<unsigned> buf;
+    allocPage(buf, 4 * MAX_SIZE, buf);
+    permute(buf);
+    {
+        Pool<unsigned,SorterSpec<SorterConfig<SimpleCompare<unsigned> > > > sorter(conf);
+        Pipe<Buffer<unsigned>, Source<> > src(buf);
+        sorter << src;
+
+        // 16 MB exceed the budget and are sorted externally
+        SEQAN_ASSERT(sorter.memBuffer.begin == NULL);
+
+        beginRead(sorter);
+        for (unsigned pos = 0; pos < 4 * MAX_SIZE; ++pos, ++sorter)
+            SEQAN_ASSERT_EQ(*sorter, pos);
+        SEQAN_ASSERT(eof(sorter));
+        endRead(sorter);
+    }
+    SEQAN_ASSERT_GT(budget.peak, 0u);
+    SEQAN_ASSERT_LEQ(budget.peak, budget.limit);
+    SEQAN_ASSERT_EQ(budget.used, 0u);
+
+    // small contents are kept in memory and charged as well
+    resize(buf, 1024);
+    permute(buf);
+    {
+        Pool<unsigned,SorterSpec<SorterConfig<SimpleCompare<unsigned> > > > sorter(conf);
+        Pipe<Buffer<unsigned>, Source<> > src(buf);
+        sorter << src;
+        SEQAN_ASSERT(sorter.memBuffer.begin != NULL);
+        SEQAN_ASSERT_EQ(budget.used, 1024u * sizeof(unsigned));
+    }
+    SEQAN_ASSERT_EQ(budget.used, 0u);
+    freePage(buf, buf);
+}
+
+
+SEQAN_DEFINE_TEST(test_pipe_test_skew7_memory_budget) {
+    typedef StringSet<DnaString>                        TText;
+    typedef String<Pair<unsigned, unsigned> >           TSA;
+
+    TText text;
+    resize(text, 4);
+    srand(0);
+    for (unsigned i = 0; i < length(text); ++i)
+    {
+        resize(text[i], MAX_SIZE / 2 + 1000 * i);
+        for (unsigned j = 0; j < length(text[i]); ++j)
+            text[i][j] = Dna(rand() % 4);
+    }
+
+    TSA expected, sa;
+    resize(expected, lengthSum(text));
+    resize(sa, lengthSum(text));
+    createSuffixArray(expected, text, Skew7());
+
+    // all pools alive during the recursion share the budget
+    PoolMemoryBudget budget(4 * 1024 * 1024);
+    createSuffixArray(sa, text, Skew7(), PoolParameters(budget));
+
+    SEQAN_ASSERT(sa == expected);
+    SEQAN_ASSERT_GT(budget.peak, 0u);
+    SEQAN_ASSERT_LEQ(budget.peak, budget.limit);
+    SEQAN_ASSERT_EQ(budget.used, 0u);
+}
+
 template <typename TStringSet>
 inline void appendValues(TStringSet &stringSet, int numArgs, ...)
 {
@@ -667,10 +756,13 @@ SEQAN_DEFINE_TEST(test_pipe_tupler_multi)
 SEQAN_BEGIN_TESTSUITE(test_pipe) {
 	std::cerr << "";  // This line is an esoteric fix for an even more esoteric crash in MS VC++ 9/10.
     SEQAN_CALL_TEST(test_pipe_test_external_string);
+    SEQAN_CALL_TEST(test_pipe_test_mmap_string_readonly);
     SEQAN_CALL_TEST(test_pipe_test_simple_pool);
     SEQAN_CALL_TEST(test_pipe_test_mapper);
     SEQAN_CALL_TEST(test_pipe_test_mapper_partially_filled);
     SEQAN_CALL_TEST(test_pipe_test_sorter);
+    SEQAN_CALL_TEST(test_pipe_test_sorter_memory_budget);
+    SEQAN_CALL_TEST(test_pipe_test_skew7_memory_budget);
     SEQAN_CALL_TEST(test_pipe_sampler);
     SEQAN_CALL_TEST(test_pipe_tupler);
     SEQAN_CALL_TEST(test_pipe_tupler_multi);
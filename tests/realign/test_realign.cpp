@@ -648,6 +648,59 @@ SEQAN_DEFINE_TEST(test_realign_tricky_insert_window_cuts)
     SEQAN_ASSERT_EQ(ss.str(), EXPECTED);
 }
 
+// Realigning all contigs at once, possibly in parallel, yields the same as realigning them one by one.
+SEQAN_DEFINE_TEST(test_realign_all_contigs)
+{
+    const char * READS[] =
+    {
+        "AACTAAATGCATCCATGTATGCCACAGTGTATACTCTGGAATACTATACAGTAGTTAAAATGTGGTATAGCTGAAAGTACAGTACCGAAATGCCAT",
+        "ATCCATGTATGCCACAGTGTATACTCTGGAATACTATACAGTAGTTAAAATGTGGTATAGCTGAAAGTACAGTACCGAAATGCCATTGCAGAGTAG",
+        "GCCACAGTGTATACTCTGGAATACTATACAGTAGTTAAAATGTGGTATAGCTGAAAGTACAGTACCGAAATGCCATTGCAGAGTAGTAAGACCCCA",
+        "ATACTCTGGAATACTATACAGTAGTTAAATGTGGTATAGCTGAAAGTACAGTACCGAAATGCCATTGCAGAGTAGTAAGACCCCACTTCTATTAA",
+        "ATACTATACAGTAGTTAAAAAGAATGTGGTATAGCTGAAAGTACAGTACCGAAATGCCATTGCAGAGTAGTAAGACCCCACTTCTATTAAATGAAAAGTT"
+    };
+
+    typedef typename seqan::Size<typename seqan::FragmentStore<>::TAlignedReadStore>::Type TSize;
+    seqan::FragmentStore<> store;
+    resize(store.contigStore, 3);
+    appendValue(store.contigNameStore, "ref0");
+    appendValue(store.contigNameStore, "ref1");
+    appendValue(store.contigNameStore, "ref2");
+
+    // Add the reads to the contigs in reverse order, the reads on contig 1 are reverse-complemented.
+    for (int contigID = 2; contigID >= 0; --contigID)
+        for (unsigned i = 0; i < 5u; ++i)
+        {
+            seqan::Dna5String seq = READS[i];
+            if (contigID == 1)
+                reverseComplement(seq);
+            unsigned readID = appendRead(store, seq);
+            TSize beginPos = 10 * i, endPos = beginPos + length(seq);
+            if (contigID == 1)
+                std::swap(beginPos, endPos);
+            appendAlignedRead(store, readID, contigID, beginPos, endPos);
+        }
+
+    seqan::FragmentStore<> expectedStore = store;
+    for (unsigned contigID = 0; contigID < 3u; ++contigID)
+        reAlignment(expectedStore, contigID, 1, 10, false, 0, 0, DEBUG_REALIGNMENT);
+
+    reAlignmentAllContigs(store, 1, 10, false, /*numThreads=*/3, DEBUG_REALIGNMENT);
+
+    seqan::AlignedReadLayout layout, expectedLayout;
+    layoutAlignment(layout, store);
+    layoutAlignment(expectedLayout, expectedStore);
+    for (unsigned contigID = 0; contigID < 3u; ++contigID)
+    {
+        std::stringstream ss, expectedSS;
+        printAlignment(ss, layout, store, contigID, 0, 200, 0, 20);
+        printAlignment(expectedSS, expectedLayout, expectedStore, contigID, 0, 200, 0, 20);
+        SEQAN_ASSERT_EQ(ss.str(), expectedSS.str());
+        SEQAN_ASSERT_EQ(store.contigStore[contigID].seq, expectedStore.contigStore[contigID].seq);
+    }
+    SEQAN_ASSERT(store.readSeqStore == expectedStore.readSeqStore);
+}
+
 SEQAN_BEGIN_TESTSUITE(test_realign)
 {
 	SEQAN_CALL_TEST(test_realign_one_read_no_gaps);
@@ -664,5 +717,7 @@ SEQAN_BEGIN_TESTSUITE(test_realign)
 	SEQAN_CALL_TEST(test_realign_simple_insert_window_tight_right);
 
     SEQAN_CALL_TEST(test_realign_tricky_insert_window_cuts);
+
+    SEQAN_CALL_TEST(test_realign_all_contigs);
 }
 SEQAN_END_TESTSUITE
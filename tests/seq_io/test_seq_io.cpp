@@ -60,6 +60,8 @@ SEQAN_BEGIN_TESTSUITE(test_seq_io)
     // Test reading with different interfaces.
     SEQAN_CALL_TEST(test_seq_io_sequence_file_read_record_text_fasta);
     SEQAN_CALL_TEST(test_seq_io_sequence_file_read_all_text_fasta);
+    SEQAN_CALL_TEST(test_seq_io_sequence_file_read_records_parallel_text_fasta);
+    SEQAN_CALL_TEST(test_seq_io_sequence_file_read_records_parallel_text_fastq);
 
     // Test writing with different interfaces.
     SEQAN_CALL_TEST(test_seq_io_sequence_file_write_record_text_fasta);
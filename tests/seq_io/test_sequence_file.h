@@ -169,6 +169,90 @@ SEQAN_DEFINE_TEST(test_seq_io_sequence_file_read_all_text_fasta)
     SEQAN_ASSERT(atEnd(seqIO));
 }
 
+// ---------------------------------------------------------------------------
+// Test reading batches of records in parallel.
+// ---------------------------------------------------------------------------
+
+template <typename TSeqString>
+void testSeqIOSequenceFileReadRecordsParallel(seqan::CharString const & filePath, unsigned batchSize)
+{
+    // Read all records sequentially as reference.
+    seqan::StringSet<seqan::CharString> expectedIds;
+    seqan::StringSet<TSeqString> expectedSeqs;
+    seqan::StringSet<seqan::CharString> expectedQuals;
+    {
+        SeqFileIn seqIO(toCString(filePath));
+        readRecords(expectedIds, expectedSeqs, expectedQuals, seqIO);
+    }
+
+    for (unsigned numThreads = 2; numThreads <= 4; numThreads += 2)
+    {
+        SeqFileIn seqIO(toCString(filePath));
+        seqan::StringSet<seqan::CharString> ids;
+        seqan::StringSet<TSeqString> seqs;
+        seqan::StringSet<seqan::CharString> quals;
+        while (!atEnd(seqIO))
+            readRecords(ids, seqs, quals, seqIO, batchSize, numThreads);
+
+        SEQAN_ASSERT_EQ(length(ids), length(expectedIds));
+        for (unsigned i = 0; i < length(expectedIds); ++i)
+        {
+            SEQAN_ASSERT_EQ(ids[i], expectedIds[i]);
+            SEQAN_ASSERT_EQ(seqs[i], expectedSeqs[i]);
+            SEQAN_ASSERT_EQ(quals[i], expectedQuals[i]);
+        }
+
+        // Qualities stored inside the sequence.
+        SeqFileIn seqIO2(toCString(filePath));
+        seqan::StringSet<seqan::CharString> ids2;
+        seqan::StringSet<seqan::String<seqan::Dna5Q> > seqs2;
+        while (!atEnd(seqIO2))
+            readRecords(ids2, seqs2, seqIO2, batchSize, numThreads);
+
+        SEQAN_ASSERT_EQ(length(seqs2), length(expectedSeqs));
+        for (unsigned i = 0; i < length(expectedSeqs); ++i)
+        {
+            SEQAN_ASSERT_EQ(ids2[i], expectedIds[i]);
+            seqan::CharString qual;
+            for (unsigned j = 0; j < length(seqs2[i]); ++j)
+                appendValue(qual, (char)(getQualityValue(seqs2[i][j]) + 33));
+            if (!empty(expectedQuals[i]))
+                SEQAN_ASSERT_EQ(qual, expectedQuals[i]);
+        }
+    }
+}
+
+SEQAN_DEFINE_TEST(test_seq_io_sequence_file_read_records_parallel_text_fasta)
+{
+    seqan::CharString filePath = SEQAN_PATH_TO_ROOT();
+    append(filePath, "/tests/seq_io/test_dna.fa");
+
+    testSeqIOSequenceFileReadRecordsParallel<seqan::Dna5String>(filePath, 2u);
+    testSeqIOSequenceFileReadRecordsParallel<seqan::CharString>(filePath, 2u);
+}
+
+SEQAN_DEFINE_TEST(test_seq_io_sequence_file_read_records_parallel_text_fastq)
+{
+    seqan::CharString filePath = SEQAN_PATH_TO_ROOT();
+    append(filePath, "/tests/seq_io/test_dna.fq");
+
+    testSeqIOSequenceFileReadRecordsParallel<seqan::Dna5String>(filePath, 2u);
+    testSeqIOSequenceFileReadRecordsParallel<seqan::CharString>(filePath, 2u);
+
+    // SRR067601_1.1k.fasta contains 1000 FASTQ records, copy it to a file with FASTQ extension.
+    seqan::CharString srrPath = SEQAN_PATH_TO_ROOT();
+    append(srrPath, "/tests/seq_io/SRR067601_1.1k.fasta");
+    seqan::CharString tmpPath = SEQAN_TEMP_FILENAME();
+    append(tmpPath, ".fq");
+    {
+        std::ifstream in(toCString(srrPath), std::ios::binary);
+        std::ofstream out(toCString(tmpPath), std::ios::binary);
+        out << in.rdbuf();
+    }
+
+    testSeqIOSequenceFileReadRecordsParallel<seqan::Dna5String>(tmpPath, 300u);
+}
+
 // ---------------------------------------------------------------------------
 // Test writing with different interfaces.
 // ---------------------------------------------------------------------------
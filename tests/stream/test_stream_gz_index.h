@@ -0,0 +1,318 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2015, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Tests for the access point index of gzip files.
+// ==========================================================================
+
+#ifndef TEST_STREAM_TEST_STREAM_GZ_INDEX_H_
+#define TEST_STREAM_TEST_STREAM_GZ_INDEX_H_
+
+#include <seqan/basic.h>
+#include <seqan/sequence.h>
+#include <seqan/stream.h>
+
+#include <sstream>
+
+#if SEQAN_HAS_ZLIB
+
+using namespace seqan;
+
+// Write a gzip file with numbered copies of FASTQ_EXAMPLE, return the uncompressed contents.
+inline CharString
+testGZFileIndexWriteFile(CharString const & fileName, unsigned firstCopy, unsigned numCopies)
+{
+    CharString buffer;
+    for (unsigned i = firstCopy; i != firstCopy + numCopies; ++i)
+    {
+        appendNumber(buffer, i);
+        append(buffer, "@seq");
+        appendNumber(buffer, i * 7919u % 10007u);
+        append(buffer, FASTQ_EXAMPLE);
+    }
+
+    VirtualStream<char, Output> vostream(toCString(fileName), OPEN_WRONLY);
+    SEQAN_ASSERT((bool)vostream);
+    vostream << buffer;
+    close(vostream);
+    return buffer;
+}
+
+inline CharString
+testGZFileIndexReadAll(std::istream & stream)
+{
+    std::stringstream sstr;
+    sstr << stream.rdbuf();
+    return CharString(sstr.str());
+}
+
+SEQAN_TEST(GZFileIndexTest, Build)
+{
+    CharString fileName = SEQAN_TEMP_FILENAME();
+    append(fileName, ".gz");
+    CharString buffer = testGZFileIndexWriteFile(fileName, 0, 20000);
+
+    GZFileIndex index;
+    SEQAN_ASSERT(build(index, toCString(fileName), 65536u));
+    SEQAN_ASSERT_EQ(index.uncompressedSize, length(buffer));
+    SEQAN_ASSERT_GT(length(index.points), 4u);
+    SEQAN_ASSERT_EQ(index.points[0].uncompressedOffset, 0u);
+    for (unsigned i = 1; i < length(index.points); ++i)
+        SEQAN_ASSERT_GT(index.points[i].uncompressedOffset, index.points[i - 1].uncompressedOffset + 65536u);
+
+    // Save and load the index.
+    CharString indexFileName = getIndexFileName(index, fileName);
+    SEQAN_ASSERT(save(index, toCString(indexFileName)));
+    GZFileIndex index2;
+    SEQAN_ASSERT(open(index2, toCString(indexFileName)));
+    SEQAN_ASSERT_EQ(index2.compressedSize, index.compressedSize);
+    SEQAN_ASSERT_EQ(index2.uncompressedSize, index.uncompressedSize);
+    SEQAN_ASSERT_EQ(index2.fingerprint, index.fingerprint);
+    SEQAN_ASSERT_EQ(length(index2.points), length(index.points));
+    for (unsigned i = 0; i < length(index.points); ++i)
+        SEQAN_ASSERT_EQ(index2.points[i].crc, index.points[i].crc);
+    SEQAN_ASSERT(index2.windows == index.windows);
+
+    // Not a gzip file.
+    CharString plainFileName = SEQAN_PATH_TO_ROOT();
+    append(plainFileName, "/tests/seq_io/test_dna.fq");
+    SEQAN_ASSERT_NOT(build(index, toCString(plainFileName)));
+    SEQAN_ASSERT_NOT(open(index, toCString(plainFileName)));
+}
+
+SEQAN_TEST(GZFileIndexTest, Read)
+{
+    CharString fileName = SEQAN_TEMP_FILENAME();
+    append(fileName, ".gz");
+    CharString buffer = testGZFileIndexWriteFile(fileName, 0, 20000);
+
+    GZFileIndex index;
+    SEQAN_ASSERT(build(index, toCString(fileName), 65536u));
+
+    std::ifstream file(toCString(fileName), std::ios::binary | std::ios::in);
+    basic_gz_index_istream<char> stream(file, index);
+    SEQAN_ASSERT(testGZFileIndexReadAll(stream) == buffer);
+}
+
+SEQAN_TEST(GZFileIndexTest, Seek)
+{
+    CharString fileName = SEQAN_TEMP_FILENAME();
+    append(fileName, ".gz");
+    CharString buffer = testGZFileIndexWriteFile(fileName, 0, 20000);
+
+    GZFileIndex index;
+    SEQAN_ASSERT(build(index, toCString(fileName), 65536u));
+
+    std::ifstream file(toCString(fileName), std::ios::binary | std::ios::in);
+    basic_gz_index_istream<char> stream(file, index);
+
+    // Seek to chunk borders and random positions, forwards and backwards.
+    String<__uint64> positions;
+    for (unsigned i = 0; i < length(index.points); ++i)
+    {
+        appendValue(positions, index.points[i].uncompressedOffset);
+        appendValue(positions, index.points[i].uncompressedOffset - (i != 0));
+    }
+    for (unsigned i = 0; i < 20; ++i)
+        appendValue(positions, (i * 104729ull) % length(buffer));
+    appendValue(positions, length(buffer) - 1);
+
+    char chars[16];
+    for (unsigned i = 0; i < length(positions); ++i)
+    {
+        __uint64 pos = positions[length(positions) - 1 - i];
+        SEQAN_ASSERT((bool)stream.seekg(pos));
+        SEQAN_ASSERT_EQ((__uint64)stream.tellg(), pos);
+
+        size_t count = std::min((size_t)16, (size_t)(length(buffer) - pos));
+        SEQAN_ASSERT((bool)stream.read(chars, count));
+        SEQAN_ASSERT(CharString(prefix(suffix(buffer, pos), count)) == CharString(String<char>(chars, count)));
+    }
+
+    // Relative seeks.
+    SEQAN_ASSERT((bool)stream.seekg(-10, std::ios_base::end));
+    SEQAN_ASSERT_EQ((__uint64)stream.tellg(), length(buffer) - 10);
+    SEQAN_ASSERT((bool)stream.seekg(-100000, std::ios_base::cur));
+    SEQAN_ASSERT_EQ((__uint64)stream.tellg(), length(buffer) - 100010);
+    SEQAN_ASSERT((bool)stream.read(chars, 1));
+    SEQAN_ASSERT_EQ(chars[0], buffer[length(buffer) - 100010]);
+
+    // Read until the end after seeking back to the beginning.
+    SEQAN_ASSERT((bool)stream.seekg(0));
+    SEQAN_ASSERT(testGZFileIndexReadAll(stream) == buffer);
+}
+
+SEQAN_TEST(GZFileIndexTest, MultiMember)
+{
+    // Concatenate two gzip files into a multi-member gzip file.
+    CharString fileName1 = SEQAN_TEMP_FILENAME();
+    append(fileName1, ".gz");
+    CharString buffer = testGZFileIndexWriteFile(fileName1, 0, 8000);
+    CharString fileName2 = SEQAN_TEMP_FILENAME();
+    append(fileName2, ".gz");
+    append(buffer, testGZFileIndexWriteFile(fileName2, 8000, 8000));
+
+    CharString fileName = SEQAN_TEMP_FILENAME();
+    append(fileName, ".gz");
+    {
+        std::ofstream out(toCString(fileName), std::ios::binary | std::ios::out);
+        std::ifstream in1(toCString(fileName1), std::ios::binary | std::ios::in);
+        std::ifstream in2(toCString(fileName2), std::ios::binary | std::ios::in);
+        out << in1.rdbuf() << in2.rdbuf();
+    }
+
+    GZFileIndex index;
+    SEQAN_ASSERT(build(index, toCString(fileName), 32768u));
+    SEQAN_ASSERT_EQ(index.uncompressedSize, length(buffer));
+
+    std::ifstream file(toCString(fileName), std::ios::binary | std::ios::in);
+    basic_gz_index_istream<char> stream(file, index);
+    SEQAN_ASSERT(testGZFileIndexReadAll(stream) == buffer);
+}
+
+SEQAN_TEST(GZFileIndexTest, VirtualStream)
+{
+    CharString fileName = SEQAN_TEMP_FILENAME();
+    append(fileName, ".gz");
+    CharString buffer = testGZFileIndexWriteFile(fileName, 0, 20000);
+
+    GZFileIndex index;
+    SEQAN_ASSERT(build(index, toCString(fileName), 65536u));
+    SEQAN_ASSERT(save(index, toCString(getIndexFileName(index, fileName))));
+
+    // The VirtualStream picks up the index stored next to the file.
+    VirtualStream<char, Input> vstream(toCString(fileName), OPEN_RDONLY);
+    SEQAN_ASSERT((bool)vstream);
+    SEQAN_ASSERT(dynamic_cast<basic_gz_index_streambuf<char> *>(vstream.streamBuf) != NULL);
+
+    std::stringstream sstr;
+    sstr << vstream.streamBuf;
+    SEQAN_ASSERT(CharString(sstr.str()) == buffer);
+    close(vstream);
+}
+
+SEQAN_TEST(GZFileIndexTest, Verify)
+{
+    CharString fileName = SEQAN_TEMP_FILENAME();
+    append(fileName, ".gz");
+    testGZFileIndexWriteFile(fileName, 0, 100000);
+
+    GZFileIndex index;
+    SEQAN_ASSERT(build(index, toCString(fileName), 65536u));
+    CharString indexFileName = getIndexFileName(index, fileName);
+    SEQAN_ASSERT(save(index, toCString(indexFileName)));
+    SEQAN_ASSERT(_gzFileIndexMatches(index, toCString(fileName)));
+
+    CharString contents;
+    {
+        std::ifstream in(toCString(fileName), std::ios::binary | std::ios::in);
+        contents = testGZFileIndexReadAll(in);
+    }
+    SEQAN_ASSERT_GT(length(contents), 3u * GZFileIndex::FINGERPRINT_SIZE);
+
+    // A file of the same size with a different tail does not match the index.
+    CharString otherFileName = SEQAN_TEMP_FILENAME();
+    append(otherFileName, ".gz");
+    {
+        CharString otherContents = contents;
+        otherContents[length(otherContents) - 5] ^= 1;
+        std::ofstream out(toCString(otherFileName), std::ios::binary | std::ios::out);
+        out << otherContents;
+    }
+    SEQAN_ASSERT_NOT(_gzFileIndexMatches(index, toCString(otherFileName)));
+
+    // Corrupted compressed data between the fingerprinted ends is detected during decompression, by an inflate error
+    // or by the CRC32 of its chunk.
+    GZFileIndex badIndex = index;
+    back(badIndex.points).crc ^= 1;
+    {
+        std::ifstream file(toCString(fileName), std::ios::binary | std::ios::in);
+        basic_gz_index_istream<char> stream(file, badIndex);
+        bool caught = false;
+        SEQAN_TRY
+        {
+            // Read from the streambuf directly, istream operations would catch the exception.
+            while (stream.rdbuf()->sbumpc() != std::char_traits<char>::eof()) {}
+        }
+        SEQAN_CATCH(IOError const &)
+        {
+            caught = true;
+        }
+        SEQAN_ASSERT(caught);
+    }
+    {
+        CharString otherContents = contents;
+        otherContents[length(otherContents) / 2] ^= 1;
+        std::ofstream out(toCString(otherFileName), std::ios::binary | std::ios::out);
+        out << otherContents;
+    }
+    SEQAN_ASSERT(_gzFileIndexMatches(index, toCString(otherFileName)));
+    {
+        std::ifstream file(toCString(otherFileName), std::ios::binary | std::ios::in);
+        basic_gz_index_istream<char> stream(file, index);
+        bool caught = false;
+        SEQAN_TRY
+        {
+            while (stream.rdbuf()->sbumpc() != std::char_traits<char>::eof()) {}
+        }
+        SEQAN_CATCH(IOError const &)
+        {
+            caught = true;
+        }
+        SEQAN_ASSERT(caught);
+    }
+
+    // Truncated and inconsistent index files are rejected.
+    CharString indexContents;
+    {
+        std::ifstream in(toCString(indexFileName), std::ios::binary | std::ios::in);
+        indexContents = testGZFileIndexReadAll(in);
+    }
+    CharString badIndexFileName = SEQAN_TEMP_FILENAME();
+    {
+        std::ofstream out(toCString(badIndexFileName), std::ios::binary | std::ios::out);
+        out << prefix(indexContents, length(indexContents) - 1);
+    }
+    SEQAN_ASSERT_NOT(open(index, toCString(badIndexFileName)));
+    {
+        // A huge number of access points (at offset 28) must not be allocated.
+        CharString badContents = indexContents;
+        for (unsigned i = 0; i < 8; ++i)
+            badContents[28 + i] = (char)0xff;
+        std::ofstream out(toCString(badIndexFileName), std::ios::binary | std::ios::out);
+        out << badContents;
+    }
+    SEQAN_ASSERT_NOT(open(index, toCString(badIndexFileName)));
+    SEQAN_ASSERT(open(index, toCString(indexFileName)));
+}
+
+#endif  // #if SEQAN_HAS_ZLIB
+
+#endif  // TEST_STREAM_TEST_STREAM_GZ_INDEX_H_
@@ -35,6 +35,9 @@
 // ==========================================================================
 
 #include <cmath>
+#include <cstdio>
+#include <limits>
+#include <sstream>
 
 #ifndef TEST_STREAM_TEST_LEXICAL_CAST_H_
 
@@ -148,6 +151,17 @@ typedef Product<CharString, SignedTypes>::Type AppendSignedTypes;
 
 SEQAN_TYPED_TEST_CASE(AppendSignedTest, AppendSignedTypes);
 
+// --------------------------------------------------------------------------
+// Class AppendIntegerTest
+// --------------------------------------------------------------------------
+
+template <typename TTargetSourcePair>
+class AppendIntegerTest : public LexicalTest<TTargetSourcePair> {};
+
+typedef Product<CharString, IntegerTypes>::Type AppendIntegerTypes;
+
+SEQAN_TYPED_TEST_CASE(AppendIntegerTest, AppendIntegerTypes);
+
 // --------------------------------------------------------------------------
 // Class AppendFloatingPointTest
 // --------------------------------------------------------------------------
@@ -201,6 +215,51 @@ SEQAN_TYPED_TEST(LexicalCastTest, FloatingPointSource)
     if (success) SEQAN_ASSERT_LT(this->target + reciprocal, epsilon);
 }
 
+// --------------------------------------------------------------------------
+// Test lexicalCast(TTarget, ExponentSource)
+// --------------------------------------------------------------------------
+
+SEQAN_TYPED_TEST(LexicalCastTest, ExponentSource)
+{
+    assign(this->source, "-1.2345E4");
+    bool success = lexicalCast(this->target, this->source);
+    SEQAN_ASSERT(success ^ IsIntegral<typename TestFixture::TTarget>::VALUE);
+    if (success) SEQAN_ASSERT_EQ(this->target, static_cast<typename TestFixture::TTarget>(-12345));
+
+    assign(this->source, "25e-2");
+    success = lexicalCast(this->target, this->source);
+    SEQAN_ASSERT(success ^ IsIntegral<typename TestFixture::TTarget>::VALUE);
+    if (success) SEQAN_ASSERT_EQ(this->target, static_cast<typename TestFixture::TTarget>(0.25));
+}
+
+// --------------------------------------------------------------------------
+// Test lexicalCast(TTarget, FractionSource)
+// --------------------------------------------------------------------------
+
+SEQAN_TYPED_TEST(LexicalCastTest, FractionSource)
+{
+    assign(this->source, ".5");
+    bool success = lexicalCast(this->target, this->source);
+    SEQAN_ASSERT(success ^ IsIntegral<typename TestFixture::TTarget>::VALUE);
+    if (success) SEQAN_ASSERT_EQ(this->target, static_cast<typename TestFixture::TTarget>(0.5));
+
+    assign(this->source, "5.");
+    success = lexicalCast(this->target, this->source);
+    SEQAN_ASSERT(success ^ IsIntegral<typename TestFixture::TTarget>::VALUE);
+    if (success) SEQAN_ASSERT_EQ(this->target, static_cast<typename TestFixture::TTarget>(5));
+
+    // Long mantissas and large exponents take the slow path and must agree with strtod().
+    assign(this->source, "0.1000000000000000055511151231257827");
+    success = lexicalCast(this->target, this->source);
+    SEQAN_ASSERT(success ^ IsIntegral<typename TestFixture::TTarget>::VALUE);
+    if (success) SEQAN_ASSERT_EQ(this->target, static_cast<typename TestFixture::TTarget>(0.1));
+
+    assign(this->source, "1e30");
+    success = lexicalCast(this->target, this->source);
+    SEQAN_ASSERT(success ^ IsIntegral<typename TestFixture::TTarget>::VALUE);
+    if (success) SEQAN_ASSERT_EQ(this->target, static_cast<typename TestFixture::TTarget>(1e30));
+}
+
 // --------------------------------------------------------------------------
 // Test lexicalCast(TTarget, WrongPrefixSource)
 // --------------------------------------------------------------------------
@@ -272,4 +331,49 @@ SEQAN_TYPED_TEST(AppendFloatingPointTest, AppendNumber)
     SEQAN_ASSERT_EQ(this->target, "foo-123.45");
 }
 
+// --------------------------------------------------------------------------
+// Test appendNumber(TTarget, IntegerLimits)
+// --------------------------------------------------------------------------
+
+SEQAN_TYPED_TEST(AppendIntegerTest, Limits)
+{
+    typedef typename TestFixture::TSource TSource;
+
+    std::ostringstream expected;
+    expected << std::numeric_limits<TSource>::min() << ' ' << std::numeric_limits<TSource>::max() << ' ' << 0;
+
+    clear(this->target);
+    appendNumber(this->target, std::numeric_limits<TSource>::min());
+    appendValue(this->target, ' ');
+    appendNumber(this->target, std::numeric_limits<TSource>::max());
+    appendValue(this->target, ' ');
+    appendNumber(this->target, static_cast<TSource>(0));
+    SEQAN_ASSERT_EQ(this->target, expected.str());
+}
+
+// --------------------------------------------------------------------------
+// Test appendNumber(TTarget, FloatingPointSource) against printf("%g")
+// --------------------------------------------------------------------------
+
+SEQAN_TYPED_TEST(AppendFloatingPointTest, PrintfCompatible)
+{
+    typedef typename TestFixture::TSource TSource;
+
+    static const double values[] =
+    {
+        0.0, -0.0, 1.0, -29.0, 0.1, 0.5, 1.0 / 3.0, 2.5, 0.125, 0.0001, 0.00012345675, 1e-5, 123456.5,
+        999999.4, 999999.5, 1e6, 1234567.0, 1e300, 3.0e-300
+    };
+
+    char buffer[64];
+    for (unsigned i = 0; i < sizeof(values) / sizeof(values[0]); ++i)
+    {
+        TSource value = static_cast<TSource>(values[i]);
+        snprintf(buffer, 64, "%g", static_cast<double>(value));
+        clear(this->target);
+        appendNumber(this->target, value);
+        SEQAN_ASSERT_EQ(this->target, buffer);
+    }
+}
+
 #endif // ifndef TEST_STREAM_TEST_LEXICAL_CAST_H_
@@ -360,4 +360,100 @@ SEQAN_TYPED_TEST(TokenizationTest, SkipLine)
     SEQAN_ASSERT(atEnd(ctx.iter));
 }
 
+// Splits a long text with delimiters at all chunk offsets and compares
+// readUntil() and skipUntil() with a plain character loop.
+template <typename TStream, typename TStopFunctor>
+void testTokenizationDelimiterScan(TStopFunctor stopFunctor)
+{
+    std::string text;
+    for (unsigned i = 0; i < 3000; ++i)
+    {
+        text += static_cast<char>('a' + (i * 7) % 26);
+        if ((i * i) % 37 == 0)
+            text += "\t\n\r |0\xe9"[(i / 37) % 7];
+        else if (i % 101 == 0)
+            text += '5';
+    }
+
+    TokenizationContext<TStream> ctx(text.c_str());
+    CharString buf;
+    size_t pos = 0;
+    bool skip = false;
+    while (!atEnd(ctx.iter))
+    {
+        size_t stop = pos;
+        while (stop < text.size() && !stopFunctor(text[stop]))
+            ++stop;
+
+        if (skip)
+        {
+            skipUntil(ctx.iter, stopFunctor);
+        }
+        else
+        {
+            clear(buf);
+            readUntil(buf, ctx.iter, stopFunctor);
+            SEQAN_ASSERT_EQ(buf, text.substr(pos, stop - pos));
+        }
+        skip = !skip;
+
+        if (stop == text.size())
+        {
+            SEQAN_ASSERT(atEnd(ctx.iter));
+            break;
+        }
+        SEQAN_ASSERT_EQ(value(ctx.iter), text[stop]);
+        skipOne(ctx.iter);
+        pos = stop + 1;
+    }
+}
+
+SEQAN_TYPED_TEST(TokenizationTest, DelimiterScan)
+{
+    typedef typename TestFixture::TStream TStream;
+
+    testTokenizationDelimiterScan<TStream>(IsNewline());
+    testTokenizationDelimiterScan<TStream>(IsTab());
+    testTokenizationDelimiterScan<TStream>(IsWhitespace());
+    testTokenizationDelimiterScan<TStream>(EqualsChar<'|'>());
+    testTokenizationDelimiterScan<TStream>(IsDigit());
+    testTokenizationDelimiterScan<TStream>(NotFunctor<IsGraph>());
+    testTokenizationDelimiterScan<TStream>(NotFunctor<IsAlpha>());
+    testTokenizationDelimiterScan<TStream>(AndFunctor<IsGraph, NotFunctor<IsAlpha> >());
+}
+
+// Reads nucleotides of all cases and unknown characters into the alphabets with
+// vectorised character conversion and compares them with element-wise assignment.
+template <typename TStream, typename TAlphabet>
+void testTokenizationReadNucleotides()
+{
+    std::string text;
+    for (unsigned i = 0; i < 1000; ++i)
+        text += "ACGTUNacgtunXx*-.\x80\xc1\xe1"[(i * i + i / 7) % 20];
+    text += '\n';
+
+    TokenizationContext<TStream> ctx(text.c_str());
+    String<TAlphabet> seq;
+    readUntil(seq, ctx.iter, IsNewline());
+
+    String<TAlphabet> expected;
+    for (unsigned i = 0; i + 1 < text.size(); ++i)
+        appendValue(expected, text[i]);
+    SEQAN_ASSERT_EQ(length(seq), length(expected));
+    for (unsigned i = 0; i < length(seq); ++i)
+        SEQAN_ASSERT_EQ(ordValue(seq[i]), ordValue(expected[i]));
+    SEQAN_ASSERT_EQ(value(ctx.iter), '\n');
+}
+
+SEQAN_TYPED_TEST(TokenizationTest, ReadNucleotides)
+{
+    typedef typename TestFixture::TStream TStream;
+
+    testTokenizationReadNucleotides<TStream, Dna>();
+    testTokenizationReadNucleotides<TStream, Dna5>();
+    testTokenizationReadNucleotides<TStream, Rna>();
+    testTokenizationReadNucleotides<TStream, Rna5>();
+    testTokenizationReadNucleotides<TStream, Iupac>();
+}
+
 #endif // ifndef TEST_STREAM_TEST_STREAM_TOKENIZATION_H_
@@ -161,6 +161,80 @@ SEQAN_TYPED_TEST(VStreamTest, Compression)
     close(vistream);
 }
 
+#if SEQAN_HAS_ZLIB
+SEQAN_TYPED_TEST(VStreamTest, CompressionThreads)
+{
+    CharString buffer;
+    for (unsigned i = 0; i != 10000; ++i)
+    {
+        appendNumber(buffer,i);
+        append(buffer, FASTQ_EXAMPLE);
+    }
+
+    typedef typename TestFixture::Type TCompressionTag;
+    CharString fileName = SEQAN_TEMP_FILENAME();
+    append(fileName, FileExtensions<TCompressionTag>::VALUE[0]);
+
+    // Only BGZF streams are multi-threaded, all other streams must ignore the setting.
+    size_t oldCompressionThreads = bgzfCompressionThreads();
+    size_t oldDecompressionThreads = bgzfDecompressionThreads();
+    setBgzfThreads(3, 1);
+    SEQAN_ASSERT_EQ(bgzfCompressionThreads(), 3u);
+    SEQAN_ASSERT_EQ(bgzfDecompressionThreads(), 1u);
+    {
+        // The settings are applied to the BGZF streams opened afterwards.
+        std::stringstream outStr, inStr;
+        bgzf_ostream bgzfOut(outStr);
+        SEQAN_ASSERT_EQ(bgzfOut.rdbuf()->numThreads, 3u);
+        bgzf_istream bgzfIn(inStr);
+        SEQAN_ASSERT_EQ(bgzfIn.rdbuf()->numThreads, 1u);
+    }
+    {
+        // An explicit thread count of a stream overrides the setting.
+        std::stringstream outStr, inStr;
+        bgzf_ostream bgzfOut(outStr, 2);
+        SEQAN_ASSERT_EQ(bgzfOut.rdbuf()->numThreads, 2u);
+        bgzf_istream bgzfIn(inStr, 2);
+        SEQAN_ASSERT_EQ(bgzfIn.rdbuf()->numThreads, 2u);
+
+        std::stringstream bgzfStr;
+        {
+            VirtualStream<char, Output> vostream;
+            vostream.bgzfThreads = 2;
+            SEQAN_ASSERT(open(vostream, bgzfStr, BgzfFile()));
+            basic_bgzf_streambuf<char> *buf = dynamic_cast<basic_bgzf_streambuf<char> *>(vostream.streamBuf);
+            SEQAN_ASSERT(buf != NULL);
+            SEQAN_ASSERT_EQ(buf->numThreads, 2u);
+            vostream << buffer;
+        }
+        VirtualStream<char, Input> vistream;
+        vistream.bgzfThreads = 2;
+        SEQAN_ASSERT(open(vistream, bgzfStr));
+        basic_unbgzf_streambuf<char> *buf = dynamic_cast<basic_unbgzf_streambuf<char> *>(vistream.streamBuf);
+        SEQAN_ASSERT(buf != NULL);
+        SEQAN_ASSERT_EQ(buf->numThreads, 2u);
+        std::stringstream sstr;
+        sstr << vistream.streamBuf;
+        SEQAN_ASSERT_EQ(CharString(sstr.str()), buffer);
+        SEQAN_ASSERT_EQ(bgzfCompressionThreads(), 3u);
+        SEQAN_ASSERT_EQ(bgzfDecompressionThreads(), 1u);
+    }
+    {
+        VirtualStream<char, Output> vostream(toCString(fileName), OPEN_WRONLY);
+        SEQAN_ASSERT((bool)vostream);
+        vostream << buffer;
+    }
+
+    VirtualStream<char, Input> vistream(toCString(fileName), OPEN_RDONLY);
+    SEQAN_ASSERT((bool)vistream);
+    std::stringstream sstr;
+    sstr << vistream.streamBuf;
+    SEQAN_ASSERT_EQ(CharString(sstr.str()), buffer);
+    close(vistream);
+    setBgzfThreads(oldCompressionThreads, oldDecompressionThreads);
+}
+#endif  // #if SEQAN_HAS_ZLIB
+
 SEQAN_TYPED_TEST(VStreamTest, AutoDetection)
 {
     typedef typename TestFixture::Type TCompressionTag;
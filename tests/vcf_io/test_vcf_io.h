@@ -35,6 +35,7 @@
 #ifndef SEQAN_TESTS_VCF_TEST_VCF_IO_H_
 #define SEQAN_TESTS_VCF_TEST_VCF_IO_H_
 
+#include <fstream>
 #include <iostream>
 
 #include <seqan/basic.h>
@@ -269,6 +270,129 @@ SEQAN_DEFINE_TEST(test_vcf_io_vcf_file_read_record)
     SEQAN_ASSERT_EQ(length(records[2].genotypeInfos), 3u);
 }
 
+SEQAN_DEFINE_TEST(test_vcf_io_vcf_file_read_records_batch)
+{
+    seqan::CharString vcfPath = SEQAN_PATH_TO_ROOT();
+    append(vcfPath, "/tests/vcf_io/example.vcf");
+
+    // Read the records one by one as reference.
+    seqan::VcfFileIn vcfStream(toCString(vcfPath));
+    seqan::VcfHeader header;
+    readHeader(header, vcfStream);
+
+    seqan::String<seqan::VcfRecord> expected;
+    seqan::VcfRecord record;
+    while (!atEnd(vcfStream))
+    {
+        readRecord(record, vcfStream);
+        appendValue(expected, record);
+    }
+    SEQAN_ASSERT_EQ(length(expected), 3u);
+
+    for (unsigned numThreads = 1; numThreads <= 4; numThreads += 3)
+    {
+        seqan::VcfFileIn vcfBatchStream(toCString(vcfPath));
+        readHeader(header, vcfBatchStream);
+
+        seqan::String<seqan::VcfRecord> records;
+        seqan::String<seqan::VcfRecord> batch;
+        while (!atEnd(vcfBatchStream))
+        {
+            unsigned numRecords = readRecords(batch, vcfBatchStream, 2u, numThreads);
+            SEQAN_ASSERT_GT(numRecords, 0u);
+            append(records, prefix(batch, numRecords));
+        }
+
+        SEQAN_ASSERT_EQ(length(records), length(expected));
+        for (unsigned i = 0; i < length(expected); ++i)
+        {
+            SEQAN_ASSERT_EQ(records[i].rID, expected[i].rID);
+            SEQAN_ASSERT_EQ(records[i].beginPos, expected[i].beginPos);
+            SEQAN_ASSERT_EQ(records[i].id, expected[i].id);
+            SEQAN_ASSERT_EQ(records[i].ref, expected[i].ref);
+            SEQAN_ASSERT_EQ(records[i].alt, expected[i].alt);
+            SEQAN_ASSERT_EQ(records[i].qual, expected[i].qual);
+            SEQAN_ASSERT_EQ(records[i].filter, expected[i].filter);
+            SEQAN_ASSERT_EQ(records[i].info, expected[i].info);
+            SEQAN_ASSERT_EQ(records[i].format, expected[i].format);
+            SEQAN_ASSERT(records[i].genotypeInfos == expected[i].genotypeInfos);
+        }
+    }
+}
+
+// Contigs missing in the header must get the same ids as with sequential reading, the first bad record must fail.
+
+SEQAN_DEFINE_TEST(test_vcf_io_vcf_file_read_records_batch_names)
+{
+    seqan::CharString vcfPath = SEQAN_TEMP_FILENAME();
+    append(vcfPath, ".vcf");
+    {
+        std::ofstream out(toCString(vcfPath), std::ios::binary);
+        out << "##fileformat=VCFv4.1\n##contig=<ID=20,length=62435964>\n"
+            << "#CHROM\tPOS\tID\tREF\tALT\tQUAL\tFILTER\tINFO\tFORMAT\tNA00001\n";
+        for (unsigned i = 0; i < 500; ++i)
+        {
+            if (i % 5 == 0)
+                out << "20";
+            else
+                out << "ctg" << (i * 7) % 31;
+            out << "\t" << i + 1 << "\t.\tG\tA\t29\tPASS\tDP=14\tGT\t0|1\n";
+        }
+        out << "20\tx\t.\tG\tA\t29\tPASS\tDP=14\tGT\t0|1\n";
+        out << "20\t1\t.\tG\tA\t29\tPASS\tDP=14\tGT\t0|1\n";
+        out << "20\ty\t.\tG\tA\t29\tPASS\tDP=14\tGT\t0|1\n";
+    }
+
+    seqan::VcfHeader header;
+    seqan::VcfRecord record;
+    seqan::String<seqan::VcfRecord> expected;
+    std::string expectedError;
+
+    seqan::VcfFileIn vcfStream(toCString(vcfPath));
+    readHeader(header, vcfStream);
+    try
+    {
+        while (!atEnd(vcfStream))
+        {
+            readRecord(record, vcfStream);
+            appendValue(expected, record);
+        }
+    }
+    catch (seqan::ParseError const & e)
+    {
+        expectedError = e.what();
+    }
+    SEQAN_ASSERT_EQ(length(expected), 500u);
+    SEQAN_ASSERT_NOT(expectedError.empty());
+
+    for (unsigned numThreads = 1; numThreads <= 4; numThreads += 3)
+    {
+        seqan::VcfFileIn vcfBatchStream(toCString(vcfPath));
+        readHeader(header, vcfBatchStream);
+
+        seqan::String<seqan::VcfRecord> records;
+        unsigned numRecords = readRecords(records, vcfBatchStream, 500u, numThreads);
+        SEQAN_ASSERT_EQ(numRecords, 500u);
+        for (unsigned i = 0; i < numRecords; ++i)
+        {
+            SEQAN_ASSERT_EQ(records[i].rID, expected[i].rID);
+            SEQAN_ASSERT_EQ(records[i].beginPos, expected[i].beginPos);
+        }
+        SEQAN_ASSERT(contigNames(context(vcfBatchStream)) == contigNames(context(vcfStream)));
+
+        std::string error;
+        try
+        {
+            readRecords(records, vcfBatchStream, 10u, numThreads);
+        }
+        catch (seqan::ParseError const & e)
+        {
+            error = e.what();
+        }
+        SEQAN_ASSERT_EQ(error, expectedError);
+    }
+}
+
 SEQAN_DEFINE_TEST(test_vcf_io_write_vcf_header)
 {
     seqan::VcfIOContext<> vcfIOContext;